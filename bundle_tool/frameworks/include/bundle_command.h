@@ -36,7 +36,8 @@ const std::string HELP_MSG = "usage: bm <command> <options>\n"
                              "  disable      disable the bundle\n"
                              "  get          obtain device udid\n"
                              "  getrm        obtain the value of isRemovable by given bundle name and module name\n"
-                             "  setrm        set module isRemovable by given bundle name and module name\n";
+                             "  setrm        set module isRemovable by given bundle name and module name\n"
+                             "  batch        run the operations listed in a manifest concurrently\n";
 
 const std::string HELP_MSG_INSTALL =
     "usage: bm install <options>\n"
@@ -68,7 +69,8 @@ const std::string HELP_MSG_DUMP =
     "  -n, --bundle-name <bundle-name>      list the bundle info by a bundle name\n"
     "  -s, --shortcut-info                  list the shortcut info\n"
     "  -d, --device-id <device-id>          specify a device id\n"
-    "  -u, --user-id <user-id>              specify a user id\n";
+    "  -u, --user-id <user-id>              specify a user id\n"
+    "  -l, --json-lines                     print a json object per line and bundle, with -a, -i or -n\n";
 
 const std::string HELP_MSG_CLEAN =
     "usage: bm clean <options>\n"
@@ -117,6 +119,21 @@ const std::string HELP_MSG_GET_REMOVABLE =
     "  -n, --bundle-name  <bundle-name>       get isRemovable by moduleNmae and bundleName\n"
     "  -m, --module-name <module-name>        get isRemovable by moduleNmae and bundleName\n";
 
+const std::string HELP_MSG_BATCH =
+    "usage: bm batch <options>\n"
+    "eg:bm batch -f <manifest-path> -j 8\n"
+    "options list:\n"
+    "  -h, --help                             list available commands\n"
+    "  -f, --file <manifest-path>             run the operations of a manifest, one per line, among:\n"
+    "                                           install -p <hap-file-path> ... [-u <user-id>]\n"
+    "                                           uninstall -n <bundle-name> [-m <module-name>] [-k] [-u <user-id>]\n"
+    "                                           enable -n <bundle-name> [-a <ability-name>] [-u <user-id>]\n"
+    "                                           disable -n <bundle-name> [-a <ability-name>] [-u <user-id>]\n"
+    "                                           clean -n <bundle-name> -c|-d [-u <user-id>]\n"
+    "                                         blank lines and lines starting with '#' are skipped\n"
+    "  -j, --jobs <number>                    run at most <number> operations at the same time, 4 by default\n"
+    "  -l, --json-lines                       print the result of each operation as a json object per line\n";
+
 const std::string STRING_INCORRECT_OPTION = "error: incorrect option";
 const std::string HELP_MSG_NO_BUNDLE_PATH_OPTION =
     "error: you must specify a bundle path with '-p' or '--bundle-path'.";
@@ -157,6 +174,11 @@ const std::string HELP_MSG_NO_REMOVABLE_OPTION =
     "error: you must specify a bundle name with '-n' or '--bundle-name' \n"
     "and a module name with '-m' or '--module-name' \n";
 
+const std::string HELP_MSG_NO_MANIFEST_OPTION =
+    "error: you must specify a manifest file with '-f' or '--file'.";
+const std::string STRING_BATCH_MANIFEST_NG = "error: failed to read the manifest file.";
+const std::string STRING_BATCH_OPERATION_NG = "error: invalid operation in the manifest at line ";
+
 const std::string HELP_MSG_DUMP_FAILED = "error: failed to get information and the parameters may be wrong.";
 const std::string STRING_REQUIRE_CORRECT_VALUE = "error: option requires a correct value.\n";
 } // namespace
@@ -185,12 +207,14 @@ private:
     ErrCode RunAsGetCommand();
     ErrCode RunAsSetRmCommand();
     ErrCode RunAsGetRmCommand();
+    ErrCode RunAsBatchCommand();
 
     std::string DumpBundleList(int32_t userId) const;
     std::string DumpBundleInfo(const std::string &bundleName, int32_t userId) const;
     std::string DumpBundleInfos(int32_t userId) const;
     std::string DumpShortcutInfos(const std::string &bundleName, int32_t userId) const;
     std::string DumpDistributedBundleInfo(const std::string &deviceId, const std::string &bundleName);
+    bool DumpBundleInfosAsJsonLines(bool isNameOnly, const std::string &bundleName, int32_t userId);
 
     int32_t InstallOperation(const std::vector<std::string> &bundlePaths, InstallParam &installParam) const;
     int32_t UninstallOperation(const std::string &bundleName, const std::string &moduleName,
@@ -209,6 +233,33 @@ private:
         const std::string &bundleName, const std::string &moduleName, std::string &result) const;
     int32_t GetCurrentUserId(int32_t userId) const;
 
+    struct BatchOperation {
+        size_t lineNumber = 0;
+        std::string line;
+        std::string command;
+        std::vector<std::string> bundlePaths;
+        std::string bundleName;
+        std::string moduleName;
+        std::string abilityName;
+        int32_t userId = Constants::UNSPECIFIED_USERID;
+        bool isKeepData = false;
+        bool cleanCache = false;
+        bool cleanData = false;
+    };
+
+    struct BatchResult {
+        bool isSucceeded = false;
+        int32_t resultCode = OHOS::ERR_OK;
+        std::string message;
+        int64_t costTime = 0;
+    };
+
+    bool ParseBatchManifest(const std::string &manifestPath, std::vector<BatchOperation> &operations);
+    bool ParseBatchOperation(const std::string &line, BatchOperation &operation) const;
+    BatchResult ExecuteBatchOperation(const BatchOperation &operation) const;
+    std::string FormatBatchResult(const BatchOperation &operation, const BatchResult &batchResult,
+        bool isJsonLines) const;
+
     sptr<IBundleMgr> bundleMgrProxy_;
     sptr<IBundleInstaller> bundleInstallerProxy_;
 };
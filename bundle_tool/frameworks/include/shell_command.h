@@ -19,6 +19,7 @@
 #include <map>
 #include <string>
 #include <functional>
+#include <ostream>
 #include <vector>
 
 #include "utils/native/base/include/errors.h"
@@ -41,6 +42,9 @@ public:
     std::string GetCommandErrorMsg() const;
     std::string GetUnknownOptionMsg(std::string &unknownOption) const;
     std::string GetMessageFromCode(const int32_t code) const;
+    // Commands producing a long output write it to the stream as it is ready, instead of returning it from
+    // ExecCommand at the end.
+    void SetOutputStream(std::ostream *outputStream);
 
     virtual ErrCode CreateCommandMap() = 0;
     virtual ErrCode CreateMessageMap() = 0;
@@ -49,6 +53,8 @@ public:
 protected:
     static constexpr int MIN_ARGUMENT_NUMBER = 2;
 
+    void WriteOutput(const std::string &output);
+
     int argc_;
     char **argv_;
 
@@ -60,6 +66,7 @@ protected:
     std::map<int32_t, std::string> messageMap_;
 
     std::string resultReceiver_ = "";
+    std::ostream *outputStream_ = nullptr;
 };
 
 }  // namespace AppExecFwk
@@ -14,11 +14,16 @@
  */
 #include "bundle_command.h"
 
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <future>
 #include <getopt.h>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <unistd.h>
 #include <vector>
 
@@ -26,8 +31,11 @@
 #include "bundle_death_recipient.h"
 #include "bundle_mgr_client.h"
 #include "clean_cache_callback_host.h"
+#include "concurrent_util.h"
 #include "if_system_ability_manager.h"
 #include "iservice_registry.h"
+#include "json_serializer.h"
+#include "nlohmann/json.hpp"
 #include "os_account_info.h"
 #include "os_account_manager.h"
 #include "parameter.h"
@@ -43,6 +51,13 @@ const int32_t INDEX_OFFSET = 2;
 const int32_t MAX_WAITING_TIME = 3000;
 const int32_t DEVICE_UDID_LENGTH = 65;
 const int32_t MAX_ARGUEMENTS_NUMBER = 3;
+const int32_t DEFAULT_BATCH_JOBS = 4;
+const int32_t MAX_BATCH_JOBS = 64;
+const std::string BATCH_BLANK_CHARS = " \t\r";
+const std::set<std::string> BATCH_COMMANDS = {"install", "uninstall", "enable", "disable", "clean"};
+// the same infos as the text dump of a bundle
+const int32_t DUMP_JSON_LINES_FLAGS = BundleFlag::GET_BUNDLE_WITH_ABILITIES |
+    BundleFlag::GET_BUNDLE_WITH_REQUESTED_PERMISSION | BundleFlag::GET_BUNDLE_WITH_EXTENSION_INFO;
 
 const std::string SHORT_OPTIONS = "hp:rn:m:a:cdu:";
 const struct option LONG_OPTIONS[] = {
@@ -60,7 +75,7 @@ const struct option LONG_OPTIONS[] = {
     {nullptr, 0, nullptr, 0},
 };
 
-const std::string SHORT_OPTIONS_DUMP = "hn:aisu:d:";
+const std::string SHORT_OPTIONS_DUMP = "hn:aisu:d:l";
 const struct option LONG_OPTIONS_DUMP[] = {
     {"help", no_argument, nullptr, 'h'},
     {"bundle-name", required_argument, nullptr, 'n'},
@@ -69,6 +84,16 @@ const struct option LONG_OPTIONS_DUMP[] = {
     {"shortcut-info", no_argument, nullptr, 's'},
     {"user-id", required_argument, nullptr, 'u'},
     {"device-id", required_argument, nullptr, 'd'},
+    {"json-lines", no_argument, nullptr, 'l'},
+    {nullptr, 0, nullptr, 0},
+};
+
+const std::string SHORT_OPTIONS_BATCH = "hf:j:l";
+const struct option LONG_OPTIONS_BATCH[] = {
+    {"help", no_argument, nullptr, 'h'},
+    {"file", required_argument, nullptr, 'f'},
+    {"jobs", required_argument, nullptr, 'j'},
+    {"json-lines", no_argument, nullptr, 'l'},
     {nullptr, 0, nullptr, 0},
 };
 
@@ -78,6 +103,11 @@ const struct option LONG_OPTIONS_GET[] = {
     {"udid", no_argument, nullptr, 'u'},
     {nullptr, 0, nullptr, 0},
 };
+
+int64_t GetElapsedTime(const std::chrono::steady_clock::time_point &beginTime)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - beginTime).count();
+}
 }  // namespace
 
 class CleanCacheCallbackImpl : public CleanCacheCallbackHost {
@@ -131,6 +161,7 @@ ErrCode BundleManagerShellCommand::CreateCommandMap()
         {"get", std::bind(&BundleManagerShellCommand::RunAsGetCommand, this)},
         {"getrm", std::bind(&BundleManagerShellCommand::RunAsGetRmCommand, this)},
         {"setrm", std::bind(&BundleManagerShellCommand::RunAsSetRmCommand, this)},
+        {"batch", std::bind(&BundleManagerShellCommand::RunAsBatchCommand, this)},
     };
 
     return OHOS::ERR_OK;
@@ -874,6 +905,7 @@ ErrCode BundleManagerShellCommand::RunAsDumpCommand()
     bool bundleDumpDistributedBundleInfo = false;
     std::string deviceId = "";
     int32_t userId = Constants::ALL_USERID;
+    bool isJsonLines = false;
     while (true) {
         counter++;
         option = getopt_long(argc_, argv_, SHORT_OPTIONS_DUMP.c_str(), LONG_OPTIONS_DUMP, nullptr);
@@ -989,6 +1021,13 @@ ErrCode BundleManagerShellCommand::RunAsDumpCommand()
                 bundleDumpDistributedBundleInfo = true;
                 break;
             }
+            case 'l': {
+                // 'bm dump -a -l'
+                // 'bm dump --bundle-name <bundleName> --json-lines'
+                APP_LOGD("'bm dump %{public}s'", argv_[optind - 1]);
+                isJsonLines = true;
+                break;
+            }
             default: {
                 result = OHOS::ERR_INVALID_VALUE;
                 break;
@@ -1013,6 +1052,15 @@ ErrCode BundleManagerShellCommand::RunAsDumpCommand()
         resultReceiver_.append(HELP_MSG_DUMP);
     } else {
         APP_LOGD("dumpResults: %{public}s", dumpResults.c_str());
+        if (isJsonLines && !bundleDumpShortcut && !bundleDumpDistributedBundleInfo &&
+            (bundleDumpAll || bundleDumpInfos || bundleDumpInfo)) {
+            // a bundle is written as soon as it is converted, instead of building the whole dump first
+            std::string jsonBundleName = (bundleDumpAll || bundleDumpInfos) ? "" : bundleName;
+            if (!DumpBundleInfosAsJsonLines(bundleDumpAll, jsonBundleName, userId)) {
+                resultReceiver_.append(HELP_MSG_DUMP_FAILED + "\n");
+            }
+            return result;
+        }
         if (bundleDumpShortcut) {
             dumpResults = DumpShortcutInfos(bundleName, userId);
         } else if (bundleDumpDistributedBundleInfo) {
@@ -1757,6 +1805,323 @@ ErrCode BundleManagerShellCommand::RunAsGetRmCommand()
     }
 }
 
+ErrCode BundleManagerShellCommand::RunAsBatchCommand()
+{
+    int result = OHOS::ERR_OK;
+    int option = -1;
+    int counter = 0;
+    std::string manifestPath = "";
+    int32_t jobs = DEFAULT_BATCH_JOBS;
+    bool isJsonLines = false;
+    while (true) {
+        counter++;
+        option = getopt_long(argc_, argv_, SHORT_OPTIONS_BATCH.c_str(), LONG_OPTIONS_BATCH, nullptr);
+        APP_LOGD("option: %{public}d, optopt: %{public}d, optind: %{public}d", option, optopt, optind);
+        if (optind < 0 || optind > argc_) {
+            return OHOS::ERR_INVALID_VALUE;
+        }
+        if (option == -1) {
+            if (counter == 1) {
+                // When scanning the first argument
+                if (strcmp(argv_[optind], cmd_.c_str()) == 0) {
+                    // 'bm batch' with no option: bm batch
+                    // 'bm batch' with a wrong argument: bm batch xxx
+                    APP_LOGD("'bm batch' with no option.");
+                    resultReceiver_.append(HELP_MSG_NO_OPTION + "\n");
+                    result = OHOS::ERR_INVALID_VALUE;
+                }
+            }
+            break;
+        }
+        if (option == '?') {
+            switch (optopt) {
+                case 'f':
+                case 'j': {
+                    // 'bm batch -f' with no argument: bm batch -f
+                    // 'bm batch --jobs' with no argument: bm batch --jobs
+                    APP_LOGD("'bm batch' with no argument.");
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    result = OHOS::ERR_INVALID_VALUE;
+                    break;
+                }
+                default: {
+                    // 'bm batch' with an unknown option: bm batch -x
+                    // 'bm batch' with an unknown option: bm batch -xxx
+                    std::string unknownOption = "";
+                    std::string unknownOptionMsg = GetUnknownOptionMsg(unknownOption);
+                    APP_LOGD("'bm batch' with an unknown option.");
+                    resultReceiver_.append(unknownOptionMsg);
+                    result = OHOS::ERR_INVALID_VALUE;
+                    break;
+                }
+            }
+            break;
+        }
+        switch (option) {
+            case 'h': {
+                // 'bm batch -h'
+                // 'bm batch --help'
+                APP_LOGD("'bm batch %{public}s'", argv_[optind - 1]);
+                result = OHOS::ERR_INVALID_VALUE;
+                break;
+            }
+            case 'f': {
+                // 'bm batch -f <manifest-path>'
+                // 'bm batch --file <manifest-path>'
+                manifestPath = optarg;
+                break;
+            }
+            case 'j': {
+                // 'bm batch -f <manifest-path> -j <number>'
+                // 'bm batch --file <manifest-path> --jobs <number>'
+                if (!OHOS::StrToInt(optarg, jobs) || jobs <= 0 || jobs > MAX_BATCH_JOBS) {
+                    APP_LOGE("bm batch with error jobs %{private}s", optarg);
+                    resultReceiver_.append(STRING_REQUIRE_CORRECT_VALUE);
+                    return OHOS::ERR_INVALID_VALUE;
+                }
+                break;
+            }
+            case 'l': {
+                // 'bm batch -f <manifest-path> -l'
+                // 'bm batch --file <manifest-path> --json-lines'
+                isJsonLines = true;
+                break;
+            }
+            default: {
+                result = OHOS::ERR_INVALID_VALUE;
+                break;
+            }
+        }
+    }
+
+    if (result == OHOS::ERR_OK) {
+        if (resultReceiver_ == "" && manifestPath.empty()) {
+            // 'bm batch ...' with no manifest option
+            APP_LOGD("'bm batch' with no manifest option.");
+            resultReceiver_.append(HELP_MSG_NO_MANIFEST_OPTION + "\n");
+            result = OHOS::ERR_INVALID_VALUE;
+        }
+    }
+
+    std::vector<BatchOperation> operations;
+    if (result == OHOS::ERR_OK && !ParseBatchManifest(manifestPath, operations)) {
+        result = OHOS::ERR_INVALID_VALUE;
+    }
+    if (result != OHOS::ERR_OK) {
+        resultReceiver_.append(HELP_MSG_BATCH);
+        return result;
+    }
+
+    // the operations are parsed before any of them runs, so a typo in the manifest changes nothing, and every
+    // result is written as soon as its operation finishes
+    auto beginTime = std::chrono::steady_clock::now();
+    std::mutex outputMutex;
+    std::atomic<size_t> failedCount {0};
+    RunConcurrently(operations.size(), static_cast<size_t>(jobs),
+        [this, &operations, &outputMutex, &failedCount, isJsonLines](size_t index) {
+            BatchResult batchResult = ExecuteBatchOperation(operations[index]);
+            if (!batchResult.isSucceeded) {
+                failedCount++;
+            }
+            std::string output = FormatBatchResult(operations[index], batchResult, isJsonLines);
+            std::lock_guard<std::mutex> lock(outputMutex);
+            WriteOutput(output);
+        });
+
+    int64_t costTime = GetElapsedTime(beginTime);
+    size_t succeededCount = operations.size() - failedCount;
+    if (isJsonLines) {
+        nlohmann::json summary = {
+            {"total", operations.size()},
+            {"succeeded", succeededCount},
+            {"failed", failedCount.load()},
+            {"costTime", costTime},
+        };
+        WriteOutput(summary.dump() + "\n");
+    } else {
+        WriteOutput("batch finished: " + std::to_string(operations.size()) + " operations, " +
+            std::to_string(succeededCount) + " succeeded, " + std::to_string(failedCount.load()) + " failed, cost " +
+            std::to_string(costTime) + " ms\n");
+    }
+    return result;
+}
+
+bool BundleManagerShellCommand::ParseBatchManifest(
+    const std::string &manifestPath, std::vector<BatchOperation> &operations)
+{
+    std::ifstream manifest(manifestPath);
+    if (!manifest.is_open()) {
+        APP_LOGE("failed to open the manifest %{private}s", manifestPath.c_str());
+        resultReceiver_.append(STRING_BATCH_MANIFEST_NG + "\n");
+        return false;
+    }
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(manifest, line)) {
+        lineNumber++;
+        size_t begin = line.find_first_not_of(BATCH_BLANK_CHARS);
+        if (begin == std::string::npos || line[begin] == '#') {
+            continue;
+        }
+        size_t end = line.find_last_not_of(BATCH_BLANK_CHARS);
+        BatchOperation operation;
+        operation.lineNumber = lineNumber;
+        operation.line = line.substr(begin, end - begin + 1);
+        if (!ParseBatchOperation(operation.line, operation)) {
+            APP_LOGE("invalid operation at line %{public}zu of the manifest", lineNumber);
+            resultReceiver_.append(STRING_BATCH_OPERATION_NG + std::to_string(lineNumber) + ": " + operation.line +
+                "\n");
+            return false;
+        }
+        operations.emplace_back(std::move(operation));
+    }
+    APP_LOGD("%{public}zu operations in the manifest", operations.size());
+    return true;
+}
+
+bool BundleManagerShellCommand::ParseBatchOperation(const std::string &line, BatchOperation &operation) const
+{
+    std::istringstream lineStream(line);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (lineStream >> token) {
+        tokens.emplace_back(token);
+    }
+    if (tokens.empty() || BATCH_COMMANDS.find(tokens[0]) == BATCH_COMMANDS.end()) {
+        return false;
+    }
+    operation.command = tokens[0];
+    // the same default users as the single commands
+    if (operation.command == "install" || operation.command == "uninstall") {
+        operation.userId = Constants::ALL_USERID;
+    }
+    for (size_t i = 1; i < tokens.size(); ++i) {
+        const std::string &option = tokens[i];
+        if (option == "-p" || option == "--bundle-path") {
+            // like 'bm install', the paths of the haps of one bundle follow one '-p'
+            while (i + 1 < tokens.size() && tokens[i + 1][0] != '-') {
+                operation.bundlePaths.emplace_back(tokens[++i]);
+            }
+            continue;
+        }
+        if (option == "-r" || option == "--replace") {
+            continue;
+        }
+        if (option == "-k" || option == "--keep-data") {
+            operation.isKeepData = true;
+            continue;
+        }
+        if (option == "-c" || option == "--cache") {
+            operation.cleanCache = true;
+            continue;
+        }
+        if (option == "-d" || option == "--data") {
+            operation.cleanData = true;
+            continue;
+        }
+        // the options below require a value
+        if (i + 1 >= tokens.size()) {
+            return false;
+        }
+        const std::string &value = tokens[++i];
+        if (option == "-n" || option == "--bundle-name") {
+            operation.bundleName = value;
+        } else if (option == "-m" || option == "--module-name") {
+            operation.moduleName = value;
+        } else if (option == "-a" || option == "--ability-name") {
+            operation.abilityName = value;
+        } else if (option == "-u" || option == "--user-id") {
+            if (!OHOS::StrToInt(value, operation.userId) || operation.userId < 0) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    if (operation.command == "install") {
+        return !operation.bundlePaths.empty();
+    }
+    if (operation.bundleName.empty()) {
+        return false;
+    }
+    if (operation.command == "clean") {
+        // like 'bm clean', either the cache or the data is cleaned
+        return operation.cleanCache != operation.cleanData;
+    }
+    return true;
+}
+
+BundleManagerShellCommand::BatchResult BundleManagerShellCommand::ExecuteBatchOperation(
+    const BatchOperation &operation) const
+{
+    BatchResult batchResult;
+    auto beginTime = std::chrono::steady_clock::now();
+    if (operation.command == "install") {
+        InstallParam installParam;
+        installParam.installFlag = InstallFlag::REPLACE_EXISTING;
+        installParam.userId = operation.userId;
+        batchResult.resultCode = InstallOperation(operation.bundlePaths, installParam);
+        batchResult.isSucceeded = (batchResult.resultCode == OHOS::ERR_OK);
+        batchResult.message = batchResult.isSucceeded ? STRING_INSTALL_BUNDLE_OK : STRING_INSTALL_BUNDLE_NG;
+    } else if (operation.command == "uninstall") {
+        InstallParam installParam;
+        installParam.userId = operation.userId;
+        installParam.isKeepData = operation.isKeepData;
+        batchResult.resultCode = UninstallOperation(operation.bundleName, operation.moduleName, installParam);
+        batchResult.isSucceeded = (batchResult.resultCode == OHOS::ERR_OK);
+        batchResult.message = batchResult.isSucceeded ? STRING_UNINSTALL_BUNDLE_OK : STRING_UNINSTALL_BUNDLE_NG;
+    } else if (operation.command == "enable" || operation.command == "disable") {
+        bool isEnable = (operation.command == "enable");
+        AbilityInfo abilityInfo;
+        abilityInfo.name = operation.abilityName;
+        abilityInfo.bundleName = operation.bundleName;
+        batchResult.isSucceeded = SetApplicationEnabledOperation(abilityInfo, isEnable, operation.userId);
+        if (isEnable) {
+            batchResult.message = batchResult.isSucceeded ? STRING_ENABLE_BUNDLE_OK : STRING_ENABLE_BUNDLE_NG;
+        } else {
+            batchResult.message = batchResult.isSucceeded ? STRING_DISABLE_BUNDLE_OK : STRING_DISABLE_BUNDLE_NG;
+        }
+    } else if (operation.cleanCache) {
+        batchResult.isSucceeded = CleanBundleCacheFilesOperation(operation.bundleName, operation.userId);
+        batchResult.message = batchResult.isSucceeded ? STRING_CLEAN_CACHE_BUNDLE_OK : STRING_CLEAN_CACHE_BUNDLE_NG;
+    } else {
+        batchResult.isSucceeded = CleanBundleDataFilesOperation(operation.bundleName, operation.userId);
+        batchResult.message = batchResult.isSucceeded ? STRING_CLEAN_DATA_BUNDLE_OK : STRING_CLEAN_DATA_BUNDLE_NG;
+    }
+    if (!batchResult.isSucceeded && batchResult.resultCode == OHOS::ERR_OK) {
+        batchResult.resultCode = OHOS::ERR_INVALID_VALUE;
+    }
+    if (!batchResult.isSucceeded && (operation.command == "install" || operation.command == "uninstall")) {
+        std::string codeMessage = GetMessageFromCode(batchResult.resultCode);
+        if (!codeMessage.empty() && codeMessage.back() == '\n') {
+            codeMessage.pop_back();
+        }
+        if (!codeMessage.empty()) {
+            batchResult.message.append(" ").append(codeMessage);
+        }
+    }
+    batchResult.costTime = GetElapsedTime(beginTime);
+    return batchResult;
+}
+
+std::string BundleManagerShellCommand::FormatBatchResult(const BatchOperation &operation,
+    const BatchResult &batchResult, bool isJsonLines) const
+{
+    if (isJsonLines) {
+        nlohmann::json jsonObject = {
+            {"line", operation.lineNumber},
+            {"operation", operation.line},
+            {"succeeded", batchResult.isSucceeded},
+            {"resultCode", batchResult.resultCode},
+            {"message", batchResult.message},
+            {"costTime", batchResult.costTime},
+        };
+        return jsonObject.dump() + "\n";
+    }
+    return "line " + std::to_string(operation.lineNumber) + ": " + operation.line + ": " + batchResult.message +
+        " cost " + std::to_string(batchResult.costTime) + " ms\n";
+}
+
 bool BundleManagerShellCommand::SetIsRemovableOperation(
     const std::string &bundleName, const std::string &moduleName, bool enable) const
 {
@@ -1856,6 +2221,42 @@ std::string BundleManagerShellCommand::DumpDistributedBundleInfo(
     return dumpResults;
 }
 
+bool BundleManagerShellCommand::DumpBundleInfosAsJsonLines(
+    bool isNameOnly, const std::string &bundleName, int32_t userId)
+{
+    std::vector<BundleInfo> bundleInfos;
+    if (!bundleName.empty()) {
+        // the bundle info of one user is dumped, the current one if no user is specified
+        int32_t requestUserId =
+            (userId == Constants::ALL_USERID) ? GetCurrentUserId(Constants::UNSPECIFIED_USERID) : userId;
+        BundleInfo bundleInfo;
+        if (!bundleMgrProxy_->GetBundleInfo(bundleName, DUMP_JSON_LINES_FLAGS, bundleInfo, requestUserId)) {
+            APP_LOGE("failed to get bundle info of %{public}s.", bundleName.c_str());
+            return false;
+        }
+        bundleInfos.emplace_back(std::move(bundleInfo));
+    } else {
+        int32_t flags = isNameOnly ? static_cast<int32_t>(BundleFlag::GET_BUNDLE_DEFAULT) : DUMP_JSON_LINES_FLAGS;
+        if (!bundleMgrProxy_->GetBundleInfos(flags, bundleInfos, userId)) {
+            APP_LOGE("failed to get bundle infos.");
+            return false;
+        }
+    }
+    for (auto &bundleInfo : bundleInfos) {
+        nlohmann::json jsonObject;
+        if (isNameOnly) {
+            jsonObject["bundleName"] = bundleInfo.name;
+        } else {
+            jsonObject = bundleInfo;
+            jsonObject["hapModuleInfos"] = bundleInfo.hapModuleInfos;
+        }
+        WriteOutput(jsonObject.dump() + "\n");
+        // the info written is not needed any more
+        bundleInfo = BundleInfo();
+    }
+    return true;
+}
+
 int32_t BundleManagerShellCommand::InstallOperation(const std::vector<std::string> &bundlePaths,
     InstallParam &installParam) const
 {
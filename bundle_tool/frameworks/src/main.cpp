@@ -18,6 +18,7 @@
 int main(int argc, char *argv[])
 {
     OHOS::AppExecFwk::BundleManagerShellCommand cmd(argc, argv);
+    cmd.SetOutputStream(&std::cout);
     std::cout << cmd.ExecCommand();
     return 0;
 }
@@ -123,5 +123,19 @@ std::string ShellCommand::GetMessageFromCode(const int32_t code) const
     return result;
 }
 
+void ShellCommand::SetOutputStream(std::ostream *outputStream)
+{
+    outputStream_ = outputStream;
+}
+
+void ShellCommand::WriteOutput(const std::string &output)
+{
+    if (outputStream_ == nullptr) {
+        resultReceiver_.append(output);
+        return;
+    }
+    *outputStream_ << output << std::flush;
+}
+
 }  // namespace AppExecFwk
 }  // namespace OHOS
\ No newline at end of file
@@ -18,6 +18,25 @@
 using namespace OHOS::AAFwk;
 namespace OHOS {
 namespace AppExecFwk {
+bool MockBundleMgrHost::GetBundleInfo(
+    const std::string &bundleName, int32_t flags, BundleInfo &bundleInfo, int32_t userId)
+{
+    APP_LOGD("enter");
+    APP_LOGD("bundleName: %{public}s", bundleName.c_str());
+    bundleInfo.name = bundleName;
+    return true;
+}
+
+bool MockBundleMgrHost::GetBundleInfos(int32_t flags, std::vector<BundleInfo> &bundleInfos, int32_t userId)
+{
+    APP_LOGD("enter");
+    APP_LOGD("flags: %{public}d", flags);
+    BundleInfo bundleInfo;
+    bundleInfo.name = STRING_MOCK_BUNDLE_NAME;
+    bundleInfos.emplace_back(bundleInfo);
+    return true;
+}
+
 bool MockBundleMgrHost::DumpInfos(
     const DumpFlag flag, const std::string &bundleName, int32_t userId, std::string &result)
 {
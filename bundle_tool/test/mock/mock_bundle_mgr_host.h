@@ -23,8 +23,16 @@
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+const std::string STRING_MOCK_BUNDLE_NAME = "mock_bundle_name";
+}  // namespace
+
 class MockBundleMgrHost : public BundleMgrHost {
 public:
+    bool GetBundleInfo(const std::string &bundleName, int32_t flags, BundleInfo &bundleInfo,
+        int32_t userId = Constants::UNSPECIFIED_USERID) override;
+    bool GetBundleInfos(int32_t flags, std::vector<BundleInfo> &bundleInfos,
+        int32_t userId = Constants::UNSPECIFIED_USERID) override;
     bool CleanBundleCacheFiles(const std::string &bundleName, const sptr<ICleanCacheCallback> &cleanCacheCallback,
         int32_t userId = Constants::UNSPECIFIED_USERID) override;
     bool CleanBundleDataFiles(const std::string &bundleName, const int userId = 0);
@@ -404,4 +404,53 @@ HWTEST_F(BmCommandDumpTest, Bm_Command_Dump_1400, Function | MediumTest | Level1
     SetMockObjects(cmd);
     EXPECT_EQ(cmd.ExecCommand(), STRING_BUNDLE_NAME + "\n");
 }
+
+/**
+ * @tc.number: Bm_Command_Dump_1500
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump -a -l" command.
+ */
+HWTEST_F(BmCommandDumpTest, Bm_Command_Dump_1500, Function | MediumTest | Level1)
+{
+    char *argv[] = {
+        (char *)TOOL_NAME.c_str(),
+        (char *)cmd_.c_str(),
+        (char *)"-a",
+        (char *)"-l",
+        (char *)"",
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.ExecCommand(), "{\"bundleName\":\"" + STRING_MOCK_BUNDLE_NAME + "\"}\n");
+}
+
+/**
+ * @tc.number: Bm_Command_Dump_1600
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm dump -n <bundle-name> -u <user-id> -l" command.
+ */
+HWTEST_F(BmCommandDumpTest, Bm_Command_Dump_1600, Function | MediumTest | Level1)
+{
+    char *argv[] = {
+        (char *)TOOL_NAME.c_str(),
+        (char *)cmd_.c_str(),
+        (char *)"-n",
+        (char *)STRING_BUNDLE_NAME.c_str(),
+        (char *)"-u",
+        (char *)"100",
+        (char *)"-l",
+        (char *)"",
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    std::string result = cmd.ExecCommand();
+    EXPECT_NE(result.find("\"name\":\"" + STRING_BUNDLE_NAME + "\""), std::string::npos);
+    EXPECT_NE(result.find("\"hapModuleInfos\""), std::string::npos);
+    // the whole bundle is written as one line
+    EXPECT_EQ(result.find('\n'), result.size() - 1);
+}
 } // namespace OHOS
\ No newline at end of file
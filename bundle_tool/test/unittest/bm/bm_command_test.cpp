@@ -13,6 +13,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <gtest/gtest.h>
 
 #define private public
@@ -29,6 +32,16 @@ using namespace OHOS::AAFwk;
 using namespace OHOS::AppExecFwk;
 
 namespace OHOS {
+namespace {
+const std::string STRING_BATCH_MANIFEST_PATH = "/data/local/tmp/bm_batch_manifest.txt";
+
+void WriteBatchManifest(const std::string &content)
+{
+    std::ofstream manifest(STRING_BATCH_MANIFEST_PATH, std::ios::trunc);
+    manifest << content;
+}
+}  // namespace
+
 class BmCommandTest : public ::testing::Test {
 public:
     static void SetUpTestCase();
@@ -887,4 +900,156 @@ HWTEST_F(BmCommandTest, Bm_Command_Get_0009, Function | MediumTest | Level1)
 
     EXPECT_EQ(cmd.ExecCommand(), HELP_MSG_GET);
 }
+
+/**
+ * @tc.number: Bm_Command_Batch_0001
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm batch" command.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Batch_0001, Function | MediumTest | Level1)
+{
+    char *argv[] = {
+        (char *)TOOL_NAME.c_str(),
+        (char *)"batch",
+        (char *)"",
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.ExecCommand(), HELP_MSG_NO_OPTION + "\n" + HELP_MSG_BATCH);
+}
+
+/**
+ * @tc.number: Bm_Command_Batch_0002
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm batch -f <manifest-path>" command with a manifest which does not exist.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Batch_0002, Function | MediumTest | Level1)
+{
+    std::remove(STRING_BATCH_MANIFEST_PATH.c_str());
+    char *argv[] = {
+        (char *)TOOL_NAME.c_str(),
+        (char *)"batch",
+        (char *)"-f",
+        (char *)STRING_BATCH_MANIFEST_PATH.c_str(),
+        (char *)"",
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.ExecCommand(), STRING_BATCH_MANIFEST_NG + "\n" + HELP_MSG_BATCH);
+}
+
+/**
+ * @tc.number: Bm_Command_Batch_0003
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm batch -f <manifest-path>" command with an invalid operation.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Batch_0003, Function | MediumTest | Level1)
+{
+    WriteBatchManifest("# clean needs -c or -d\n"
+        "clean -n " + STRING_BUNDLE_NAME + "\n");
+    char *argv[] = {
+        (char *)TOOL_NAME.c_str(),
+        (char *)"batch",
+        (char *)"-f",
+        (char *)STRING_BATCH_MANIFEST_PATH.c_str(),
+        (char *)"",
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.ExecCommand(),
+        STRING_BATCH_OPERATION_NG + "2: clean -n " + STRING_BUNDLE_NAME + "\n" + HELP_MSG_BATCH);
+    std::remove(STRING_BATCH_MANIFEST_PATH.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Batch_0004
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm batch -f <manifest-path> -j <number>" command.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Batch_0004, Function | MediumTest | Level1)
+{
+    WriteBatchManifest("install -p " + STRING_BUNDLE_PATH + "\n"
+        "\n"
+        "uninstall -n " + STRING_BUNDLE_NAME + "\n"
+        "enable -n " + STRING_BUNDLE_NAME + " -u 100\n"
+        "clean -n " + STRING_BUNDLE_NAME + " -d -u 100\n");
+    char *argv[] = {
+        (char *)TOOL_NAME.c_str(),
+        (char *)"batch",
+        (char *)"-f",
+        (char *)STRING_BATCH_MANIFEST_PATH.c_str(),
+        (char *)"-j",
+        (char *)"2",
+        (char *)"",
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    std::string result = cmd.ExecCommand();
+    EXPECT_NE(result.find("line 1: install -p " + STRING_BUNDLE_PATH + ": " + STRING_INSTALL_BUNDLE_OK),
+        std::string::npos);
+    EXPECT_NE(result.find("line 3: uninstall -n " + STRING_BUNDLE_NAME + ": " + STRING_UNINSTALL_BUNDLE_OK),
+        std::string::npos);
+    EXPECT_NE(result.find("batch finished: 4 operations, 4 succeeded, 0 failed"), std::string::npos);
+    std::remove(STRING_BATCH_MANIFEST_PATH.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Batch_0005
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm batch -f <manifest-path> -l" command.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Batch_0005, Function | MediumTest | Level1)
+{
+    WriteBatchManifest("install -p " + STRING_BUNDLE_PATH + "\n"
+        "uninstall -n " + STRING_BUNDLE_NAME + "\n");
+    char *argv[] = {
+        (char *)TOOL_NAME.c_str(),
+        (char *)"batch",
+        (char *)"-f",
+        (char *)STRING_BATCH_MANIFEST_PATH.c_str(),
+        (char *)"-l",
+        (char *)"",
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    std::string result = cmd.ExecCommand();
+    // a line per operation and a line of the summary
+    EXPECT_EQ(std::count(result.begin(), result.end(), '\n'), 3);
+    EXPECT_NE(result.find("\"succeeded\":true"), std::string::npos);
+    EXPECT_NE(result.find("\"failed\":0"), std::string::npos);
+    std::remove(STRING_BATCH_MANIFEST_PATH.c_str());
+}
+
+/**
+ * @tc.number: Bm_Command_Batch_0006
+ * @tc.name: ExecCommand
+ * @tc.desc: Verify the "bm batch -f <manifest-path> -j <number>" command with a wrong number.
+ */
+HWTEST_F(BmCommandTest, Bm_Command_Batch_0006, Function | MediumTest | Level1)
+{
+    char *argv[] = {
+        (char *)TOOL_NAME.c_str(),
+        (char *)"batch",
+        (char *)"-f",
+        (char *)STRING_BATCH_MANIFEST_PATH.c_str(),
+        (char *)"-j",
+        (char *)"0",
+        (char *)"",
+    };
+    int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+    BundleManagerShellCommand cmd(argc, argv);
+    // set the mock objects
+    SetMockObjects(cmd);
+    EXPECT_EQ(cmd.ExecCommand(), STRING_REQUIRE_CORRECT_VALUE);
+}
 } // namespace OHOS
\ No newline at end of file
@@ -45,6 +45,9 @@ const int64_t BUNDLE_INSTALL_INIT_END_TIME = 0;
 const int64_t BUNDLE_INSTALL_SET_END_TIME = 300;
 const int64_t BUNDLE_INSTALL_SET_END_TIME_SECOND = 500;
 const int64_t BUNDLE_INSTALL_INIT_TOTAL_TIME = 0;
+const int64_t BUNDLE_INSTALL_STAGE_INIT_TIME = 0;
+const int64_t BUNDLE_INSTALL_STAGE_SET_TIME = 20;
+const int64_t BUNDLE_INSTALL_STAGE_SET_TIME_SECOND = 30;
 
 const int64_t BUNDLE_UNINSTALL_INIT_START_TIME = 0;
 const int64_t BUNDLE_UNINSTALL_SET_START_TIME = 30;
@@ -430,6 +433,38 @@ HWTEST_F(CommonPerfProfileTest, SetBundleInstallTime_005, TestSize.Level0)
     EXPECT_EQ(realTotalInstallTime, expectTotalInstallTime) << "bundle total install time " << realTotalInstallTime;
 }
 
+/*
+ * Feature: CommonPerfProfileTest
+ * Function: AddBundleInstallStageTime
+ * SubFunction: NA
+ * FunctionPoints: AddBundleInstallStageTime
+ * EnvConditions: NA
+ * CaseDescription: verify the time of install stages are accumulated and the invalid time is ignored
+ */
+HWTEST_F(CommonPerfProfileTest, AddBundleInstallStageTime_001, TestSize.Level0)
+{
+    PerfProfile::GetInstance().AddBundleSysCapCheckTime(BUNDLE_INSTALL_STAGE_SET_TIME);
+    PerfProfile::GetInstance().AddBundleSignatureVerifyTime(BUNDLE_INSTALL_STAGE_SET_TIME);
+    PerfProfile::GetInstance().AddBundleHapParseTime(BUNDLE_INSTALL_STAGE_SET_TIME);
+    PerfProfile::GetInstance().AddBundleModuleExtractTime(BUNDLE_INSTALL_STAGE_SET_TIME);
+    PerfProfile::GetInstance().AddBundleHapParseTime(BUNDLE_INSTALL_STAGE_SET_TIME_SECOND);
+    PerfProfile::GetInstance().AddBundleModuleExtractTime(INVALID_TIME);
+    PerfProfile::GetInstance().Dump();
+
+    EXPECT_EQ(PerfProfile::GetInstance().GetBundleSysCapCheckTime(), BUNDLE_INSTALL_STAGE_SET_TIME);
+    EXPECT_EQ(PerfProfile::GetInstance().GetBundleSignatureVerifyTime(), BUNDLE_INSTALL_STAGE_SET_TIME);
+    EXPECT_EQ(PerfProfile::GetInstance().GetBundleHapParseTime(),
+        BUNDLE_INSTALL_STAGE_SET_TIME + BUNDLE_INSTALL_STAGE_SET_TIME_SECOND);
+    EXPECT_EQ(PerfProfile::GetInstance().GetBundleModuleExtractTime(), BUNDLE_INSTALL_STAGE_SET_TIME);
+
+    // after reset the perf profile, the time of install stages should be zero
+    PerfProfile::GetInstance().Reset();
+    EXPECT_EQ(PerfProfile::GetInstance().GetBundleSysCapCheckTime(), BUNDLE_INSTALL_STAGE_INIT_TIME);
+    EXPECT_EQ(PerfProfile::GetInstance().GetBundleSignatureVerifyTime(), BUNDLE_INSTALL_STAGE_INIT_TIME);
+    EXPECT_EQ(PerfProfile::GetInstance().GetBundleHapParseTime(), BUNDLE_INSTALL_STAGE_INIT_TIME);
+    EXPECT_EQ(PerfProfile::GetInstance().GetBundleModuleExtractTime(), BUNDLE_INSTALL_STAGE_INIT_TIME);
+}
+
 /*
  * Feature: CommonPerfProfileTest
  * Function: SetBundleUninstallTime
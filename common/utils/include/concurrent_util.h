@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_STANDARD_COMMON_UTILS_INCLUDE_CONCURRENT_UTIL_H
+#define FOUNDATION_APPEXECFWK_STANDARD_COMMON_UTILS_INCLUDE_CONCURRENT_UTIL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * @brief Get the count of threads for tasks which mostly use the cpu.
+ * @param maxThreadNum Indicates the max count of threads.
+ * @return Returns maxThreadNum, or the count of cpu cores if it is less.
+ */
+inline size_t GetCpuBoundThreadNum(size_t maxThreadNum)
+{
+    return std::min(static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)), maxThreadNum);
+}
+
+/**
+ * @brief Run task(index) for every index in [0, count) by at most maxThreadNum threads, the calling thread included.
+ *        A thread takes the next index as soon as it finished one, so a slow task does not hold back the others.
+ * @param count Indicates the count of the tasks.
+ * @param maxThreadNum Indicates the max count of threads.
+ * @param task Indicates the task, it may run on another thread.
+ * @return Returns the count of threads used.
+ */
+inline size_t RunConcurrently(size_t count, size_t maxThreadNum, const std::function<void(size_t)> &task)
+{
+    std::atomic<size_t> nextIndex {0};
+    auto worker = [count, &task, &nextIndex] {
+        for (size_t index = nextIndex++; index < count; index = nextIndex++) {
+            task(index);
+        }
+    };
+    size_t threadNum = std::min(std::max(maxThreadNum, static_cast<size_t>(1)), count);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadNum; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return threadNum;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_STANDARD_COMMON_UTILS_INCLUDE_CONCURRENT_UTIL_H
@@ -16,7 +16,12 @@
 #ifndef FOUNDATION_APPEXECFWK_SERVICES_D_BUNDLEMGR_INCLUDE_DISTRIBUTED_BMS_H
 #define FOUNDATION_APPEXECFWK_SERVICES_D_BUNDLEMGR_INCLUDE_DISTRIBUTED_BMS_H
 
+#include <list>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "bundle_info.h"
 #include "bundle_mgr_interface.h"
@@ -24,6 +29,7 @@
 #include "if_system_ability_manager.h"
 #include "iremote_object.h"
 #include "image_buffer.h"
+#include "remote_ability_info_cache.h"
 #include "resource_manager.h"
 #include "system_ability.h"
 
@@ -101,11 +107,12 @@ public:
         const std::vector<ElementName> &elementNames, std::vector<RemoteAbilityInfo> &remoteAbilityInfos) override;
 
     /**
-     * @brief get ability infos
+     * @brief get ability infos, the elements of different bundles are queried concurrently.
      * @param elementNames Indicates the elementNames.
      * @param localeInfo Indicates the localeInfo.
-     * @param remoteAbilityInfos Indicates the remote ability infos.
-     * @return Returns true when get remote ability info success; returns false otherwise.
+     * @param remoteAbilityInfos Indicates the remote ability infos in the order of elementNames, an element
+     *                           failed to query has an empty label and icon.
+     * @return Returns NO_ERROR if any element is queried; returns the error of the first element otherwise.
      */
     int32_t GetAbilityInfos(const std::vector<ElementName> &elementNames, const std::string &localeInfo,
         std::vector<RemoteAbilityInfo> &remoteAbilityInfos) override;
@@ -121,8 +128,17 @@ public:
      */
     virtual void OnStop() override;
 private:
+    int32_t GetAbilityInfoOfBundle(const sptr<IBundleMgr> &iBundleMgr, int32_t userId,
+        const BundleInfo &bundleInfo, const ElementName &elementName, const std::string &localeInfo,
+        RemoteAbilityInfo &remoteAbilityInfo);
+    void GetAbilityInfosOfBundle(const sptr<IBundleMgr> &iBundleMgr, int32_t userId,
+        const std::vector<ElementName> &elementNames, const std::vector<size_t> &indexes,
+        const std::string &localeInfo, std::vector<RemoteAbilityInfo> &remoteAbilityInfos,
+        std::vector<int32_t> &results);
     std::shared_ptr<Global::Resource::ResourceManager> GetResourceManager(
         const AppExecFwk::BundleInfo &bundleInfo, const std::string &localeInfo);
+    std::shared_ptr<Global::Resource::ResourceManager> CreateResourceManager(
+        const AppExecFwk::BundleInfo &bundleInfo, const std::string &localeInfo);
     bool GetMediaBase64(std::string &path, std::string &value);
     bool GetMediaBae64FromImageBuffer(std::shared_ptr<ImageBuffer>& imageBuffer, std::string& value);
     std::unique_ptr<unsigned char[]> LoadResourceFile(std::string &path, int &len);
@@ -131,6 +147,11 @@ private:
 
     static OHOS::sptr<OHOS::AppExecFwk::IBundleMgr> bundleMgr_;
     static std::mutex bundleMgrMutex_;
+
+    RemoteAbilityInfoCache abilityInfoCache_;
+    std::mutex resourceManagerMutex_;
+    // key:bundle name, version code, update time and locale, front is the most recently used
+    std::list<std::pair<std::string, std::shared_ptr<Global::Resource::ResourceManager>>> resourceManagers_;
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -20,6 +20,7 @@
 #include <cstdlib>
 #include <string>
 #include <cmath>
+#include <vector>
 
 #include "png.h"
 #include "jpeglib.h"
@@ -30,7 +31,7 @@ namespace AppExecFwk {
 class ImageCompress {
 public:
     ImageCompress() = default;
-    ~ImageCompress();
+    ~ImageCompress() = default;
     double CalRatio(std::string fileName);
     bool NeedCompress(std::string fileName);
     bool InitPngFile(std::shared_ptr<ImageBuffer>& imageBuffer, png_structp& png, png_infop& info);
@@ -40,6 +41,16 @@ public:
     int32_t DecodeJPGFile(std::string fileName, std::shared_ptr<ImageBuffer>& imageBuffer);
     int32_t EncodeJPGFile(std::shared_ptr<ImageBuffer>& imageBuffer);
     int32_t ResizeRGBImage(std::shared_ptr<ImageBuffer>& imageBufferIn, std::shared_ptr<ImageBuffer>& imageBufferOut);
+    /**
+     * @brief Downscale an image by averaging the source pixels covered by every output pixel.
+     * @param imageBufferIn Indicates the source image, with 3 or 4 components of 8 bits.
+     * @param imageBufferOut Indicates the resized image.
+     * @param ratio Indicates the ratio of the output size to the source size.
+     * @return Returns 0 if succeeded; returns -1 otherwise.
+     */
+    int32_t ResizeImage(std::shared_ptr<ImageBuffer>& imageBufferIn, std::shared_ptr<ImageBuffer>& imageBufferOut,
+        double ratio);
+    void GetSourceSpans(uint32_t inSize, uint32_t outSize, std::vector<uint32_t>& starts, std::vector<uint32_t>& ends);
     std::shared_ptr<ImageBuffer> CompressImage(std::string inFileName);
     void ReleasePngPointer(png_bytepp& rowPointers, uint32_t height);
     bool MallocPngPointer(png_bytepp& rowPointers, uint32_t height, uint32_t strides);
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_REMOTE_ABILITY_INFO_CACHE_H
+#define FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_REMOTE_ABILITY_INFO_CACHE_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Persists the label and the compressed base64 icon of the abilities queried by remote devices, so that
+ * the icon is decoded, resized and encoded once per (bundle, ability, locale, version) instead of on every
+ * query. The files of a bundle are kept in one directory, and the files of its former versions are
+ * removed when an entry of a new version is stored. The directories of the least recently used bundles
+ * are removed when more than a limited count of bundles are cached.
+ */
+class RemoteAbilityInfoCache final {
+public:
+    struct Key {
+        std::string bundleName;
+        std::string moduleName;
+        std::string abilityName;
+        std::string locale;
+        uint32_t versionCode = 0;
+        int64_t updateTime = 0;
+    };
+
+    RemoteAbilityInfoCache() = default;
+    ~RemoteAbilityInfoCache() = default;
+
+    /**
+     * @brief Load the cached label and icon of an ability.
+     * @param key Indicates the ability and the version of its bundle.
+     * @param label Indicates the cached label.
+     * @param icon Indicates the cached base64 icon.
+     * @return Returns true if the ability is cached; returns false otherwise.
+     */
+    bool Load(const Key &key, std::string &label, std::string &icon);
+    /**
+     * @brief Store the label and icon of an ability.
+     * @param key Indicates the ability and the version of its bundle.
+     * @param label Indicates the label.
+     * @param icon Indicates the base64 icon.
+     */
+    void Store(const Key &key, const std::string &label, const std::string &icon);
+    /**
+     * @brief Remove the cached labels and icons of a bundle.
+     * @param bundleName Indicates the bundle name.
+     */
+    void RemoveBundle(const std::string &bundleName);
+
+private:
+    static constexpr size_t BUNDLE_MUTEX_COUNT = 16;
+
+    std::mutex &GetBundleMutex(const std::string &bundleName);
+    bool GetBundleDir(const std::string &bundleName, std::string &bundleDir) const;
+    std::string GetVersionPrefix(const Key &key) const;
+    std::string GetFileName(const Key &key) const;
+    void RemoveStaleFiles(const std::string &bundleDir, const std::string &versionPrefix) const;
+    void RemoveBundleDir(const std::string &bundleDir) const;
+    void EvictBundles(const std::string &bundleName);
+
+    // the files are replaced by rename, so Load takes no lock, and Store of different bundles runs concurrently
+    std::array<std::mutex, BUNDLE_MUTEX_COUNT> bundleMutexes_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_DBMS_INCLUDE_REMOTE_ABILITY_INFO_CACHE_H
@@ -16,12 +16,15 @@
 #include "distributed_bms.h"
 
 #include <fstream>
+#include <iterator>
+#include <map>
 #include <vector>
 
 #include "app_log_wrapper.h"
 #include "appexecfwk_errors.h"
 #include "bundle_mgr_interface.h"
 #include "bundle_mgr_proxy.h"
+#include "concurrent_util.h"
 #include "iservice_registry.h"
 #include "if_system_ability_manager.h"
 #include "locale_config.h"
@@ -41,14 +44,17 @@ namespace {
     const uint8_t DECODE_VALUE_SIX = 6;
     const unsigned char DECODE_VALUE_CHAR_FIFTEEN = 15;
     const unsigned char DECODE_VALUE_CHAR_SIXTY_THREE = 63;
-    const std::vector<char> DECODE_TABLE = {
-        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
-        'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
-        'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
-        'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
-        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
-    };
+    // positions of the bytes in a 24 bits group, and of the first two 6 bits chars encoded from it
+    const uint8_t BASE64_SHIFT_BYTE_ONE = 16;
+    const uint8_t BASE64_SHIFT_BYTE_TWO = 8;
+    const uint8_t BASE64_SHIFT_CHAR_ONE = 18;
+    const uint8_t BASE64_SHIFT_CHAR_TWO = 12;
+    const char BASE64_TABLE[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
     const std::string POSTFIX = "_Compress.";
+    // a ResourceManager holds the parsed resource index of all the modules of an app, keep a few of them only
+    const size_t MAX_RESOURCE_MANAGER_CACHE_SIZE = 16;
+    // the bundles of a GetAbilityInfos call are queried by this many threads at most, the caller included
+    const size_t MAX_GET_ABILITY_INFOS_THREAD_NUM = 4;
 }
 REGISTER_SYSTEM_ABILITY_BY_ID(DistributedBms, DISTRIBUTED_BUNDLE_MGR_SERVICE_SYS_ABILITY_ID, true);
 
@@ -181,14 +187,17 @@ int32_t DistributedBms::GetAbilityInfo(const OHOS::AppExecFwk::ElementName &elem
     BundleInfo bundleInfo;
     if (!iBundleMgr->GetBundleInfo(elementName.GetBundleName(), 1, bundleInfo, userId)) {
         APP_LOGE("DistributedBms GetBundleInfo failed");
+        // the bundle is uninstalled, so are its cached labels and icons
+        abilityInfoCache_.RemoveBundle(elementName.GetBundleName());
         return ERR_APPEXECFWK_FAILED_GET_BUNDLE_INFO;
     }
-    std::shared_ptr<Global::Resource::ResourceManager> resourceManager = nullptr;
-    resourceManager = GetResourceManager(bundleInfo, localeInfo);
-    if (resourceManager == nullptr) {
-        APP_LOGE("DistributedBms InitResourceManager failed");
-        return ERR_APPEXECFWK_FAILED_GET_RESOURCEMANAGER;
-    }
+    return GetAbilityInfoOfBundle(iBundleMgr, userId, bundleInfo, elementName, localeInfo, remoteAbilityInfo);
+}
+
+int32_t DistributedBms::GetAbilityInfoOfBundle(const sptr<IBundleMgr> &iBundleMgr, int32_t userId,
+    const BundleInfo &bundleInfo, const ElementName &elementName, const std::string &localeInfo,
+    RemoteAbilityInfo &remoteAbilityInfo)
+{
     AbilityInfo abilityInfo;
     OHOS::AAFwk::Want want;
     want.SetElement(elementName);
@@ -197,6 +206,23 @@ int32_t DistributedBms::GetAbilityInfo(const OHOS::AppExecFwk::ElementName &elem
         return ERR_APPEXECFWK_FAILED_GET_ABILITY_INFO;
     }
     remoteAbilityInfo.elementName = elementName;
+    RemoteAbilityInfoCache::Key cacheKey;
+    cacheKey.bundleName = bundleInfo.name;
+    cacheKey.moduleName = abilityInfo.moduleName;
+    cacheKey.abilityName = abilityInfo.name;
+    cacheKey.locale = localeInfo;
+    cacheKey.versionCode = bundleInfo.versionCode;
+    cacheKey.updateTime = bundleInfo.updateTime;
+    if (abilityInfoCache_.Load(cacheKey, remoteAbilityInfo.label, remoteAbilityInfo.icon)) {
+        APP_LOGD("DistributedBms GetAbilityInfo from cache, label:%{public}s", remoteAbilityInfo.label.c_str());
+        return OHOS::NO_ERROR;
+    }
+    std::shared_ptr<Global::Resource::ResourceManager> resourceManager = nullptr;
+    resourceManager = GetResourceManager(bundleInfo, localeInfo);
+    if (resourceManager == nullptr) {
+        APP_LOGE("DistributedBms InitResourceManager failed");
+        return ERR_APPEXECFWK_FAILED_GET_RESOURCEMANAGER;
+    }
     OHOS::Global::Resource::RState errval =
         resourceManager->GetStringById(static_cast<uint32_t>(abilityInfo.labelId), remoteAbilityInfo.label);
     if (errval != OHOS::Global::Resource::RState::SUCCESS) {
@@ -211,7 +237,7 @@ int32_t DistributedBms::GetAbilityInfo(const OHOS::AppExecFwk::ElementName &elem
         return ERR_APPEXECFWK_FAILED_GET_RESOURCEMANAGER;
     }
 
-    std::shared_ptr<ImageCompress> imageCompress;
+    std::shared_ptr<ImageCompress> imageCompress = std::make_shared<ImageCompress>();
     if (imageCompress->NeedCompress(iconPath)) {
         std::shared_ptr<ImageBuffer> imageBuffer = imageCompress->CompressImage(iconPath.c_str());
         if (imageBuffer != nullptr) {
@@ -232,6 +258,7 @@ int32_t DistributedBms::GetAbilityInfo(const OHOS::AppExecFwk::ElementName &elem
         }
     }
 
+    abilityInfoCache_.Store(cacheKey, remoteAbilityInfo.label, remoteAbilityInfo.icon);
     APP_LOGD("DistributedBms GetAbilityInfo label:%{public}s", remoteAbilityInfo.label.c_str());
     return OHOS::NO_ERROR;
 }
@@ -247,21 +274,108 @@ int32_t DistributedBms::GetAbilityInfos(const std::vector<ElementName> &elementN
     const std::string &localeInfo, std::vector<RemoteAbilityInfo> &remoteAbilityInfos)
 {
     APP_LOGD("DistributedBms GetAbilityInfos");
-    for (auto elementName : elementNames) {
-        RemoteAbilityInfo remoteAbilityInfo;
-        int32_t result = GetAbilityInfo(elementName, localeInfo, remoteAbilityInfo);
-        if (result) {
-            APP_LOGE("get AbilityInfo:%{public}s, %{public}s, %{public}s failed", elementName.GetBundleName().c_str(),
-                elementName.GetModuleName().c_str(), elementName.GetAbilityName().c_str());
-            return result;
+    if (elementNames.empty()) {
+        return OHOS::NO_ERROR;
+    }
+    auto iBundleMgr = GetBundleMgr();
+    if (!iBundleMgr) {
+        APP_LOGE("DistributedBms GetBundleMgr failed");
+        return ERR_APPEXECFWK_FAILED_SERVICE_DIED;
+    }
+    int userId = -1;
+    if (!GetCurrentUserId(userId)) {
+        APP_LOGE("GetCurrentUserId failed");
+        return ERR_APPEXECFWK_USER_NOT_EXIST;
+    }
+    // the elements of a bundle share its bundle info and ResourceManager, so they are queried by one worker
+    std::map<std::string, std::vector<size_t>> bundleElements;
+    for (size_t i = 0; i < elementNames.size(); ++i) {
+        bundleElements[elementNames[i].GetBundleName()].push_back(i);
+    }
+    std::vector<const std::vector<size_t> *> groups;
+    for (const auto &item : bundleElements) {
+        groups.push_back(&item.second);
+    }
+    std::vector<RemoteAbilityInfo> infos(elementNames.size());
+    std::vector<int32_t> results(elementNames.size(), OHOS::NO_ERROR);
+    RunConcurrently(groups.size(), MAX_GET_ABILITY_INFOS_THREAD_NUM, [&](size_t group) {
+        GetAbilityInfosOfBundle(iBundleMgr, userId, elementNames, *groups[group], localeInfo, infos, results);
+    });
+
+    int32_t result = OHOS::NO_ERROR;
+    size_t failedCount = 0;
+    for (size_t i = 0; i < elementNames.size(); ++i) {
+        if (results[i] != OHOS::NO_ERROR) {
+            APP_LOGE("get AbilityInfo:%{public}s, %{public}s, %{public}s failed, result:%{public}d",
+                elementNames[i].GetBundleName().c_str(), elementNames[i].GetModuleName().c_str(),
+                elementNames[i].GetAbilityName().c_str(), results[i]);
+            // a failed element is returned with its element name only
+            infos[i] = RemoteAbilityInfo();
+            infos[i].elementName = elementNames[i];
+            if (failedCount++ == 0) {
+                result = results[i];
+            }
         }
-        remoteAbilityInfos.push_back(remoteAbilityInfo);
     }
+    if (failedCount == elementNames.size()) {
+        return result;
+    }
+    remoteAbilityInfos.insert(remoteAbilityInfos.end(),
+        std::make_move_iterator(infos.begin()), std::make_move_iterator(infos.end()));
     return OHOS::NO_ERROR;
 }
 
+void DistributedBms::GetAbilityInfosOfBundle(const sptr<IBundleMgr> &iBundleMgr, int32_t userId,
+    const std::vector<ElementName> &elementNames, const std::vector<size_t> &indexes, const std::string &localeInfo,
+    std::vector<RemoteAbilityInfo> &remoteAbilityInfos, std::vector<int32_t> &results)
+{
+    BundleInfo bundleInfo;
+    if (!iBundleMgr->GetBundleInfo(elementNames[indexes[0]].GetBundleName(), 1, bundleInfo, userId)) {
+        APP_LOGE("DistributedBms GetBundleInfo failed");
+        abilityInfoCache_.RemoveBundle(elementNames[indexes[0]].GetBundleName());
+        for (size_t index : indexes) {
+            results[index] = ERR_APPEXECFWK_FAILED_GET_BUNDLE_INFO;
+        }
+        return;
+    }
+    for (size_t index : indexes) {
+        results[index] = GetAbilityInfoOfBundle(
+            iBundleMgr, userId, bundleInfo, elementNames[index], localeInfo, remoteAbilityInfos[index]);
+    }
+}
+
 std::shared_ptr<Global::Resource::ResourceManager> DistributedBms::GetResourceManager(
     const AppExecFwk::BundleInfo &bundleInfo, const std::string &localeInfo)
+{
+    // an installed, updated or uninstalled bundle changes its version code or update time, so its
+    // stale entries are never hit again and age out of the cache
+    std::string key = bundleInfo.name + "_" + std::to_string(bundleInfo.versionCode) + "_" +
+        std::to_string(bundleInfo.updateTime) + "_" + localeInfo;
+    {
+        std::lock_guard<std::mutex> lock(resourceManagerMutex_);
+        for (auto item = resourceManagers_.begin(); item != resourceManagers_.end(); ++item) {
+            if (item->first == key) {
+                resourceManagers_.splice(resourceManagers_.begin(), resourceManagers_, item);
+                return item->second;
+            }
+        }
+    }
+    // created out of the lock so that the bundles of a GetAbilityInfos call load their resources concurrently
+    std::shared_ptr<Global::Resource::ResourceManager> resourceManager =
+        CreateResourceManager(bundleInfo, localeInfo);
+    if (resourceManager == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(resourceManagerMutex_);
+    resourceManagers_.emplace_front(key, resourceManager);
+    if (resourceManagers_.size() > MAX_RESOURCE_MANAGER_CACHE_SIZE) {
+        resourceManagers_.pop_back();
+    }
+    return resourceManager;
+}
+
+std::shared_ptr<Global::Resource::ResourceManager> DistributedBms::CreateResourceManager(
+    const AppExecFwk::BundleInfo &bundleInfo, const std::string &localeInfo)
 {
     std::shared_ptr<Global::Resource::ResourceManager> resourceManager(Global::Resource::CreateResourceManager());
     for (auto moduleResPath : bundleInfo.moduleResPaths) {
@@ -334,40 +448,42 @@ std::unique_ptr<unsigned char[]> DistributedBms::LoadResourceFile(std::string &p
 
 std::unique_ptr<char[]> DistributedBms::EncodeBase64(std::unique_ptr<unsigned char[]> &data, int srcLen)
 {
+    if (srcLen < 0) {
+        srcLen = 0;
+    }
     int len = (srcLen / DECODE_VALUE_THREE) * DECODE_VALUE_FOUR; // Split 3 bytes to 4 parts, each containing 6 bits.
     int outLen = ((srcLen % DECODE_VALUE_THREE) != 0) ? (len + DECODE_VALUE_FOUR) : len;
     const unsigned char *srcData = data.get();
     std::unique_ptr<char[]>  result = std::make_unique<char[]>(outLen + DECODE_VALUE_ONE);
     char *dstData = result.get();
-    int j = 0;
-    int i = 0;
-    for (; i < srcLen - DECODE_VALUE_THREE; i += DECODE_VALUE_THREE) {
-        unsigned char byte1 = srcData[i];
-        unsigned char byte2 = srcData[i + DECODE_VALUE_ONE];
-        unsigned char byte3 = srcData[i + DECODE_VALUE_TWO];
-        dstData[j++] = DECODE_TABLE[byte1 >> DECODE_VALUE_TWO];
-        dstData[j++] =
-            DECODE_TABLE[(static_cast<uint8_t>(byte1 & DECODE_VALUE_CHAR_THREE) << DECODE_VALUE_FOUR)
-             | (byte2 >> DECODE_VALUE_FOUR)];
-        dstData[j++] =
-            DECODE_TABLE[(static_cast<uint8_t>(byte2 & DECODE_VALUE_CHAR_FIFTEEN)
-                << DECODE_VALUE_TWO) | (byte3 >> DECODE_VALUE_SIX)];
-        dstData[j++] = DECODE_TABLE[byte3 & DECODE_VALUE_CHAR_SIXTY_THREE];
+    // the groups are independent, so index them instead of carrying counters to let the compiler unroll
+    int groups = srcLen / DECODE_VALUE_THREE;
+    for (int group = 0; group < groups; ++group) {
+        const unsigned char *src = srcData + group * DECODE_VALUE_THREE;
+        char *dst = dstData + group * DECODE_VALUE_FOUR;
+        uint32_t bits = (static_cast<uint32_t>(src[0]) << BASE64_SHIFT_BYTE_ONE) |
+            (static_cast<uint32_t>(src[DECODE_VALUE_ONE]) << BASE64_SHIFT_BYTE_TWO) | src[DECODE_VALUE_TWO];
+        dst[0] = BASE64_TABLE[(bits >> BASE64_SHIFT_CHAR_ONE) & DECODE_VALUE_CHAR_SIXTY_THREE];
+        dst[DECODE_VALUE_ONE] = BASE64_TABLE[(bits >> BASE64_SHIFT_CHAR_TWO) & DECODE_VALUE_CHAR_SIXTY_THREE];
+        dst[DECODE_VALUE_TWO] = BASE64_TABLE[(bits >> DECODE_VALUE_SIX) & DECODE_VALUE_CHAR_SIXTY_THREE];
+        dst[DECODE_VALUE_THREE] = BASE64_TABLE[bits & DECODE_VALUE_CHAR_SIXTY_THREE];
     }
+    int i = groups * DECODE_VALUE_THREE;
+    int j = groups * DECODE_VALUE_FOUR;
     if (srcLen % DECODE_VALUE_THREE == DECODE_VALUE_ONE) {
         unsigned char byte1 = srcData[i];
-        dstData[j++] = DECODE_TABLE[byte1 >> DECODE_VALUE_TWO];
-        dstData[j++] = DECODE_TABLE[static_cast<uint8_t>(byte1 & DECODE_VALUE_CHAR_THREE) << DECODE_VALUE_FOUR];
+        dstData[j++] = BASE64_TABLE[byte1 >> DECODE_VALUE_TWO];
+        dstData[j++] = BASE64_TABLE[static_cast<uint8_t>(byte1 & DECODE_VALUE_CHAR_THREE) << DECODE_VALUE_FOUR];
         dstData[j++] = '=';
         dstData[j++] = '=';
-    } else {
+    } else if (srcLen % DECODE_VALUE_THREE == DECODE_VALUE_TWO) {
         unsigned char byte1 = srcData[i];
         unsigned char byte2 = srcData[i + DECODE_VALUE_ONE];
-        dstData[j++] = DECODE_TABLE[byte1 >> DECODE_VALUE_TWO];
+        dstData[j++] = BASE64_TABLE[byte1 >> DECODE_VALUE_TWO];
         dstData[j++] =
-            DECODE_TABLE[(static_cast<uint8_t>(byte1 & DECODE_VALUE_CHAR_THREE) << DECODE_VALUE_FOUR)
+            BASE64_TABLE[(static_cast<uint8_t>(byte1 & DECODE_VALUE_CHAR_THREE) << DECODE_VALUE_FOUR)
              | (byte2 >> DECODE_VALUE_FOUR)];
-        dstData[j++] = DECODE_TABLE[static_cast<uint8_t>(byte2 & DECODE_VALUE_CHAR_FIFTEEN)
+        dstData[j++] = BASE64_TABLE[static_cast<uint8_t>(byte2 & DECODE_VALUE_CHAR_FIFTEEN)
                                     << DECODE_VALUE_TWO];
         dstData[j++] = '=';
     }
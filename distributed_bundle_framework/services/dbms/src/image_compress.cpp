@@ -12,9 +12,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 #include <unistd.h>
+#include <vector>
 
 #include "image_compress.h"
 
@@ -32,9 +34,6 @@ namespace {
     constexpr int32_t FILE_COMPRESS_SIZE = 4196;
     constexpr int32_t BITDEPTH_SIXTHEN = 16;
     constexpr int32_t BITDEPTH_EIGHT = 8;
-    constexpr int32_t COLOR_CHANNEL_GREEN = 1;
-    constexpr int32_t COLOR_CHANNEL_BLUE = 2; 
-    constexpr int32_t COLOR_CHANNEL_ALPHA = 3;
     constexpr int32_t NUMBER_ONE = 1;
     constexpr int32_t QUALITY = 30;
     constexpr double EPSILON = 1e-5;
@@ -46,6 +45,25 @@ namespace {
         ImageRow buffer;
         uint32_t size;
     };
+    // averages the summed source columns covered by each output pixel, the channel count is a constant so
+    // that the channel loops are unrolled
+    template<int32_t COMPONENTS>
+    void AverageColumns(const uint32_t *sums, const std::vector<uint32_t>& columnStarts,
+        const std::vector<uint32_t>& columnEnds, uint32_t rowCount, ImageRow dst)
+    {
+        for (size_t w = 0; w < columnStarts.size(); ++w) {
+            uint64_t area = static_cast<uint64_t>(columnEnds[w] - columnStarts[w]) * rowCount;
+            uint64_t pixel[COMPONENTS] = { 0 };
+            for (uint32_t column = columnStarts[w]; column < columnEnds[w]; ++column) {
+                for (int32_t c = 0; c < COMPONENTS; ++c) {
+                    pixel[c] += sums[column * COMPONENTS + c];
+                }
+            }
+            for (int32_t c = 0; c < COMPONENTS; ++c) {
+                dst[w * COMPONENTS + c] = static_cast<ImageData>((pixel[c] + area / 2) / area);
+            }
+        }
+    }
 }
 
 void ImageCompress::ReleasePngPointer(png_bytepp& rowPointers, uint32_t height)
@@ -364,41 +382,7 @@ int32_t ImageCompress::ResizeRGBAImage(std::shared_ptr<ImageBuffer>& imageBuffer
     }
     double ratio = imageBufferIn->GetRatio();
     ratio = ratio * (static_cast<double>(imageBufferIn->GetPngComponents()) / RGBA_COMPONENTS) ;
-    if (DoubleEqual(ratio, 0.0)) {
-        return -1;
-    }
-    imageBufferOut->SetWidth(imageBufferIn->GetWidth() * ratio);
-    imageBufferOut->SetHeight(imageBufferIn->GetHeight() * ratio);
-    imageBufferOut->SetComponents(imageBufferIn->GetComponents());
-    imageBufferOut->SetColorType(imageBufferIn->GetColorType());
-    imageBufferOut->SetBitDepth(imageBufferIn->GetBitDepth());
-    imageBufferOut->MallocImageMap(imageBufferOut->GetComponents());
-    ImageRow imageRowIn = imageBufferIn->GetImageDataPointer().get();
-    ImageRow imageRowOut = imageBufferOut->GetImageDataPointer().get();
-    uint32_t outRowStride = imageBufferOut->GetWidth() * imageBufferOut->GetComponents();
-    uint32_t inRowStride = imageBufferIn->GetWidth() * imageBufferIn->GetComponents();
-    uint32_t components = imageBufferIn->GetComponents();
-    for (uint32_t h = 0; h < imageBufferOut->GetHeight(); ++h) {
-        for (uint32_t w = 0; w < imageBufferOut->GetWidth(); ++w) {
-            uint64_t heightIndex = std::round(h / ratio);
-            uint64_t widthIndex = std::round(w / ratio);
-            if (heightIndex > imageBufferIn->GetHeight()) {
-                heightIndex = imageBufferIn->GetHeight() == 0 ? 0 : imageBufferIn->GetHeight() - 1;
-            }
-            if (widthIndex > imageBufferIn->GetWidth()) {
-                widthIndex = imageBufferIn->GetWidth() == 0 ? 0 : imageBufferIn->GetWidth() - 1;
-            }
-            imageRowOut[h * outRowStride +  w * components] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components];
-            imageRowOut[h * outRowStride +  w * components + COLOR_CHANNEL_GREEN] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components + COLOR_CHANNEL_GREEN];
-            imageRowOut[h * outRowStride +  w * components + COLOR_CHANNEL_BLUE] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components + COLOR_CHANNEL_BLUE];
-            imageRowOut[h * outRowStride +  w * components + COLOR_CHANNEL_ALPHA] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components + COLOR_CHANNEL_ALPHA];
-        }
-    }
-    return 0;
+    return ResizeImage(imageBufferIn, imageBufferOut, ratio);
 }
 
 int32_t ImageCompress::DecodeJPGFile(std::string fileName, std::shared_ptr<ImageBuffer>& imageBuffer)
@@ -501,42 +485,84 @@ int32_t ImageCompress::ResizeRGBImage(std::shared_ptr<ImageBuffer>& imageBufferI
         APP_LOGE("ImageCompress: ResizePRGBAImage should input image buffer");
         return -1;
     }
-    double ratio = imageBufferIn->GetRatio();
-    if (DoubleEqual(ratio, 0.0)) {
+    return ResizeImage(imageBufferIn, imageBufferOut, imageBufferIn->GetRatio());
+}
+
+int32_t ImageCompress::ResizeImage(std::shared_ptr<ImageBuffer>& imageBufferIn,
+                                   std::shared_ptr<ImageBuffer>& imageBufferOut, double ratio)
+{
+    if (DoubleEqual(ratio, 0.0) || ratio < 0) {
+        return -1;
+    }
+    uint32_t inWidth = imageBufferIn->GetWidth();
+    uint32_t inHeight = imageBufferIn->GetHeight();
+    uint32_t components = imageBufferIn->GetComponents();
+    if (inWidth == 0 || inHeight == 0 || (components != RGB_COMPONENTS && components != RGBA_COMPONENTS)) {
+        APP_LOGE("ImageCompress: ResizeImage input image is unavailable");
         return -1;
     }
-    imageBufferOut->SetWidth(imageBufferIn->GetWidth() * ratio);
-    imageBufferOut->SetHeight(imageBufferIn->GetHeight() * ratio);
-    imageBufferOut->SetComponents(imageBufferIn->GetComponents());
+    uint32_t outWidth = std::max(static_cast<uint32_t>(inWidth * ratio), static_cast<uint32_t>(NUMBER_ONE));
+    uint32_t outHeight = std::max(static_cast<uint32_t>(inHeight * ratio), static_cast<uint32_t>(NUMBER_ONE));
+    imageBufferOut->SetWidth(outWidth);
+    imageBufferOut->SetHeight(outHeight);
+    imageBufferOut->SetComponents(components);
     imageBufferOut->SetColorType(imageBufferIn->GetColorType());
     imageBufferOut->SetBitDepth(imageBufferIn->GetBitDepth());
-    imageBufferOut->MallocImageMap(imageBufferOut->GetComponents());
-    ImageRow imageRowIn = imageBufferIn->GetImageDataPointer().get();
+    imageBufferOut->MallocImageMap(components);
+    const ImageData *imageRowIn = imageBufferIn->GetImageDataPointer().get();
     ImageRow imageRowOut = imageBufferOut->GetImageDataPointer().get();
-    uint32_t outRowStride = imageBufferOut->GetWidth() * imageBufferOut->GetComponents();
-    uint32_t inRowStride = imageBufferIn->GetWidth() * imageBufferIn->GetComponents();
-    uint32_t components = imageBufferIn->GetComponents();
-    for (uint32_t h = 0; h < imageBufferOut->GetHeight(); ++h) {
-        for (uint32_t w = 0; w < imageBufferOut->GetWidth(); ++w) {
-            uint64_t heightIndex = std::round(h / ratio);
-            uint64_t widthIndex = std::round(w / ratio);
-            if (heightIndex > imageBufferIn->GetHeight()) {
-                heightIndex = imageBufferIn->GetHeight() == 0 ? 0 : imageBufferIn->GetHeight() - 1;
-            }
-            if (widthIndex > imageBufferIn->GetWidth()) {
-                widthIndex = imageBufferIn->GetWidth() == 0 ? 0 : imageBufferIn->GetWidth() - 1;
+    if (imageRowIn == nullptr || imageRowOut == nullptr) {
+        return -1;
+    }
+
+    // every output pixel is the average of the source pixels it covers, the covered spans only depend
+    // on the sizes, so they are computed once in integers instead of per pixel
+    std::vector<uint32_t> columnStarts;
+    std::vector<uint32_t> columnEnds;
+    std::vector<uint32_t> rowStarts;
+    std::vector<uint32_t> rowEnds;
+    GetSourceSpans(inWidth, outWidth, columnStarts, columnEnds);
+    GetSourceSpans(inHeight, outHeight, rowStarts, rowEnds);
+    size_t inRowStride = static_cast<size_t>(inWidth) * components;
+    size_t outRowStride = static_cast<size_t>(outWidth) * components;
+    // column sums of the source rows covered by the current output row, a plain add of byte rows into
+    // an integer row that the compiler vectorizes
+    std::vector<uint32_t> rowSums(inRowStride);
+    uint32_t *sums = rowSums.data();
+    for (uint32_t h = 0; h < outHeight; ++h) {
+        std::fill(rowSums.begin(), rowSums.end(), 0);
+        for (uint32_t row = rowStarts[h]; row < rowEnds[h]; ++row) {
+            const ImageData *src = imageRowIn + row * inRowStride;
+            for (size_t i = 0; i < inRowStride; ++i) {
+                sums[i] += src[i];
             }
-            imageRowOut[h * outRowStride +  w * components] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components];
-            imageRowOut[h * outRowStride +  w * components + COLOR_CHANNEL_GREEN] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components + COLOR_CHANNEL_GREEN];
-            imageRowOut[h * outRowStride +  w * components + COLOR_CHANNEL_BLUE] =
-                imageRowIn[heightIndex * inRowStride + widthIndex * components + COLOR_CHANNEL_BLUE];
+        }
+        uint32_t rowCount = rowEnds[h] - rowStarts[h];
+        ImageRow dst = imageRowOut + h * outRowStride;
+        if (components == RGBA_COMPONENTS) {
+            AverageColumns<RGBA_COMPONENTS>(sums, columnStarts, columnEnds, rowCount, dst);
+        } else {
+            AverageColumns<RGB_COMPONENTS>(sums, columnStarts, columnEnds, rowCount, dst);
         }
     }
     return 0;
 }
 
+void ImageCompress::GetSourceSpans(uint32_t inSize, uint32_t outSize,
+                                   std::vector<uint32_t>& starts, std::vector<uint32_t>& ends)
+{
+    starts.resize(outSize);
+    ends.resize(outSize);
+    for (uint32_t i = 0; i < outSize; ++i) {
+        starts[i] = static_cast<uint32_t>(static_cast<uint64_t>(i) * inSize / outSize);
+        ends[i] = static_cast<uint32_t>(static_cast<uint64_t>(i + 1) * inSize / outSize);
+        // enlarging, the pixel falls inside one source pixel
+        if (ends[i] <= starts[i]) {
+            ends[i] = std::min(starts[i] + 1, inSize);
+        }
+    }
+}
+
 std::shared_ptr<ImageBuffer> ImageCompress::CompressImage(std::string inFileName)
 {
     std::string inFileSuffix = inFileName.substr(inFileName.find_last_of('.') + 1);
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "remote_ability_info_cache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "app_log_wrapper.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+    const std::string CACHE_DIR = "/data/service/el1/public/dbms/ability_info_cache";
+    const std::string TMP_SUFFIX = ".tmp";
+    const char NAME_SEPARATOR = '_';
+    // module name, ability name, locale, label and icon
+    const size_t FIELD_COUNT = 5;
+    const uint32_t MAX_FIELD_SIZE = 1024 * 1024;
+    const size_t MAX_CACHED_BUNDLE_COUNT = 128;
+    const int64_t NANOSECONDS_PER_SECOND = 1000000000;
+
+    bool WriteField(std::ofstream &stream, const std::string &field)
+    {
+        uint32_t size = static_cast<uint32_t>(field.size());
+        stream.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        stream.write(field.data(), field.size());
+        return stream.good();
+    }
+
+    bool ReadField(std::ifstream &stream, std::string &field)
+    {
+        uint32_t size = 0;
+        if (!stream.read(reinterpret_cast<char *>(&size), sizeof(size)) || size > MAX_FIELD_SIZE) {
+            return false;
+        }
+        field.resize(size);
+        return static_cast<bool>(stream.read(&field[0], size));
+    }
+}
+
+bool RemoteAbilityInfoCache::Load(const Key &key, std::string &label, std::string &icon)
+{
+    std::string bundleDir;
+    if (!GetBundleDir(key.bundleName, bundleDir)) {
+        return false;
+    }
+    std::ifstream stream(bundleDir + GetFileName(key), std::ios::binary);
+    if (!stream.is_open()) {
+        return false;
+    }
+    std::vector<std::string> fields(FIELD_COUNT);
+    for (auto &field : fields) {
+        if (!ReadField(stream, field)) {
+            APP_LOGW("cache of %{public}s is broken", key.bundleName.c_str());
+            return false;
+        }
+    }
+    // the file name is a hash of these fields, so check them against the key in case of a collision
+    if (fields[0] != key.moduleName || fields[1] != key.abilityName || fields[2] != key.locale) {
+        return false;
+    }
+    label = std::move(fields[3]);
+    icon = std::move(fields[4]);
+    // the mtime of a bundle dir is the time it was last used, which orders the eviction
+    utimensat(AT_FDCWD, bundleDir.c_str(), nullptr, 0);
+    return true;
+}
+
+void RemoteAbilityInfoCache::Store(const Key &key, const std::string &label, const std::string &icon)
+{
+    std::string bundleDir;
+    if (!GetBundleDir(key.bundleName, bundleDir)) {
+        return;
+    }
+    bool isNewBundle = false;
+    {
+        std::lock_guard<std::mutex> lock(GetBundleMutex(key.bundleName));
+        if (mkdir(CACHE_DIR.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+            APP_LOGW("create cache dir failed, errno:%{public}d", errno);
+            return;
+        }
+        isNewBundle = mkdir(bundleDir.c_str(), S_IRWXU) == 0;
+        if (!isNewBundle && errno != EEXIST) {
+            APP_LOGW("create cache dir of %{public}s failed, errno:%{public}d", key.bundleName.c_str(), errno);
+            return;
+        }
+        RemoveStaleFiles(bundleDir, GetVersionPrefix(key));
+        std::string path = bundleDir + GetFileName(key);
+        std::string tmpPath = path + TMP_SUFFIX;
+        {
+            std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!stream.is_open() || !WriteField(stream, key.moduleName) || !WriteField(stream, key.abilityName) ||
+                !WriteField(stream, key.locale) || !WriteField(stream, label) || !WriteField(stream, icon)) {
+                APP_LOGW("write cache of %{public}s failed", key.bundleName.c_str());
+                stream.close();
+                unlink(tmpPath.c_str());
+                return;
+            }
+        }
+        if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+            APP_LOGW("rename cache of %{public}s failed, errno:%{public}d", key.bundleName.c_str(), errno);
+            unlink(tmpPath.c_str());
+        }
+    }
+    // evicted out of the lock of this bundle, which takes the locks of the evicted ones
+    if (isNewBundle) {
+        EvictBundles(key.bundleName);
+    }
+}
+
+void RemoteAbilityInfoCache::RemoveBundle(const std::string &bundleName)
+{
+    std::string bundleDir;
+    if (!GetBundleDir(bundleName, bundleDir)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(GetBundleMutex(bundleName));
+    RemoveBundleDir(bundleDir);
+}
+
+std::mutex &RemoteAbilityInfoCache::GetBundleMutex(const std::string &bundleName)
+{
+    return bundleMutexes_[std::hash<std::string>()(bundleName) % BUNDLE_MUTEX_COUNT];
+}
+
+bool RemoteAbilityInfoCache::GetBundleDir(const std::string &bundleName, std::string &bundleDir) const
+{
+    if (bundleName.empty() || bundleName == "." || bundleName == ".." ||
+        bundleName.find('/') != std::string::npos) {
+        return false;
+    }
+    bundleDir = CACHE_DIR + "/" + bundleName + "/";
+    return true;
+}
+
+std::string RemoteAbilityInfoCache::GetVersionPrefix(const Key &key) const
+{
+    return std::to_string(key.versionCode) + NAME_SEPARATOR + std::to_string(key.updateTime) + NAME_SEPARATOR;
+}
+
+std::string RemoteAbilityInfoCache::GetFileName(const Key &key) const
+{
+    std::string ability = key.moduleName + '\0' + key.abilityName + '\0' + key.locale;
+    std::stringstream name;
+    name << GetVersionPrefix(key) << std::hex << std::hash<std::string>()(ability);
+    return name.str();
+}
+
+void RemoteAbilityInfoCache::RemoveStaleFiles(const std::string &bundleDir, const std::string &versionPrefix) const
+{
+    DIR *dir = opendir(bundleDir.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_type != DT_REG || strncmp(entry->d_name, versionPrefix.c_str(), versionPrefix.size()) == 0) {
+            continue;
+        }
+        APP_LOGD("remove stale cache %{public}s", entry->d_name);
+        unlink((bundleDir + entry->d_name).c_str());
+    }
+    closedir(dir);
+}
+
+void RemoteAbilityInfoCache::RemoveBundleDir(const std::string &bundleDir) const
+{
+    DIR *dir = opendir(bundleDir.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_type == DT_REG) {
+            unlink((bundleDir + entry->d_name).c_str());
+        }
+    }
+    closedir(dir);
+    if (rmdir(bundleDir.c_str()) != 0) {
+        APP_LOGW("remove cache dir failed, errno:%{public}d", errno);
+    }
+}
+
+void RemoteAbilityInfoCache::EvictBundles(const std::string &bundleName)
+{
+    DIR *dir = opendir(CACHE_DIR.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+    // key:mtime of the bundle dir in nanoseconds, value:bundle name
+    std::vector<std::pair<int64_t, std::string>> bundles;
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string name = entry->d_name;
+        std::string bundleDir;
+        struct stat fileInfo = {};
+        if (entry->d_type != DT_DIR || name == bundleName || !GetBundleDir(name, bundleDir) ||
+            stat(bundleDir.c_str(), &fileInfo) != 0) {
+            continue;
+        }
+        bundles.emplace_back(
+            static_cast<int64_t>(fileInfo.st_mtim.tv_sec) * NANOSECONDS_PER_SECOND + fileInfo.st_mtim.tv_nsec, name);
+    }
+    closedir(dir);
+    // the bundle just stored is the most recently used one
+    if (bundles.size() < MAX_CACHED_BUNDLE_COUNT) {
+        return;
+    }
+    size_t evictCount = bundles.size() + 1 - MAX_CACHED_BUNDLE_COUNT;
+    std::partial_sort(bundles.begin(), bundles.begin() + evictCount, bundles.end());
+    for (size_t i = 0; i < evictCount; ++i) {
+        APP_LOGD("evict cache of %{public}s", bundles[i].second.c_str());
+        RemoveBundle(bundles[i].second);
+    }
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
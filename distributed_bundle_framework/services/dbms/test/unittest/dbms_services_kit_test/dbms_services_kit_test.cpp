@@ -0,0 +1,583 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <dirent.h>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+#define private public
+#include "distributed_bms.h"
+#undef private
+#include "appexecfwk_errors.h"
+#include "bundle_mgr_host.h"
+#include "image_buffer.h"
+#include "image_compress.h"
+#include "remote_ability_info_cache.h"
+#include "system_ability_definition.h"
+
+using namespace testing::ext;
+using namespace OHOS::AppExecFwk;
+
+namespace OHOS {
+namespace {
+const int32_t RGB_COMPONENTS = 3;
+const int32_t RGBA_COMPONENTS = 4;
+const int32_t INVALID_COMPONENTS = 2;
+const int32_t RESIZE_FAILED = -1;
+const uint32_t IMAGE_WIDTH = 4;
+const uint32_t IMAGE_HEIGHT = 4;
+const uint32_t UNEVEN_IMAGE_WIDTH = 5;
+const uint32_t UNEVEN_IMAGE_HEIGHT = 3;
+const uint32_t SMALL_IMAGE_SIZE = 2;
+const double HALF_RATIO = 0.5;
+const double UNEVEN_RATIO = 0.4;
+const double DOUBLE_RATIO = 2.0;
+const uint32_t PIXEL_STEP = 7;
+const std::string CACHE_BUNDLE_NAME = "com.example.cachetest";
+const std::string CACHE_BUNDLE_DIR = "/data/service/el1/public/dbms/ability_info_cache/com.example.cachetest/";
+const std::string CACHE_DIR = "/data/service/el1/public/dbms/ability_info_cache";
+const std::string CACHE_MODULE_NAME = "entry";
+const std::string CACHE_ABILITY_NAME = "MainAbility";
+const std::string CACHE_LOCALE = "zh-Hans-CN";
+const std::string CACHE_LABEL = "label";
+const std::string CACHE_ICON = "aWNvbg==";
+const std::string CACHE_NEW_LABEL = "new label";
+const uint32_t CACHE_VERSION_CODE = 1;
+const uint32_t CACHE_NEW_VERSION_CODE = 2;
+const int64_t CACHE_UPDATE_TIME = 1000;
+const int64_t CACHE_NEW_UPDATE_TIME = 2000;
+const size_t CACHE_FILE_COUNT_ONE = 1;
+const size_t MAX_CACHED_BUNDLE_COUNT = 128;
+const std::string OTHER_BUNDLE_NAME = "com.example.cachetest.other";
+const std::string MISSING_BUNDLE_NAME = "com.example.cachetest.missing";
+const std::string MISSING_ABILITY_NAME = "MissingAbility";
+const std::string OTHER_ABILITY_NAME = "OtherAbility";
+const size_t ELEMENT_COUNT = 4;
+const size_t SUCCEEDED_ELEMENT_INDEX = 2;
+}  // namespace
+
+namespace AppExecFwk {
+// the bundle manager proxy used by DistributedBms
+extern sptr<IBundleMgr> bundleMgr_;
+}  // namespace AppExecFwk
+
+namespace {
+class MockBundleMgr : public BundleMgrHost {
+public:
+    bool GetBundleInfo(const std::string &bundleName, int32_t flags, BundleInfo &bundleInfo,
+        int32_t userId) override
+    {
+        if (bundleName != CACHE_BUNDLE_NAME && bundleName != OTHER_BUNDLE_NAME) {
+            return false;
+        }
+        bundleInfo.name = bundleName;
+        bundleInfo.versionCode = CACHE_VERSION_CODE;
+        bundleInfo.updateTime = CACHE_UPDATE_TIME;
+        return true;
+    }
+
+    bool QueryAbilityInfo(const Want &want, int32_t flags, int32_t userId, AbilityInfo &abilityInfo) override
+    {
+        ElementName elementName = want.GetElement();
+        if (elementName.GetAbilityName() == MISSING_ABILITY_NAME) {
+            return false;
+        }
+        abilityInfo.bundleName = elementName.GetBundleName();
+        abilityInfo.moduleName = CACHE_MODULE_NAME;
+        abilityInfo.name = elementName.GetAbilityName();
+        return true;
+    }
+};
+}  // namespace
+
+class DbmsServicesKitTest : public testing::Test {
+public:
+    DbmsServicesKitTest();
+    ~DbmsServicesKitTest();
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+    std::string EncodeBase64(const std::string &data);
+    std::shared_ptr<ImageBuffer> CreateImageBuffer(uint32_t width, uint32_t height, int32_t components) const;
+    ImageData GetAveragePixel(const std::shared_ptr<ImageBuffer> &imageBuffer, uint32_t outWidth,
+        uint32_t outHeight, uint32_t w, uint32_t h, uint32_t c) const;
+    void CheckResizedImage(const std::shared_ptr<ImageBuffer> &imageBufferIn,
+        const std::shared_ptr<ImageBuffer> &imageBufferOut) const;
+    RemoteAbilityInfoCache::Key GetCacheKey() const;
+    size_t CountEntries(const std::string &path) const;
+    void StoreAbilityInfo(const std::string &bundleName, const std::string &abilityName);
+    std::string GetLabel(const std::string &bundleName, const std::string &abilityName) const;
+
+private:
+    std::shared_ptr<DistributedBms> distributedBms_ =
+        std::make_shared<DistributedBms>(DISTRIBUTED_BUNDLE_MGR_SERVICE_SYS_ABILITY_ID, true);
+};
+
+DbmsServicesKitTest::DbmsServicesKitTest()
+{}
+
+DbmsServicesKitTest::~DbmsServicesKitTest()
+{}
+
+void DbmsServicesKitTest::SetUpTestCase()
+{}
+
+void DbmsServicesKitTest::TearDownTestCase()
+{}
+
+void DbmsServicesKitTest::SetUp()
+{}
+
+void DbmsServicesKitTest::TearDown()
+{}
+
+std::string DbmsServicesKitTest::EncodeBase64(const std::string &data)
+{
+    std::unique_ptr<unsigned char[]> buffer = std::make_unique<unsigned char[]>(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        buffer[i] = static_cast<unsigned char>(data[i]);
+    }
+    std::unique_ptr<char[]> result = distributedBms_->EncodeBase64(buffer, static_cast<int>(data.size()));
+    return std::string(result.get());
+}
+
+std::shared_ptr<ImageBuffer> DbmsServicesKitTest::CreateImageBuffer(
+    uint32_t width, uint32_t height, int32_t components) const
+{
+    std::shared_ptr<ImageBuffer> imageBuffer = std::make_shared<ImageBuffer>();
+    imageBuffer->SetWidth(width);
+    imageBuffer->SetHeight(height);
+    imageBuffer->SetComponents(components);
+    imageBuffer->MallocImageMap(components);
+    ImageRow data = imageBuffer->GetImageDataPointer().get();
+    size_t size = static_cast<size_t>(width) * height * components;
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<ImageData>(i * PIXEL_STEP);
+    }
+    return imageBuffer;
+}
+
+RemoteAbilityInfoCache::Key DbmsServicesKitTest::GetCacheKey() const
+{
+    RemoteAbilityInfoCache::Key key;
+    key.bundleName = CACHE_BUNDLE_NAME;
+    key.moduleName = CACHE_MODULE_NAME;
+    key.abilityName = CACHE_ABILITY_NAME;
+    key.locale = CACHE_LOCALE;
+    key.versionCode = CACHE_VERSION_CODE;
+    key.updateTime = CACHE_UPDATE_TIME;
+    return key;
+}
+
+size_t DbmsServicesKitTest::CountEntries(const std::string &path) const
+{
+    size_t count = 0;
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        return count;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (std::string(entry->d_name) != "." && std::string(entry->d_name) != "..") {
+            ++count;
+        }
+    }
+    closedir(dir);
+    return count;
+}
+
+void DbmsServicesKitTest::StoreAbilityInfo(const std::string &bundleName, const std::string &abilityName)
+{
+    // the cached entries are hit by GetAbilityInfos, so the abilities need no resources
+    RemoteAbilityInfoCache::Key key = GetCacheKey();
+    key.bundleName = bundleName;
+    key.abilityName = abilityName;
+    key.locale.clear();
+    distributedBms_->abilityInfoCache_.Store(key, GetLabel(bundleName, abilityName), CACHE_ICON);
+}
+
+std::string DbmsServicesKitTest::GetLabel(const std::string &bundleName, const std::string &abilityName) const
+{
+    return bundleName + "/" + abilityName;
+}
+
+ImageData DbmsServicesKitTest::GetAveragePixel(const std::shared_ptr<ImageBuffer> &imageBuffer, uint32_t outWidth,
+    uint32_t outHeight, uint32_t w, uint32_t h, uint32_t c) const
+{
+    // the source pixels covered by the output pixel, at least one when the image is enlarged
+    uint32_t inWidth = imageBuffer->GetWidth();
+    uint32_t inHeight = imageBuffer->GetHeight();
+    uint32_t components = imageBuffer->GetComponents();
+    uint32_t left = w * inWidth / outWidth;
+    uint32_t right = std::max((w + 1) * inWidth / outWidth, left + 1);
+    uint32_t top = h * inHeight / outHeight;
+    uint32_t bottom = std::max((h + 1) * inHeight / outHeight, top + 1);
+    const ImageData *data = imageBuffer->GetImageDataPointer().get();
+    uint32_t sum = 0;
+    for (uint32_t y = top; y < bottom; ++y) {
+        for (uint32_t x = left; x < right; ++x) {
+            sum += data[(y * inWidth + x) * components + c];
+        }
+    }
+    uint32_t area = (right - left) * (bottom - top);
+    return static_cast<ImageData>((sum + area / 2) / area);
+}
+
+void DbmsServicesKitTest::CheckResizedImage(const std::shared_ptr<ImageBuffer> &imageBufferIn,
+    const std::shared_ptr<ImageBuffer> &imageBufferOut) const
+{
+    uint32_t outWidth = imageBufferOut->GetWidth();
+    uint32_t outHeight = imageBufferOut->GetHeight();
+    uint32_t components = imageBufferIn->GetComponents();
+    EXPECT_EQ(imageBufferOut->GetComponents(), components);
+    const ImageData *data = imageBufferOut->GetImageDataPointer().get();
+    ASSERT_NE(data, nullptr);
+    for (uint32_t h = 0; h < outHeight; ++h) {
+        for (uint32_t w = 0; w < outWidth; ++w) {
+            for (uint32_t c = 0; c < components; ++c) {
+                EXPECT_EQ(data[(h * outWidth + w) * components + c],
+                    GetAveragePixel(imageBufferIn, outWidth, outHeight, w, h, c)) << w << "," << h << "," << c;
+            }
+        }
+    }
+}
+
+/**
+ * @tc.number: EncodeBase64_0100
+ * @tc.name: test the EncodeBase64 function of DistributedBms
+ * @tc.desc: 1. encode data whose length is 0 mod 3
+ *           2. no padding is added
+ */
+HWTEST_F(DbmsServicesKitTest, EncodeBase64_0100, Function | SmallTest | Level0)
+{
+    EXPECT_EQ(EncodeBase64(""), "");
+    EXPECT_EQ(EncodeBase64("foo"), "Zm9v");
+    EXPECT_EQ(EncodeBase64("foobar"), "Zm9vYmFy");
+    EXPECT_EQ(EncodeBase64("\xfb\xff\xbf"), "+/+/");
+}
+
+/**
+ * @tc.number: EncodeBase64_0200
+ * @tc.name: test the EncodeBase64 function of DistributedBms
+ * @tc.desc: 1. encode data whose length is 1 mod 3
+ *           2. two padding characters are added
+ */
+HWTEST_F(DbmsServicesKitTest, EncodeBase64_0200, Function | SmallTest | Level0)
+{
+    EXPECT_EQ(EncodeBase64("f"), "Zg==");
+    EXPECT_EQ(EncodeBase64("foob"), "Zm9vYg==");
+    EXPECT_EQ(EncodeBase64("\xff"), "/w==");
+}
+
+/**
+ * @tc.number: EncodeBase64_0300
+ * @tc.name: test the EncodeBase64 function of DistributedBms
+ * @tc.desc: 1. encode data whose length is 2 mod 3
+ *           2. one padding character is added
+ */
+HWTEST_F(DbmsServicesKitTest, EncodeBase64_0300, Function | SmallTest | Level0)
+{
+    EXPECT_EQ(EncodeBase64("fo"), "Zm8=");
+    EXPECT_EQ(EncodeBase64("fooba"), "Zm9vYmE=");
+    EXPECT_EQ(EncodeBase64("\xff\xff"), "//8=");
+}
+
+/**
+ * @tc.number: ResizeImage_0100
+ * @tc.name: test the ResizeImage function of ImageCompress
+ * @tc.desc: 1. downscale a rgba image to half
+ *           2. every output pixel is the rounded average of the 2x2 source pixels it covers
+ */
+HWTEST_F(DbmsServicesKitTest, ResizeImage_0100, Function | SmallTest | Level0)
+{
+    ImageCompress imageCompress;
+    std::shared_ptr<ImageBuffer> imageBufferIn = CreateImageBuffer(IMAGE_WIDTH, IMAGE_HEIGHT, RGBA_COMPONENTS);
+    std::shared_ptr<ImageBuffer> imageBufferOut = std::make_shared<ImageBuffer>();
+    EXPECT_EQ(imageCompress.ResizeImage(imageBufferIn, imageBufferOut, HALF_RATIO), 0);
+    EXPECT_EQ(imageBufferOut->GetWidth(), IMAGE_WIDTH / SMALL_IMAGE_SIZE);
+    EXPECT_EQ(imageBufferOut->GetHeight(), IMAGE_HEIGHT / SMALL_IMAGE_SIZE);
+    CheckResizedImage(imageBufferIn, imageBufferOut);
+}
+
+/**
+ * @tc.number: ResizeImage_0200
+ * @tc.name: test the ResizeImage function of ImageCompress
+ * @tc.desc: 1. downscale a rgb image whose size is not a multiple of the output size
+ *           2. the output pixels cover source spans of different sizes
+ */
+HWTEST_F(DbmsServicesKitTest, ResizeImage_0200, Function | SmallTest | Level0)
+{
+    ImageCompress imageCompress;
+    std::shared_ptr<ImageBuffer> imageBufferIn =
+        CreateImageBuffer(UNEVEN_IMAGE_WIDTH, UNEVEN_IMAGE_HEIGHT, RGB_COMPONENTS);
+    std::shared_ptr<ImageBuffer> imageBufferOut = std::make_shared<ImageBuffer>();
+    EXPECT_EQ(imageCompress.ResizeImage(imageBufferIn, imageBufferOut, UNEVEN_RATIO), 0);
+    EXPECT_EQ(imageBufferOut->GetWidth(), static_cast<uint32_t>(UNEVEN_IMAGE_WIDTH * UNEVEN_RATIO));
+    EXPECT_EQ(imageBufferOut->GetHeight(), static_cast<uint32_t>(UNEVEN_IMAGE_HEIGHT * UNEVEN_RATIO));
+    CheckResizedImage(imageBufferIn, imageBufferOut);
+}
+
+/**
+ * @tc.number: ResizeImage_0300
+ * @tc.name: test the ResizeImage function of ImageCompress
+ * @tc.desc: 1. enlarge a rgba image
+ *           2. every output pixel is the source pixel it falls in
+ */
+HWTEST_F(DbmsServicesKitTest, ResizeImage_0300, Function | SmallTest | Level0)
+{
+    ImageCompress imageCompress;
+    std::shared_ptr<ImageBuffer> imageBufferIn =
+        CreateImageBuffer(SMALL_IMAGE_SIZE, SMALL_IMAGE_SIZE, RGBA_COMPONENTS);
+    std::shared_ptr<ImageBuffer> imageBufferOut = std::make_shared<ImageBuffer>();
+    EXPECT_EQ(imageCompress.ResizeImage(imageBufferIn, imageBufferOut, DOUBLE_RATIO), 0);
+    EXPECT_EQ(imageBufferOut->GetWidth(), SMALL_IMAGE_SIZE * SMALL_IMAGE_SIZE);
+    EXPECT_EQ(imageBufferOut->GetHeight(), SMALL_IMAGE_SIZE * SMALL_IMAGE_SIZE);
+    CheckResizedImage(imageBufferIn, imageBufferOut);
+}
+
+/**
+ * @tc.number: ResizeImage_0400
+ * @tc.name: test the ResizeImage function of ImageCompress
+ * @tc.desc: 1. the ratio is 0, or the image has an unsupported count of components
+ *           2. the resize fails
+ */
+HWTEST_F(DbmsServicesKitTest, ResizeImage_0400, Function | SmallTest | Level0)
+{
+    ImageCompress imageCompress;
+    std::shared_ptr<ImageBuffer> imageBufferIn = CreateImageBuffer(IMAGE_WIDTH, IMAGE_HEIGHT, RGB_COMPONENTS);
+    std::shared_ptr<ImageBuffer> imageBufferOut = std::make_shared<ImageBuffer>();
+    EXPECT_EQ(imageCompress.ResizeImage(imageBufferIn, imageBufferOut, 0.0), RESIZE_FAILED);
+
+    imageBufferIn = CreateImageBuffer(IMAGE_WIDTH, IMAGE_HEIGHT, INVALID_COMPONENTS);
+    EXPECT_EQ(imageCompress.ResizeImage(imageBufferIn, imageBufferOut, HALF_RATIO), RESIZE_FAILED);
+}
+
+/**
+ * @tc.number: RemoteAbilityInfoCache_0100
+ * @tc.name: test the Load and Store functions of RemoteAbilityInfoCache
+ * @tc.desc: 1. the stored label and icon are loaded by the same key
+ *           2. a key of another locale or ability is not loaded
+ */
+HWTEST_F(DbmsServicesKitTest, RemoteAbilityInfoCache_0100, Function | SmallTest | Level0)
+{
+    RemoteAbilityInfoCache cache;
+    cache.RemoveBundle(CACHE_BUNDLE_NAME);
+    RemoteAbilityInfoCache::Key key = GetCacheKey();
+    std::string label;
+    std::string icon;
+    EXPECT_FALSE(cache.Load(key, label, icon));
+    cache.Store(key, CACHE_LABEL, CACHE_ICON);
+    EXPECT_TRUE(cache.Load(key, label, icon));
+    EXPECT_EQ(label, CACHE_LABEL);
+    EXPECT_EQ(icon, CACHE_ICON);
+
+    RemoteAbilityInfoCache::Key otherKey = key;
+    otherKey.locale.clear();
+    EXPECT_FALSE(cache.Load(otherKey, label, icon));
+    otherKey = key;
+    otherKey.abilityName = CACHE_MODULE_NAME;
+    EXPECT_FALSE(cache.Load(otherKey, label, icon));
+    cache.RemoveBundle(CACHE_BUNDLE_NAME);
+}
+
+/**
+ * @tc.number: RemoteAbilityInfoCache_0200
+ * @tc.name: test the version prefix of RemoteAbilityInfoCache
+ * @tc.desc: 1. the file name starts with the version prefix
+ *           2. a new version code or update time changes the prefix
+ */
+HWTEST_F(DbmsServicesKitTest, RemoteAbilityInfoCache_0200, Function | SmallTest | Level0)
+{
+    RemoteAbilityInfoCache cache;
+    RemoteAbilityInfoCache::Key key = GetCacheKey();
+    std::string prefix = cache.GetVersionPrefix(key);
+    EXPECT_EQ(cache.GetFileName(key).compare(0, prefix.size(), prefix), 0);
+
+    RemoteAbilityInfoCache::Key newKey = key;
+    newKey.versionCode = CACHE_NEW_VERSION_CODE;
+    EXPECT_NE(cache.GetVersionPrefix(newKey), prefix);
+    newKey = key;
+    newKey.updateTime = CACHE_NEW_UPDATE_TIME;
+    EXPECT_NE(cache.GetVersionPrefix(newKey), prefix);
+    newKey = key;
+    newKey.locale.clear();
+    EXPECT_EQ(cache.GetVersionPrefix(newKey), prefix);
+    EXPECT_NE(cache.GetFileName(newKey), cache.GetFileName(key));
+}
+
+/**
+ * @tc.number: RemoteAbilityInfoCache_0300
+ * @tc.name: test the stale files of RemoteAbilityInfoCache
+ * @tc.desc: 1. an entry of a new version is stored
+ *           2. the entries of the former version are removed
+ */
+HWTEST_F(DbmsServicesKitTest, RemoteAbilityInfoCache_0300, Function | SmallTest | Level0)
+{
+    RemoteAbilityInfoCache cache;
+    cache.RemoveBundle(CACHE_BUNDLE_NAME);
+    RemoteAbilityInfoCache::Key key = GetCacheKey();
+    RemoteAbilityInfoCache::Key otherLocaleKey = key;
+    otherLocaleKey.locale.clear();
+    cache.Store(key, CACHE_LABEL, CACHE_ICON);
+    cache.Store(otherLocaleKey, CACHE_LABEL, CACHE_ICON);
+
+    RemoteAbilityInfoCache::Key newKey = key;
+    newKey.versionCode = CACHE_NEW_VERSION_CODE;
+    cache.Store(newKey, CACHE_NEW_LABEL, CACHE_ICON);
+    EXPECT_EQ(CountEntries(CACHE_BUNDLE_DIR), CACHE_FILE_COUNT_ONE);
+    std::string label;
+    std::string icon;
+    EXPECT_FALSE(cache.Load(key, label, icon));
+    EXPECT_FALSE(cache.Load(otherLocaleKey, label, icon));
+    EXPECT_TRUE(cache.Load(newKey, label, icon));
+    EXPECT_EQ(label, CACHE_NEW_LABEL);
+    cache.RemoveBundle(CACHE_BUNDLE_NAME);
+}
+
+/**
+ * @tc.number: RemoteAbilityInfoCache_0400
+ * @tc.name: test the RemoveBundle function of RemoteAbilityInfoCache
+ * @tc.desc: 1. the cached entries of a bundle are removed
+ *           2. the bundle dir is removed too
+ */
+HWTEST_F(DbmsServicesKitTest, RemoteAbilityInfoCache_0400, Function | SmallTest | Level0)
+{
+    RemoteAbilityInfoCache cache;
+    RemoteAbilityInfoCache::Key key = GetCacheKey();
+    cache.Store(key, CACHE_LABEL, CACHE_ICON);
+    cache.RemoveBundle(CACHE_BUNDLE_NAME);
+    std::string label;
+    std::string icon;
+    EXPECT_FALSE(cache.Load(key, label, icon));
+    EXPECT_NE(access(CACHE_BUNDLE_DIR.c_str(), F_OK), 0);
+}
+
+/**
+ * @tc.number: RemoteAbilityInfoCache_0500
+ * @tc.name: test the eviction of RemoteAbilityInfoCache
+ * @tc.desc: 1. more bundles than the limit are stored
+ *           2. the count of cached bundles is limited and the last stored one is kept
+ */
+HWTEST_F(DbmsServicesKitTest, RemoteAbilityInfoCache_0500, Function | SmallTest | Level0)
+{
+    RemoteAbilityInfoCache cache;
+    RemoteAbilityInfoCache::Key key = GetCacheKey();
+    for (size_t i = 0; i <= MAX_CACHED_BUNDLE_COUNT; ++i) {
+        key.bundleName = CACHE_BUNDLE_NAME + std::to_string(i);
+        cache.Store(key, CACHE_LABEL, CACHE_ICON);
+    }
+    EXPECT_LE(CountEntries(CACHE_DIR), MAX_CACHED_BUNDLE_COUNT);
+    std::string label;
+    std::string icon;
+    EXPECT_TRUE(cache.Load(key, label, icon));
+    for (size_t i = 0; i <= MAX_CACHED_BUNDLE_COUNT; ++i) {
+        cache.RemoveBundle(CACHE_BUNDLE_NAME + std::to_string(i));
+    }
+}
+
+/**
+ * @tc.number: GetAbilityInfos_0100
+ * @tc.name: test the GetAbilityInfos function of DistributedBms
+ * @tc.desc: 1. the elements of two bundles are interleaved
+ *           2. the infos are returned in the order of the elements
+ */
+HWTEST_F(DbmsServicesKitTest, GetAbilityInfos_0100, Function | SmallTest | Level0)
+{
+    StoreAbilityInfo(CACHE_BUNDLE_NAME, CACHE_ABILITY_NAME);
+    StoreAbilityInfo(CACHE_BUNDLE_NAME, OTHER_ABILITY_NAME);
+    StoreAbilityInfo(OTHER_BUNDLE_NAME, CACHE_ABILITY_NAME);
+    StoreAbilityInfo(OTHER_BUNDLE_NAME, OTHER_ABILITY_NAME);
+    AppExecFwk::bundleMgr_ = new MockBundleMgr();
+    std::vector<ElementName> elementNames = {
+        ElementName("", OTHER_BUNDLE_NAME, CACHE_ABILITY_NAME, CACHE_MODULE_NAME),
+        ElementName("", CACHE_BUNDLE_NAME, OTHER_ABILITY_NAME, CACHE_MODULE_NAME),
+        ElementName("", OTHER_BUNDLE_NAME, OTHER_ABILITY_NAME, CACHE_MODULE_NAME),
+        ElementName("", CACHE_BUNDLE_NAME, CACHE_ABILITY_NAME, CACHE_MODULE_NAME),
+    };
+    std::vector<RemoteAbilityInfo> remoteAbilityInfos;
+    EXPECT_EQ(distributedBms_->GetAbilityInfos(elementNames, remoteAbilityInfos), OHOS::NO_ERROR);
+    ASSERT_EQ(remoteAbilityInfos.size(), ELEMENT_COUNT);
+    for (size_t i = 0; i < ELEMENT_COUNT; ++i) {
+        EXPECT_EQ(remoteAbilityInfos[i].elementName.GetBundleName(), elementNames[i].GetBundleName());
+        EXPECT_EQ(remoteAbilityInfos[i].elementName.GetAbilityName(), elementNames[i].GetAbilityName());
+        EXPECT_EQ(remoteAbilityInfos[i].label,
+            GetLabel(elementNames[i].GetBundleName(), elementNames[i].GetAbilityName()));
+        EXPECT_EQ(remoteAbilityInfos[i].icon, CACHE_ICON);
+    }
+    AppExecFwk::bundleMgr_ = nullptr;
+    distributedBms_->abilityInfoCache_.RemoveBundle(CACHE_BUNDLE_NAME);
+    distributedBms_->abilityInfoCache_.RemoveBundle(OTHER_BUNDLE_NAME);
+}
+
+/**
+ * @tc.number: GetAbilityInfos_0200
+ * @tc.name: test the GetAbilityInfos function of DistributedBms
+ * @tc.desc: 1. an ability of a bundle and all the abilities of another bundle are not found
+ *           2. the failed elements are returned with the element name only, the others succeed
+ */
+HWTEST_F(DbmsServicesKitTest, GetAbilityInfos_0200, Function | SmallTest | Level0)
+{
+    StoreAbilityInfo(CACHE_BUNDLE_NAME, CACHE_ABILITY_NAME);
+    AppExecFwk::bundleMgr_ = new MockBundleMgr();
+    std::vector<ElementName> elementNames = {
+        ElementName("", CACHE_BUNDLE_NAME, MISSING_ABILITY_NAME, CACHE_MODULE_NAME),
+        ElementName("", MISSING_BUNDLE_NAME, CACHE_ABILITY_NAME, CACHE_MODULE_NAME),
+        ElementName("", CACHE_BUNDLE_NAME, CACHE_ABILITY_NAME, CACHE_MODULE_NAME),
+        ElementName("", MISSING_BUNDLE_NAME, OTHER_ABILITY_NAME, CACHE_MODULE_NAME),
+    };
+    std::vector<RemoteAbilityInfo> remoteAbilityInfos;
+    EXPECT_EQ(distributedBms_->GetAbilityInfos(elementNames, remoteAbilityInfos), OHOS::NO_ERROR);
+    ASSERT_EQ(remoteAbilityInfos.size(), ELEMENT_COUNT);
+    for (size_t i = 0; i < ELEMENT_COUNT; ++i) {
+        EXPECT_EQ(remoteAbilityInfos[i].elementName.GetBundleName(), elementNames[i].GetBundleName());
+        EXPECT_EQ(remoteAbilityInfos[i].elementName.GetAbilityName(), elementNames[i].GetAbilityName());
+        if (i == SUCCEEDED_ELEMENT_INDEX) {
+            EXPECT_EQ(remoteAbilityInfos[i].label, GetLabel(CACHE_BUNDLE_NAME, CACHE_ABILITY_NAME));
+            EXPECT_EQ(remoteAbilityInfos[i].icon, CACHE_ICON);
+        } else {
+            // a failed element is marked by the empty label and icon
+            EXPECT_TRUE(remoteAbilityInfos[i].label.empty());
+            EXPECT_TRUE(remoteAbilityInfos[i].icon.empty());
+        }
+    }
+    AppExecFwk::bundleMgr_ = nullptr;
+    distributedBms_->abilityInfoCache_.RemoveBundle(CACHE_BUNDLE_NAME);
+}
+
+/**
+ * @tc.number: GetAbilityInfos_0300
+ * @tc.name: test the GetAbilityInfos function of DistributedBms
+ * @tc.desc: 1. all the elements fail
+ *           2. the error of the first failed element is returned and no info is added
+ */
+HWTEST_F(DbmsServicesKitTest, GetAbilityInfos_0300, Function | SmallTest | Level0)
+{
+    AppExecFwk::bundleMgr_ = new MockBundleMgr();
+    std::vector<ElementName> elementNames = {
+        ElementName("", MISSING_BUNDLE_NAME, CACHE_ABILITY_NAME, CACHE_MODULE_NAME),
+        ElementName("", CACHE_BUNDLE_NAME, MISSING_ABILITY_NAME, CACHE_MODULE_NAME),
+    };
+    std::vector<RemoteAbilityInfo> remoteAbilityInfos;
+    EXPECT_EQ(distributedBms_->GetAbilityInfos(elementNames, remoteAbilityInfos),
+        ERR_APPEXECFWK_FAILED_GET_BUNDLE_INFO);
+    EXPECT_TRUE(remoteAbilityInfos.empty());
+    AppExecFwk::bundleMgr_ = nullptr;
+}
+}  // namespace OHOS
\ No newline at end of file
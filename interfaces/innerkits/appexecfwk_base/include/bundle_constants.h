@@ -48,6 +48,9 @@ const std::string THIRD_SYSTEM_APP_INSTALL_PATH = "/data/accounts";
 const std::string THIRD_PARTY_APP_INSTALL_PATH = "/data/accounts";
 const std::string EXTRACT_TMP_PATH = "/data/sadata/install_tmp/bundle_haps";
 const std::string HAP_COPY_PATH = "/data/sadata/install_tmp/Tmp_";
+const std::string STREAM_INSTALL_PATH = "/data/sadata/install_tmp/stream_install";
+// the max time in milliseconds to wait for the next data of a stream install
+const int32_t STREAM_IDLE_TIMEOUT_MS = 10000;
 const std::string USER_ACCOUNT_DIR = "account";
 const std::string APP_CODE_DIR = "applications";
 const std::string APP_DATA_DIR = "appdata";
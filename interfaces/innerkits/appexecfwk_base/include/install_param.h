@@ -49,6 +49,8 @@ struct InstallParam : public Parcelable {
     // OTA upgrade skips the killing process
     bool noSkipsKill  = true;
     bool needSendEvent = true;
+    // the data dirs of the bundle were created for the user in advance, used when creating a new user.
+    bool isDataDirCreated = false;
 
     // the parcel object function is not const.
     bool ReadFromParcel(Parcel &parcel);
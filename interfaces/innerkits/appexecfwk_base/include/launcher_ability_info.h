@@ -17,6 +17,7 @@
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_LAUNCHER_ABILITYINFO_H
 
 #include <string>
+#include <vector>
 
 #include "application_info.h"
 #include "element_name.h"
@@ -32,6 +33,15 @@ public:
     int32_t userId;
     int64_t installTime;
 };
+
+struct LauncherAbilityDelta {
+public:
+    uint64_t version = 0; // version of the launcher snapshot the delta leads to
+    bool isFullSnapshot = false; // the requested version is too old, added holds all launcher abilities
+    std::vector<LauncherAbilityInfo> added;
+    std::vector<LauncherAbilityInfo> changed;
+    std::vector<LauncherAbilityInfo> removed;
+};
 }  // namespace AppExecFwk
 }  // namespace OHOS
 #endif  // FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_LAUNCHER_ABILITYINFO_H
\ No newline at end of file
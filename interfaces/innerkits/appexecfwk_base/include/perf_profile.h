@@ -51,6 +51,19 @@ public:
     int64_t GetBundleInstallEndTime() const;
     void SetBundleInstallEndTime(int64_t time);
 
+    // the stages of installation, accumulated like the total install time
+    int64_t GetBundleSysCapCheckTime() const;
+    void AddBundleSysCapCheckTime(int64_t time);
+
+    int64_t GetBundleSignatureVerifyTime() const;
+    void AddBundleSignatureVerifyTime(int64_t time);
+
+    int64_t GetBundleHapParseTime() const;
+    void AddBundleHapParseTime(int64_t time);
+
+    int64_t GetBundleModuleExtractTime() const;
+    void AddBundleModuleExtractTime(int64_t time);
+
     int64_t GetBundleUninstallStartTime() const;
     void SetBundleUninstallStartTime(int64_t time);
 
@@ -101,6 +114,10 @@ private:
     int64_t bundleInstallStart_ = 0;
     int64_t bundleInstallEnd_ = 0;
     int64_t bundleInstallTime_ = 0;
+    int64_t bundleSysCapCheckTime_ = 0;
+    int64_t bundleSignatureVerifyTime_ = 0;
+    int64_t bundleHapParseTime_ = 0;
+    int64_t bundleModuleExtractTime_ = 0;
 
     int64_t bundleUninstallStart_ = 0;
     int64_t bundleUninstallEnd_ = 0;
@@ -120,6 +120,46 @@ int64_t PerfProfile::GetBundleTotalInstallTime() const
     return bundleInstallTime_;
 }
 
+int64_t PerfProfile::GetBundleSysCapCheckTime() const
+{
+    return bundleSysCapCheckTime_;
+}
+
+void PerfProfile::AddBundleSysCapCheckTime(int64_t time)
+{
+    bundleSysCapCheckTime_ += (time > 0) ? time : 0;
+}
+
+int64_t PerfProfile::GetBundleSignatureVerifyTime() const
+{
+    return bundleSignatureVerifyTime_;
+}
+
+void PerfProfile::AddBundleSignatureVerifyTime(int64_t time)
+{
+    bundleSignatureVerifyTime_ += (time > 0) ? time : 0;
+}
+
+int64_t PerfProfile::GetBundleHapParseTime() const
+{
+    return bundleHapParseTime_;
+}
+
+void PerfProfile::AddBundleHapParseTime(int64_t time)
+{
+    bundleHapParseTime_ += (time > 0) ? time : 0;
+}
+
+int64_t PerfProfile::GetBundleModuleExtractTime() const
+{
+    return bundleModuleExtractTime_;
+}
+
+void PerfProfile::AddBundleModuleExtractTime(int64_t time)
+{
+    bundleModuleExtractTime_ += (time > 0) ? time : 0;
+}
+
 int64_t PerfProfile::GetBundleUninstallStartTime() const
 {
     return bundleUninstallStart_;
@@ -244,6 +284,10 @@ void PerfProfile::Reset()
     bundleInstallStart_ = 0;
     bundleInstallEnd_ = 0;
     bundleInstallTime_ = 0;
+    bundleSysCapCheckTime_ = 0;
+    bundleSignatureVerifyTime_ = 0;
+    bundleHapParseTime_ = 0;
+    bundleModuleExtractTime_ = 0;
 
     bundleUninstallStart_ = 0;
     bundleUninstallEnd_ = 0;
@@ -285,6 +329,10 @@ void PerfProfile::Dump() const
         }
         if (bundleInstallTime_ > 0) {
             APP_LOGI("BundleInstallTime: %{public}" PRId64 "(ms) \n", bundleInstallTime_);
+            APP_LOGI("    SysCapCheckTime: %{public}" PRId64 "(ms) \n", bundleSysCapCheckTime_);
+            APP_LOGI("    SignatureVerifyTime: %{public}" PRId64 "(ms) \n", bundleSignatureVerifyTime_);
+            APP_LOGI("    HapParseTime: %{public}" PRId64 "(ms) \n", bundleHapParseTime_);
+            APP_LOGI("    ModuleExtractTime: %{public}" PRId64 "(ms) \n", bundleModuleExtractTime_);
         }
         if (bundleUninstallEnd_ > bundleUninstallStart_) {
             APP_LOGI("BundleUninstallTime: %{public}" PRId64 "(ms) \n", (bundleUninstallEnd_ - bundleUninstallStart_));
@@ -59,6 +59,22 @@ public:
     virtual bool Install(const std::vector<std::string> &bundleFilePaths, const InstallParam &installParam,
         const sptr<IStatusReceiver> &statusReceiver) = 0;
 
+    /**
+     * @brief Installs an application from a stream, the final result will be notified from the statusReceiver object.
+     * @attention Notice that the HAP is received while the caller is still writing it, so the caller can pass the
+     *            read end of a pipe and write the HAP as it is downloaded, without storing it to a file first.
+     * @param streamFd Indicates the readable file descriptor the ohos Ability Package (HAP) is read from until
+     *                 the end of file.
+     * @param installParam Indicates the install parameters.
+     * @param statusReceiver Indicates the callback object that using for notifing the install result.
+     * @return Returns true if this function is successfully called; returns false otherwise.
+     */
+    virtual bool StreamInstall(int32_t streamFd, const InstallParam &installParam,
+        const sptr<IStatusReceiver> &statusReceiver)
+    {
+        return false;
+    }
+
     /**
      * @brief Uninstalls an application, the result will be notified from the statusReceiver object.
      * @param bundleName Indicates the bundle name of the application to uninstall.
@@ -118,6 +134,7 @@ public:
         RECOVER,
         INSTALL_SANDBOX_APP,
         UNINSTALL_SANDBOX_APP,
+        STREAM_INSTALL,
     };
 };
 
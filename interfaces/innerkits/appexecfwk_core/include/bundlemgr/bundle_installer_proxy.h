@@ -58,6 +58,16 @@ public:
      */
     virtual bool Install(const std::vector<std::string> &bundleFilePaths, const InstallParam &installParam,
         const sptr<IStatusReceiver> &statusReceiver) override;
+    /**
+     * @brief Installs an application from a stream through the proxy object.
+     * @param streamFd Indicates the readable file descriptor the HAP is read from until the end of file,
+     *                 it is still owned by the caller.
+     * @param installParam Indicates the install parameters.
+     * @param statusReceiver Indicates the callback object that using for notifing the install result.
+     * @return Returns true if this function is successfully called; returns false otherwise.
+     */
+    virtual bool StreamInstall(int32_t streamFd, const InstallParam &installParam,
+        const sptr<IStatusReceiver> &statusReceiver) override;
     /**
      * @brief Uninstalls an application through the proxy object.
      * @param bundleName Indicates the bundle name of the application to uninstall.
@@ -16,6 +16,9 @@
 #ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_MONITOR_H
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_MONITOR_H
 
+#include <functional>
+#include <mutex>
+
 #include "common_event_manager.h"
 #include "common_event_support.h"
 #include "common_event_subscriber.h"
@@ -29,6 +32,7 @@ namespace AppExecFwk {
 class BundleMonitor : public EventFwk::CommonEventSubscriber, public std::enable_shared_from_this<BundleMonitor> {
 public:
     using Want = OHOS::AAFwk::Want;
+    using EventListener = std::function<void(const std::string &action, const std::string &bundleName, int userId)>;
 
     explicit BundleMonitor(const EventFwk::CommonEventSubscribeInfo &subscribeInfo);
     ~BundleMonitor() = default;
@@ -44,6 +48,12 @@ public:
      * @return Returns true if this function is successfully called; returns false otherwise.
      */
     bool UnSubscribe();
+    /**
+     * @brief Subscribe commonEvent for an in-process listener, independently of the registered callback.
+     * @param listener The listener called with the action, bundle name and user id of every received event.
+     * @return Returns true if this function is successfully called; returns false otherwise.
+     */
+    bool SubscribeListener(const EventListener &listener);
     /**
      * @brief CommonEvent callback.
      * @param eventData publish common event data.
@@ -52,7 +62,12 @@ public:
     void OnReceiveEvent(const EventFwk::CommonEventData &eventData);
 
 private:
+    bool SubscribeCommonEvent();
+
+    std::mutex subscribeMutex_;
+    bool isSubscribed_ = false;
     sptr<IBundleStatusCallback> callback_ = nullptr;
+    EventListener listener_ = nullptr;
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
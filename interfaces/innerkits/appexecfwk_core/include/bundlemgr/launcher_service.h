@@ -16,6 +16,10 @@
 #ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_LAUNCHER_SERVICE_H
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_LAUNCHER_SERVICE_H
 
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -107,12 +111,73 @@ public:
      * @return Returns true if the function is successfully called; returns false otherwise.
      */
     virtual bool GetAllLauncherAbilityInfos(int32_t userId, std::vector<LauncherAbilityInfo> &launcherAbilityInfos);
+    /**
+     * @brief Obtains a versioned snapshot of the launcher abilities of all application that appears on launcher.
+     *        Later snapshots only query the bundles changed since, so they cost O(changes).
+     * @param userId Indicates the id for the user.
+     * @param version Indicates the version of the obtained snapshot.
+     * @param launcherAbilityInfos Indicates the obtained LauncherAbilityInfo objects.
+     * @return Returns true if the function is successfully called; returns false otherwise.
+     */
+    virtual bool GetLauncherAbilitySnapshot(
+        int32_t userId, uint64_t &version, std::vector<LauncherAbilityInfo> &launcherAbilityInfos);
+    /**
+     * @brief Obtains the launcher abilities added, changed and removed since a snapshot version.
+     * @param userId Indicates the id for the user.
+     * @param sinceVersion Indicates the snapshot version the caller holds, 0 if it holds none.
+     * @param delta Indicates the obtained changes, or a full snapshot if sinceVersion is no longer tracked.
+     * @return Returns true if the function is successfully called; returns false otherwise.
+     */
+    virtual bool GetLauncherAbilityDelta(int32_t userId, uint64_t sinceVersion, LauncherAbilityDelta &delta);
 
 private:
+    enum class LauncherChangeType {
+        ADDED,
+        CHANGED,
+        REMOVED,
+    };
+
+    struct LauncherChange {
+        uint64_t version = 0;
+        LauncherChangeType type = LauncherChangeType::ADDED;
+        LauncherAbilityInfo info;
+    };
+
+    struct LauncherSnapshot {
+        bool isLoaded = false;
+        uint64_t version = 0;
+        // deltas from versions older than this one are no longer in changes
+        uint64_t oldestDeltaVersion = 0;
+        // key:bundleName, value:launcher abilities of the bundle
+        std::map<std::string, std::vector<LauncherAbilityInfo>> bundleAbilities;
+        // ordered by version
+        std::deque<LauncherChange> changes;
+    };
+
+    // filled by the bundle monitor thread, drained when a snapshot is refreshed
+    struct ChangedBundles {
+        std::mutex mutex;
+        bool isListening = false;
+        std::set<int32_t> userIds;
+        // key:userId, value:names of the bundles changed since the last refresh
+        std::map<int32_t, std::set<std::string>> bundleNames;
+    };
+
     void init();
     static OHOS::sptr<OHOS::AppExecFwk::IBundleMgr> GetBundleMgr();
+    bool QueryLauncherAbilityInfos(const sptr<IBundleMgr> &iBundleMgr, const std::string &bundleName,
+        int32_t userId, std::vector<LauncherAbilityInfo> &launcherAbilityInfos);
+    bool StartListening(int32_t userId);
+    bool RefreshSnapshot(int32_t userId, LauncherSnapshot &snapshot);
+    bool ApplyBundleAbilities(const std::string &bundleName,
+        std::vector<LauncherAbilityInfo> &launcherAbilityInfos, LauncherSnapshot &snapshot);
+    void CollectDelta(const LauncherSnapshot &snapshot, uint64_t sinceVersion, LauncherAbilityDelta &delta);
 
     std::shared_ptr<BundleMonitor> bundleMonitor_ = nullptr;
+    std::mutex snapshotMutex_;
+    // key:userId
+    std::map<int32_t, LauncherSnapshot> snapshots_;
+    std::shared_ptr<ChangedBundles> changedBundles_ = std::make_shared<ChangedBundles>();
     static OHOS::sptr<OHOS::AppExecFwk::IBundleMgr> bundleMgr_;
     static std::mutex bundleMgrMutex_;
     DISALLOW_COPY_AND_MOVE(LauncherService);
@@ -88,6 +88,30 @@ bool BundleInstallerProxy::Install(const std::vector<std::string> &bundleFilePat
         option);
 }
 
+bool BundleInstallerProxy::StreamInstall(int32_t streamFd, const InstallParam &installParam,
+    const sptr<IStatusReceiver> &statusReceiver)
+{
+    BYTRACE_NAME(BYTRACE_TAG_APP, __PRETTY_FUNCTION__);
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_SYNC);
+
+    PARCEL_WRITE_INTERFACE_TOKEN(data, GetDescriptor());
+    PARCEL_WRITE(data, FileDescriptor, streamFd);
+    PARCEL_WRITE(data, Parcelable, &installParam);
+
+    if (!statusReceiver) {
+        APP_LOGE("fail to install, for statusReceiver is nullptr");
+        return false;
+    }
+    if (!data.WriteObject<IRemoteObject>(statusReceiver->AsObject())) {
+        APP_LOGE("write parcel failed");
+        return false;
+    }
+
+    return SendInstallRequest(IBundleInstaller::Message::STREAM_INSTALL, data, reply, option);
+}
+
 bool BundleInstallerProxy::Recover(const std::string &bundleName,
     const InstallParam &installParam, const sptr<IStatusReceiver> &statusReceiver)
 {
@@ -26,22 +26,46 @@ BundleMonitor::BundleMonitor(const EventFwk::CommonEventSubscribeInfo &subscribe
 bool BundleMonitor::Subscribe(const sptr<IBundleStatusCallback> &callback)
 {
     APP_LOGI("Subscribe called");
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
     callback_ = callback;
+    return SubscribeCommonEvent();
+}
 
+bool BundleMonitor::SubscribeListener(const EventListener &listener)
+{
+    APP_LOGI("SubscribeListener called");
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    listener_ = listener;
+    return SubscribeCommonEvent();
+}
+
+bool BundleMonitor::SubscribeCommonEvent()
+{
+    if (isSubscribed_) {
+        return true;
+    }
     if (EventFwk::CommonEventManager::SubscribeCommonEvent(shared_from_this()) != true) {
         APP_LOGE("SubscribeCommonEvent occur exception.");
         return false;
     }
+    isSubscribed_ = true;
     return true;
 }
 
 bool BundleMonitor::UnSubscribe()
 {
     APP_LOGI("unsubscribe called");
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    // the in-process listener still needs the events
+    if (listener_ != nullptr) {
+        callback_ = nullptr;
+        return true;
+    }
     if (EventFwk::CommonEventManager::UnSubscribeCommonEvent(shared_from_this()) != true) {
         APP_LOGE("UnsubscribeCommonEvent occur exception.");
         return false;
     }
+    isSubscribed_ = false;
     callback_ = nullptr;
     return true;
 }
@@ -55,12 +79,22 @@ void BundleMonitor::OnReceiveEvent(const EventFwk::CommonEventData &eventData)
     int userId = want.GetIntParam(Constants::USER_ID, Constants::INVALID_USERID);
     APP_LOGI("OnReceiveEvent action = %{public}s, bundle = %{public}s, userId = %{public}d",
         action.c_str(), bundleName.c_str(), userId);
-    if ((action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_ADDED) && (callback_ != nullptr)) {
-        callback_->OnBundleAdded(bundleName, userId);
-    } else if ((action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_CHANGED) && (callback_ != nullptr)) {
-        callback_->OnBundleUpdated(bundleName, userId);
-    } else if ((action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED) && (callback_ != nullptr)) {
-        callback_->OnBundleRemoved(bundleName, userId);
+    EventListener listener;
+    sptr<IBundleStatusCallback> callback;
+    {
+        std::lock_guard<std::mutex> lock(subscribeMutex_);
+        listener = listener_;
+        callback = callback_;
+    }
+    if (listener != nullptr) {
+        listener(action, bundleName, userId);
+    }
+    if ((action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_ADDED) && (callback != nullptr)) {
+        callback->OnBundleAdded(bundleName, userId);
+    } else if ((action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_CHANGED) && (callback != nullptr)) {
+        callback->OnBundleUpdated(bundleName, userId);
+    } else if ((action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED) && (callback != nullptr)) {
+        callback->OnBundleRemoved(bundleName, userId);
     } else {
         APP_LOGI("OnReceiveEvent action = %{public}s not support", action.c_str());
     }
@@ -15,6 +15,8 @@
 
 #include "launcher_service.h"
 
+#include <cinttypes>
+
 #include "bundle_mgr_proxy.h"
 #include "common_event_subscribe_info.h"
 #include "common_event_support.h"
@@ -23,6 +25,28 @@
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+const size_t MAX_LAUNCHER_CHANGES = 1000;
+
+std::string GetLauncherAbilityKey(const LauncherAbilityInfo &info)
+{
+    return info.elementName.GetBundleName() + Constants::PATH_SEPARATOR + info.elementName.GetModuleName() +
+        Constants::PATH_SEPARATOR + info.elementName.GetAbilityName();
+}
+
+bool IsSameLauncherAbility(const LauncherAbilityInfo &first, const LauncherAbilityInfo &second)
+{
+    return first.labelId == second.labelId && first.iconId == second.iconId &&
+        first.installTime == second.installTime &&
+        first.applicationInfo.versionCode == second.applicationInfo.versionCode &&
+        first.applicationInfo.label == second.applicationInfo.label &&
+        first.applicationInfo.labelId == second.applicationInfo.labelId &&
+        first.applicationInfo.iconPath == second.applicationInfo.iconPath &&
+        first.applicationInfo.iconId == second.applicationInfo.iconId &&
+        first.applicationInfo.enabled == second.applicationInfo.enabled;
+}
+}  // namespace
+
 OHOS::sptr<OHOS::AppExecFwk::IBundleMgr> LauncherService::bundleMgr_ = nullptr;
 std::mutex LauncherService::bundleMgrMutex_;
 
@@ -167,10 +191,20 @@ bool LauncherService::GetAllLauncherAbilityInfos(int32_t userId, std::vector<Lau
         APP_LOGE("can not get iBundleMgr");
         return false;
     }
+    return QueryLauncherAbilityInfos(iBundleMgr, Constants::EMPTY_STRING, userId, launcherAbilityInfos);
+}
 
+bool LauncherService::QueryLauncherAbilityInfos(const sptr<IBundleMgr> &iBundleMgr, const std::string &bundleName,
+    int32_t userId, std::vector<LauncherAbilityInfo> &launcherAbilityInfos)
+{
     Want want;
     want.SetAction(Want::ACTION_HOME);
     want.AddEntity(Want::ENTITY_HOME);
+    if (!bundleName.empty()) {
+        ElementName elementName;
+        elementName.SetBundleName(bundleName);
+        want.SetElement(elementName);
+    }
 
     std::vector<AbilityInfo> abilityInfos;
     if (!iBundleMgr->QueryAllAbilityInfos(want, userId, abilityInfos)) {
@@ -178,18 +212,27 @@ bool LauncherService::GetAllLauncherAbilityInfos(int32_t userId, std::vector<Lau
         return false;
     }
 
+    // key:bundleName, value:installTime, so that each bundle info is queried once
+    std::map<std::string, int64_t> installTimes;
     for (const auto& ability : abilityInfos) {
         if (ability.applicationInfo.isLauncherApp || !ability.enabled) {
             continue;
         }
-        LauncherAbilityInfo info;
-        BundleInfo bundleInfo;
-        BundleFlag flags = BundleFlag::GET_BUNDLE_DEFAULT;
-        if (!iBundleMgr->GetBundleInfo(ability.bundleName, flags, bundleInfo, userId)) {
-            APP_LOGE("Get bundle info failed for %{public}s",  ability.bundleName.c_str());
+        if (!bundleName.empty() && ability.bundleName != bundleName) {
             continue;
         }
-        info.installTime = bundleInfo.installTime;
+        auto installTimeItem = installTimes.find(ability.bundleName);
+        if (installTimeItem == installTimes.end()) {
+            BundleInfo bundleInfo;
+            BundleFlag flags = BundleFlag::GET_BUNDLE_DEFAULT;
+            if (!iBundleMgr->GetBundleInfo(ability.bundleName, flags, bundleInfo, userId)) {
+                APP_LOGE("Get bundle info failed for %{public}s",  ability.bundleName.c_str());
+                continue;
+            }
+            installTimeItem = installTimes.emplace(ability.bundleName, bundleInfo.installTime).first;
+        }
+        LauncherAbilityInfo info;
+        info.installTime = installTimeItem->second;
         info.applicationInfo = ability.applicationInfo;
         info.labelId = ability.labelId;
         info.iconId = ability.iconId;
@@ -205,6 +248,215 @@ bool LauncherService::GetAllLauncherAbilityInfos(int32_t userId, std::vector<Lau
     return true;
 }
 
+bool LauncherService::GetLauncherAbilitySnapshot(
+    int32_t userId, uint64_t &version, std::vector<LauncherAbilityInfo> &launcherAbilityInfos)
+{
+    APP_LOGD("GetLauncherAbilitySnapshot called");
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    LauncherSnapshot &snapshot = snapshots_[userId];
+    if (!RefreshSnapshot(userId, snapshot)) {
+        APP_LOGE("refresh launcher snapshot failed");
+        return false;
+    }
+    version = snapshot.version;
+    for (const auto &item : snapshot.bundleAbilities) {
+        launcherAbilityInfos.insert(launcherAbilityInfos.end(), item.second.begin(), item.second.end());
+    }
+    return true;
+}
+
+bool LauncherService::GetLauncherAbilityDelta(int32_t userId, uint64_t sinceVersion, LauncherAbilityDelta &delta)
+{
+    APP_LOGD("GetLauncherAbilityDelta called, sinceVersion %{public}" PRIu64, sinceVersion);
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    LauncherSnapshot &snapshot = snapshots_[userId];
+    if (!RefreshSnapshot(userId, snapshot)) {
+        APP_LOGE("refresh launcher snapshot failed");
+        return false;
+    }
+    CollectDelta(snapshot, sinceVersion, delta);
+    return true;
+}
+
+bool LauncherService::StartListening(int32_t userId)
+{
+    std::lock_guard<std::mutex> lock(changedBundles_->mutex);
+    changedBundles_->userIds.insert(userId);
+    if (changedBundles_->isListening || bundleMonitor_ == nullptr) {
+        return changedBundles_->isListening;
+    }
+    // the listener may outlive this service, so it only holds the shared change set
+    auto changedBundles = changedBundles_;
+    changedBundles_->isListening = bundleMonitor_->SubscribeListener(
+        [changedBundles](const std::string &action, const std::string &bundleName, int eventUserId) {
+            if (bundleName.empty()) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(changedBundles->mutex);
+            for (int32_t snapshotUserId : changedBundles->userIds) {
+                if (eventUserId == Constants::INVALID_USERID || eventUserId == snapshotUserId) {
+                    changedBundles->bundleNames[snapshotUserId].insert(bundleName);
+                }
+            }
+        });
+    return changedBundles_->isListening;
+}
+
+bool LauncherService::RefreshSnapshot(int32_t userId, LauncherSnapshot &snapshot)
+{
+    auto iBundleMgr = GetBundleMgr();
+    if (!iBundleMgr) {
+        APP_LOGE("can not get iBundleMgr");
+        return false;
+    }
+    // listen before querying, so that no change made during the query is missed
+    bool isListening = StartListening(userId);
+    std::set<std::string> bundleNames;
+    {
+        std::lock_guard<std::mutex> lock(changedBundles_->mutex);
+        bundleNames.swap(changedBundles_->bundleNames[userId]);
+    }
+    bool isFullQuery = !snapshot.isLoaded || !isListening;
+    std::map<std::string, std::vector<LauncherAbilityInfo>> bundleAbilities;
+    if (!isFullQuery) {
+        for (const auto &bundleName : bundleNames) {
+            // the query of an uninstalled bundle fails as well as a failed ipc, so only the full query can tell
+            // whether the bundle is removed
+            std::vector<LauncherAbilityInfo> launcherAbilityInfos;
+            if (!QueryLauncherAbilityInfos(iBundleMgr, bundleName, userId, launcherAbilityInfos)) {
+                APP_LOGD("query of %{public}s failed, query all the bundles instead", bundleName.c_str());
+                isFullQuery = true;
+                break;
+            }
+            bundleAbilities.emplace(bundleName, std::move(launcherAbilityInfos));
+        }
+    }
+    if (isFullQuery) {
+        bundleAbilities.clear();
+        std::vector<LauncherAbilityInfo> launcherAbilityInfos;
+        if (!QueryLauncherAbilityInfos(iBundleMgr, Constants::EMPTY_STRING, userId, launcherAbilityInfos)) {
+            // keep the changed bundles for the next refresh
+            std::lock_guard<std::mutex> lock(changedBundles_->mutex);
+            changedBundles_->bundleNames[userId].insert(bundleNames.begin(), bundleNames.end());
+            return false;
+        }
+        for (auto &info : launcherAbilityInfos) {
+            bundleAbilities[info.elementName.GetBundleName()].emplace_back(info);
+        }
+        for (const auto &item : snapshot.bundleAbilities) {
+            bundleAbilities.emplace(item.first, std::vector<LauncherAbilityInfo>());
+        }
+    }
+    bool isChanged = false;
+    for (auto &item : bundleAbilities) {
+        isChanged = ApplyBundleAbilities(item.first, item.second, snapshot) || isChanged;
+    }
+    if (isChanged || !snapshot.isLoaded) {
+        snapshot.version++;
+    }
+    if (!snapshot.isLoaded) {
+        // the first snapshot is only served as a whole
+        snapshot.changes.clear();
+        snapshot.oldestDeltaVersion = snapshot.version;
+        snapshot.isLoaded = true;
+    }
+    return true;
+}
+
+bool LauncherService::ApplyBundleAbilities(const std::string &bundleName,
+    std::vector<LauncherAbilityInfo> &launcherAbilityInfos, LauncherSnapshot &snapshot)
+{
+    uint64_t version = snapshot.version + 1;
+    std::map<std::string, const LauncherAbilityInfo *> oldInfos;
+    auto bundleItem = snapshot.bundleAbilities.find(bundleName);
+    if (bundleItem != snapshot.bundleAbilities.end()) {
+        for (const auto &info : bundleItem->second) {
+            oldInfos.emplace(GetLauncherAbilityKey(info), &info);
+        }
+    }
+
+    size_t changeCount = snapshot.changes.size();
+    for (const auto &info : launcherAbilityInfos) {
+        auto oldItem = oldInfos.find(GetLauncherAbilityKey(info));
+        if (oldItem == oldInfos.end()) {
+            snapshot.changes.push_back({ version, LauncherChangeType::ADDED, info });
+            continue;
+        }
+        if (!IsSameLauncherAbility(*oldItem->second, info)) {
+            snapshot.changes.push_back({ version, LauncherChangeType::CHANGED, info });
+        }
+        oldInfos.erase(oldItem);
+    }
+    for (const auto &item : oldInfos) {
+        snapshot.changes.push_back({ version, LauncherChangeType::REMOVED, *item.second });
+    }
+    bool isChanged = snapshot.changes.size() != changeCount;
+    if (launcherAbilityInfos.empty()) {
+        snapshot.bundleAbilities.erase(bundleName);
+    } else {
+        snapshot.bundleAbilities[bundleName] = std::move(launcherAbilityInfos);
+    }
+    while (snapshot.changes.size() > MAX_LAUNCHER_CHANGES) {
+        snapshot.oldestDeltaVersion = snapshot.changes.front().version;
+        snapshot.changes.pop_front();
+    }
+    return isChanged;
+}
+
+void LauncherService::CollectDelta(const LauncherSnapshot &snapshot, uint64_t sinceVersion, LauncherAbilityDelta &delta)
+{
+    delta = LauncherAbilityDelta();
+    delta.version = snapshot.version;
+    if (sinceVersion < snapshot.oldestDeltaVersion || sinceVersion > snapshot.version) {
+        delta.isFullSnapshot = true;
+        for (const auto &item : snapshot.bundleAbilities) {
+            delta.added.insert(delta.added.end(), item.second.begin(), item.second.end());
+        }
+        return;
+    }
+
+    // fold the changes of each ability into the one the caller has to apply
+    std::map<std::string, LauncherChange> foldedChanges;
+    for (const auto &change : snapshot.changes) {
+        if (change.version <= sinceVersion) {
+            continue;
+        }
+        std::string key = GetLauncherAbilityKey(change.info);
+        auto item = foldedChanges.find(key);
+        if (item == foldedChanges.end()) {
+            foldedChanges.emplace(key, change);
+            continue;
+        }
+        LauncherChangeType previousType = item->second.type;
+        item->second.info = change.info;
+        if (change.type == LauncherChangeType::ADDED) {
+            item->second.type = (previousType == LauncherChangeType::REMOVED) ?
+                LauncherChangeType::CHANGED : LauncherChangeType::ADDED;
+        } else if (change.type == LauncherChangeType::CHANGED) {
+            item->second.type = (previousType == LauncherChangeType::ADDED) ?
+                LauncherChangeType::ADDED : LauncherChangeType::CHANGED;
+        } else if (previousType == LauncherChangeType::ADDED) {
+            foldedChanges.erase(item);
+        } else {
+            item->second.type = LauncherChangeType::REMOVED;
+        }
+    }
+
+    for (const auto &item : foldedChanges) {
+        switch (item.second.type) {
+            case LauncherChangeType::ADDED:
+                delta.added.emplace_back(item.second.info);
+                break;
+            case LauncherChangeType::CHANGED:
+                delta.changed.emplace_back(item.second.info);
+                break;
+            default:
+                delta.removed.emplace_back(item.second.info);
+                break;
+        }
+    }
+}
+
 bool LauncherService::GetAbilityInfo(const Want &want, const int userId, LauncherAbilityInfo &launcherAbilityInfo)
 {
     APP_LOGI("GetAbilityInfo called");
@@ -845,6 +845,16 @@ public:
         return eventRunner_;
     }
 
+    /**
+     * Get the id of the 'EventHandler', which is unique in the process and never reused.
+     *
+     * @return Return the id.
+     */
+    inline uint64_t GetHandlerId() const
+    {
+        return handlerId_;
+    }
+
     /**
      * Distribute the event.
      *
@@ -915,6 +925,7 @@ protected:
     virtual void ProcessEvent(const InnerEvent::Pointer &event);
 
 private:
+    uint64_t handlerId_ {0};
     std::shared_ptr<EventRunner> eventRunner_;
     CallbackTimeout deliveryTimeoutCallback_;
     CallbackTimeout distributeTimeoutCallback_;
@@ -17,9 +17,14 @@
 #define FOUNDATION_APPEXECFWK_INTERFACES_INNERKITS_LIBEVENTHANDLER_INCLUDE_EVENT_QUEUE_H
 
 #include <array>
+#include <atomic>
 #include <list>
 #include <map>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "inner_event.h"
 #include "event_handler_errors.h"
@@ -30,6 +35,7 @@
 namespace OHOS {
 namespace AppExecFwk {
 class IoWaiter;
+class ImmediateEventRing;
 
 class EventQueue final {
 public:
@@ -47,7 +53,7 @@ public:
 
     EventQueue();
     explicit EventQueue(const std::shared_ptr<IoWaiter> &ioWaiter);
-    ~EventQueue() = default;
+    ~EventQueue();
     DISALLOW_COPY_AND_MOVE(EventQueue);
 
     /**
@@ -216,19 +222,47 @@ private:
     // Sub event queues for IMMEDIATE, HIGH and LOW priority. So use value of IDLE as size.
     static const uint32_t SUB_EVENT_QUEUE_NUM = static_cast<uint32_t>(Priority::IDLE);
 
+    // Events sorted by handle time, events with the same handle time are kept in insertion order.
+    struct QueuedEvent {
+        InnerEvent::Pointer event;
+        // Owner of the event when inserted, only used as key of the owner index.
+        const EventHandler *owner;
+        // Insertion sequence, makes keys of the owner index unique.
+        uint64_t sequence;
+    };
+    using EventList = std::multimap<InnerEvent::TimePoint, QueuedEvent>;
+
+    // Position of an event in one of the event lists.
+    struct EventPosition {
+        EventList *events;
+        EventList::iterator iter;
+    };
+
+    // Index of the queued events of one owner, to avoid walking all the event lists.
+    struct OwnerIndex {
+        // key:inner event id of events without task and insertion sequence
+        std::map<std::pair<uint32_t, uint64_t>, EventPosition> events;
+        // key:task name of events with task and insertion sequence
+        std::map<std::pair<std::string, uint64_t>, EventPosition> tasks;
+    };
+
     struct SubEventQueue {
-        std::list<InnerEvent::Pointer> queue;
+        EventList queue;
         uint32_t handledEventsCount{0};
         uint32_t maxHandledEventsCount{DEFAULT_MAX_HANDLED_EVENT_COUNT};
     };
 
     void Remove(const RemoveFilter &filter);
-    bool HasInnerEvent(const HasFilter &filter);
+    void EraseEventsLocked(const std::vector<EventPosition> &positions);
+    void InsertEventLocked(EventList &events, InnerEvent::Pointer &event);
+    InnerEvent::Pointer EraseEventLocked(EventList &events, EventList::iterator iter);
     InnerEvent::Pointer PickEventLocked(const InnerEvent::TimePoint &now, InnerEvent::TimePoint &nextWakeUpTime);
     InnerEvent::Pointer GetExpiredEventLocked(InnerEvent::TimePoint &nextExpiredTime);
     void WaitUntilLocked(const InnerEvent::TimePoint &when, std::unique_lock<std::mutex> &lock);
     void HandleFileDescriptorEvent(int32_t fileDescriptor, uint32_t events);
     bool EnsureIoWaiterSupportListerningFileDescriptorLocked();
+    bool InsertImmediateEvent(InnerEvent::Pointer &event);
+    void DrainImmediateEventsLocked();
 
     std::mutex queueLock_;
 
@@ -236,7 +270,13 @@ private:
     std::array<SubEventQueue, SUB_EVENT_QUEUE_NUM> subEventQueues_;
 
     // Event queue for IDLE events.
-    std::list<InnerEvent::Pointer> idleEvents_;
+    EventList idleEvents_;
+
+    // Index of queued events, key:owner of the events.
+    std::unordered_map<const EventHandler *, OwnerIndex> ownerIndexes_;
+
+    // Sequence of the last inserted event.
+    uint64_t eventSequence_ {0};
 
     // Next wake up time when block in 'GetEvent'.
     InnerEvent::TimePoint wakeUpTime_ { InnerEvent::TimePoint::max() };
@@ -254,6 +294,12 @@ private:
 
     // File descriptor listeners to handle IO events.
     std::map<int32_t, std::shared_ptr<FileDescriptorListener>> listeners_;
+
+    // Zero-delay immediate events inserted without holding 'queueLock_', drained while holding it.
+    std::unique_ptr<ImmediateEventRing> immediateEvents_;
+
+    // Mark if blocked in 'GetEvent', so only the first immediate event after that wakes up the thread.
+    std::atomic<bool> isWaiting_ {false};
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -131,6 +131,20 @@ public:
      */
     void SetLogger(const std::shared_ptr<Logger> &logger);
 
+    /**
+     * Start to collect the queue wait time and the execution time of the events dispatched by this event runner,
+     * which are printed by {@link #Dump} and {@link #DumpRunnerInfo}.
+     *
+     * @param slowEventThresholdMs Events which wait or execute longer than it are counted and logged as slow,
+     * 0 means not to check slow events.
+     */
+    void EnableDispatchProfiling(uint64_t slowEventThresholdMs = 0);
+
+    /**
+     * Stop to collect the dispatch statistics, and clear the collected ones.
+     */
+    void DisableDispatchProfiling();
+
     /**
      * Obtain the ID of the worker thread associated with this EventRunner.
      *
@@ -14,6 +14,7 @@
  */
 #include "bundle_mgr.h"
 
+#include <algorithm>
 #include <string>
 
 #include "app_log_wrapper.h"
@@ -22,6 +23,7 @@
 #include "bundle_mgr_interface.h"
 #include "bundle_mgr_proxy.h"
 #include "cleancache_callback.h"
+#include "concurrent_util.h"
 #include "if_system_ability_manager.h"
 #include "installer_callback.h"
 #include "ipc_skeleton.h"
@@ -58,6 +60,9 @@ constexpr int32_t PARAM3 = 3;
 constexpr int32_t NAPI_RETURN_FAILED = -1;
 constexpr int32_t NAPI_RETURN_ZERO = 0;
 constexpr int32_t NAPI_RETURN_ONE = 1;
+// The queries of a batch are independent IPCs which mostly wait for the bundle manager service, so they overlap
+// on a few threads whatever the count of cpu cores is.
+constexpr size_t MAX_BATCH_QUERY_THREAD_NUM = 4;
 constexpr int32_t NAPI_RETURN_TWO = 2;
 constexpr int32_t NAPI_RETURN_THREE = 3;
 constexpr int32_t CODE_SUCCESS = 0;
@@ -818,145 +823,134 @@ static void ConvertRequestPermission(napi_env env, napi_value result, const Requ
     NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, result, "usedScene", nUsedScene));
 }
 
-static void ConvertBundleInfo(napi_env env, napi_value objBundleInfo, const BundleInfo &bundleInfo)
+static napi_value CreateStringValue(napi_env env, const std::string &value)
 {
-    napi_value nName;
-    NAPI_CALL_RETURN_VOID(env, napi_create_string_utf8(env, bundleInfo.name.c_str(), NAPI_AUTO_LENGTH, &nName));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "name", nName));
-
-    napi_value nVendor;
-    NAPI_CALL_RETURN_VOID(env, napi_create_string_utf8(env, bundleInfo.vendor.c_str(), NAPI_AUTO_LENGTH, &nVendor));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "vendor", nVendor));
-
-    napi_value nVersionCode;
-    NAPI_CALL_RETURN_VOID(env, napi_create_uint32(env, bundleInfo.versionCode, &nVersionCode));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "versionCode", nVersionCode));
-
-    napi_value nVersionName;
-    NAPI_CALL_RETURN_VOID(
-        env, napi_create_string_utf8(env, bundleInfo.versionName.c_str(), NAPI_AUTO_LENGTH, &nVersionName));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "versionName", nVersionName));
-
-    napi_value nCpuAbi;
-    NAPI_CALL_RETURN_VOID(env, napi_create_string_utf8(env, bundleInfo.cpuAbi.c_str(), NAPI_AUTO_LENGTH, &nCpuAbi));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "cpuAbi", nCpuAbi));
-
-    napi_value nAppId;
-    NAPI_CALL_RETURN_VOID(env, napi_create_string_utf8(env, bundleInfo.appId.c_str(), NAPI_AUTO_LENGTH, &nAppId));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "appId", nAppId));
-
-    napi_value nEntryModuleName;
-    NAPI_CALL_RETURN_VOID(
-        env, napi_create_string_utf8(env, bundleInfo.entryModuleName.c_str(), NAPI_AUTO_LENGTH, &nEntryModuleName));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "entryModuleName", nEntryModuleName));
-
-    napi_value nCompatibleVersion;
-    NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, bundleInfo.compatibleVersion, &nCompatibleVersion));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "compatibleVersion", nCompatibleVersion));
-
-    napi_value nTargetVersion;
-    NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, bundleInfo.targetVersion, &nTargetVersion));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "targetVersion", nTargetVersion));
-
-    napi_value nUid;
-    NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, bundleInfo.uid, &nUid));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "uid", nUid));
-
-    napi_value nInstallTime;
-    NAPI_CALL_RETURN_VOID(env, napi_create_int64(env, bundleInfo.installTime, &nInstallTime));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "installTime", nInstallTime));
-
-    napi_value nUpdateTime;
-    NAPI_CALL_RETURN_VOID(env, napi_create_int64(env, bundleInfo.updateTime, &nUpdateTime));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "updateTime", nUpdateTime));
-
-    napi_value nAppInfo;
-    NAPI_CALL_RETURN_VOID(env, napi_create_object(env, &nAppInfo));
-    ConvertApplicationInfo(env, nAppInfo, bundleInfo.applicationInfo);
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "appInfo", nAppInfo));
+    napi_value result = nullptr;
+    NAPI_CALL(env, napi_create_string_utf8(env, value.c_str(), NAPI_AUTO_LENGTH, &result));
+    return result;
+}
 
-    napi_value nAbilityInfos;
-    NAPI_CALL_RETURN_VOID(env, napi_create_array(env, &nAbilityInfos));
-    for (size_t idx = 0; idx < bundleInfo.abilityInfos.size(); idx++) {
-        napi_value objAbilityInfo;
-        NAPI_CALL_RETURN_VOID(env, napi_create_object(env, &objAbilityInfo));
-        ConvertAbilityInfo(env, objAbilityInfo, bundleInfo.abilityInfos[idx]);
-        NAPI_CALL_RETURN_VOID(env, napi_set_element(env, nAbilityInfos, idx, objAbilityInfo));
-    }
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "abilityInfos", nAbilityInfos));
+static napi_value CreateInt32Value(napi_env env, int32_t value)
+{
+    napi_value result = nullptr;
+    NAPI_CALL(env, napi_create_int32(env, value, &result));
+    return result;
+}
 
-    napi_value nHapModuleInfos;
-    NAPI_CALL_RETURN_VOID(env, napi_create_array(env, &nHapModuleInfos));
-    for (size_t idx = 0; idx < bundleInfo.hapModuleInfos.size(); idx++) {
-        napi_value objHapModuleInfo;
-        NAPI_CALL_RETURN_VOID(env, napi_create_object(env, &objHapModuleInfo));
-        ConvertHapModuleInfo(env, objHapModuleInfo, bundleInfo.hapModuleInfos[idx]);
-        NAPI_CALL_RETURN_VOID(env, napi_set_element(env, nHapModuleInfos, idx, objHapModuleInfo));
-    }
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "hapModuleInfos", nHapModuleInfos));
+static napi_value CreateInt64Value(napi_env env, int64_t value)
+{
+    napi_value result = nullptr;
+    NAPI_CALL(env, napi_create_int64(env, value, &result));
+    return result;
+}
 
-    napi_value nReqPermissions;
-    NAPI_CALL_RETURN_VOID(env, napi_create_array(env, &nReqPermissions));
-    for (size_t idx = 0; idx < bundleInfo.reqPermissions.size(); idx++) {
-        napi_value nReqPermission;
-        NAPI_CALL_RETURN_VOID(env,
-            napi_create_string_utf8(env, bundleInfo.reqPermissions[idx].c_str(), NAPI_AUTO_LENGTH, &nReqPermission));
-        NAPI_CALL_RETURN_VOID(env, napi_set_element(env, nReqPermissions, idx, nReqPermission));
-    }
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "reqPermissions", nReqPermissions));
+static napi_value CreateBooleanValue(napi_env env, bool value)
+{
+    napi_value result = nullptr;
+    NAPI_CALL(env, napi_get_boolean(env, value, &result));
+    return result;
+}
 
-    napi_value nReqPermissionStates;
-    NAPI_CALL_RETURN_VOID(env, napi_create_array(env, &nReqPermissionStates));
-    for (size_t idx = 0; idx < bundleInfo.reqPermissionStates.size(); idx++) {
-        napi_value nReqPermissionState;
-        NAPI_CALL_RETURN_VOID(env,
-            napi_create_int32(env, bundleInfo.reqPermissionStates[idx], &nReqPermissionState));
-        NAPI_CALL_RETURN_VOID(env, napi_set_element(env, nReqPermissionStates, idx, nReqPermissionState));
+template<typename T>
+static napi_value CreateObjectArray(
+    napi_env env, const std::vector<T> &infos, void (*convert)(napi_env, napi_value, const T &))
+{
+    napi_value result = nullptr;
+    NAPI_CALL(env, napi_create_array_with_length(env, infos.size(), &result));
+    for (size_t idx = 0; idx < infos.size(); idx++) {
+        napi_value objInfo = nullptr;
+        NAPI_CALL(env, napi_create_object(env, &objInfo));
+        convert(env, objInfo, infos[idx]);
+        NAPI_CALL(env, napi_set_element(env, result, idx, objInfo));
     }
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "reqPermissionStates",
-        nReqPermissionStates));
-
-    napi_value nIsCompressNativeLibs;
-    NAPI_CALL_RETURN_VOID(env, napi_get_boolean(env, false, &nIsCompressNativeLibs));
-    NAPI_CALL_RETURN_VOID(
-        env, napi_set_named_property(env, objBundleInfo, "isCompressNativeLibs", nIsCompressNativeLibs));
+    return result;
+}
 
-    napi_value nIsSilentInstallation;
-    NAPI_CALL_RETURN_VOID(
-        env, napi_create_string_utf8(env, std::string().c_str(), NAPI_AUTO_LENGTH, &nIsSilentInstallation));
-    NAPI_CALL_RETURN_VOID(
-        env, napi_set_named_property(env, objBundleInfo, "isSilentInstallation", nIsSilentInstallation));
+struct BundleInfoProperty {
+    const char *name;
+    napi_value (*convert)(napi_env env, const BundleInfo &bundleInfo);
+};
 
-    napi_value nType;
-    NAPI_CALL_RETURN_VOID(env, napi_create_string_utf8(env, std::string().c_str(), NAPI_AUTO_LENGTH, &nType));
-    NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, "type", nType));
+// The properties of the js BundleInfo in the order they are set.
+const BundleInfoProperty BUNDLE_INFO_PROPERTIES[] = {
+    {"name", [](napi_env env, const BundleInfo &info) { return CreateStringValue(env, info.name); }},
+    {"vendor", [](napi_env env, const BundleInfo &info) { return CreateStringValue(env, info.vendor); }},
+    {"versionCode", [](napi_env env, const BundleInfo &info) -> napi_value {
+        napi_value nVersionCode = nullptr;
+        NAPI_CALL(env, napi_create_uint32(env, info.versionCode, &nVersionCode));
+        return nVersionCode;
+    }},
+    {"versionName", [](napi_env env, const BundleInfo &info) { return CreateStringValue(env, info.versionName); }},
+    {"cpuAbi", [](napi_env env, const BundleInfo &info) { return CreateStringValue(env, info.cpuAbi); }},
+    {"appId", [](napi_env env, const BundleInfo &info) { return CreateStringValue(env, info.appId); }},
+    {"entryModuleName", [](napi_env env, const BundleInfo &info) {
+        return CreateStringValue(env, info.entryModuleName);
+    }},
+    {"compatibleVersion", [](napi_env env, const BundleInfo &info) {
+        return CreateInt32Value(env, info.compatibleVersion);
+    }},
+    {"targetVersion", [](napi_env env, const BundleInfo &info) { return CreateInt32Value(env, info.targetVersion); }},
+    {"uid", [](napi_env env, const BundleInfo &info) { return CreateInt32Value(env, info.uid); }},
+    {"installTime", [](napi_env env, const BundleInfo &info) { return CreateInt64Value(env, info.installTime); }},
+    {"updateTime", [](napi_env env, const BundleInfo &info) { return CreateInt64Value(env, info.updateTime); }},
+    {"appInfo", [](napi_env env, const BundleInfo &info) -> napi_value {
+        napi_value nAppInfo = nullptr;
+        NAPI_CALL(env, napi_create_object(env, &nAppInfo));
+        ConvertApplicationInfo(env, nAppInfo, info.applicationInfo);
+        return nAppInfo;
+    }},
+    {"abilityInfos", [](napi_env env, const BundleInfo &info) {
+        return CreateObjectArray(env, info.abilityInfos, ConvertAbilityInfo);
+    }},
+    {"hapModuleInfos", [](napi_env env, const BundleInfo &info) {
+        return CreateObjectArray(env, info.hapModuleInfos, ConvertHapModuleInfo);
+    }},
+    {"reqPermissions", [](napi_env env, const BundleInfo &info) -> napi_value {
+        napi_value nReqPermissions = nullptr;
+        NAPI_CALL(env, napi_create_array_with_length(env, info.reqPermissions.size(), &nReqPermissions));
+        for (size_t idx = 0; idx < info.reqPermissions.size(); idx++) {
+            NAPI_CALL(env,
+                napi_set_element(env, nReqPermissions, idx, CreateStringValue(env, info.reqPermissions[idx])));
+        }
+        return nReqPermissions;
+    }},
+    {"reqPermissionStates", [](napi_env env, const BundleInfo &info) -> napi_value {
+        napi_value nReqPermissionStates = nullptr;
+        NAPI_CALL(env, napi_create_array_with_length(env, info.reqPermissionStates.size(), &nReqPermissionStates));
+        for (size_t idx = 0; idx < info.reqPermissionStates.size(); idx++) {
+            NAPI_CALL(env, napi_set_element(
+                env, nReqPermissionStates, idx, CreateInt32Value(env, info.reqPermissionStates[idx])));
+        }
+        return nReqPermissionStates;
+    }},
+    {"isCompressNativeLibs", [](napi_env env, const BundleInfo &info) { return CreateBooleanValue(env, false); }},
+    {"isSilentInstallation", [](napi_env env, const BundleInfo &info) {
+        return CreateStringValue(env, std::string());
+    }},
+    {"type", [](napi_env env, const BundleInfo &info) { return CreateStringValue(env, std::string()); }},
+    {"reqPermissionDetails", [](napi_env env, const BundleInfo &info) {
+        return CreateObjectArray(env, info.reqPermissionDetails, ConvertRequestPermission);
+    }},
+    {"minCompatibleVersionCode", [](napi_env env, const BundleInfo &info) {
+        return CreateInt32Value(env, DEFAULT_INT32);
+    }},
+    {"entryInstallationFree", [](napi_env env, const BundleInfo &info) {
+        return CreateBooleanValue(env, info.entryInstallationFree);
+    }},
+    {"extensionAbilityInfo", [](napi_env env, const BundleInfo &info) -> napi_value {
+        napi_value nExtensionAbilityInfos = nullptr;
+        NAPI_CALL(env, napi_create_array_with_length(env, info.extensionInfos.size(), &nExtensionAbilityInfos));
+        ConvertExtensionInfos(env, nExtensionAbilityInfos, info.extensionInfos);
+        return nExtensionAbilityInfos;
+    }},
+};
 
-    napi_value nReqPermissionDetails;
-    NAPI_CALL_RETURN_VOID(env, napi_create_array(env, &nReqPermissionDetails));
-    for (size_t idx = 0; idx < bundleInfo.reqPermissionDetails.size(); idx++) {
-        napi_value objReqPermission;
-        NAPI_CALL_RETURN_VOID(env, napi_create_object(env, &objReqPermission));
-        ConvertRequestPermission(env, objReqPermission, bundleInfo.reqPermissionDetails[idx]);
-        NAPI_CALL_RETURN_VOID(env, napi_set_element(env, nReqPermissionDetails, idx, objReqPermission));
+static void ConvertBundleInfo(napi_env env, napi_value objBundleInfo, const BundleInfo &bundleInfo)
+{
+    for (const auto &property : BUNDLE_INFO_PROPERTIES) {
+        napi_value value = property.convert(env, bundleInfo);
+        NAPI_CALL_RETURN_VOID(env, napi_set_named_property(env, objBundleInfo, property.name, value));
     }
-    NAPI_CALL_RETURN_VOID(
-        env, napi_set_named_property(env, objBundleInfo, "reqPermissionDetails", nReqPermissionDetails));
-
-    napi_value nMinCompatibleVersionCode;
-    NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, DEFAULT_INT32, &nMinCompatibleVersionCode));
-    NAPI_CALL_RETURN_VOID(
-        env, napi_set_named_property(env, objBundleInfo, "minCompatibleVersionCode", nMinCompatibleVersionCode));
-
-    napi_value nEntryInstallationFree;
-    NAPI_CALL_RETURN_VOID(env, napi_get_boolean(env, bundleInfo.entryInstallationFree, &nEntryInstallationFree));
-    NAPI_CALL_RETURN_VOID(
-        env, napi_set_named_property(env, objBundleInfo, "entryInstallationFree", nEntryInstallationFree));
-
-    napi_value nExtensionAbilityInfos;
-    napi_create_array_with_length(env, bundleInfo.extensionInfos.size(), &nExtensionAbilityInfos);
-    ConvertExtensionInfos(env, nExtensionAbilityInfos, bundleInfo.extensionInfos);
-    NAPI_CALL_RETURN_VOID(env,
-        napi_set_named_property(env, objBundleInfo, "extensionAbilityInfo", nExtensionAbilityInfos));
 }
 
 static void ConvertFormCustomizeData(napi_env env, napi_value objformInfo, const FormCustomizeData &customizeData)
@@ -1635,6 +1629,151 @@ napi_value QueryAbilityInfos(napi_env env, napi_callback_info info)
     return promise;
 }
 
+static bool InnerQueryAbilityInfosBatch(const std::vector<Want> &wants, int32_t flags, int32_t userId,
+    std::vector<std::vector<AbilityInfo>> &abilityInfos)
+{
+    auto iBundleMgr = GetBundleMgr();
+    if (!iBundleMgr) {
+        APP_LOGE("can not get iBundleMgr");
+        return false;
+    }
+    abilityInfos.resize(wants.size());
+    RunConcurrently(wants.size(), MAX_BATCH_QUERY_THREAD_NUM, [&](size_t index) {
+        if (!iBundleMgr->QueryAbilityInfos(wants[index], flags, userId, abilityInfos[index])) {
+            abilityInfos[index].clear();
+        }
+    });
+    return true;
+}
+
+static bool ParseWants(napi_env env, std::vector<Want> &wants, napi_value args)
+{
+    bool isArray = false;
+    NAPI_CALL_BASE(env, napi_is_array(env, args, &isArray), false);
+    if (!isArray) {
+        APP_LOGE("args not array");
+        return false;
+    }
+    uint32_t arrayLength = 0;
+    NAPI_CALL_BASE(env, napi_get_array_length(env, args, &arrayLength), false);
+    wants.resize(arrayLength);
+    for (uint32_t i = 0; i < arrayLength; i++) {
+        napi_value value = nullptr;
+        NAPI_CALL_BASE(env, napi_get_element(env, args, i, &value), false);
+        if (!ParseWant(env, wants[i], value)) {
+            APP_LOGE("want %{public}u is invalid", i);
+            wants.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Promise and async callback, the abilities of all the wants are queried in one async work and returned as an array
+ * of AbilityInfo arrays in the order of the wants.
+ */
+napi_value QueryAbilityInfosBatch(napi_env env, napi_callback_info info)
+{
+    APP_LOGD("QueryAbilityInfosBatch called");
+    size_t argc = ARGS_SIZE_FOUR;
+    napi_value argv[ARGS_SIZE_FOUR] = {nullptr};
+    napi_value thisArg = nullptr;
+    void *data = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisArg, &data));
+    APP_LOGD("argc = [%{public}zu]", argc);
+    AsyncAbilityInfoBatchCallbackInfo *asyncCallbackInfo = new (std::nothrow) AsyncAbilityInfoBatchCallbackInfo(env);
+    if (asyncCallbackInfo == nullptr) {
+        return nullptr;
+    }
+    std::unique_ptr<AsyncAbilityInfoBatchCallbackInfo> callbackPtr {asyncCallbackInfo};
+    asyncCallbackInfo->userId = IPCSkeleton::GetCallingUid() / Constants::BASE_USER_RANGE;
+
+    for (size_t i = 0; i < argc; ++i) {
+        napi_valuetype valueType = napi_undefined;
+        napi_typeof(env, argv[i], &valueType);
+        if ((i == PARAM0) && (valueType == napi_object)) {
+            if (!ParseWants(env, asyncCallbackInfo->wants, argv[i])) {
+                asyncCallbackInfo->err = PARAM_TYPE_ERROR;
+            }
+        } else if ((i == PARAM1) && (valueType == napi_number)) {
+            ParseInt(env, asyncCallbackInfo->flags, argv[i]);
+        } else if (i == PARAM2) {
+            if (valueType == napi_number) {
+                ParseInt(env, asyncCallbackInfo->userId, argv[i]);
+            } else if (valueType == napi_function) {
+                NAPI_CALL(env, napi_create_reference(env, argv[i], NAPI_RETURN_ONE, &asyncCallbackInfo->callback));
+                break;
+            } else {
+                asyncCallbackInfo->err = PARAM_TYPE_ERROR;
+            }
+        } else if ((i == PARAM3) && (valueType == napi_function)) {
+            NAPI_CALL(env, napi_create_reference(env, argv[i], NAPI_RETURN_ONE, &asyncCallbackInfo->callback));
+        } else {
+            asyncCallbackInfo->err = PARAM_TYPE_ERROR;
+        }
+    }
+    napi_value promise = nullptr;
+    if (asyncCallbackInfo->callback == nullptr) {
+        NAPI_CALL(env, napi_create_promise(env, &asyncCallbackInfo->deferred, &promise));
+    } else {
+        NAPI_CALL(env, napi_get_undefined(env,  &promise));
+    }
+    napi_value resource = nullptr;
+    NAPI_CALL(env, napi_create_string_utf8(env, "QueryAbilityInfosBatch", NAPI_AUTO_LENGTH, &resource));
+    NAPI_CALL(env, napi_create_async_work(
+        env, nullptr, resource,
+        [](napi_env env, void *data) {
+            AsyncAbilityInfoBatchCallbackInfo *asyncCallbackInfo = (AsyncAbilityInfoBatchCallbackInfo *)data;
+            if (!asyncCallbackInfo->err) {
+                asyncCallbackInfo->ret = InnerQueryAbilityInfosBatch(asyncCallbackInfo->wants,
+                    asyncCallbackInfo->flags, asyncCallbackInfo->userId, asyncCallbackInfo->abilityInfos);
+            }
+        },
+        [](napi_env env, napi_status status, void *data) {
+            AsyncAbilityInfoBatchCallbackInfo *asyncCallbackInfo = (AsyncAbilityInfoBatchCallbackInfo *)data;
+            std::unique_ptr<AsyncAbilityInfoBatchCallbackInfo> callbackPtr {asyncCallbackInfo};
+            napi_value result[2] = { 0 };
+            if (asyncCallbackInfo->err) {
+                NAPI_CALL_RETURN_VOID(env, napi_create_uint32(env, static_cast<uint32_t>(asyncCallbackInfo->err),
+                    &result[0]));
+                NAPI_CALL_RETURN_VOID(env, napi_create_string_utf8(env, "type mismatch",
+                    NAPI_AUTO_LENGTH, &result[1]));
+            } else if (asyncCallbackInfo->ret) {
+                NAPI_CALL_RETURN_VOID(env, napi_create_uint32(env, 0, &result[0]));
+                NAPI_CALL_RETURN_VOID(env,
+                    napi_create_array_with_length(env, asyncCallbackInfo->abilityInfos.size(), &result[1]));
+                for (size_t idx = 0; idx < asyncCallbackInfo->abilityInfos.size(); idx++) {
+                    napi_value nAbilityInfos = nullptr;
+                    NAPI_CALL_RETURN_VOID(env, napi_create_array(env, &nAbilityInfos));
+                    ProcessAbilityInfos(env, nAbilityInfos, asyncCallbackInfo->abilityInfos[idx]);
+                    NAPI_CALL_RETURN_VOID(env, napi_set_element(env, result[1], idx, nAbilityInfos));
+                }
+            } else {
+                NAPI_CALL_RETURN_VOID(env, napi_create_uint32(env, 1, &result[0]));
+                NAPI_CALL_RETURN_VOID(env,
+                    napi_create_string_utf8(env, "QueryAbilityInfosBatch failed", NAPI_AUTO_LENGTH, &result[1]));
+            }
+            if (asyncCallbackInfo->deferred) {
+                if (asyncCallbackInfo->ret) {
+                    NAPI_CALL_RETURN_VOID(env, napi_resolve_deferred(env, asyncCallbackInfo->deferred, result[1]));
+                } else {
+                    NAPI_CALL_RETURN_VOID(env, napi_reject_deferred(env, asyncCallbackInfo->deferred, result[0]));
+                }
+            } else {
+                napi_value callback = nullptr;
+                napi_value placeHolder = nullptr;
+                NAPI_CALL_RETURN_VOID(env, napi_get_reference_value(env, asyncCallbackInfo->callback, &callback));
+                NAPI_CALL_RETURN_VOID(env, napi_call_function(env, nullptr, callback,
+                    sizeof(result) / sizeof(result[0]), result, &placeHolder));
+            }
+        },
+        (void*)asyncCallbackInfo, &asyncCallbackInfo->asyncWork));
+    NAPI_CALL(env, napi_queue_async_work(env, asyncCallbackInfo->asyncWork));
+    callbackPtr.release();
+    return promise;
+}
+
 static bool InnerGetApplicationInfo(napi_env env, const std::string &bundleName, int32_t flags,
     const int userId, ApplicationInfo &appInfo)
 {
@@ -1922,15 +2061,9 @@ static void ProcessBundleInfos(
     napi_env env, napi_value result, const std::vector<OHOS::AppExecFwk::BundleInfo> &bundleInfos)
 {
     if (bundleInfos.size() > 0) {
-        APP_LOGI("-----bundleInfos is not null-----");
+        APP_LOGD("-----bundleInfos is not null, size: %{public}zu-----", bundleInfos.size());
         size_t index = 0;
         for (const auto &item : bundleInfos) {
-            APP_LOGI("name{%s} ", item.name.c_str());
-            APP_LOGI("bundleName{%s} ", item.applicationInfo.bundleName.c_str());
-            for (const auto &moduleInfo : item.applicationInfo.moduleInfos) {
-                APP_LOGI("moduleName{%s} ", moduleInfo.moduleName.c_str());
-                APP_LOGI("moduleSourceDir{%s} ", moduleInfo.moduleSourceDir.c_str());
-            }
             napi_value objBundleInfo = nullptr;
             napi_create_object(env, &objBundleInfo);
             ConvertBundleInfo(env, objBundleInfo, item);
@@ -2512,6 +2645,139 @@ napi_value GetBundleInfo(napi_env env, napi_callback_info info)
     return promise;
 }
 
+static bool InnerGetBundleInfoBatch(const std::vector<std::string> &bundleNames, int32_t flags,
+    const BundleOptions &bundleOptions, std::vector<BundleInfo> &bundleInfos, std::vector<uint8_t> &isFound)
+{
+    auto iBundleMgr = GetBundleMgr();
+    if (!iBundleMgr) {
+        APP_LOGE("can not get iBundleMgr");
+        return false;
+    }
+    bundleInfos.resize(bundleNames.size());
+    isFound.assign(bundleNames.size(), 0);
+    RunConcurrently(bundleNames.size(), MAX_BATCH_QUERY_THREAD_NUM, [&](size_t index) {
+        isFound[index] = iBundleMgr->GetBundleInfo(bundleNames[index], flags, bundleInfos[index],
+            bundleOptions.userId) ? 1 : 0;
+        if (!isFound[index]) {
+            APP_LOGD("bundleInfo of %{public}s is not found", bundleNames[index].c_str());
+        }
+    });
+    return true;
+}
+
+/**
+ * Promise and async callback, the infos of all the bundles are got in one async work and returned as an array in the
+ * order of the bundle names, with undefined for the bundles not found.
+ */
+napi_value GetBundleInfoBatch(napi_env env, napi_callback_info info)
+{
+    APP_LOGD("NAPI GetBundleInfoBatch called");
+    size_t argc = ARGS_SIZE_FOUR;
+    napi_value argv[ARGS_SIZE_FOUR] = {nullptr};
+    napi_value thisArg = nullptr;
+    void *data = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisArg, &data));
+    APP_LOGD("argc = [%{public}zu]", argc);
+    AsyncBundleInfoBatchCallbackInfo *asyncCallbackInfo = new (std::nothrow) AsyncBundleInfoBatchCallbackInfo(env);
+    if (asyncCallbackInfo == nullptr) {
+        APP_LOGE("asyncCallbackInfo is nullptr");
+        return nullptr;
+    }
+    std::unique_ptr<AsyncBundleInfoBatchCallbackInfo> callbackPtr {asyncCallbackInfo};
+    for (size_t i = 0; i < argc; ++i) {
+        napi_valuetype valueType = napi_undefined;
+        NAPI_CALL(env, napi_typeof(env, argv[i], &valueType));
+        if ((i == PARAM0) && (valueType == napi_object)) {
+            if (ParseStringArray(env, asyncCallbackInfo->bundleNames, argv[i]) == nullptr) {
+                asyncCallbackInfo->err = PARAM_TYPE_ERROR;
+                asyncCallbackInfo->message = "type mismatch";
+            }
+        } else if ((i == PARAM1) && valueType == napi_number) {
+            ParseInt(env, asyncCallbackInfo->flags, argv[i]);
+        } else if ((i == PARAM2) && (valueType == napi_function)) {
+            NAPI_CALL(env, napi_create_reference(env, argv[i], NAPI_RETURN_ONE, &asyncCallbackInfo->callback));
+            break;
+        } else if ((i == PARAM2) && (valueType == napi_object)) {
+            bool ret = ParseBundleOptions(env, asyncCallbackInfo->bundleOptions, argv[i]);
+            if (!ret) {
+                asyncCallbackInfo->err = PARAM_TYPE_ERROR;
+            }
+        } else if ((i == PARAM3) && (valueType == napi_function)) {
+            NAPI_CALL(env, napi_create_reference(env, argv[i], NAPI_RETURN_ONE, &asyncCallbackInfo->callback));
+            break;
+        } else {
+            asyncCallbackInfo->err = PARAM_TYPE_ERROR;
+            asyncCallbackInfo->message = "type mismatch";
+        }
+    }
+
+    napi_value promise = nullptr;
+    if (asyncCallbackInfo->callback == nullptr) {
+        NAPI_CALL(env, napi_create_promise(env, &asyncCallbackInfo->deferred, &promise));
+    } else {
+        NAPI_CALL(env, napi_get_undefined(env,  &promise));
+    }
+
+    napi_value resource = nullptr;
+    NAPI_CALL(env, napi_create_string_utf8(env, "GetBundleInfoBatch", NAPI_AUTO_LENGTH, &resource));
+
+    NAPI_CALL(env, napi_create_async_work(
+        env, nullptr, resource,
+        [](napi_env env, void* data) {
+            AsyncBundleInfoBatchCallbackInfo* asyncCallbackInfo = (AsyncBundleInfoBatchCallbackInfo*)data;
+            if (!asyncCallbackInfo->err) {
+                asyncCallbackInfo->ret = InnerGetBundleInfoBatch(asyncCallbackInfo->bundleNames,
+                    asyncCallbackInfo->flags, asyncCallbackInfo->bundleOptions, asyncCallbackInfo->bundleInfos,
+                    asyncCallbackInfo->isFound);
+            }
+        },
+        [](napi_env env, napi_status status, void* data) {
+            AsyncBundleInfoBatchCallbackInfo* asyncCallbackInfo = (AsyncBundleInfoBatchCallbackInfo*)data;
+            std::unique_ptr<AsyncBundleInfoBatchCallbackInfo> callbackPtr {asyncCallbackInfo};
+            napi_value result[2] = { 0 };
+            if (asyncCallbackInfo->err) {
+                NAPI_CALL_RETURN_VOID(env, napi_create_uint32(env, static_cast<uint32_t>(asyncCallbackInfo->err),
+                    &result[0]));
+                NAPI_CALL_RETURN_VOID(env, napi_create_string_utf8(env, asyncCallbackInfo->message.c_str(),
+                    NAPI_AUTO_LENGTH, &result[1]));
+            } else if (asyncCallbackInfo->ret) {
+                NAPI_CALL_RETURN_VOID(env, napi_create_uint32(env, 0, &result[0]));
+                NAPI_CALL_RETURN_VOID(env,
+                    napi_create_array_with_length(env, asyncCallbackInfo->bundleInfos.size(), &result[1]));
+                for (size_t idx = 0; idx < asyncCallbackInfo->bundleInfos.size(); idx++) {
+                    napi_value objBundleInfo = nullptr;
+                    if (asyncCallbackInfo->isFound[idx]) {
+                        NAPI_CALL_RETURN_VOID(env, napi_create_object(env, &objBundleInfo));
+                        ConvertBundleInfo(env, objBundleInfo, asyncCallbackInfo->bundleInfos[idx]);
+                    } else {
+                        NAPI_CALL_RETURN_VOID(env, napi_get_undefined(env, &objBundleInfo));
+                    }
+                    NAPI_CALL_RETURN_VOID(env, napi_set_element(env, result[1], idx, objBundleInfo));
+                }
+            } else {
+                NAPI_CALL_RETURN_VOID(env, napi_create_int32(env, 1, &result[0]));
+                NAPI_CALL_RETURN_VOID(env, napi_get_undefined(env, &result[1]));
+            }
+            if (asyncCallbackInfo->deferred) {
+              if (asyncCallbackInfo->ret) {
+                  NAPI_CALL_RETURN_VOID(env, napi_resolve_deferred(env, asyncCallbackInfo->deferred, result[1]));
+              } else {
+                  NAPI_CALL_RETURN_VOID(env, napi_reject_deferred(env, asyncCallbackInfo->deferred, result[0]));
+              }
+            } else {
+                napi_value callback = nullptr;
+                napi_value placeHolder = nullptr;
+                NAPI_CALL_RETURN_VOID(env, napi_get_reference_value(env, asyncCallbackInfo->callback, &callback));
+                NAPI_CALL_RETURN_VOID(env, napi_call_function(env, nullptr, callback,
+                    sizeof(result) / sizeof(result[0]), result, &placeHolder));
+            }
+        },
+        (void*)asyncCallbackInfo, &asyncCallbackInfo->asyncWork));
+    NAPI_CALL(env, napi_queue_async_work(env, asyncCallbackInfo->asyncWork));
+    callbackPtr.release();
+    return promise;
+}
+
 static bool InnerGetArchiveInfo(
     napi_env env, const std::string &hapFilePath, const int32_t flags, BundleInfo &bundleInfo)
 {
@@ -82,6 +82,29 @@ struct AsyncBundleInfoCallbackInfo : public AsyncWorkData {
     BundleOptions bundleOptions;
 };
 
+struct AsyncBundleInfoBatchCallbackInfo : public AsyncWorkData {
+    explicit AsyncBundleInfoBatchCallbackInfo(napi_env env) : AsyncWorkData(env) {}
+    std::vector<std::string> bundleNames;
+    int32_t flags = 0;
+    std::vector<OHOS::AppExecFwk::BundleInfo> bundleInfos;
+    // not vector<bool>, whose elements can not be written by several threads
+    std::vector<uint8_t> isFound;
+    bool ret = false;
+    int32_t err = 0;
+    std::string message;
+    BundleOptions bundleOptions;
+};
+
+struct AsyncAbilityInfoBatchCallbackInfo : public AsyncWorkData {
+    explicit AsyncAbilityInfoBatchCallbackInfo(napi_env env) : AsyncWorkData(env) {}
+    std::vector<OHOS::AAFwk::Want> wants;
+    int32_t flags = 0;
+    int32_t userId = Constants::UNSPECIFIED_USERID;
+    std::vector<std::vector<OHOS::AppExecFwk::AbilityInfo>> abilityInfos;
+    bool ret = false;
+    int32_t err = 0;
+};
+
 struct AsyncApplicationInfoCallbackInfo : public AsyncWorkData {
     explicit AsyncApplicationInfoCallbackInfo(napi_env env) : AsyncWorkData(env) {}
     std::string bundleName;
@@ -309,8 +332,10 @@ napi_value GetApplicationInfos(napi_env env, napi_callback_info info);
 napi_value GetApplicationInfo(napi_env env, napi_callback_info info);
 napi_value GetAbilityInfo(napi_env env, napi_callback_info info);
 napi_value QueryAbilityInfos(napi_env env, napi_callback_info info);
+napi_value QueryAbilityInfosBatch(napi_env env, napi_callback_info info);
 napi_value GetBundleInfos(napi_env env, napi_callback_info info);
 napi_value GetBundleInfo(napi_env env, napi_callback_info info);
+napi_value GetBundleInfoBatch(napi_env env, napi_callback_info info);
 napi_value GetBundlePackInfo(napi_env env, napi_callback_info info);
 napi_value GetBundleArchiveInfo(napi_env env, napi_callback_info info);
 napi_value GetLaunchWantForBundle(napi_env env, napi_callback_info info);
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_dispatch_profiler.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "event_handler_utils.h"
+
+DEFINE_HILOG_LABEL("EventDispatchProfiler");
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+// Count of the (handler, event) pairs with the longest total execution time printed in dump.
+constexpr size_t MAX_DUMP_EVENT_STATS_SIZE = 10;
+constexpr uint64_t US_PER_MS = 1000;
+
+inline uint64_t ToMicroseconds(const InnerEvent::TimePoint &from, const InnerEvent::TimePoint &to)
+{
+    if (to <= from) {
+        return 0;
+    }
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
+}
+
+inline size_t GetBucketIndex(uint64_t us)
+{
+    size_t index = 0;
+    while ((us != 0) && (index < LatencyHistogram::BUCKET_COUNT - 1)) {
+        us >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+inline void UpdateMax(std::atomic<uint64_t> &maxValue, uint64_t value)
+{
+    if (value > maxValue.load(std::memory_order_relaxed)) {
+        maxValue.store(value, std::memory_order_relaxed);
+    }
+}
+}  // unnamed namespace
+
+void LatencyHistogram::Add(uint64_t us)
+{
+    buckets_[GetBucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    totalUs_.fetch_add(us, std::memory_order_relaxed);
+    UpdateMax(maxUs_, us);
+}
+
+void LatencyHistogram::Reset()
+{
+    for (auto &bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    totalUs_.store(0, std::memory_order_relaxed);
+    maxUs_.store(0, std::memory_order_relaxed);
+}
+
+std::string LatencyHistogram::ToString() const
+{
+    uint64_t count = count_.load(std::memory_order_relaxed);
+    uint64_t average = (count == 0) ? 0 : (totalUs_.load(std::memory_order_relaxed) / count);
+    std::string content = "count " + std::to_string(count) + ", avg " + std::to_string(average) + "us, max " +
+                          std::to_string(maxUs_.load(std::memory_order_relaxed)) + "us, buckets {";
+    bool first = true;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        uint64_t bucketCount = buckets_[i].load(std::memory_order_relaxed);
+        if (bucketCount == 0) {
+            continue;
+        }
+        if (!first) {
+            content += ", ";
+        }
+        first = false;
+        // Upper bound of the bucket, the last one has none.
+        content += (i == BUCKET_COUNT - 1) ? (">=" + std::to_string(1ULL << (i - 1))) :
+                                             ("<" + std::to_string(1ULL << i));
+        content += "us: " + std::to_string(bucketCount);
+    }
+    return content + "}";
+}
+
+size_t EventDispatchProfiler::EventKeyHash::operator()(const EventKey &key) const
+{
+    size_t hashCode = std::hash<uint64_t>()(key.handlerId);
+    hashCode ^= std::hash<uint32_t>()(key.eventId) + (hashCode << 1);
+    if (!key.taskName.empty()) {
+        hashCode ^= std::hash<std::string>()(key.taskName) + (hashCode << 1);
+    }
+    return hashCode;
+}
+
+void EventDispatchProfiler::Enable(uint64_t slowEventThresholdMs)
+{
+    slowEventThresholdUs_.store(slowEventThresholdMs * US_PER_MS, std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void EventDispatchProfiler::Disable()
+{
+    enabled_.store(false, std::memory_order_relaxed);
+    slowEventCount_.store(0, std::memory_order_relaxed);
+    waitHistogram_.Reset();
+    executeHistogram_.Reset();
+    // The runner thread drops its slots of the former generation at the next record.
+    generation_.fetch_add(1, std::memory_order_release);
+    droppedEventCount_.store(0, std::memory_order_relaxed);
+}
+
+void EventDispatchProfiler::Record(uint64_t handlerId, const InnerEvent &event,
+    const InnerEvent::TimePoint &dispatchTime, const InnerEvent::TimePoint &finishTime)
+{
+    uint64_t waitUs = ToMicroseconds(event.GetHandleTime(), dispatchTime);
+    uint64_t executeUs = ToMicroseconds(dispatchTime, finishTime);
+    waitHistogram_.Add(waitUs);
+    executeHistogram_.Add(executeUs);
+    RecordEventStats(handlerId, event, executeUs);
+
+    uint64_t threshold = slowEventThresholdUs_.load(std::memory_order_relaxed);
+    if ((threshold > 0) && ((waitUs >= threshold) || (executeUs >= threshold))) {
+        slowEventCount_.fetch_add(1, std::memory_order_relaxed);
+        if (event.HasTask()) {
+            HILOGW("Slow event: handler %{public}" PRIu64 ", task name = %{public}s, wait %{public}" PRIu64
+                "us, execute %{public}" PRIu64 "us", handlerId, event.GetTaskName().c_str(), waitUs, executeUs);
+        } else {
+            HILOGW("Slow event: handler %{public}" PRIu64 ", event id = %{public}u, wait %{public}" PRIu64
+                "us, execute %{public}" PRIu64 "us", handlerId, event.GetInnerEventId(), waitUs, executeUs);
+        }
+    }
+}
+
+void EventDispatchProfiler::RecordEventStats(uint64_t handlerId, const InnerEvent &event, uint64_t executeUs)
+{
+    EventKey key;
+    key.handlerId = handlerId;
+    if (event.HasTask()) {
+        key.taskName = event.GetTaskName();
+    } else {
+        key.eventId = event.GetInnerEventId();
+    }
+
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    if (generation != slotGeneration_) {
+        slotIndexes_.clear();
+        slotGeneration_ = generation;
+    }
+    auto it = slotIndexes_.find(key);
+    if (it == slotIndexes_.end()) {
+        if (slotIndexes_.size() >= MAX_EVENT_STATS_SIZE) {
+            droppedEventCount_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        size_t index = slotIndexes_.size();
+        EventStatsSlot &slot = eventStatsSlots_[index];
+        slot.count.store(0, std::memory_order_relaxed);
+        slot.totalUs.store(0, std::memory_order_relaxed);
+        slot.maxUs.store(0, std::memory_order_relaxed);
+        std::atomic_store(&slot.key, std::make_shared<const SlotKey>(SlotKey {key, generation}));
+        it = slotIndexes_.emplace(std::move(key), index).first;
+    }
+    EventStatsSlot &slot = eventStatsSlots_[it->second];
+    slot.count.fetch_add(1, std::memory_order_relaxed);
+    slot.totalUs.fetch_add(executeUs, std::memory_order_relaxed);
+    UpdateMax(slot.maxUs, executeUs);
+}
+
+void EventDispatchProfiler::Dump(const std::string &prefix, std::string &info) const
+{
+    if (!IsEnabled()) {
+        return;
+    }
+    info += prefix + "Dispatch profiling: slow events " +
+            std::to_string(slowEventCount_.load(std::memory_order_relaxed)) + " (threshold " +
+            std::to_string(slowEventThresholdUs_.load(std::memory_order_relaxed) / US_PER_MS) + "ms)" +
+            LINE_SEPARATOR;
+    info += prefix + "Queue wait: " + waitHistogram_.ToString() + LINE_SEPARATOR;
+    info += prefix + "Execution: " + executeHistogram_.ToString() + LINE_SEPARATOR;
+
+    std::vector<std::pair<EventKey, EventStats>> eventStats;
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    for (const auto &slot : eventStatsSlots_) {
+        std::shared_ptr<const SlotKey> slotKey = std::atomic_load(&slot.key);
+        if ((slotKey == nullptr) || (slotKey->generation != generation)) {
+            continue;
+        }
+        EventStats stats;
+        stats.count = slot.count.load(std::memory_order_relaxed);
+        stats.totalUs = slot.totalUs.load(std::memory_order_relaxed);
+        stats.maxUs = slot.maxUs.load(std::memory_order_relaxed);
+        if (stats.count > 0) {
+            eventStats.emplace_back(slotKey->key, stats);
+        }
+    }
+    uint64_t droppedEventCount = droppedEventCount_.load(std::memory_order_relaxed);
+    size_t dumpSize = std::min(eventStats.size(), MAX_DUMP_EVENT_STATS_SIZE);
+    std::partial_sort(eventStats.begin(), eventStats.begin() + dumpSize, eventStats.end(),
+        [](const std::pair<EventKey, EventStats> &left, const std::pair<EventKey, EventStats> &right) {
+            return left.second.totalUs > right.second.totalUs;
+        });
+    for (size_t i = 0; i < dumpSize; ++i) {
+        const EventKey &key = eventStats[i].first;
+        const EventStats &stats = eventStats[i].second;
+        std::string event =
+            key.taskName.empty() ? ("event id = " + std::to_string(key.eventId)) : ("task name = " + key.taskName);
+        info += prefix + "Handler(id " + std::to_string(key.handlerId) + "), " + event + ": count " +
+                std::to_string(stats.count) + ", total " + std::to_string(stats.totalUs) + "us, avg " +
+                std::to_string(stats.totalUs / stats.count) + "us, max " + std::to_string(stats.maxUs) + "us" +
+                LINE_SEPARATOR;
+    }
+    if (droppedEventCount > 0) {
+        info += prefix + "Events of other handlers not counted: " + std::to_string(droppedEventCount) +
+                LINE_SEPARATOR;
+    }
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
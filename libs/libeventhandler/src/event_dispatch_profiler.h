@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_LIBS_LIBEVENTHANDLER_SRC_EVENT_DISPATCH_PROFILER_H
+#define FOUNDATION_APPEXECFWK_LIBS_LIBEVENTHANDLER_SRC_EVENT_DISPATCH_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "inner_event.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+// Histogram of durations in microseconds, bucket 'i' counts the durations in [2^(i-1), 2^i) us.
+class LatencyHistogram final {
+public:
+    static constexpr size_t BUCKET_COUNT = 24;
+
+    LatencyHistogram() = default;
+    ~LatencyHistogram() = default;
+    DISALLOW_COPY_AND_MOVE(LatencyHistogram);
+
+    /*
+     * Add a duration, only called by the runner thread, so plain relaxed stores are enough.
+     */
+    void Add(uint64_t us);
+    void Reset();
+    std::string ToString() const;
+
+private:
+    std::atomic<uint64_t> buckets_[BUCKET_COUNT] {};
+    std::atomic<uint64_t> count_ {0};
+    std::atomic<uint64_t> totalUs_ {0};
+    std::atomic<uint64_t> maxUs_ {0};
+};
+
+/*
+ * Opt-in statistics of the events dispatched by an event runner: how long the events waited after their
+ * handle time, how long their handlers ran, per handler and event id or task name, and how many of them
+ * were slow. Nothing is recorded, and no time is read, while it is disabled.
+ */
+class EventDispatchProfiler final {
+public:
+    EventDispatchProfiler() = default;
+    ~EventDispatchProfiler() = default;
+    DISALLOW_COPY_AND_MOVE(EventDispatchProfiler);
+
+    void Enable(uint64_t slowEventThresholdMs);
+    void Disable();
+
+    inline bool IsEnabled() const
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Record an event dispatched by the runner thread, it takes no lock.
+     *
+     * @param handlerId Id of the handler which the event is distributed to.
+     * @param event The event, must not be released yet.
+     * @param dispatchTime Time when the event is taken out of the queue.
+     * @param finishTime Time when the handler returns.
+     */
+    void Record(uint64_t handlerId, const InnerEvent &event, const InnerEvent::TimePoint &dispatchTime,
+        const InnerEvent::TimePoint &finishTime);
+
+    /*
+     * Append the statistics to 'info', one line for each item, every line starts with 'prefix'.
+     */
+    void Dump(const std::string &prefix, std::string &info) const;
+
+private:
+    // Limit the count of (handler, event) pairs to keep statistics for, the others are only counted.
+    static constexpr size_t MAX_EVENT_STATS_SIZE = 128;
+
+    struct EventKey {
+        uint64_t handlerId {0};
+        uint32_t eventId {0};
+        std::string taskName;
+
+        bool operator==(const EventKey &other) const
+        {
+            return (handlerId == other.handlerId) && (eventId == other.eventId) && (taskName == other.taskName);
+        }
+    };
+
+    struct EventKeyHash {
+        size_t operator()(const EventKey &key) const;
+    };
+
+    struct EventStats {
+        uint64_t count {0};
+        uint64_t totalUs {0};
+        uint64_t maxUs {0};
+    };
+
+    struct SlotKey {
+        EventKey key;
+        // Slots taken before the last 'Disable' belong to a former generation, and are not dumped.
+        uint64_t generation {0};
+    };
+
+    // Statistics of a (handler, event) pair. The runner thread resets the counters and then publishes the key
+    // when it takes the slot, dumping reads the key by 'std::atomic_load' and the counters without a lock.
+    struct EventStatsSlot {
+        std::shared_ptr<const SlotKey> key;
+        std::atomic<uint64_t> count {0};
+        std::atomic<uint64_t> totalUs {0};
+        std::atomic<uint64_t> maxUs {0};
+    };
+
+    void RecordEventStats(uint64_t handlerId, const InnerEvent &event, uint64_t executeUs);
+
+    std::atomic<bool> enabled_ {false};
+    std::atomic<uint64_t> slowEventThresholdUs_ {0};
+    std::atomic<uint64_t> slowEventCount_ {0};
+    LatencyHistogram waitHistogram_;
+    LatencyHistogram executeHistogram_;
+
+    std::atomic<uint64_t> generation_ {0};
+    std::atomic<uint64_t> droppedEventCount_ {0};
+    std::array<EventStatsSlot, MAX_EVENT_STATS_SIZE> eventStatsSlots_;
+    // Only accessed by the runner thread: index of the slot of each pair taken in 'slotGeneration_'.
+    std::unordered_map<EventKey, size_t, EventKeyHash> slotIndexes_;
+    uint64_t slotGeneration_ {0};
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef FOUNDATION_APPEXECFWK_LIBS_LIBEVENTHANDLER_SRC_EVENT_DISPATCH_PROFILER_H
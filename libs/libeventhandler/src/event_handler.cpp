@@ -15,6 +15,7 @@
 
 #include "event_handler.h"
 
+#include <atomic>
 #include <unistd.h>
 #include "event_handler_utils.h"
 #include "hichecker.h"
@@ -26,6 +27,7 @@ using namespace OHOS::HiviewDFX;
 namespace OHOS {
 namespace AppExecFwk {
 static constexpr int DATETIME_STRING_LENGTH = 80;
+static std::atomic<uint64_t> nextHandlerId {1};
 
 ThreadLocalData<std::weak_ptr<EventHandler>> EventHandler::currentEventHandler;
 
@@ -35,7 +37,8 @@ std::shared_ptr<EventHandler> EventHandler::Current()
     return wp.lock();
 }
 
-EventHandler::EventHandler(const std::shared_ptr<EventRunner> &runner) : eventRunner_(runner)
+EventHandler::EventHandler(const std::shared_ptr<EventRunner> &runner)
+    : handlerId_(nextHandlerId.fetch_add(1, std::memory_order_relaxed)), eventRunner_(runner)
 {}
 
 EventHandler::~EventHandler()
@@ -244,7 +247,11 @@ void EventHandler::DeliveryTimeAction(const InnerEvent::Pointer &event, InnerEve
         return;
     }
     int64_t deliveryTimeout = eventRunner_->GetDeliveryTimeout();
-    if (deliveryTimeout > 0) {
+    if (deliveryTimeout <= 0) {
+        return;
+    }
+    // Only format the tag of the events which are slow.
+    if ((nowStart - std::chrono::milliseconds(deliveryTimeout)) > event->GetHandleTime()) {
         std::string threadName = eventRunner_->GetRunnerThreadName();
         std::string eventName = GetEventName(event);
         int64_t threadId = gettid();
@@ -255,11 +262,9 @@ void EventHandler::DeliveryTimeAction(const InnerEvent::Pointer &event, InnerEve
         std::string handOutTag = "threadId: " + threadIdCharacter + "," + "threadName: " + threadName + "," +
             "eventName: " + eventName + "," + "deliveryTime: " + deliveryTimeCharacter + "," +
             "deliveryTimeout: " + deliveryTimeoutCharacter;
-        if ((nowStart - std::chrono::milliseconds(deliveryTimeout)) > event->GetHandleTime()) {
-            HiChecker::NotifySlowEvent(handOutTag);
-            if (deliveryTimeoutCallback_) {
-                deliveryTimeoutCallback_();
-            }
+        HiChecker::NotifySlowEvent(handOutTag);
+        if (deliveryTimeoutCallback_) {
+            deliveryTimeoutCallback_();
         }
     }
 }
@@ -270,23 +275,25 @@ void EventHandler::DistributeTimeAction(const InnerEvent::Pointer &event, InnerE
         return;
     }
     int64_t distributeTimeout = eventRunner_->GetDistributeTimeout();
-    if (distributeTimeout > 0) {
+    if (distributeTimeout <= 0) {
+        return;
+    }
+    InnerEvent::TimePoint nowEnd = InnerEvent::Clock::now();
+    // Only format the tag of the events which are slow.
+    if ((nowEnd - std::chrono::milliseconds(distributeTimeout)) > nowStart) {
         std::string threadName = eventRunner_->GetRunnerThreadName();
         std::string eventName = GetEventName(event);
         int64_t threadId = gettid();
         std::string threadIdCharacter = std::to_string(threadId);
-        InnerEvent::TimePoint nowEnd = InnerEvent::Clock::now();
         std::chrono::duration<double> distributeTime = nowEnd - nowStart;
         std::string distributeTimeCharacter = std::to_string((distributeTime).count());
         std::string distributeTimeoutCharacter = std::to_string(distributeTimeout);
         std::string executeTag = "threadId: " + threadIdCharacter + "," + "threadName: " + threadName + "," +
             "eventName: " + eventName + "," + "distributeTime: " + distributeTimeCharacter + "," +
             "distributeTimeout: " + distributeTimeoutCharacter;
-        if ((nowEnd - std::chrono::milliseconds(distributeTimeout)) > nowStart) {
-            HiChecker::NotifySlowEvent(executeTag);
-            if (distributeTimeoutCallback_) {
-                distributeTimeoutCallback_();
-            }
+        HiChecker::NotifySlowEvent(executeTag);
+        if (distributeTimeoutCallback_) {
+            distributeTimeoutCallback_();
         }
     }
 }
@@ -16,6 +16,7 @@
 #ifndef FOUNDATION_APPEXECFWK_LIBS_LIBEVENTHANDLER_SRC_EVENT_INNER_RUNNER_H
 #define FOUNDATION_APPEXECFWK_LIBS_LIBEVENTHANDLER_SRC_EVENT_INNER_RUNNER_H
 
+#include "event_dispatch_profiler.h"
 #include "event_handler_utils.h"
 #include "event_queue.h"
 #include "event_runner.h"
@@ -45,6 +46,11 @@ public:
         logger_ = logger;
     }
 
+    EventDispatchProfiler &GetProfiler()
+    {
+        return profiler_;
+    }
+
     const std::string &GetThreadName()
     {
         return threadName_;
@@ -59,6 +65,7 @@ protected:
     std::shared_ptr<EventQueue> queue_;
     std::weak_ptr<EventRunner> owner_;
     std::shared_ptr<Logger> logger_;
+    EventDispatchProfiler profiler_;
     static ThreadLocalData<std::weak_ptr<EventRunner>> currentEventRunner;
     std::string threadName_;
     std::thread::id threadId_;
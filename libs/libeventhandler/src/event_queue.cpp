@@ -20,6 +20,7 @@
 #include "epoll_io_waiter.h"
 #include "event_handler.h"
 #include "event_handler_utils.h"
+#include "immediate_event_ring.h"
 #include "none_io_waiter.h"
 
 DEFINE_HILOG_LABEL("EventQueue");
@@ -27,17 +28,35 @@ DEFINE_HILOG_LABEL("EventQueue");
 namespace OHOS {
 namespace AppExecFwk {
 namespace {
-// Help to insert events into the event queue sorted by handle time.
-inline void InsertEventsLocked(std::list<InnerEvent::Pointer> &events, InnerEvent::Pointer &event)
+// Help to collect positions of indexed events which match the filter.
+template<typename Iterator, typename Filter, typename Position>
+void CollectEventPositions(Iterator begin, Iterator end, const Filter &filter, std::vector<Position> &positions)
 {
-    auto f = [](const InnerEvent::Pointer &first, const InnerEvent::Pointer &second) {
-        if (!first || !second) {
-            return false;
+    for (auto it = begin; it != end; ++it) {
+        if (filter(it->second.iter->second.event)) {
+            positions.emplace_back(it->second);
         }
-        return first->GetHandleTime() < second->GetHandleTime();
-    };
-    auto it = std::upper_bound(events.begin(), events.end(), event, f);
-    events.insert(it, std::move(event));
+    }
+}
+
+// Help to check whether any indexed event matches the filter.
+template<typename Iterator, typename Filter>
+bool FindEventPosition(Iterator begin, Iterator end, const Filter &filter)
+{
+    for (auto it = begin; it != end; ++it) {
+        if (filter(it->second.iter->second.event)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Help to get the index entries with the key, they are sorted by insertion sequence.
+template<typename Index, typename Key>
+inline std::pair<typename Index::iterator, typename Index::iterator> EqualRange(Index &index, const Key &key)
+{
+    return std::make_pair(index.lower_bound(typename Index::key_type(key, 0)),
+        index.upper_bound(typename Index::key_type(key, UINT64_MAX)));
 }
 
 // Help to remove file descriptor listeners.
@@ -59,11 +78,12 @@ void RemoveFileDescriptorListenerLocked(std::map<int32_t, std::shared_ptr<FileDe
 }
 
 // Help to check whether there is a valid event in list and update wake up time.
-inline bool CheckEventInListLocked(const std::list<InnerEvent::Pointer> &events, const InnerEvent::TimePoint &now,
+template<typename List>
+inline bool CheckEventInListLocked(const List &events, const InnerEvent::TimePoint &now,
     InnerEvent::TimePoint &nextWakeUpTime)
 {
     if (!events.empty()) {
-        const auto &handleTime = events.front()->GetHandleTime();
+        const auto &handleTime = events.begin()->first;
         if (handleTime < nextWakeUpTime) {
             nextWakeUpTime = handleTime;
             return handleTime <= now;
@@ -72,20 +92,15 @@ inline bool CheckEventInListLocked(const std::list<InnerEvent::Pointer> &events,
 
     return false;
 }
-
-inline InnerEvent::Pointer PopFrontEventFromListLocked(std::list<InnerEvent::Pointer> &events)
-{
-    InnerEvent::Pointer event = std::move(events.front());
-    events.pop_front();
-    return event;
-}
 }  // unnamed namespace
 
-EventQueue::EventQueue() : ioWaiter_(std::make_shared<NoneIoWaiter>())
+EventQueue::EventQueue()
+    : ioWaiter_(std::make_shared<NoneIoWaiter>()), immediateEvents_(std::make_unique<ImmediateEventRing>())
 {}
 
 EventQueue::EventQueue(const std::shared_ptr<IoWaiter> &ioWaiter)
-    : ioWaiter_(ioWaiter ? ioWaiter : std::make_shared<NoneIoWaiter>())
+    : ioWaiter_(ioWaiter ? ioWaiter : std::make_shared<NoneIoWaiter>()),
+      immediateEvents_(std::make_unique<ImmediateEventRing>())
 {
     if (ioWaiter_->SupportListeningFileDescriptor()) {
         // Set callback to handle events from file descriptors.
@@ -94,6 +109,9 @@ EventQueue::EventQueue(const std::shared_ptr<IoWaiter> &ioWaiter)
     }
 }
 
+EventQueue::~EventQueue()
+{}
+
 void EventQueue::Insert(InnerEvent::Pointer &event, Priority priority)
 {
     if (!event) {
@@ -101,19 +119,27 @@ void EventQueue::Insert(InnerEvent::Pointer &event, Priority priority)
         return;
     }
 
+    // Zero-delay immediate events do not need to be sorted, so skip the lock if possible.
+    if ((priority == Priority::IMMEDIATE) && (event->GetHandleTime() <= event->GetSendTime()) &&
+        InsertImmediateEvent(event)) {
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(queueLock_);
+    // Keep order with the immediate events which are inserted before.
+    DrainImmediateEventsLocked();
     bool needNotify = false;
     switch (priority) {
         case Priority::IMMEDIATE:
         case Priority::HIGH:
         case Priority::LOW: {
             needNotify = (event->GetHandleTime() < wakeUpTime_);
-            InsertEventsLocked(subEventQueues_[static_cast<uint32_t>(priority)].queue, event);
+            InsertEventLocked(subEventQueues_[static_cast<uint32_t>(priority)].queue, event);
             break;
         }
         case Priority::IDLE: {
             // Never wake up thread if insert an idle event.
-            InsertEventsLocked(idleEvents_, event);
+            InsertEventLocked(idleEvents_, event);
             break;
         }
         default:
@@ -153,7 +179,16 @@ void EventQueue::Remove(const std::shared_ptr<EventHandler> &owner)
 
     auto filter = [&owner](const InnerEvent::Pointer &p) { return (p->GetOwner() == owner); };
 
-    Remove(filter);
+    std::lock_guard<std::mutex> lock(queueLock_);
+    DrainImmediateEventsLocked();
+    auto index = ownerIndexes_.find(owner.get());
+    if (index == ownerIndexes_.end()) {
+        return;
+    }
+    std::vector<EventPosition> positions;
+    CollectEventPositions(index->second.events.begin(), index->second.events.end(), filter, positions);
+    CollectEventPositions(index->second.tasks.begin(), index->second.tasks.end(), filter, positions);
+    EraseEventsLocked(positions);
 }
 
 void EventQueue::Remove(const std::shared_ptr<EventHandler> &owner, uint32_t innerEventId)
@@ -167,7 +202,16 @@ void EventQueue::Remove(const std::shared_ptr<EventHandler> &owner, uint32_t inn
         return (!p->HasTask()) && (p->GetOwner() == owner) && (p->GetInnerEventId() == innerEventId);
     };
 
-    Remove(filter);
+    std::lock_guard<std::mutex> lock(queueLock_);
+    DrainImmediateEventsLocked();
+    auto index = ownerIndexes_.find(owner.get());
+    if (index == ownerIndexes_.end()) {
+        return;
+    }
+    std::vector<EventPosition> positions;
+    auto range = EqualRange(index->second.events, innerEventId);
+    CollectEventPositions(range.first, range.second, filter, positions);
+    EraseEventsLocked(positions);
 }
 
 void EventQueue::Remove(const std::shared_ptr<EventHandler> &owner, uint32_t innerEventId, int64_t param)
@@ -182,7 +226,16 @@ void EventQueue::Remove(const std::shared_ptr<EventHandler> &owner, uint32_t inn
                (p->GetParam() == param);
     };
 
-    Remove(filter);
+    std::lock_guard<std::mutex> lock(queueLock_);
+    DrainImmediateEventsLocked();
+    auto index = ownerIndexes_.find(owner.get());
+    if (index == ownerIndexes_.end()) {
+        return;
+    }
+    std::vector<EventPosition> positions;
+    auto range = EqualRange(index->second.events, innerEventId);
+    CollectEventPositions(range.first, range.second, filter, positions);
+    EraseEventsLocked(positions);
 }
 
 void EventQueue::Remove(const std::shared_ptr<EventHandler> &owner, const std::string &name)
@@ -196,16 +249,29 @@ void EventQueue::Remove(const std::shared_ptr<EventHandler> &owner, const std::s
         return (p->HasTask()) && (p->GetOwner() == owner) && (p->GetTaskName() == name);
     };
 
-    Remove(filter);
+    std::lock_guard<std::mutex> lock(queueLock_);
+    DrainImmediateEventsLocked();
+    auto index = ownerIndexes_.find(owner.get());
+    if (index == ownerIndexes_.end()) {
+        return;
+    }
+    std::vector<EventPosition> positions;
+    auto range = EqualRange(index->second.tasks, name);
+    CollectEventPositions(range.first, range.second, filter, positions);
+    EraseEventsLocked(positions);
 }
 
 void EventQueue::Remove(const RemoveFilter &filter)
 {
     std::lock_guard<std::mutex> lock(queueLock_);
-    for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-        subEventQueues_[i].queue.remove_if(filter);
-    }
-    idleEvents_.remove_if(filter);
+    DrainImmediateEventsLocked();
+    // Owners of events are checked one by one, so walk the owner index instead of the event lists.
+    std::vector<EventPosition> positions;
+    for (const auto &index : ownerIndexes_) {
+        CollectEventPositions(index.second.events.begin(), index.second.events.end(), filter, positions);
+        CollectEventPositions(index.second.tasks.begin(), index.second.tasks.end(), filter, positions);
+    }
+    EraseEventsLocked(positions);
 }
 
 bool EventQueue::HasInnerEvent(const std::shared_ptr<EventHandler> &owner, uint32_t innerEventId)
@@ -217,7 +283,15 @@ bool EventQueue::HasInnerEvent(const std::shared_ptr<EventHandler> &owner, uint3
     auto filter = [&owner, innerEventId](const InnerEvent::Pointer &p) {
         return (!p->HasTask()) && (p->GetOwner() == owner) && (p->GetInnerEventId() == innerEventId);
     };
-    return HasInnerEvent(filter);
+
+    std::lock_guard<std::mutex> lock(queueLock_);
+    DrainImmediateEventsLocked();
+    auto index = ownerIndexes_.find(owner.get());
+    if (index == ownerIndexes_.end()) {
+        return false;
+    }
+    auto range = EqualRange(index->second.events, innerEventId);
+    return FindEventPosition(range.first, range.second, filter);
 }
 
 bool EventQueue::HasInnerEvent(const std::shared_ptr<EventHandler> &owner, int64_t param)
@@ -229,21 +303,56 @@ bool EventQueue::HasInnerEvent(const std::shared_ptr<EventHandler> &owner, int64
     auto filter = [&owner, param](const InnerEvent::Pointer &p) {
         return (!p->HasTask()) && (p->GetOwner() == owner) && (p->GetParam() == param);
     };
-    return HasInnerEvent(filter);
+
+    std::lock_guard<std::mutex> lock(queueLock_);
+    DrainImmediateEventsLocked();
+    auto index = ownerIndexes_.find(owner.get());
+    if (index == ownerIndexes_.end()) {
+        return false;
+    }
+    return FindEventPosition(index->second.events.begin(), index->second.events.end(), filter);
 }
 
-bool EventQueue::HasInnerEvent(const HasFilter &filter)
+void EventQueue::InsertEventLocked(EventList &events, InnerEvent::Pointer &event)
 {
-    std::lock_guard<std::mutex> lock(queueLock_);
-    for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-        std::list<InnerEvent::Pointer>::iterator iter =
-            std::find_if(subEventQueues_[i].queue.begin(), subEventQueues_[i].queue.end(), filter);
-        if (iter != subEventQueues_[i].queue.end()) {
-            return true;
+    const EventHandler *owner = event->GetOwner().get();
+    InnerEvent::TimePoint handleTime = event->GetHandleTime();
+    // Events with the same handle time are inserted at the upper bound, so they keep FIFO order.
+    uint64_t sequence = ++eventSequence_;
+    auto iter = events.emplace(handleTime, QueuedEvent { std::move(event), owner, sequence });
+    const InnerEvent::Pointer &queuedEvent = iter->second.event;
+    EventPosition position { &events, iter };
+    OwnerIndex &index = ownerIndexes_[owner];
+    if (queuedEvent->HasTask()) {
+        index.tasks.emplace(std::make_pair(queuedEvent->GetTaskName(), sequence), position);
+    } else {
+        index.events.emplace(std::make_pair(queuedEvent->GetInnerEventId(), sequence), position);
+    }
+}
+
+InnerEvent::Pointer EventQueue::EraseEventLocked(EventList &events, EventList::iterator iter)
+{
+    InnerEvent::Pointer event = std::move(iter->second.event);
+    auto index = ownerIndexes_.find(iter->second.owner);
+    if (index != ownerIndexes_.end()) {
+        if (event->HasTask()) {
+            index->second.tasks.erase(std::make_pair(event->GetTaskName(), iter->second.sequence));
+        } else {
+            index->second.events.erase(std::make_pair(event->GetInnerEventId(), iter->second.sequence));
+        }
+        if (index->second.events.empty() && index->second.tasks.empty()) {
+            ownerIndexes_.erase(index);
         }
     }
-    std::list<InnerEvent::Pointer>::iterator iter = std::find_if(idleEvents_.begin(), idleEvents_.end(), filter);
-    return iter != idleEvents_.end();
+    events.erase(iter);
+    return event;
+}
+
+void EventQueue::EraseEventsLocked(const std::vector<EventPosition> &positions)
+{
+    for (const auto &position : positions) {
+        EraseEventLocked(*position.events, position.iter);
+    }
 }
 
 InnerEvent::Pointer EventQueue::PickEventLocked(const InnerEvent::TimePoint &now, InnerEvent::TimePoint &nextWakeUpTime)
@@ -279,11 +388,13 @@ InnerEvent::Pointer EventQueue::PickEventLocked(const InnerEvent::TimePoint &now
         subEventQueues_[i].handledEventsCount = 0;
     }
 
-    return PopFrontEventFromListLocked(subEventQueues_[priorityIndex].queue);
+    EventList &events = subEventQueues_[priorityIndex].queue;
+    return EraseEventLocked(events, events.begin());
 }
 
 InnerEvent::Pointer EventQueue::GetExpiredEventLocked(InnerEvent::TimePoint &nextExpiredTime)
 {
+    DrainImmediateEventsLocked();
     auto now = InnerEvent::Clock::now();
     wakeUpTime_ = InnerEvent::TimePoint::max();
     // Find an event which could be distributed right now.
@@ -301,11 +412,11 @@ InnerEvent::Pointer EventQueue::GetExpiredEventLocked(InnerEvent::TimePoint &nex
     }
 
     if (!idleEvents_.empty()) {
-        const auto &idleEvent = idleEvents_.front();
+        const auto &idleEvent = idleEvents_.begin()->second.event;
 
         // Return the idle event that has been sent before time stamp and reaches its handle time.
         if ((idleEvent->GetSendTime() <= idleTimeStamp_) && (idleEvent->GetHandleTime() <= now)) {
-            return PopFrontEventFromListLocked(idleEvents_);
+            return EraseEventLocked(idleEvents_, idleEvents_.begin());
         }
     }
 
@@ -323,7 +434,15 @@ InnerEvent::Pointer EventQueue::GetEvent()
         if (event) {
             return event;
         }
+
+        // Mark waiting before checking immediate events at last, so any event inserted later will wake up thread.
+        isWaiting_.store(true);
+        if (immediateEvents_->HasEvent()) {
+            isWaiting_.store(false);
+            continue;
+        }
         WaitUntilLocked(nextWakeUpTime, lock);
+        isWaiting_.store(false);
     }
 
     HILOGD("GetEvent: Break out");
@@ -476,6 +595,31 @@ void EventQueue::HandleFileDescriptorEvent(int32_t fileDescriptor, uint32_t even
     handler->PostHighPriorityTask(f);
 }
 
+bool EventQueue::InsertImmediateEvent(InnerEvent::Pointer &event)
+{
+    if (!immediateEvents_->Push(event)) {
+        // Ring is full, fall back to insert under the lock.
+        return false;
+    }
+
+    // Only wake up thread if it is blocked, so notifications are coalesced while it is running.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (isWaiting_.exchange(false)) {
+        // Lock to make sure the thread is already blocked in io waiter before notifying it.
+        std::lock_guard<std::mutex> lock(queueLock_);
+        ioWaiter_->NotifyOne();
+    }
+    return true;
+}
+
+void EventQueue::DrainImmediateEventsLocked()
+{
+    EventList &events = subEventQueues_[static_cast<uint32_t>(Priority::IMMEDIATE)].queue;
+    for (auto event = immediateEvents_->Pop(); event; event = immediateEvents_->Pop()) {
+        InsertEventLocked(events, event);
+    }
+}
+
 bool EventQueue::EnsureIoWaiterSupportListerningFileDescriptorLocked()
 {
     if (ioWaiter_->SupportListeningFileDescriptor()) {
@@ -500,6 +644,7 @@ bool EventQueue::EnsureIoWaiterSupportListerningFileDescriptorLocked()
 void EventQueue::Dump(Dumper &dumper)
 {
     std::lock_guard<std::mutex> lock(queueLock_);
+    DrainImmediateEventsLocked();
     std::string priority[] = {"Immediate", "High", "Low"};
     uint32_t total = 0;
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
@@ -507,7 +652,7 @@ void EventQueue::Dump(Dumper &dumper)
         dumper.Dump(dumper.GetTag() + " " + priority[i] + " priority event queue information:" + LINE_SEPARATOR);
         for (auto it = subEventQueues_[i].queue.begin(); it != subEventQueues_[i].queue.end(); ++it) {
             ++n;
-            dumper.Dump(dumper.GetTag() + " No." + std::to_string(n) + " : " + (*it)->Dump());
+            dumper.Dump(dumper.GetTag() + " No." + std::to_string(n) + " : " + it->second.event->Dump());
             ++total;
         }
         dumper.Dump(
@@ -518,7 +663,7 @@ void EventQueue::Dump(Dumper &dumper)
     int n = 0;
     for (auto it = idleEvents_.begin(); it != idleEvents_.end(); ++it) {
         ++n;
-        dumper.Dump(dumper.GetTag() + " No." + std::to_string(n) + " : " + (*it)->Dump());
+        dumper.Dump(dumper.GetTag() + " No." + std::to_string(n) + " : " + it->second.event->Dump());
         ++total;
     }
     dumper.Dump(dumper.GetTag() + " Total size of Idle events : " + std::to_string(n) + LINE_SEPARATOR);
@@ -529,6 +674,7 @@ void EventQueue::Dump(Dumper &dumper)
 void EventQueue::DumpQueueInfo(std::string& queueInfo)
 {
     std::lock_guard<std::mutex> lock(queueLock_);
+    DrainImmediateEventsLocked();
     std::string priority[] = {"Immediate", "High", "Low"};
     uint32_t total = 0;
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
@@ -536,7 +682,7 @@ void EventQueue::DumpQueueInfo(std::string& queueInfo)
         queueInfo +=  "            " + priority[i] + " priority event queue:" + LINE_SEPARATOR;
         for (auto it = subEventQueues_[i].queue.begin(); it != subEventQueues_[i].queue.end(); ++it) {
             ++n;
-            queueInfo +=  "            No." + std::to_string(n) + " : " + (*it)->Dump();
+            queueInfo +=  "            No." + std::to_string(n) + " : " + it->second.event->Dump();
             ++total;
         }
         queueInfo +=  "              Total size of " + priority[i] + " events : " + std::to_string(n) + LINE_SEPARATOR;
@@ -547,7 +693,7 @@ void EventQueue::DumpQueueInfo(std::string& queueInfo)
     int n = 0;
     for (auto it = idleEvents_.begin(); it != idleEvents_.end(); ++it) {
         ++n;
-        queueInfo += "            No." + std::to_string(n) + " : " + (*it)->Dump();
+        queueInfo += "            No." + std::to_string(n) + " : " + it->second.event->Dump();
         ++total;
     }
     queueInfo += "              Total size of Idle events : " + std::to_string(n) + LINE_SEPARATOR;
@@ -563,14 +709,14 @@ bool EventQueue::IsIdle()
 bool EventQueue::IsQueueEmpty()
 {
     std::lock_guard<std::mutex> lock(queueLock_);
+    DrainImmediateEventsLocked();
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-        uint32_t queueSize = subEventQueues_[i].queue.size();
-        if (queueSize != 0) {
+        if (!subEventQueues_[i].queue.empty()) {
             return false;
         }
     }
 
-    return idleEvents_.size() == 0;
+    return idleEvents_.empty();
 }
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -27,6 +27,7 @@
 #include "event_handler.h"
 #include "event_handler_utils.h"
 #include "event_inner_runner.h"
+#include "inner_event_pool.h"
 #include "singleton.h"
 #include "thread_local_data.h"
 
@@ -320,8 +321,6 @@ public:
             // Make sure owner of the event exists.
             if (handler) {
                 std::shared_ptr<Logger> logging = logger_;
-                std::stringstream address;
-                address << handler.get();
                 if (logging != nullptr) {
                     if (!event->HasTask()) {
                         logging->Log("Dispatching to handler event id = " + std::to_string(event->GetInnerEventId()));
@@ -329,9 +328,17 @@ public:
                         logging->Log("Dispatching to handler event task name = " + event->GetTaskName());
                     }
                 }
-                handler->DistributeEvent(event);
+                if (profiler_.IsEnabled()) {
+                    InnerEvent::TimePoint dispatchTime = InnerEvent::Clock::now();
+                    handler->DistributeEvent(event);
+                    profiler_.Record(handler->GetHandlerId(), *event, dispatchTime, InnerEvent::Clock::now());
+                } else {
+                    handler->DistributeEvent(event);
+                }
 
                 if (logging != nullptr) {
+                    std::stringstream address;
+                    address << handler.get();
                     logging->Log("Finished to handler(0x" + address.str() + ")");
                 }
             }
@@ -510,6 +517,19 @@ void EventRunner::Dump(Dumper &dumper)
                 ", Thread ID = " + std::to_string(GetThreadId()) + ") is running" + LINE_SEPARATOR);
 
     queue_->Dump(dumper);
+
+    std::string profilingInfo;
+    innerRunner_->GetProfiler().Dump(dumper.GetTag() + " ", profilingInfo);
+    if (!profilingInfo.empty()) {
+        dumper.Dump(profilingInfo);
+    }
+
+    InnerEventPoolStats poolStats = GetInnerEventPoolStats();
+    dumper.Dump(dumper.GetTag() + " Inner event pool: using " + std::to_string(poolStats.usingCount) +
+                ", peak using " + std::to_string(poolStats.peakUsingCount) + ", cached " +
+                std::to_string(poolStats.cachedCount) + "/" + std::to_string(poolStats.capacity) + ", allocated " +
+                std::to_string(poolStats.allocatedCount) + ", reused " + std::to_string(poolStats.reusedCount) +
+                ", released " + std::to_string(poolStats.releasedCount) + LINE_SEPARATOR);
 }
 
 void EventRunner::DumpRunnerInfo(std::string& runnerInfo)
@@ -526,6 +546,7 @@ void EventRunner::DumpRunnerInfo(std::string& runnerInfo)
     std::string queueInfo;
     queue_->DumpQueueInfo(queueInfo);
     runnerInfo += queueInfo;
+    innerRunner_->GetProfiler().Dump("        ", runnerInfo);
 }
 
 void EventRunner::SetLogger(const std::shared_ptr<Logger> &logger)
@@ -533,6 +554,16 @@ void EventRunner::SetLogger(const std::shared_ptr<Logger> &logger)
     innerRunner_->SetLogger(logger);
 }
 
+void EventRunner::EnableDispatchProfiling(uint64_t slowEventThresholdMs)
+{
+    innerRunner_->GetProfiler().Enable(slowEventThresholdMs);
+}
+
+void EventRunner::DisableDispatchProfiling()
+{
+    innerRunner_->GetProfiler().Disable();
+}
+
 std::shared_ptr<EventQueue> EventRunner::GetCurrentEventQueue()
 {
     auto runner = EventRunner::Current();
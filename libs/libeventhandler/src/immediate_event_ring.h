@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_LIBS_LIBEVENTHANDLER_SRC_IMMEDIATE_EVENT_RING_H
+#define FOUNDATION_APPEXECFWK_LIBS_LIBEVENTHANDLER_SRC_IMMEDIATE_EVENT_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "inner_event.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/*
+ * Bounded lock-free ring, used to pass zero-delay immediate events from many producer threads to event queue.
+ * Any thread could push events without blocking, but popping MUST be serialized by caller.
+ */
+class ImmediateEventRing final {
+public:
+    ImmediateEventRing() : slots_(CAPACITY)
+    {
+        for (uint64_t i = 0; i < CAPACITY; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    ~ImmediateEventRing() = default;
+    DISALLOW_COPY_AND_MOVE(ImmediateEventRing);
+
+    /*
+     * Push an event into the ring.
+     * Returns false and keeps the event unchanged if the ring is full.
+     */
+    bool Push(InnerEvent::Pointer &event)
+    {
+        uint64_t position = enqueuePosition_.load(std::memory_order_relaxed);
+        Slot *slot = nullptr;
+        for (;;) {
+            slot = &slots_[position & MASK];
+            uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(sequence - position);
+            if (diff == 0) {
+                // Slot is free, try to claim it.
+                if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Slot is not popped yet, so the ring is full.
+                return false;
+            } else {
+                // Slot is claimed by another producer, try next one.
+                position = enqueuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->event = std::move(event);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*
+     * Pop the oldest published event, returns nullptr if no event is ready.
+     */
+    InnerEvent::Pointer Pop()
+    {
+        Slot &slot = slots_[dequeuePosition_ & MASK];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition_ + 1) {
+            return InnerEvent::Pointer(nullptr, nullptr);
+        }
+
+        InnerEvent::Pointer event = std::move(slot.event);
+        slot.sequence.store(dequeuePosition_ + CAPACITY, std::memory_order_release);
+        ++dequeuePosition_;
+        return event;
+    }
+
+    /*
+     * Check whether the oldest event is published, MUST be serialized with 'Pop'.
+     */
+    bool HasEvent() const
+    {
+        const Slot &slot = slots_[dequeuePosition_ & MASK];
+        return slot.sequence.load(std::memory_order_seq_cst) == dequeuePosition_ + 1;
+    }
+
+private:
+    // MUST be power of 2.
+    static const uint64_t CAPACITY = 256;
+    static const uint64_t MASK = CAPACITY - 1;
+
+    struct Slot {
+        std::atomic<uint64_t> sequence {0};
+        InnerEvent::Pointer event {nullptr, nullptr};
+    };
+
+    std::vector<Slot> slots_;
+
+    // Keep producer and consumer positions in different cache lines.
+    alignas(64) std::atomic<uint64_t> enqueuePosition_ {0};
+    alignas(64) uint64_t dequeuePosition_ {0};
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef FOUNDATION_APPEXECFWK_LIBS_LIBEVENTHANDLER_SRC_IMMEDIATE_EVENT_RING_H
@@ -15,11 +15,14 @@
 
 #include "inner_event.h"
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <vector>
 
 #include "event_handler_utils.h"
+#include "inner_event_pool.h"
 #include "singleton.h"
 
 DEFINE_HILOG_LABEL("InnerEvent");
@@ -69,78 +72,155 @@ public:
 
     InnerEvent::Pointer Get()
     {
-        size_t newPeakUsingCount = 0;
+        UpdateUsingCount();
 
-        {
-            // Check whether pool is empty.
-            std::lock_guard<std::mutex> lock(poolLock_);
-            ++usingCount_;
-            if (!events_.empty()) {
-                auto event = std::move(events_.back());
-                events_.pop_back();
-                return InnerEvent::Pointer(event.release(), Drop);
-            }
-
-            // Update peak using events count.
-            if (usingCount_ >= nextPeakUsingCount_) {
-                if (UINT32_MAX - nextPeakUsingCount_ > MAX_BUFFER_POOL_SIZE) {
-                    nextPeakUsingCount_ += MAX_BUFFER_POOL_SIZE;
-                } else {
-                    nextPeakUsingCount_ = UINT32_MAX;
-                }
-
-                newPeakUsingCount = usingCount_;
-            }
+        // Try events cached by current thread at first, then refill them from the shared pool.
+        ThreadCache *cache = GetThreadCache();
+        if ((cache != nullptr) && (cache->events.empty())) {
+            Refill(cache->events);
         }
-
-        // Print the new peak using count of inner events
-        if (newPeakUsingCount > 0) {
-            HILOGD("Peak using count of inner events is up to %{public}zu", newPeakUsingCount);
+        if ((cache != nullptr) && (!cache->events.empty())) {
+            InnerEvent *event = cache->events.back();
+            cache->events.pop_back();
+            --cachedCount_;
+            ++reusedCount_;
+            return InnerEvent::Pointer(event, Drop);
         }
 
         // Allocate new memory, while pool is empty.
+        ++allocatedCount_;
         return InnerEvent::Pointer(new InnerEvent, Drop);
     }
 
+    InnerEventPoolStats GetStats()
+    {
+        InnerEventPoolStats stats;
+        stats.usingCount = usingCount_.load();
+        stats.peakUsingCount = peakUsingCount_.load();
+        stats.cachedCount = cachedCount_.load();
+        stats.capacity = GetCapacity();
+        stats.allocatedCount = allocatedCount_.load();
+        stats.reusedCount = reusedCount_.load();
+        stats.releasedCount = releasedCount_.load();
+        return stats;
+    }
+
 private:
+    // Events cached by one thread, so getting and dropping events does not contend on the pool lock.
+    struct ThreadCache {
+        ~ThreadCache()
+        {
+            threadCacheReleased_ = true;
+            GetInstance().Flush(events, 0);
+        }
+
+        std::vector<InnerEvent *> events;
+    };
+
+    static ThreadCache *GetThreadCache()
+    {
+        // Thread cache may be already released while other thread local data dropping events.
+        if (threadCacheReleased_) {
+            return nullptr;
+        }
+        static thread_local ThreadCache cache;
+        return &cache;
+    }
+
     static void Drop(InnerEvent *event)
     {
         if (event == nullptr) {
             return;
         }
 
-        auto destructor = [](InnerEvent *event) {
-            if (event != nullptr) {
-                delete event;
-            }
-        };
-
         // Clear content of the event
         event->ClearEvent();
         // Put event into event buffer pool
-        GetInstance().Put(InnerEvent::Pointer(event, destructor));
+        GetInstance().Put(event);
     }
 
-    void Put(InnerEvent::Pointer &&event)
+    void Put(InnerEvent *event)
     {
-        // Check whether pool is full.
-        std::lock_guard<std::mutex> lock(poolLock_);
         --usingCount_;
-        if (events_.size() < MAX_BUFFER_POOL_SIZE) {
-            events_.push_back(std::move(event));
+
+        // Release the event, if enough events are cached.
+        ThreadCache *cache = GetThreadCache();
+        if ((cache == nullptr) || (cachedCount_.load() >= GetCapacity())) {
+            ++releasedCount_;
+            delete event;
+            return;
+        }
+
+        ++cachedCount_;
+        cache->events.push_back(event);
+        if (cache->events.size() >= MAX_THREAD_CACHE_SIZE) {
+            // Give half of the events back, so other threads could reuse them.
+            Flush(cache->events, MAX_THREAD_CACHE_SIZE / 2);
         }
     }
 
+    void Refill(std::vector<InnerEvent *> &events)
+    {
+        std::lock_guard<std::mutex> lock(poolLock_);
+        size_t count = std::min(events_.size(), MAX_THREAD_CACHE_SIZE / 2);
+        events.insert(events.end(), events_.end() - count, events_.end());
+        events_.resize(events_.size() - count);
+    }
+
+    void Flush(std::vector<InnerEvent *> &events, size_t keepCount)
+    {
+        if (events.size() <= keepCount) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(poolLock_);
+        events_.insert(events_.end(), events.begin() + keepCount, events.end());
+        events.resize(keepCount);
+    }
+
+    void UpdateUsingCount()
+    {
+        size_t usingCount = ++usingCount_;
+        size_t peakUsingCount = peakUsingCount_.load();
+        while ((usingCount > peakUsingCount) && (!peakUsingCount_.compare_exchange_weak(peakUsingCount, usingCount))) {
+        }
+
+        // Print the new peak using count of inner events
+        if ((usingCount > peakUsingCount) && ((usingCount % MAX_BUFFER_POOL_SIZE) == 0)) {
+            HILOGD("Peak using count of inner events is up to %{public}zu", usingCount);
+        }
+    }
+
+    // Cache as many events as the peak using count, rounded down to a multiple of the default pool size.
+    size_t GetCapacity() const
+    {
+        size_t capacity = peakUsingCount_.load() / MAX_BUFFER_POOL_SIZE * MAX_BUFFER_POOL_SIZE;
+        return std::min(std::max(capacity, MAX_BUFFER_POOL_SIZE), MAX_POOL_CAPACITY);
+    }
+
     static const size_t MAX_BUFFER_POOL_SIZE = 64;
+    static const size_t MAX_POOL_CAPACITY = 1024;
+    static const size_t MAX_THREAD_CACHE_SIZE = 32;
+
+    static thread_local bool threadCacheReleased_;
 
     std::mutex poolLock_;
-    std::vector<InnerEvent::Pointer> events_;
+    std::vector<InnerEvent *> events_;
+
+    // Count of events cached in the pool and all thread caches.
+    std::atomic<size_t> cachedCount_ {0};
 
     // Used to statistical peak value of count of using inner events.
-    size_t usingCount_ {0};
-    size_t nextPeakUsingCount_ {MAX_BUFFER_POOL_SIZE};
+    std::atomic<size_t> usingCount_ {0};
+    std::atomic<size_t> peakUsingCount_ {0};
+
+    std::atomic<uint64_t> allocatedCount_ {0};
+    std::atomic<uint64_t> reusedCount_ {0};
+    std::atomic<uint64_t> releasedCount_ {0};
 };
 
+thread_local bool InnerEventPool::threadCacheReleased_ = false;
+
 InnerEventPool::InnerEventPool() : poolLock_(), events_()
 {
     // Reserve enough memory
@@ -152,9 +232,17 @@ InnerEventPool::~InnerEventPool()
 {
     // Release all memory in the poll
     std::lock_guard<std::mutex> lock(poolLock_);
+    for (auto event : events_) {
+        delete event;
+    }
     events_.clear();
 }
 
+InnerEventPoolStats GetInnerEventPoolStats()
+{
+    return InnerEventPool::GetInstance().GetStats();
+}
+
 InnerEvent::Pointer InnerEvent::Get()
 {
     auto event = InnerEventPool::GetInstance().Get();
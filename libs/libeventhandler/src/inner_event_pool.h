@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_LIBS_LIBEVENTHANDLER_SRC_INNER_EVENT_POOL_H
+#define FOUNDATION_APPEXECFWK_LIBS_LIBEVENTHANDLER_SRC_INNER_EVENT_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace AppExecFwk {
+// Statistics of the inner event pool shared by all event runners in the process.
+struct InnerEventPoolStats {
+    // Count of events which are got and not dropped yet.
+    size_t usingCount {0};
+    size_t peakUsingCount {0};
+    // Count of events cached in the pool and thread caches, and the limit of it.
+    size_t cachedCount {0};
+    size_t capacity {0};
+    // Count of events allocated from heap, reused from cache and released to heap.
+    uint64_t allocatedCount {0};
+    uint64_t reusedCount {0};
+    uint64_t releasedCount {0};
+};
+
+/*
+ * Get statistics of the inner event pool.
+ */
+InnerEventPoolStats GetInnerEventPoolStats();
+}  // namespace AppExecFwk
+}  // namespace OHOS
+
+#endif  // #ifndef FOUNDATION_APPEXECFWK_LIBS_LIBEVENTHANDLER_SRC_INNER_EVENT_POOL_H
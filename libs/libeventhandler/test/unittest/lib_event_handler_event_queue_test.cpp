@@ -17,6 +17,7 @@
 
 #include <chrono>
 #include <thread>
+#include <vector>
 
 #include <fcntl.h>
 #include <sys/resource.h>
@@ -48,6 +49,12 @@ const uint32_t REMOVE_EVENT_ID = 0;
 const uint32_t HAS_EVENT_ID = 100;
 const int64_t HAS_EVENT_PARAM = 1000;
 const uint32_t INSERT_DELAY = 10;
+const uint32_t SAME_TIME_EVENT_COUNT = 100;
+const uint32_t LARGE_QUEUE_EVENT_COUNT = 10000;
+const uint32_t IMMEDIATE_EVENT_COUNT = 1000;
+const uint32_t PRODUCER_THREAD_NUM = 4;
+const uint32_t THROUGHPUT_EVENT_COUNT = 64000;
+const uint32_t THROUGHPUT_THREAD_NUMS[] = {1, 4, 16};
 bool isDump = false;
 
 std::atomic<bool> eventRan(false);
@@ -1709,4 +1716,323 @@ HWTEST_F(LibEventHandlerEventQueueTest, IsQueueEmpty003, TestSize.Level1)
     handler->SendEvent(event, HAS_DELAY_TIME, EventQueue::Priority::IDLE);
     bool ret = runner->GetEventQueue()->IsQueueEmpty();
     EXPECT_FALSE(ret);
-}
\ No newline at end of file
+}
+/*
+ * @tc.name: InsertSameHandleTime001
+ * @tc.desc: check events with the same handle time are distributed in insertion order
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, InsertSameHandleTime001, TestSize.Level1)
+{
+    /**
+     * @tc.setup: prepare queue.
+     */
+    EventQueue queue;
+    queue.Prepare();
+    auto now = InnerEvent::Clock::now();
+    auto laterTime = now + std::chrono::milliseconds(DELAY_TIME);
+
+    /**
+     * @tc.steps: step1. insert events with two handle times alternately.
+     */
+    for (uint32_t eventId = 0; eventId < SAME_TIME_EVENT_COUNT; ++eventId) {
+        auto event = InnerEvent::Get(eventId);
+        event->SetSendTime(now);
+        event->SetHandleTime(((eventId % NUM) == 0) ? now : laterTime);
+        queue.Insert(event);
+    }
+
+    /**
+     * @tc.steps: step2. get events from queue.
+     * @tc.expected: step2. events are sorted by handle time, and keep insertion order for the same handle time.
+     */
+    for (uint32_t eventId = 0; eventId < SAME_TIME_EVENT_COUNT; eventId += NUM) {
+        GetEventAndCompare(eventId, queue);
+    }
+    for (uint32_t eventId = 1; eventId < SAME_TIME_EVENT_COUNT; eventId += NUM) {
+        GetEventAndCompare(eventId, queue);
+    }
+    EXPECT_TRUE(queue.IsQueueEmpty());
+}
+
+/*
+ * @tc.name: RemoveIndexedEvent001
+ * @tc.desc: check events of different owners are removed and found by owner, id, param and task name
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, RemoveIndexedEvent001, TestSize.Level1)
+{
+    /**
+     * @tc.setup: init queue, handlers and insert delayed events and tasks of both handlers.
+     */
+    EventQueue queue;
+    queue.Prepare();
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    auto otherHandler = std::make_shared<EventHandler>(runner);
+    auto now = InnerEvent::Clock::now();
+    auto handleTime = now + std::chrono::milliseconds(REMOVE_WAIT_TIME);
+    std::string taskName("RemoveIndexedEvent001");
+    for (const auto &owner : {handler, otherHandler}) {
+        for (uint32_t eventId = 0; eventId < SAME_TIME_EVENT_COUNT; ++eventId) {
+            auto event = InnerEvent::Get(eventId % NUM, static_cast<int64_t>(eventId));
+            event->SetOwner(owner);
+            event->SetSendTime(now);
+            event->SetHandleTime(handleTime);
+            queue.Insert(event);
+        }
+        auto task = InnerEvent::Get([]() {}, taskName);
+        task->SetOwner(owner);
+        task->SetSendTime(now);
+        task->SetHandleTime(handleTime);
+        queue.Insert(task, EventQueue::Priority::IDLE);
+    }
+
+    /**
+     * @tc.steps: step1. remove events of handler by id and param.
+     * @tc.expected: step1. only matched events of handler are removed.
+     */
+    queue.Remove(handler, REMOVE_EVENT_ID, 0);
+    EXPECT_FALSE(queue.HasInnerEvent(handler, static_cast<int64_t>(0)));
+    EXPECT_TRUE(queue.HasInnerEvent(otherHandler, static_cast<int64_t>(0)));
+    EXPECT_TRUE(queue.HasInnerEvent(handler, REMOVE_EVENT_ID));
+
+    /**
+     * @tc.steps: step2. remove events of handler by id and remove task by name.
+     * @tc.expected: step2. events of other handler are still in queue.
+     */
+    queue.Remove(handler, REMOVE_EVENT_ID);
+    queue.Remove(handler, taskName);
+    EXPECT_FALSE(queue.HasInnerEvent(handler, REMOVE_EVENT_ID));
+    EXPECT_TRUE(queue.HasInnerEvent(handler, REMOVE_EVENT_ID + 1));
+    EXPECT_TRUE(queue.HasInnerEvent(otherHandler, REMOVE_EVENT_ID));
+
+    /**
+     * @tc.steps: step3. remove all events of both handlers.
+     * @tc.expected: step3. queue is empty.
+     */
+    queue.Remove(handler);
+    EXPECT_FALSE(queue.HasInnerEvent(handler, REMOVE_EVENT_ID + 1));
+    EXPECT_FALSE(queue.IsQueueEmpty());
+    queue.Remove(otherHandler);
+    EXPECT_TRUE(queue.IsQueueEmpty());
+}
+
+/*
+ * @tc.name: LargeDelayedQueue001
+ * @tc.desc: insert and remove lots of delayed events, and log the time cost
+ * @tc.type: PERF
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, LargeDelayedQueue001, TestSize.Level1)
+{
+    /**
+     * @tc.setup: init queue and handler.
+     */
+    EventQueue queue;
+    queue.Prepare();
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    auto now = InnerEvent::Clock::now();
+
+    /**
+     * @tc.steps: step1. insert delayed events in reverse order of handle time.
+     */
+    auto start = InnerEvent::Clock::now();
+    for (uint32_t eventId = 0; eventId < LARGE_QUEUE_EVENT_COUNT; ++eventId) {
+        auto event = InnerEvent::Get(eventId);
+        event->SetOwner(handler);
+        event->SetSendTime(now);
+        event->SetHandleTime(now + std::chrono::milliseconds(REMOVE_WAIT_TIME + LARGE_QUEUE_EVENT_COUNT - eventId));
+        queue.Insert(event);
+    }
+    auto insertCost = std::chrono::duration_cast<std::chrono::microseconds>(InnerEvent::Clock::now() - start);
+
+    /**
+     * @tc.steps: step2. check and remove every event by id.
+     * @tc.expected: step2. all events are found and removed.
+     */
+    start = InnerEvent::Clock::now();
+    for (uint32_t eventId = 0; eventId < LARGE_QUEUE_EVENT_COUNT; ++eventId) {
+        EXPECT_TRUE(queue.HasInnerEvent(handler, eventId));
+        queue.Remove(handler, eventId);
+    }
+    auto removeCost = std::chrono::duration_cast<std::chrono::microseconds>(InnerEvent::Clock::now() - start);
+    EXPECT_TRUE(queue.IsQueueEmpty());
+    GTEST_LOG_(INFO) << "insert " << LARGE_QUEUE_EVENT_COUNT << " events cost " << insertCost.count()
+                     << "us, find and remove cost " << removeCost.count() << "us";
+}
+
+/*
+ * @tc.name: LargeDelayedQueue002
+ * @tc.desc: insert and get lots of events with the same id and unnamed tasks, and log the time cost
+ * @tc.type: PERF
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, LargeDelayedQueue002, TestSize.Level1)
+{
+    /**
+     * @tc.setup: init queue and handler.
+     */
+    EventQueue queue;
+    queue.Prepare();
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+    auto now = InnerEvent::Clock::now();
+
+    /**
+     * @tc.steps: step1. insert events with the same id and unnamed tasks alternately.
+     */
+    auto start = InnerEvent::Clock::now();
+    for (uint32_t i = 0; i < LARGE_QUEUE_EVENT_COUNT; ++i) {
+        auto event = ((i % NUM) == 0) ? InnerEvent::Get(REMOVE_EVENT_ID) : InnerEvent::Get([]() {});
+        event->SetOwner(handler);
+        event->SetSendTime(now);
+        event->SetHandleTime(now);
+        queue.Insert(event);
+    }
+
+    /**
+     * @tc.steps: step2. get all events from queue.
+     * @tc.expected: step2. events and tasks are got alternately, and queue is empty at last.
+     */
+    for (uint32_t i = 0; i < LARGE_QUEUE_EVENT_COUNT; ++i) {
+        auto event = queue.GetEvent();
+        ASSERT_NE(nullptr, event);
+        EXPECT_EQ(((i % NUM) != 0), event->HasTask());
+    }
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(InnerEvent::Clock::now() - start);
+    EXPECT_TRUE(queue.IsQueueEmpty());
+    GTEST_LOG_(INFO) << "insert and get " << LARGE_QUEUE_EVENT_COUNT << " events cost " << cost.count() << "us";
+}
+
+/*
+ * @tc.name: InsertImmediateEvent001
+ * @tc.desc: insert more zero-delay immediate events than the lock-free ring could hold, and check order
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, InsertImmediateEvent001, TestSize.Level1)
+{
+    /**
+     * @tc.setup: init queue and handler.
+     */
+    EventQueue queue;
+    queue.Prepare();
+    auto runner = EventRunner::Create(false);
+    auto handler = std::make_shared<EventHandler>(runner);
+
+    /**
+     * @tc.steps: step1. insert zero-delay immediate events without getting them.
+     * @tc.expected: step1. all events could be found in queue.
+     */
+    for (uint32_t eventId = 0; eventId < IMMEDIATE_EVENT_COUNT; ++eventId) {
+        auto event = InnerEvent::Get(eventId);
+        auto now = InnerEvent::Clock::now();
+        event->SetOwner(handler);
+        event->SetSendTime(now);
+        event->SetHandleTime(now);
+        queue.Insert(event, EventQueue::Priority::IMMEDIATE);
+    }
+    EXPECT_FALSE(queue.IsQueueEmpty());
+    EXPECT_TRUE(queue.HasInnerEvent(handler, IMMEDIATE_EVENT_COUNT - 1));
+
+    /**
+     * @tc.steps: step2. get events from queue.
+     * @tc.expected: step2. events are got in insertion order.
+     */
+    for (uint32_t eventId = 0; eventId < IMMEDIATE_EVENT_COUNT; ++eventId) {
+        GetEventAndCompare(eventId, queue);
+    }
+    EXPECT_TRUE(queue.IsQueueEmpty());
+}
+
+/*
+ * @tc.name: InsertImmediateEvent002
+ * @tc.desc: post immediate tasks from several threads, and check all tasks run in order of each thread
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, InsertImmediateEvent002, TestSize.Level1)
+{
+    /**
+     * @tc.setup: init runner and handler.
+     */
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    std::vector<uint32_t> lastTaskIds(PRODUCER_THREAD_NUM, 0);
+    std::atomic<uint32_t> taskCount(0);
+    std::atomic<bool> inOrder(true);
+
+    /**
+     * @tc.steps: step1. post immediate tasks from several threads.
+     */
+    std::vector<std::thread> producers;
+    for (uint32_t i = 0; i < PRODUCER_THREAD_NUM; ++i) {
+        producers.emplace_back([i, &handler, &lastTaskIds, &taskCount, &inOrder]() {
+            for (uint32_t taskId = 1; taskId <= IMMEDIATE_EVENT_COUNT; ++taskId) {
+                auto task = [i, taskId, &lastTaskIds, &taskCount, &inOrder]() {
+                    if (lastTaskIds[i] + 1 != taskId) {
+                        inOrder.store(false);
+                    }
+                    lastTaskIds[i] = taskId;
+                    taskCount++;
+                };
+                handler->PostImmediateTask(task);
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    /**
+     * @tc.steps: step2. wait until all tasks run.
+     * @tc.expected: step2. all tasks run, and tasks from the same thread run in order.
+     */
+    for (uint32_t i = 0; (i < REMOVE_WAIT_TIME) && (taskCount.load() < PRODUCER_THREAD_NUM * IMMEDIATE_EVENT_COUNT);
+        ++i) {
+        usleep(1000);
+    }
+    EXPECT_EQ(PRODUCER_THREAD_NUM * IMMEDIATE_EVENT_COUNT, taskCount.load());
+    EXPECT_TRUE(inOrder.load());
+}
+
+/*
+ * @tc.name: ImmediateEventThroughput001
+ * @tc.desc: post immediate tasks from 1, 4 and 16 threads, and log the throughput
+ * @tc.type: PERF
+ */
+HWTEST_F(LibEventHandlerEventQueueTest, ImmediateEventThroughput001, TestSize.Level1)
+{
+    for (uint32_t threadNum : THROUGHPUT_THREAD_NUMS) {
+        /**
+         * @tc.setup: init runner and handler.
+         */
+        auto runner = EventRunner::Create(true);
+        auto handler = std::make_shared<EventHandler>(runner);
+        std::atomic<uint32_t> taskCount(0);
+        uint32_t tasksPerThread = THROUGHPUT_EVENT_COUNT / threadNum;
+        uint32_t totalTasks = tasksPerThread * threadNum;
+
+        /**
+         * @tc.steps: step1. post immediate tasks from threads and wait until all tasks run.
+         * @tc.expected: step1. all tasks run.
+         */
+        auto start = InnerEvent::Clock::now();
+        std::vector<std::thread> producers;
+        for (uint32_t i = 0; i < threadNum; ++i) {
+            producers.emplace_back([tasksPerThread, &handler, &taskCount]() {
+                for (uint32_t j = 0; j < tasksPerThread; ++j) {
+                    handler->PostImmediateTask([&taskCount]() { taskCount++; });
+                }
+            });
+        }
+        for (auto &producer : producers) {
+            producer.join();
+        }
+        for (uint32_t i = 0; (i < REMOVE_WAIT_TIME) && (taskCount.load() < totalTasks); ++i) {
+            usleep(100);
+        }
+        auto cost = std::chrono::duration_cast<std::chrono::microseconds>(InnerEvent::Clock::now() - start);
+        EXPECT_EQ(totalTasks, taskCount.load());
+        GTEST_LOG_(INFO) << threadNum << " producer threads, " << totalTasks << " immediate tasks cost "
+                         << cost.count() << "us";
+    }
+}
@@ -19,6 +19,7 @@
 
 #include <sys/prctl.h>
 
+#include "event_dispatch_profiler.h"
 #include "event_handler.h"
 #include "event_runner.h"
 
@@ -370,3 +371,127 @@ HWTEST_F(LibEventHandlerEventRunnerTest, SetLogger001, TestSize.Level1)
     usleep(100 * 1000);
     EXPECT_TRUE(isSetLogger);
 }
+
+/*
+ * @tc.name: DispatchProfiling001
+ * @tc.desc: check the dispatch statistics are dumped after profiling is enabled, and cleared after disabled
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, DispatchProfiling001, TestSize.Level1)
+{
+    /**
+     * @tc.setup: init handler and runner, enable profiling with a slow event threshold no task reaches.
+     */
+    const uint64_t slowEventThresholdMs = 10 * 1000;
+    auto runner = EventRunner::Create(true);
+    auto handler = std::make_shared<EventHandler>(runner);
+    runner->EnableDispatchProfiling(slowEventThresholdMs);
+
+    /**
+     * @tc.steps: step1. post two tasks, then dump the runner info in a third task.
+     * @tc.expected: step1. the runner records a task before it takes the next one, so exactly the two former
+     *                 tasks are counted, and they are listed by the id of their handler and their names.
+     */
+    handler->PostTask([]() {}, "firstTask");
+    handler->PostTask([]() {}, "secondTask");
+    std::string runnerInfo;
+    std::atomic<bool> taskCalled(false);
+    WaitUntilTaskCalled([&runner, &runnerInfo, &taskCalled]() {
+        runner->DumpRunnerInfo(runnerInfo);
+        taskCalled.store(true);
+    }, handler, taskCalled);
+    ASSERT_TRUE(taskCalled.load());
+    std::string handlerName = "Handler(id " + std::to_string(handler->GetHandlerId()) + ")";
+    EXPECT_NE(runnerInfo.find("Dispatch profiling: slow events 0 (threshold 10000ms)"), std::string::npos);
+    EXPECT_NE(runnerInfo.find("Execution: count 2,"), std::string::npos);
+    EXPECT_NE(runnerInfo.find(handlerName + ", task name = firstTask: count 1,"), std::string::npos);
+    EXPECT_NE(runnerInfo.find(handlerName + ", task name = secondTask: count 1,"), std::string::npos);
+
+    /**
+     * @tc.steps: step2. disable profiling, then dump the runner info.
+     * @tc.expected: step2. no dispatch statistics are dumped.
+     */
+    runner->DisableDispatchProfiling();
+    runnerInfo.clear();
+    runner->DumpRunnerInfo(runnerInfo);
+    EXPECT_EQ(runnerInfo.find("Dispatch profiling"), std::string::npos);
+}
+
+/*
+ * @tc.name: DispatchProfiling002
+ * @tc.desc: check the statistics recorded by the profiler with given times, per handler id and event
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, DispatchProfiling002, TestSize.Level1)
+{
+    /**
+     * @tc.setup: enable a profiler with a slow event threshold of 10ms, and get an event handled at now.
+     */
+    const uint64_t slowEventThresholdMs = 10;
+    const uint32_t eventId = 1;
+    const uint64_t firstHandlerId = 1;
+    const uint64_t secondHandlerId = 2;
+    EventDispatchProfiler profiler;
+    profiler.Enable(slowEventThresholdMs);
+    auto event = InnerEvent::Get(eventId);
+    InnerEvent::TimePoint handleTime = InnerEvent::Clock::now();
+    event->SetHandleTime(handleTime);
+    InnerEvent::TimePoint dispatchTime = handleTime + std::chrono::milliseconds(1);
+
+    /**
+     * @tc.steps: step1. record a slow event and a quick one with the same id, for two handlers.
+     * @tc.expected: step1. one event is slow, and the two handlers are listed apart by their ids.
+     */
+    profiler.Record(firstHandlerId, *event, dispatchTime, dispatchTime + std::chrono::milliseconds(20));
+    profiler.Record(secondHandlerId, *event, dispatchTime, dispatchTime + std::chrono::milliseconds(2));
+    std::string info;
+    profiler.Dump("", info);
+    EXPECT_NE(info.find("Dispatch profiling: slow events 1 (threshold 10ms)"), std::string::npos);
+    EXPECT_NE(info.find("Queue wait: count 2, avg 1000us"), std::string::npos);
+    EXPECT_NE(info.find("Execution: count 2, avg 11000us, max 20000us"), std::string::npos);
+    EXPECT_NE(info.find("Handler(id 1), event id = 1: count 1, total 20000us"), std::string::npos);
+    EXPECT_NE(info.find("Handler(id 2), event id = 1: count 1, total 2000us"), std::string::npos);
+
+    /**
+     * @tc.steps: step2. record the events of more handlers than the pairs kept in statistics.
+     * @tc.expected: step2. the events beyond the limit are only counted.
+     */
+    const uint64_t maxEventStatsSize = 128;
+    const uint64_t droppedEventCount = 2;
+    for (uint64_t i = 0; i < maxEventStatsSize; ++i) {
+        profiler.Record(secondHandlerId + 1 + i, *event, dispatchTime, dispatchTime);
+    }
+    info.clear();
+    profiler.Dump("", info);
+    EXPECT_NE(info.find("Events of other handlers not counted: " + std::to_string(droppedEventCount)),
+        std::string::npos);
+
+    /**
+     * @tc.steps: step3. disable and enable the profiler again, then record an event.
+     * @tc.expected: step3. the former statistics are cleared, and the new event takes a slot again.
+     */
+    profiler.Disable();
+    profiler.Enable(slowEventThresholdMs);
+    info.clear();
+    profiler.Dump("", info);
+    EXPECT_NE(info.find("Execution: count 0,"), std::string::npos);
+    EXPECT_EQ(info.find("Handler(id"), std::string::npos);
+    EXPECT_EQ(info.find("not counted"), std::string::npos);
+    profiler.Record(secondHandlerId, *event, dispatchTime, dispatchTime + std::chrono::milliseconds(2));
+    info.clear();
+    profiler.Dump("", info);
+    EXPECT_NE(info.find("Handler(id 2), event id = 1: count 1, total 2000us"), std::string::npos);
+    EXPECT_EQ(info.find("Handler(id 1)"), std::string::npos);
+}
+
+/*
+ * @tc.name: HandlerId001
+ * @tc.desc: check the handlers have different ids
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventRunnerTest, HandlerId001, TestSize.Level1)
+{
+    auto handler = std::make_shared<EventHandler>();
+    auto otherHandler = std::make_shared<EventHandler>();
+    EXPECT_NE(handler->GetHandlerId(), otherHandler->GetHandlerId());
+}
@@ -16,15 +16,21 @@
 #include <gtest/gtest.h>
 
 #include <cstdlib>
+#include <set>
+#include <thread>
 #include <vector>
 
+#include <unistd.h>
+
 #include "event_handler.h"
+#include "event_runner.h"
 #include "inner_event.h"
 
 using namespace testing::ext;
 using namespace OHOS::AppExecFwk;
 namespace {
 const size_t MAX_POOL_SIZE = 64;
+const size_t BURST_EVENT_COUNT = 256;
 }
 
 /**
@@ -433,4 +439,72 @@ HWTEST_F(LibEventHandlerEventTest, DrainPool002, TestSize.Level1)
      * @tc.expected: step3. the two event addresses are the same.
      */
     EXPECT_EQ(firstAddr, secondAddr);
-}
\ No newline at end of file
+}
+/*
+ * @tc.name: DrainPool003
+ * @tc.desc: drop events in one thread, then get events in another thread, check the events are reused
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventTest, DrainPool003, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. get a burst of events in current thread, and drop them in another thread.
+     */
+    std::vector<InnerEvent::Pointer> events;
+    std::set<InnerEvent *> addresses;
+    for (size_t i = 0; i < BURST_EVENT_COUNT; ++i) {
+        events.push_back(InnerEvent::Get(static_cast<uint32_t>(i)));
+        addresses.insert(events.back().get());
+    }
+    std::thread([&events]() { events.clear(); }).join();
+
+    /**
+     * @tc.steps: step2. get events in a new thread.
+     * @tc.expected: step2. events dropped by the other thread are reused.
+     */
+    size_t reusedCount = 0;
+    std::thread([&addresses, &reusedCount]() {
+        std::vector<InnerEvent::Pointer> newEvents;
+        for (size_t i = 0; i < MAX_POOL_SIZE; ++i) {
+            newEvents.push_back(InnerEvent::Get(static_cast<uint32_t>(i)));
+            if (addresses.count(newEvents.back().get()) > 0) {
+                ++reusedCount;
+            }
+        }
+    }).join();
+    EXPECT_EQ(MAX_POOL_SIZE, reusedCount);
+}
+
+/*
+ * @tc.name: DumpPool001
+ * @tc.desc: check statistics of event pool are dumped with event runner
+ * @tc.type: FUNC
+ */
+HWTEST_F(LibEventHandlerEventTest, DumpPool001, TestSize.Level1)
+{
+    class DumpTest : public Dumper {
+    public:
+        void Dump(const std::string &message) override
+        {
+            content += message;
+        }
+
+        std::string GetTag() override
+        {
+            return "DumpPool001";
+        }
+
+        std::string content;
+    };
+
+    /**
+     * @tc.steps: step1. dump a running event runner.
+     * @tc.expected: step1. statistics of event pool are dumped.
+     */
+    auto runner = EventRunner::Create(true);
+    // Wait until thread of the event runner is started.
+    usleep(100 * 1000);
+    DumpTest dumper;
+    runner->Dump(dumper);
+    EXPECT_NE(std::string::npos, dumper.content.find("Inner event pool"));
+}
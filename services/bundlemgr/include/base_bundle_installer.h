@@ -17,7 +17,9 @@
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BASE_BUNDLE_INSTALLER_H
 
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "nocopyable.h"
 
@@ -32,6 +34,8 @@
 
 namespace OHOS {
 namespace AppExecFwk {
+class BundleExtractor;
+
 class BaseBundleInstaller {
 public:
     BaseBundleInstaller();
@@ -101,9 +105,11 @@ protected:
      * @brief Update the installer state.
      * @attention This function changes the base class state only.
      * @param state Indicates the state to be updated to.
+     * @param criticalPathTime Indicates the critical path time in milliseconds of the stages which ran at the same
+     *                         time to reach the state, or 0 if there are no such stages.
      * @return
      */
-    virtual void UpdateInstallerState(const InstallerState state);
+    virtual void UpdateInstallerState(const InstallerState state, const int64_t criticalPathTime = 0);
     /**
      * @brief Get the installer state.
      * @return The current state of the installer object.
@@ -113,14 +119,13 @@ protected:
         return state_;
     }
     /**
-     * @brief Get the installer state.
+     * @brief Set the installer state, and log the time taken to reach it from the last state.
      * @param state Indicates the state to be updated to.
+     * @param criticalPathTime Indicates the critical path time in milliseconds of the stages which ran at the same
+     *                         time to reach the state, or 0 if there are no such stages.
      * @return
      */
-    inline void SetInstallerState(InstallerState state)
-    {
-        state_ = state;
-    }
+    void SetInstallerState(InstallerState state, int64_t criticalPathTime = 0);
     /**
      * @brief The main function for bundle install by bundleName.
      * @param bundleName Indicates the bundleName of the application to install.
@@ -218,6 +223,19 @@ private:
      * @return Returns ERR_OK if the bundle extract and renamed successfully; returns error code otherwise.
      */
     ErrCode ExtractModule(InnerBundleInfo &info, const std::string &modulePath);
+    /**
+     * @brief Extract the code of the current installing module package to temporilay directory.
+     * @param info Indicates the InnerBundleInfo object of a bundle.
+     * @param modulePath normal files decompression path.
+     * @return Returns ERR_OK if the module code extracted successfully; returns error code otherwise.
+     */
+    ErrCode ExtractModuleCode(const InnerBundleInfo &info, const std::string &modulePath);
+    /**
+     * @brief Add the directory of the current installing module package to the module infos.
+     * @param info Indicates the InnerBundleInfo object of a bundle.
+     * @return
+     */
+    void AddModuleDirs(InnerBundleInfo &info) const;
     /**
      * @brief Remove the code and data directories of a bundle.
      * @param info Indicates the InnerBundleInfo object of a bundle.
@@ -236,12 +254,14 @@ private:
     ErrCode RemoveModuleAndDataDir(const InnerBundleInfo &info,
         const std::string &modulePackage, int32_t userId, bool isKeepData) const;
     /**
-     * @brief Parse the bundle config.json file.
-     * @param bundleFilePath Indicates the HAP file path.
+     * @brief Parse the pack.info file of a bundle.
+     * @param bundleExtractor Indicates the opened HAP file.
      * @param InnerBundleInfo Indicates the InnerBundleInfo object of a bundle.
-     * @return Returns ERR_OK if the bundle parsed successfully; returns error code otherwise.
+     * @param packInfo Indicates the obtained BundlePackInfo object.
+     * @return Returns ERR_OK if the pack.info parsed successfully or not exists; returns error code otherwise.
      */
-    ErrCode ParseBundleInfo(const std::string &bundleFilePath, InnerBundleInfo &info, BundlePackInfo &packInfo) const;
+    ErrCode ParseBundlePackInfo(const BundleExtractor &bundleExtractor, InnerBundleInfo &info,
+        BundlePackInfo &packInfo) const;
     /**
      * @brief Remove the current installing module directory.
      * @param info Indicates the InnerBundleInfo object of a bundle under installing.
@@ -259,11 +279,11 @@ private:
     ErrCode ExtractModuleFiles(const InnerBundleInfo &info, const std::string &modulePath,
         const std::string &targetSoPath, const std::string &cpuAbi);
     /**
-     * @brief Rename the directory of current installing module package.
-     * @param info Indicates the InnerBundleInfo object of a bundle under installing.
-     * @return Returns ERR_OK if the module directory renamed successfully; returns error code otherwise.
+     * @brief Rename the directories of all installing module packages in one installd transaction.
+     * @param newInfos Indicates the InnerBundleInfo objects of the bundle under installing.
+     * @return Returns ERR_OK if the module directories renamed successfully; returns error code otherwise.
      */
-    ErrCode RenameModuleDir(const InnerBundleInfo &info) const;
+    ErrCode RenameModuleDirs(const std::unordered_map<std::string, InnerBundleInfo> &newInfos) const;
     /**
      * @brief The process of install a new module package.
      * @param newInfo Indicates the InnerBundleInfo object parsed from the config.json in the HAP package.
@@ -316,11 +336,19 @@ private:
     ErrCode InnerProcessInstallByPreInstallInfo(
         const std::string &bundleName, const InstallParam &installParam, int32_t &uid, bool recoverMode);
     /**
-     * @brief Check syscap.
+     * @brief Open all HAP packages once, the extractors are shared by the checking and the parsing of them.
      * @param bundlePaths Indicates the file paths of all HAP packages.
+     * @param bundleExtractors Indicates the extractors of the HAP packages, in the order of bundlePaths.
+     * @return Returns ERR_OK if all HAP packages opened successfully; returns error code otherwise.
+     */
+    ErrCode OpenBundleExtractors(const std::vector<std::string> &bundlePaths,
+        std::vector<std::shared_ptr<BundleExtractor>> &bundleExtractors) const;
+    /**
+     * @brief Check syscap.
+     * @param bundleExtractors Indicates the extractors of all HAP packages.
      * @return Returns ERR_OK if the syscap satisfy; returns error code otherwise.
      */
-    ErrCode CheckSysCap(const std::vector<std::string> &bundlePaths);
+    ErrCode CheckSysCap(const std::vector<std::shared_ptr<BundleExtractor>> &bundleExtractors);
     /**
      * @brief Check signature info of multiple haps.
      * @param bundlePaths Indicates the file paths of all HAP packages.
@@ -336,11 +364,13 @@ private:
      * @param installParam Indicates the install parameters.
      * @param appType Indicates the app type of the hap.
      * @param hapVerifyRes Indicates all signature info of all haps.
+     * @param bundleExtractors Indicates the extractors of all haps, in the order of bundlePaths.
      * @param infos Indicates the innerBundleinfo of each hap.
      * @return Returns ERR_OK if each hap is parsed successfully; returns error code otherwise.
      */
     ErrCode ParseHapFiles(const std::vector<std::string> &bundlePaths, const InstallParam &installParam,
         const Constants::AppType appType, std::vector<Security::Verify::HapVerifyResult> &hapVerifyRes,
+        const std::vector<std::shared_ptr<BundleExtractor>> &bundleExtractors,
         std::unordered_map<std::string, InnerBundleInfo> &infos);
     /**
      * @brief To check the version code and bundleName in all haps.
@@ -443,8 +473,9 @@ private:
     void SetEntryInstallationFree(const BundlePackInfo &bundlePackInfo, InnerBundleInfo &innerBundleInfo);
 
 private:
-    ErrCode CreateBundleCodeDir(InnerBundleInfo &info) const;
     ErrCode CreateBundleDataDir(InnerBundleInfo &info) const;
+    ErrCode GenerateBundleUserInfo(const InnerBundleInfo &info, InnerBundleUserInfo &userInfo) const;
+    void SetBundleDataDirInfo(InnerBundleInfo &info, const InnerBundleUserInfo &userInfo) const;
     ErrCode RemoveModuleDataDir(const InnerBundleInfo &info, const std::string &modulePackage,
         int32_t userId) const;
     ErrCode RemoveBundleCodeDir(const InnerBundleInfo &info) const;
@@ -479,6 +510,8 @@ private:
         const InstallParam &installParam, InstallScene preBundleScene, ErrCode errCode);
 
     InstallerState state_ = InstallerState::INSTALL_START;
+    int64_t stateTime_ = 0;
+    int64_t installStagesTime_ = 0;
     std::shared_ptr<BundleDataMgr> dataMgr_ = nullptr;  // this pointer will get when public functions called
     std::shared_ptr<BundleCloneMgr> cloneMgr_ = nullptr;
     std::string bundleName_;
@@ -498,6 +531,8 @@ private:
 
     int32_t userId_ = Constants::INVALID_USERID;
     bool hasInstalledInUser_ = false;
+    // the data dirs of the user were created by the caller, so CreateBundleDataDir skips installd
+    bool isDataDirCreated_ = false;
     SingletonState singletonState_ = SingletonState::DEFAULT;
     // used to record system event infos
     EventInfo sysEventInfo_;
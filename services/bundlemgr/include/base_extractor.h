@@ -66,7 +66,7 @@ public:
      */
     bool HasEntry(const std::string &fileName) const;
     bool IsDirExist(const std::string &dir) const;
-    bool IsStageBasedModel(std::string abilityName);
+    bool IsStageBasedModel(std::string abilityName) const;
     bool IsNewVersion() const;
 
 protected:
@@ -29,6 +29,7 @@
 #include "ability_info.h"
 #include "application_info.h"
 #include "bundle_data_storage_interface.h"
+#include "bundle_mgr_reply_cache.h"
 #include "bundle_promise.h"
 #include "bundle_sandbox_data_mgr.h"
 #include "bundle_status_callback_interface.h"
@@ -44,6 +45,7 @@
 #include "preinstall_data_storage.h"
 #ifdef GLOBAL_RESMGR_ENABLE
 #include "resource_manager.h"
+#include "resource_manager_cache.h"
 #endif
 
 namespace OHOS {
@@ -122,6 +124,13 @@ public:
      * @return Returns true if this function is successfully called; returns false otherwise.
      */
     bool GetInnerBundleInfo(const std::string &bundleName, InnerBundleInfo &info);
+    /**
+     * @brief Get a copy of an InnerBundleInfo if exist, the status of the bundle is not changed.
+     * @param bundleName Indicates the bundle name.
+     * @param info Indicates the obtained InnerBundleInfo object.
+     * @return Returns true if this function is successfully called; returns false otherwise.
+     */
+    bool FetchInnerBundleInfo(const std::string &bundleName, InnerBundleInfo &info) const;
     /**
      * @brief Generate UID and GID for a bundle.
      * @param innerBundleUserInfo Indicates the InnerBundleUserInfo object.
@@ -747,6 +756,11 @@ public:
         InnerBundleInfo &info, int32_t userId = Constants::UNSPECIFIED_USERID) const;
 
     std::shared_ptr<BundleSandboxDataMgr> GetSandboxDataMgr() const;
+    /**
+     * @brief Obtains the cache of marshalled replies of hot BundleMgrHost queries.
+     * @return Returns the reply cache, which is invalidated on every bundle data change.
+     */
+    std::shared_ptr<BundleMgrReplyCache> GetReplyCache() const;
     void StoreSandboxPersistentInfo(const std::string &bundleName, const SandboxAppPersistentInfo &info);
     void DeleteSandboxPersistentInfo(const std::string &bundleName, const SandboxAppPersistentInfo &info);
 
@@ -817,7 +831,10 @@ private:
 #ifdef GLOBAL_RESMGR_ENABLE
     std::shared_ptr<Global::Resource::ResourceManager> GetResourceManager(
         const AppExecFwk::BundleInfo &bundleInfo) const;
+    std::shared_ptr<Global::Resource::ResourceManager> CreateResourceManager(
+        const AppExecFwk::BundleInfo &bundleInfo) const;
 #endif
+    void InvalidateResourceManager(const std::string &bundleName) const;
 #ifdef BUNDLE_FRAMEWORK_GRAPHICS
     std::shared_ptr<Media::PixelMap> LoadImageFile(const std::string &path) const;
 #endif
@@ -865,6 +882,10 @@ private:
     std::map<int32_t, std::set<sptr<OnPermissionChangedCallback>>> permissionsCallbacks_;
     std::shared_ptr<BundlePromise> bundlePromise_ = nullptr;
     std::shared_ptr<BundleSandboxDataMgr> sandboxDataMgr_;
+    std::shared_ptr<BundleMgrReplyCache> replyCache_;
+#ifdef GLOBAL_RESMGR_ENABLE
+    std::shared_ptr<ResourceManagerCache> resourceManagerCache_;
+#endif
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
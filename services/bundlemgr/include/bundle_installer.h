@@ -62,6 +62,13 @@ public:
      * @return
      */
     void Install(const std::vector<std::string> &bundleFilePaths, const InstallParam &installParam);
+    /**
+     * @brief Receive a bundle from a stream and install it using this installer object.
+     * @param streamFd Indicates the readable file descriptor of the HAP, it is closed once received.
+     * @param installParam Indicates the install parameters.
+     * @return
+     */
+    void StreamInstall(int32_t streamFd, const InstallParam &installParam);
     /**
      * @brief Install a bundle by bundleName.
      * @param bundleName Indicates the bundleName of the bundle to install.
@@ -90,7 +97,7 @@ public:
      * @param state Indicates the state to be updated to.
      * @return
      */
-    virtual void UpdateInstallerState(const InstallerState state) override;
+    virtual void UpdateInstallerState(const InstallerState state, const int64_t criticalPathTime = 0) override;
 
 private:
     /**
@@ -66,6 +66,8 @@ public:
      */
     virtual bool Install(const std::vector<std::string> &bundleFilePaths, const InstallParam &installParam,
         const sptr<IStatusReceiver> &statusReceiver) override;
+    virtual bool StreamInstall(int32_t streamFd, const InstallParam &installParam,
+        const sptr<IStatusReceiver> &statusReceiver) override;
     /**
      * @brief Uninstalls an application, the result will be notified from the statusReceiver object.
      * @param bundleName Indicates the bundle name of the application to uninstall.
@@ -132,6 +134,7 @@ private:
      * @return
      */
     void HandleInstallMultipleHapsMessage(Parcel &data);
+    void HandleStreamInstallMessage(MessageParcel &data);
     /**
      * @brief Handles the Uninstall bundle function called from a IBundleInstaller proxy object.
      * @param data Indicates the data to be read.
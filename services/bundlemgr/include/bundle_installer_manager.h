@@ -76,6 +76,16 @@ public:
      */
     void CreateInstallTask(const std::vector<std::string> &bundleFilePaths, const InstallParam &installParam,
         const sptr<IStatusReceiver> &statusReceiver);
+    /**
+     * @brief Create a bundle installer object to install a bundle received from a stream.
+     * @param streamFd Indicates the readable file descriptor of the HAP, it is closed by the task.
+     * @param installParam Indicates the install parameters.
+     * @param statusReceiver Indicates the callback object that using for notifing the install result.
+     * @return Returns true if the install task is created; returns false otherwise, and the caller
+     *         keeps the ownership of streamFd.
+     */
+    bool CreateStreamInstallTask(int32_t streamFd, const InstallParam &installParam,
+        const sptr<IStatusReceiver> &statusReceiver);
     /**
      * @brief Create a bundle installer object for uninstalling an bundle.
      * @param bundleName Indicates the bundle name of the application to uninstall.
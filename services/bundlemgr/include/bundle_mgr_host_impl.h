@@ -35,6 +35,16 @@ public:
         handler_ = std::make_shared<BMSEventHandler>(myRunner);
     }
     virtual ~BundleMgrHostImpl() {}
+    /**
+     * @brief Handles the IPC request, serving hot queries from the reply cache when possible.
+     * @param code Indicates the request code.
+     * @param data Indicates the request data.
+     * @param reply Indicates the reply data.
+     * @param option Indicates the message option.
+     * @return Returns NO_ERROR if the request is handled; returns an IPC error code otherwise.
+     */
+    virtual int OnRemoteRequest(
+        uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override;
     /**
      * @brief Obtains the ApplicationInfo based on a given bundle name.
      * @param appName Indicates the application bundle name to be queried.
@@ -765,6 +775,7 @@ private:
     bool DumpShortcutInfo(const std::string &bundleName, int32_t userId, std::string &result);
     std::set<int32_t> GetExistsCommonUserIs();
     bool VerifyQueryPermission(const std::string &queryBundleName);
+    bool PeekCacheableQuery(uint32_t code, MessageParcel &data, std::string &bundleName, std::string &key);
     void CleanBundleCacheTask(const std::string &bundleName, const sptr<ICleanCacheCallback> &cleanCacheCallback,
         int32_t userId);
 
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_MGR_REPLY_CACHE_H
+#define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_MGR_REPLY_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Caches already marshalled reply buffers of hot BundleMgrHost queries.
+ * Entries are keyed by (code, user id, request bytes) and belong to one bundle, so that any
+ * mutation of that bundle in BundleDataMgr drops them. A generation number taken before the
+ * query is computed guards against storing a reply that raced with a mutation.
+ */
+class BundleMgrReplyCache final {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t stores = 0;
+        uint64_t evictions = 0;
+        uint64_t invalidations = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    BundleMgrReplyCache() = default;
+    ~BundleMgrReplyCache() = default;
+
+    static std::string MakeKey(uint32_t code, int32_t userId, const uint8_t *args, size_t argsSize);
+    /**
+     * @brief Copy the cached reply of the key into reply.
+     * @param key Indicates the key built by MakeKey.
+     * @param reply Indicates the marshalled reply.
+     * @return Returns true if the key is cached; returns false otherwise.
+     */
+    bool Lookup(const std::string &key, std::vector<uint8_t> &reply);
+    /**
+     * @brief Obtains the generation to pass to Store after the reply has been computed.
+     * @return Returns the current generation.
+     */
+    uint64_t GetGeneration() const;
+    /**
+     * @brief Store a marshalled reply, unless the cache was invalidated since generation was taken.
+     * @param key Indicates the key built by MakeKey.
+     * @param bundleName Indicates the bundle the reply was computed from.
+     * @param generation Indicates the generation taken before the reply was computed.
+     * @param reply Indicates the marshalled reply.
+     */
+    void Store(const std::string &key, const std::string &bundleName, uint64_t generation,
+        const uint8_t *reply, size_t replySize);
+    void InvalidateBundle(const std::string &bundleName);
+    void InvalidateAll();
+    Stats GetStats() const;
+
+private:
+    struct Entry {
+        std::string bundleName;
+        std::vector<uint8_t> reply;
+        std::list<std::string>::iterator lruIter;
+    };
+
+    void EraseEntry(std::unordered_map<std::string, Entry>::iterator iter);
+    void Evict();
+
+    mutable std::mutex cacheMutex_;
+    uint64_t generation_ = 0;
+    size_t bytes_ = 0;
+    Stats stats_;
+    // key:code + userId + request bytes
+    std::unordered_map<std::string, Entry> entries_;
+    // front is the most recently used key
+    std::list<std::string> lruList_;
+    // key:bundleName, value:keys of entries computed from the bundle
+    std::unordered_map<std::string, std::set<std::string>> bundleKeys_;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_MGR_REPLY_CACHE_H
@@ -26,6 +26,8 @@
 
 namespace OHOS {
 namespace AppExecFwk {
+class BundleExtractor;
+
 class BundleParser {
 public:
     /**
@@ -35,8 +37,22 @@ public:
      * @return Returns ERR_OK if the bundle successfully parsed; returns ErrCode otherwise.
      */
     ErrCode Parse(const std::string &pathName, InnerBundleInfo &innerBundleInfo) const;
+    /**
+     * @brief Parse bundle from an opened hap, then save in innerBundleInfo info.
+     * @param bundleExtractor Indicates the initialized extractor of the hap.
+     * @param innerBundleInfo Indicates the obtained InnerBundleInfo object.
+     * @return Returns ERR_OK if the bundle successfully parsed; returns ErrCode otherwise.
+     */
+    ErrCode Parse(const BundleExtractor &bundleExtractor, InnerBundleInfo &innerBundleInfo) const;
 
     ErrCode ParsePackInfo(const std::string &pathName, BundlePackInfo &bundlePackInfo) const;
+    /**
+     * @brief Parse pack.info from an opened hap, then save in bundlePackInfo.
+     * @param bundleExtractor Indicates the initialized extractor of the hap.
+     * @param bundlePackInfo Indicates the obtained BundlePackInfo object.
+     * @return Returns ERR_OK if the pack.info successfully parsed or not exists; returns ErrCode otherwise.
+     */
+    ErrCode ParsePackInfo(const BundleExtractor &bundleExtractor, BundlePackInfo &bundlePackInfo) const;
     /**
      * @brief Parse bundle by the path name, then save in innerBundleInfo info.
      * @param pathName Indicates the path of Bundle.
@@ -44,6 +60,13 @@ public:
      * @return Returns ERR_OK if the bundle successfully parsed; returns ErrCode otherwise.
      */
     ErrCode ParseSysCap(const std::string &pathName, std::vector<std::string> &sysCaps) const;
+    /**
+     * @brief Parse sysCaps from an opened hap.
+     * @param bundleExtractor Indicates the initialized extractor of the hap.
+     * @param sysCaps Indicates the sysCap.
+     * @return Returns ERR_OK if the bundle successfully parsed; returns ErrCode otherwise.
+     */
+    ErrCode ParseSysCap(const BundleExtractor &bundleExtractor, std::vector<std::string> &sysCaps) const;
     /**
      * @brief Parse scanInfos by the configFile.
      * @param configFile Indicates the path of configFile.
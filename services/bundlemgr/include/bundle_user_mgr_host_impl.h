@@ -16,6 +16,8 @@
 #ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_USER_MGR_HOST_IMPL_H
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_USER_MGR_HOST_IMPL_H
 
+#include <set>
+
 #include "bundle_data_mgr.h"
 #include "bundle_installer_host.h"
 #include "bundle_user_mgr_host.h"
@@ -41,6 +43,8 @@ private:
     const std::shared_ptr<BundleDataMgr> GetDataMgrFromService();
     const sptr<IBundleInstaller> GetBundleInstaller();
     void CheckInitialUser();
+    std::set<std::string> CreateBundleDataDirs(int32_t userId, const std::shared_ptr<BundleDataMgr> &dataMgr,
+        const std::vector<PreInstallBundleInfo> &preInstallBundleInfos);
 
     std::mutex bundleUserMgrMutex_;
 };
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "appexecfwk_errors.h"
+#include "bundle_constants.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -64,6 +65,15 @@ public:
      * @return Returns true if the file size checked successfully; returns false otherwise.
      */
     static bool CheckSystemSize(const std::string &bundlePath, const std::string &diskPath);
+    /**
+     * @brief Receive a hap from a stream to a new file, the data from a pipe is moved without copying to user space.
+     * @param streamFd Indicates the readable file descriptor, the hap is read until the end of file.
+     * @param targetPath Indicates the path of the file to create.
+     * @param idleTimeoutMs Indicates the max time in milliseconds to wait for the next data of the stream.
+     * @return Returns ERR_OK if the hap received successfully; returns error code otherwise.
+     */
+    static ErrCode ReceiveStream(int32_t streamFd, const std::string &targetPath,
+        int32_t idleTimeoutMs = Constants::STREAM_IDLE_TIMEOUT_MS);
     /**
      * @brief to obtain the hap paths of the input bundle path.
      * @param currentBundlePath Indicates the current bundle path.
@@ -17,6 +17,7 @@
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_BUNDLE_DISTRIBUTED_DATA_STORAGE_H
 
 #include <map>
+#include <vector>
 
 #include "distributed_bundle_info.h"
 
@@ -47,10 +48,15 @@ private:
     bool CheckKvStore();
     DistributedKv::Status GetKvStore();
     bool GetLocalUdid(std::string &udid);
-    DistributedBundleInfo ConvertToDistributedBundleInfo(const BundleInfo &bundleInfo);
+    DistributedBundleInfo ConvertToDistributedBundleInfo(const BundleInfo &bundleInfo) const;
     int32_t GetUdidByNetworkId(const std::string &networkId, std::string &udid);
     void CheckToSyncDistributedData();
-    bool InnerSaveStorageDistributeInfo(const DistributedBundleInfo distributedBundleInfo);
+    bool InnerSaveStorageDistributeInfo(const DistributedBundleInfo distributedBundleInfo, bool &isChanged);
+    void CollectChangedData(const std::string &udid, const std::vector<BundleInfo> &bundleInfos,
+        const std::vector<DistributedKv::Entry> &storedEntries, std::vector<DistributedKv::Entry> &changedEntries,
+        std::vector<DistributedKv::Key> &removedKeys) const;
+    bool BatchUpdate(const std::vector<DistributedKv::Entry> &entries,
+        const std::vector<DistributedKv::Key> &removedKeys);
 private:
     static std::recursive_mutex mutex_;
     static std::shared_ptr<DistributedDataStorage> instance_;
@@ -33,6 +33,7 @@ enum class HidumpFlag {
     GET_BUNDLE_LIST,
     GET_BUNDLE_BY_NAME,
     GET_DEVICEID,
+    GET_REPLY_CACHE,
 };
 
 struct HidumpParam {
@@ -67,6 +68,7 @@ private:
     ErrCode GetAllBundleNameList(std::string &result);
     ErrCode GetBundleInfoByName(const std::string &name, std::string &result);
     ErrCode GetAllDeviced(std::string &result);
+    ErrCode GetReplyCacheStats(std::string &result);
 
     std::weak_ptr<BundleDataMgr> dataMgr_;
 };
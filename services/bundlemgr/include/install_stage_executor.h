@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALL_STAGE_EXECUTOR_H
+#define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALL_STAGE_EXECUTOR_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "appexecfwk_errors.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Runs the stages of an installation as a dependency graph: a stage starts once all the stages it depends on
+ * succeeded, and the independent stages run at the same time. Once a stage fails no more stage is started, the
+ * running ones are waited for, and the caller rolls back what the finished stages did.
+ */
+class InstallStageExecutor final {
+public:
+    using Stage = std::function<ErrCode()>;
+
+    InstallStageExecutor() = default;
+    ~InstallStageExecutor() = default;
+    DISALLOW_COPY_AND_MOVE(InstallStageExecutor);
+
+    /**
+     * @brief Add a stage to the graph.
+     * @param name Indicates the name of the stage, which is used in the logs.
+     * @param stage Indicates the function of the stage, it may run on another thread.
+     * @param dependencies Indicates the indexes of the stages added before which this stage depends on.
+     * @return Returns the index of the stage.
+     */
+    size_t AddStage(const std::string &name, const Stage &stage, const std::vector<size_t> &dependencies = {});
+    /**
+     * @brief Run all the stages and wait for them.
+     * @return Returns ERR_OK if all the stages succeeded; returns the error code of the failed stage added first
+     *         otherwise.
+     */
+    ErrCode Run();
+    /**
+     * @brief Get the time of the longest chain of dependent stages in the last run.
+     * @return Returns the time in milliseconds.
+     */
+    int64_t GetCriticalPathTime() const;
+    /**
+     * @brief Get the names of the longest chain of dependent stages in the last run.
+     * @return Returns the names joined by "->".
+     */
+    std::string GetCriticalPath() const;
+
+private:
+    struct StageNode {
+        std::string name;
+        Stage stage;
+        std::vector<size_t> dependencies;
+        std::vector<size_t> dependents;
+        size_t pendingCount = 0;
+        bool finished = false;
+        ErrCode result = ERR_OK;
+        int64_t startTime = 0;
+        int64_t endTime = 0;
+    };
+
+    void ExecuteStages();
+    void CalculateCriticalPath();
+
+    std::vector<StageNode> stages_;
+    std::vector<size_t> criticalPath_;
+    int64_t criticalPathTime_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<size_t> readyStages_;
+    size_t runningCount_ = 0;
+    bool isFailed_ = false;
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALL_STAGE_EXECUTOR_H
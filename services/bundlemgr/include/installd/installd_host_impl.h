@@ -16,6 +16,11 @@
 #ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALLD_HOST_IMPL_H
 #define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALLD_HOST_IMPL_H
 
+#include <functional>
+#include <map>
+#include <mutex>
+#include <utility>
+
 #include "ipc/installd_host.h"
 #include "installd/installd_operator.h"
 
@@ -112,8 +117,48 @@ public:
      */
     virtual ErrCode GetBundleCachePath(const std::string &dir, std::vector<std::string> &cachePath) override;
 
+    /**
+     * @brief Execute filesystem operations in order as one transaction, all of them are rolled back if one fails.
+     * @param operations Indicates the operations to be executed.
+     * @return Returns ERR_OK if all the operations executed successfully; returns error code otherwise.
+     */
+    virtual ErrCode ExecuteBatch(const std::vector<InstalldOperation> &operations) override;
+
+    /**
+     * @brief Create the data dirs of many bundles by a pool of threads, a failed bundle does not stop the others.
+     * @param operations Indicates the CREATE_BUNDLE_DATA_DIR operations of the bundles.
+     * @param results Indicates the result of each operation.
+     * @return Returns ERR_OK if the operations are executed; returns error code otherwise.
+     */
+    virtual ErrCode CreateBundleDataDirs(
+        const std::vector<InstalldOperation> &operations, std::vector<ErrCode> &results) override;
+
+    /**
+     * @brief Recover the paths moved aside by a batch which was interrupted by the last exit of installd.
+     */
+    void RecoverBatchBackups();
+
 private:
+    // key:dir, value:bundleName and apl of the dir
+    using AplDirs = std::map<std::string, std::pair<std::string, std::string>>;
+
+    struct BatchContext {
+        // undo actions of the executed operations, run in reverse order if the batch fails
+        std::vector<std::function<void()>> rollbackLog;
+        // actions run after all the operations succeeded
+        std::vector<std::function<void()>> commitLog;
+        // dirs to be labelled after all the operations executed
+        AplDirs aplDirs;
+    };
+
     std::string GetBundleDataDir(const std::string &el, const int userid) const;
+    ErrCode CreateBundleDataDir(const std::string &bundleName,
+        const int userid, const int uid, const int gid, const std::string &apl, AplDirs *aplDirs);
+    ErrCode ExecuteOperation(const InstalldOperation &operation, BatchContext &context);
+    bool MoveAside(const std::string &path, BatchContext &context);
+    void FindBatchBackups(const std::string &dir, bool isRecursive, std::vector<std::string> &backups) const;
+    ErrCode ApplyBatchApl(const AplDirs &aplDirs);
+    ErrCode CreateBundleDataDirOfBatch(const InstalldOperation &operation, std::mutex &aplMutex);
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
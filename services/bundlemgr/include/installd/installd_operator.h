@@ -141,6 +141,13 @@ public:
      * @return Returns true if successfully; returns false otherwise.
      */
     static int64_t GetDiskUsage(const std::string &dir);
+    /**
+     * @brief Get disk usage for dir, and disk usage of the cache directories in it, in one pass.
+     * @param dir Indicates the directory.
+     * @param cacheSize Indicates the disk size of the files in cache directories.
+     * @return Returns disk size of the dir, including the cache directories.
+     */
+    static int64_t GetDiskUsageWithCache(const std::string &dir, int64_t &cacheSize);
     /**
      * @brief Traverse all cache directories.
      * @param currentPath Indicates the current path.
@@ -148,12 +155,6 @@ public:
      * @return Returns true if successfully; returns false otherwise.
      */
     static void TraverseCacheDirectory(const std::string &currentPath, std::vector<std::string> &cacheDirs);
-    /**
-     * @brief Get disk usage from path.
-     * @param path Indicates the current path.
-     * @return Returns disk size.
-     */
-    static int64_t GetDiskUsageFromPath(const std::vector<std::string> &path);
 };
 }  // namespace AppExecFwk
 }  // namespace OHOS
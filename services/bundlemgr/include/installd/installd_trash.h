@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALLD_TRASH_H
+#define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALLD_TRASH_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Removes directories of installd out of the IPC path. A victim is renamed into the trash
+ * directory of its data volume, which is atomic and O(1), and a low priority reaper thread
+ * unlinks it later with a rate limit. Trash left by a previous run is reaped after Start.
+ */
+class InstalldTrash final {
+public:
+    static InstalldTrash &GetInstance();
+    /**
+     * @brief Reap the trash left by a previous run of installd.
+     */
+    void Start();
+    /**
+     * @brief Remove a file or a directory, moving it to the trash if possible.
+     * @param path Indicates the path to remove.
+     * @return Returns true if the path is moved to the trash or removed; returns false otherwise.
+     */
+    bool RemoveDir(const std::string &path);
+    /**
+     * @brief Remove all files and directories in a directory, moving them to the trash if possible.
+     * @param dir Indicates the directory to clean.
+     * @return Returns true if all the contents are moved to the trash or removed; returns false otherwise.
+     */
+    bool RemoveDirContents(const std::string &dir);
+
+private:
+    InstalldTrash() = default;
+    ~InstalldTrash();
+
+    bool MoveToTrash(const std::string &path);
+    std::string GetTrashDir(const std::string &path) const;
+    void ScanTrashDir(const std::string &trashDir);
+    void Enqueue(const std::string &trashDir, const std::string &name);
+    void ReapLoop();
+    bool RemoveTree(int32_t parentFd, const std::string &name);
+    bool Throttle();
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    // first:trash dir, second:name of the victim in the trash dir
+    std::deque<std::pair<std::string, std::string>> pending_;
+    std::thread reaper_;
+    uint64_t trashSeq_ = 0;
+    // count of unlinks since the current rate limit window started
+    uint32_t unlinkCount_ = 0;
+    int64_t windowStart_ = 0;
+
+    DISALLOW_COPY_AND_MOVE(InstalldTrash);
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_INSTALLD_TRASH_H
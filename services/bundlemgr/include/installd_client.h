@@ -122,6 +122,16 @@ public:
      */
     ErrCode GetBundleCachePath(const std::string &dir, std::vector<std::string> &cachePath);
 
+    ErrCode ExecuteBatch(const std::vector<InstalldOperation> &operations);
+
+    /**
+     * @brief Create the data dirs of many bundles, the operations are sent to installd in chunks.
+     * @param operations Indicates the CREATE_BUNDLE_DATA_DIR operations of the bundles.
+     * @param results Indicates the result of each operation.
+     * @return Returns ERR_OK if the operations are executed; returns error code otherwise.
+     */
+    ErrCode CreateBundleDataDirs(const std::vector<InstalldOperation> &operations, std::vector<ErrCode> &results);
+
 private:
     /**
      * @brief Get the installd proxy object.
@@ -117,6 +117,22 @@ private:
      */
     bool HandleGetBundleCachePath(MessageParcel &data, MessageParcel &reply);
 
+    /**
+     * @brief Handles the ExecuteBatch function called from a IInstalld proxy object.
+     * @param data Indicates the data to be read.
+     * @param reply Indicates the reply to be sent;
+     * @return Returns true if called successfully; returns false otherwise.
+     */
+    bool HandleExecuteBatch(MessageParcel &data, MessageParcel &reply);
+
+    /**
+     * @brief Handles the CreateBundleDataDirs function called from a IInstalld proxy object.
+     * @param data Indicates the data to be read.
+     * @param reply Indicates the reply to be sent;
+     * @return Returns true if called successfully; returns false otherwise.
+     */
+    bool HandleCreateBundleDataDirs(MessageParcel &data, MessageParcel &reply);
+
     using InstalldFunc = bool (InstalldHost::*)(MessageParcel &, MessageParcel &);
     std::unordered_map<uint32_t, InstalldFunc> funcMap_;
 };
@@ -22,6 +22,7 @@
 #include "iremote_broker.h"
 
 #include "appexecfwk_errors.h"
+#include "ipc/installd_operation.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -112,6 +113,20 @@ public:
      * @return Returns ERR_OK if get cache file path successfully; returns error code otherwise.
      */
     virtual ErrCode GetBundleCachePath(const std::string &dir, std::vector<std::string> &cachePath) = 0;
+    /**
+     * @brief Execute filesystem operations in order as one transaction, all of them are rolled back if one fails.
+     * @param operations Indicates the operations to be executed.
+     * @return Returns ERR_OK if all the operations executed successfully; returns error code otherwise.
+     */
+    virtual ErrCode ExecuteBatch(const std::vector<InstalldOperation> &operations) = 0;
+    /**
+     * @brief Create the data dirs of many bundles concurrently, a failed bundle does not stop the others.
+     * @param operations Indicates the CREATE_BUNDLE_DATA_DIR operations of the bundles.
+     * @param results Indicates the result of each operation.
+     * @return Returns ERR_OK if the operations are executed; returns error code otherwise.
+     */
+    virtual ErrCode CreateBundleDataDirs(
+        const std::vector<InstalldOperation> &operations, std::vector<ErrCode> &results) = 0;
 protected:
     enum Message : uint32_t {
         CREATE_BUNDLE_DIR = 1,
@@ -124,7 +139,9 @@ protected:
         REMOVE_DIR,
         GET_BUNDLE_STATS,
         SET_DIR_APL,
-        GET_BUNDLE_CACHE_PATH
+        GET_BUNDLE_CACHE_PATH,
+        EXECUTE_BATCH,
+        CREATE_BUNDLE_DATA_DIRS
     };
 };
 
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_IPC_INSTALLD_OPERATION_H
+#define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_IPC_INSTALLD_OPERATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * One filesystem operation of an installd batch, see IInstalld::ExecuteBatch.
+ * The parameters have the same meaning as the ones of the single IInstalld call of the same name.
+ */
+struct InstalldOperation {
+    enum class Type : int32_t {
+        CREATE_BUNDLE_DIR = 1,
+        EXTRACT_MODULE_FILES,
+        RENAME_MODULE_DIR,
+        CREATE_BUNDLE_DATA_DIR,
+        REMOVE_DIR,
+        SET_DIR_APL,
+    };
+
+    // the max count of operations in one batch
+    static constexpr size_t MAX_BATCH_SIZE = 256;
+
+    Type type = Type::CREATE_BUNDLE_DIR;
+    std::vector<std::string> strParams;
+    std::vector<int32_t> intParams;
+
+    static InstalldOperation CreateBundleDir(const std::string &bundleDir)
+    {
+        return { Type::CREATE_BUNDLE_DIR, { bundleDir }, {} };
+    }
+
+    static InstalldOperation ExtractModuleFiles(const std::string &srcModulePath, const std::string &targetPath,
+        const std::string &targetSoPath, const std::string &cpuAbi)
+    {
+        return { Type::EXTRACT_MODULE_FILES, { srcModulePath, targetPath, targetSoPath, cpuAbi }, {} };
+    }
+
+    static InstalldOperation RenameModuleDir(const std::string &oldPath, const std::string &newPath)
+    {
+        return { Type::RENAME_MODULE_DIR, { oldPath, newPath }, {} };
+    }
+
+    static InstalldOperation CreateBundleDataDir(const std::string &bundleName,
+        const int userid, const int uid, const int gid, const std::string &apl)
+    {
+        return { Type::CREATE_BUNDLE_DATA_DIR, { bundleName, apl }, { userid, uid, gid } };
+    }
+
+    static InstalldOperation RemoveDir(const std::string &dir)
+    {
+        return { Type::REMOVE_DIR, { dir }, {} };
+    }
+
+    static InstalldOperation SetDirApl(const std::string &dir, const std::string &bundleName, const std::string &apl)
+    {
+        return { Type::SET_DIR_APL, { dir, bundleName, apl }, {} };
+    }
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_IPC_INSTALLD_OPERATION_H
@@ -112,8 +112,23 @@ public:
      * @return Returns ERR_OK if get cache file path successfully; returns error code otherwise.
      */
     virtual ErrCode GetBundleCachePath(const std::string &dir, std::vector<std::string> &cachePath) override;
+    /**
+     * @brief Execute filesystem operations as one transaction through a proxy object.
+     * @param operations Indicates the operations to be executed.
+     * @return Returns ERR_OK if all the operations executed successfully; returns error code otherwise.
+     */
+    virtual ErrCode ExecuteBatch(const std::vector<InstalldOperation> &operations) override;
+    /**
+     * @brief Create the data dirs of many bundles concurrently, a failed bundle does not stop the others.
+     * @param operations Indicates the CREATE_BUNDLE_DATA_DIR operations of the bundles.
+     * @param results Indicates the result of each operation.
+     * @return Returns ERR_OK if the operations are executed; returns error code otherwise.
+     */
+    virtual ErrCode CreateBundleDataDirs(
+        const std::vector<InstalldOperation> &operations, std::vector<ErrCode> &results) override;
 
 private:
+    ErrCode WriteOperations(MessageParcel &data, const std::vector<InstalldOperation> &operations);
     ErrCode TransactInstalldCmd(uint32_t code, MessageParcel &data, MessageParcel &reply,
         MessageOption &option);
     static inline BrokerDelegator<InstalldProxy> delegator_;
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_RESOURCE_MANAGER_CACHE_H
+#define FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_RESOURCE_MANAGER_CACHE_H
+
+#ifdef GLOBAL_RESMGR_ENABLE
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "bundle_info.h"
+#include "nocopyable.h"
+#include "resource_manager.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+/**
+ * Keeps the most recently used ResourceManagers, so that label and icon lookups of an app do not
+ * load the resource index of its modules again. Entries are keyed by (bundle, module resource
+ * paths, locale) and are dropped when the bundle is installed, updated or uninstalled.
+ */
+class ResourceManagerCache final {
+public:
+    using Creator = std::function<std::shared_ptr<Global::Resource::ResourceManager>()>;
+
+    ResourceManagerCache() = default;
+    ~ResourceManagerCache() = default;
+
+    /**
+     * @brief Obtains the cached ResourceManager of a bundle, or create and cache it by creator.
+     * @param bundleInfo Indicates the bundle info which contains the module resource paths.
+     * @param locale Indicates the locale the ResourceManager is configured with.
+     * @param creator Indicates the function to create the ResourceManager if it is not cached, it is called without
+     *                holding the lock of the cache.
+     * @return Returns the ResourceManager; returns nullptr if creator failed.
+     */
+    std::shared_ptr<Global::Resource::ResourceManager> GetResourceManager(
+        const BundleInfo &bundleInfo, const std::string &locale, const Creator &creator);
+    void InvalidateBundle(const std::string &bundleName);
+    void InvalidateAll();
+
+private:
+    struct Entry {
+        std::string bundleName;
+        std::shared_ptr<Global::Resource::ResourceManager> resourceManager;
+        std::list<std::string>::iterator lruIter;
+    };
+
+    std::mutex cacheMutex_;
+    // key:bundleName + module resource paths + locale
+    std::unordered_map<std::string, Entry> entries_;
+    // front is the most recently used key
+    std::list<std::string> lruList_;
+    // increased by every invalidation, a ResourceManager created across an invalidation is not cached
+    uint64_t generation_ = 0;
+
+    DISALLOW_COPY_AND_MOVE(ResourceManagerCache);
+};
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // GLOBAL_RESMGR_ENABLE
+#endif  // FOUNDATION_APPEXECFWK_SERVICES_BUNDLEMGR_INCLUDE_RESOURCE_MANAGER_CACHE_H
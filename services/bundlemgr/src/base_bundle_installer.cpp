@@ -15,6 +15,9 @@
 
 #include "base_bundle_installer.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 #include "nlohmann/json.hpp"
 
 #ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
@@ -32,7 +35,9 @@
 #include "bundle_util.h"
 #include "bundle_verify_mgr.h"
 #include "bytrace.h"
+#include "concurrent_util.h"
 #include "datetime_ex.h"
+#include "install_stage_executor.h"
 #include "installd_client.h"
 #include "perf_profile.h"
 #include "scope_guard.h"
@@ -42,6 +47,10 @@
 namespace OHOS {
 namespace AppExecFwk {
 using namespace OHOS::Security;
+namespace {
+// the max count of threads verifying or parsing the haps of an installation, including the calling thread
+const size_t MAX_HAP_THREAD_NUM = 4;
+}  // namespace
 
 BaseBundleInstaller::BaseBundleInstaller()
 {
@@ -219,10 +228,24 @@ ErrCode BaseBundleInstaller::UninstallBundle(
     return result;
 }
 
-void BaseBundleInstaller::UpdateInstallerState(const InstallerState state)
+void BaseBundleInstaller::UpdateInstallerState(const InstallerState state, const int64_t criticalPathTime)
 {
     APP_LOGD("UpdateInstallerState in BaseBundleInstaller state %{public}d", state);
-    SetInstallerState(state);
+    SetInstallerState(state, criticalPathTime);
+}
+
+void BaseBundleInstaller::SetInstallerState(InstallerState state, int64_t criticalPathTime)
+{
+    // the states are reached one after another, the time between two of them is the critical path of the stages
+    int64_t now = GetTickCount();
+    if (stateTime_ > 0 && criticalPathTime > 0) {
+        APP_LOGI("installer state %{public}d reached in %{public}" PRId64 "ms, critical path of stages %{public}"
+            PRId64 "ms", state, now - stateTime_, criticalPathTime);
+    } else if (stateTime_ > 0) {
+        APP_LOGD("installer state %{public}d reached in %{public}" PRId64 "ms", state, now - stateTime_);
+    }
+    state_ = state;
+    stateTime_ = now;
 }
 
 void BaseBundleInstaller::SaveOldRemovableInfo(
@@ -443,28 +466,37 @@ ErrCode BaseBundleInstaller::ProcessBundleInstall(const std::vector<std::string>
         return ERR_APPEXECFWK_USER_NOT_EXIST;
     }
 
+    stateTime_ = GetTickCount();
     std::vector<std::string> bundlePaths;
     // check hap paths
     ErrCode result = BundleUtil::CheckFilePath(inBundlePaths, bundlePaths);
     CHECK_RESULT(result, "hap file check failed %{public}d");
     UpdateInstallerState(InstallerState::INSTALL_BUNDLE_CHECKED);                  // ---- 5%
 
-    // check syscap
-    result = CheckSysCap(bundlePaths);
-    CHECK_RESULT(result, "hap syscap check failed %{public}d");
-    UpdateInstallerState(InstallerState::INSTALL_SYSCAP_CHECKED);                  // ---- 10%
+    // open every hap once, the central directory of it is shared by the syscap checking and the parsing
+    std::vector<std::shared_ptr<BundleExtractor>> bundleExtractors;
+    result = OpenBundleExtractors(bundlePaths, bundleExtractors);
+    CHECK_RESULT(result, "open hap files failed %{public}d");
 
-    // verify signature info for all haps
+    // check syscap and verify signature info for all haps, they are independent and run at the same time
     std::vector<Security::Verify::HapVerifyResult> hapVerifyResults;
-    result = CheckMultipleHapsSignInfo(bundlePaths, installParam, hapVerifyResults);
-    CHECK_RESULT(result, "hap files check signature info failed %{public}d");
+    InstallStageExecutor checkExecutor;
+    checkExecutor.AddStage("check syscap", [&] { return CheckSysCap(bundleExtractors); });
+    checkExecutor.AddStage("verify signature", [&] {
+        return CheckMultipleHapsSignInfo(bundlePaths, installParam, hapVerifyResults);
+    });
+    result = checkExecutor.Run();
+    CHECK_RESULT(result, "hap syscap or signature info check failed %{public}d");
+    UpdateInstallerState(InstallerState::INSTALL_SYSCAP_CHECKED, checkExecutor.GetCriticalPathTime());  // ---- 10%
     UpdateInstallerState(InstallerState::INSTALL_SIGNATURE_CHECKED);               // ---- 15%
 
     // parse the bundle infos for all haps
     // key is bundlePath , value is innerBundleInfo
     std::unordered_map<std::string, InnerBundleInfo> newInfos;
-    result = ParseHapFiles(bundlePaths, installParam, appType, hapVerifyResults, newInfos);
+    result = ParseHapFiles(bundlePaths, installParam, appType, hapVerifyResults, bundleExtractors, newInfos);
     CHECK_RESULT(result, "parse haps file failed %{public}d");
+    // the module files are extracted by installd, close the haps here
+    bundleExtractors.clear();
     UpdateInstallerState(InstallerState::INSTALL_PARSED);                          // ---- 20%
 
     // check versioncode and bundleName
@@ -484,17 +516,10 @@ ErrCode BaseBundleInstaller::ProcessBundleInstall(const std::vector<std::string>
     InnerBundleInfo oldInfo;
     result = InnerProcessBundleInstall(newInfos, oldInfo, installParam, uid);
     CHECK_RESULT_WITH_ROLLBACK(result, "internal processing failed with result %{public}d", newInfos, oldInfo);
-    UpdateInstallerState(InstallerState::INSTALL_INFO_SAVED);                      // ---- 80%
+    UpdateInstallerState(InstallerState::INSTALL_INFO_SAVED, installStagesTime_);  // ---- 80%
 
     // rename for all temp dirs
-    for (const auto &info : newInfos) {
-        if (info.second.IsOnlyCreateBundleUser()) {
-            continue;
-        }
-        if ((result = RenameModuleDir(info.second)) != ERR_OK) {
-            break;
-        }
-    }
+    result = RenameModuleDirs(newInfos);
     UpdateInstallerState(InstallerState::INSTALL_RENAMED);                         // ---- 90%
 
     CHECK_RESULT_WITH_ROLLBACK(result, "rename temp dirs failed with result %{public}d", newInfos, oldInfo);
@@ -900,7 +925,9 @@ ErrCode BaseBundleInstaller::InnerProcessInstallByPreInstallInfo(
                 return result;
             }
 
+            isDataDirCreated_ = installParam.isDataDirCreated;
             result = CreateBundleUserData(oldInfo);
+            isDataDirCreated_ = false;
             if (result != ERR_OK) {
                 return result;
             }
@@ -978,22 +1005,34 @@ ErrCode BaseBundleInstaller::ProcessBundleInstallStatus(InnerBundleInfo &info, i
     }
 
     ScopeGuard bundleGuard([&] { RemoveBundleAndDataDir(info, false); });
+    // the module files are extracted by installd while the access token is created and the permissions are
+    // granted, both stages only read info, which is updated once they finished
     std::string modulePath = info.GetAppCodePath() + Constants::PATH_SEPARATOR + modulePackage_;
-    result = ExtractModule(info, modulePath);
+    uint32_t tokenId = 0;
+    ScopeGuard tokenGuard([&] {
+        if (tokenId != 0 && BundlePermissionMgr::DeleteAccessTokenId(tokenId) !=
+            AccessToken::AccessTokenKitRet::RET_SUCCESS) {
+            APP_LOGE("delete accessToken failed");
+        }
+    });
+    InstallStageExecutor installExecutor;
+    installExecutor.AddStage("extract module", [&] { return ExtractModuleCode(info, modulePath); });
+    installExecutor.AddStage("grant permissions", [&] {
+        tokenId = CreateAccessTokenId(info);
+        return GrantRequestPermissions(info, tokenId);
+    });
+    result = installExecutor.Run();
     if (result != ERR_OK) {
-        APP_LOGE("extract module failed");
+        APP_LOGE("extract module or grant permissions failed");
         return result;
     }
+    installStagesTime_ += installExecutor.GetCriticalPathTime();
+    info.SetAccessTokenId(tokenId, userId_);
+    AddModuleDirs(info);
 
     info.SetInstallMark(bundleName_, modulePackage_, InstallExceptionStatus::INSTALL_FINISH);
     uid = info.GetUid(userId_);
     info.SetBundleInstallTime(BundleUtil::GetCurrentTime(), userId_);
-    uint32_t tokenId = CreateAccessTokenId(info);
-    info.SetAccessTokenId(tokenId, userId_);
-    result = GrantRequestPermissions(info, tokenId);
-    if (result != ERR_OK) {
-        return result;
-    }
     if (!dataMgr_->AddInnerBundleInfo(bundleName_, info)) {
         APP_LOGE("add bundle %{public}s info failed", bundleName_.c_str());
         dataMgr_->UpdateBundleInstallState(bundleName_, InstallState::UNINSTALL_START);
@@ -1003,6 +1042,7 @@ ErrCode BaseBundleInstaller::ProcessBundleInstallStatus(InnerBundleInfo &info, i
 
     stateGuard.Dismiss();
     bundleGuard.Dismiss();
+    tokenGuard.Dismiss();
 
     APP_LOGD("finish to call processBundleInstallStatus");
     return ERR_OK;
@@ -1228,25 +1268,23 @@ ErrCode BaseBundleInstaller::ProcessModuleUpdate(InnerBundleInfo &newInfo,
 
 ErrCode BaseBundleInstaller::SetDirApl(const InnerBundleInfo &info)
 {
+    std::vector<InstalldOperation> operations;
     for (const auto &el : Constants::BUNDLE_EL) {
         std::string baseBundleDataDir = Constants::BUNDLE_APP_DATA_BASE_DIR +
                                         el +
                                         Constants::FILE_SEPARATOR_CHAR +
                                         std::to_string(userId_);
         std::string baseDataDir = baseBundleDataDir + Constants::BASE + info.GetBundleName();
-        ErrCode result = InstalldClient::GetInstance()->SetDirApl(
-            baseDataDir, info.GetBundleName(), info.GetAppPrivilegeLevel());
-        if (result != ERR_OK) {
-            APP_LOGE("fail to SetDirApl baseDir dir, error is %{public}d", result);
-            return result;
-        }
+        operations.emplace_back(InstalldOperation::SetDirApl(
+            baseDataDir, info.GetBundleName(), info.GetAppPrivilegeLevel()));
         std::string databaseDataDir = baseBundleDataDir + Constants::DATABASE + info.GetBundleName();
-        result = InstalldClient::GetInstance()->SetDirApl(
-            databaseDataDir, info.GetBundleName(), info.GetAppPrivilegeLevel());
-        if (result != ERR_OK) {
-            APP_LOGE("fail to SetDirApl databaseDir dir, error is %{public}d", result);
-            return result;
-        }
+        operations.emplace_back(InstalldOperation::SetDirApl(
+            databaseDataDir, info.GetBundleName(), info.GetAppPrivilegeLevel()));
+    }
+    ErrCode result = InstalldClient::GetInstance()->ExecuteBatch(operations);
+    if (result != ERR_OK) {
+        APP_LOGE("fail to SetDirApl data dirs, error is %{public}d", result);
+        return result;
     }
 
     return ERR_OK;
@@ -1254,64 +1292,91 @@ ErrCode BaseBundleInstaller::SetDirApl(const InnerBundleInfo &info)
 
 ErrCode BaseBundleInstaller::CreateBundleAndDataDir(InnerBundleInfo &info) const
 {
-    ErrCode result = CreateBundleCodeDir(info);
+    InnerBundleUserInfo newInnerBundleUserInfo;
+    ErrCode result = GenerateBundleUserInfo(info, newInnerBundleUserInfo);
     if (result != ERR_OK) {
-        APP_LOGE("fail to create bundle code dir, error is %{public}d", result);
         return result;
     }
-    ScopeGuard codePathGuard([&] { InstalldClient::GetInstance()->RemoveDir(info.GetAppCodePath()); });
-    result = CreateBundleDataDir(info);
+
+    // the code dir and the data dirs are created in one installd transaction, either all or none of them exist
+    auto appCodePath = Constants::BUNDLE_CODE_DIR + Constants::PATH_SEPARATOR + bundleName_;
+    APP_LOGD("create bundle dir %{private}s", appCodePath.c_str());
+    std::vector<InstalldOperation> operations = {
+        InstalldOperation::CreateBundleDir(appCodePath),
+        InstalldOperation::CreateBundleDataDir(info.GetBundleName(), userId_,
+            newInnerBundleUserInfo.uid, newInnerBundleUserInfo.uid, info.GetAppPrivilegeLevel()),
+    };
+    result = InstalldClient::GetInstance()->ExecuteBatch(operations);
     if (result != ERR_OK) {
-        APP_LOGE("fail to create bundle data dir, error is %{public}d", result);
+        APP_LOGE("fail to create bundle and data dir, error is %{public}d", result);
         return result;
     }
-    codePathGuard.Dismiss();
+
+    info.SetAppCodePath(appCodePath);
+    SetBundleDataDirInfo(info, newInnerBundleUserInfo);
     return ERR_OK;
 }
 
-ErrCode BaseBundleInstaller::CreateBundleCodeDir(InnerBundleInfo &info) const
+ErrCode BaseBundleInstaller::CreateBundleDataDir(InnerBundleInfo &info) const
 {
-    auto appCodePath = Constants::BUNDLE_CODE_DIR + Constants::PATH_SEPARATOR + bundleName_;
-    APP_LOGD("create bundle dir %{private}s", appCodePath.c_str());
-    ErrCode result = InstalldClient::GetInstance()->CreateBundleDir(appCodePath);
+    InnerBundleUserInfo newInnerBundleUserInfo;
+    ErrCode result = GenerateBundleUserInfo(info, newInnerBundleUserInfo);
     if (result != ERR_OK) {
-        APP_LOGE("fail to create bundle dir, error is %{public}d", result);
         return result;
     }
 
-    info.SetAppCodePath(appCodePath);
+    if (!isDataDirCreated_) {
+        // a batch removes the data dirs created so far if one of them fails
+        std::vector<InstalldOperation> operations = {
+            InstalldOperation::CreateBundleDataDir(info.GetBundleName(), userId_,
+                newInnerBundleUserInfo.uid, newInnerBundleUserInfo.uid, info.GetAppPrivilegeLevel()),
+        };
+        result = InstalldClient::GetInstance()->ExecuteBatch(operations);
+        if (result != ERR_OK) {
+            APP_LOGE("fail to create bundle data dir, error is %{public}d", result);
+            return result;
+        }
+    }
+
+    SetBundleDataDirInfo(info, newInnerBundleUserInfo);
     return ERR_OK;
 }
 
-ErrCode BaseBundleInstaller::CreateBundleDataDir(InnerBundleInfo &info) const
+ErrCode BaseBundleInstaller::GenerateBundleUserInfo(const InnerBundleInfo &info,
+    InnerBundleUserInfo &userInfo) const
 {
-    InnerBundleUserInfo newInnerBundleUserInfo;
-    if (!info.GetInnerBundleUserInfo(userId_, newInnerBundleUserInfo)) {
+    if (!info.GetInnerBundleUserInfo(userId_, userInfo)) {
         APP_LOGE("bundle(%{public}s) get user(%{public}d) failed.",
             info.GetBundleName().c_str(), userId_);
         return ERR_APPEXECFWK_USER_NOT_EXIST;
     }
 
-    if (!dataMgr_->GenerateUidAndGid(newInnerBundleUserInfo)) {
+    if (!dataMgr_->GenerateUidAndGid(userInfo)) {
         APP_LOGE("fail to gererate uid and gid");
         return ERR_APPEXECFWK_INSTALL_GENERATE_UID_ERROR;
     }
+    return ERR_OK;
+}
 
-    auto result = InstalldClient::GetInstance()->CreateBundleDataDir(info.GetBundleName(), userId_,
-        newInnerBundleUserInfo.uid, newInnerBundleUserInfo.uid, info.GetAppPrivilegeLevel());
-    if (result != ERR_OK) {
-        APP_LOGE("fail to create bundle data dir, error is %{public}d", result);
-        return result;
-    }
-
+void BaseBundleInstaller::SetBundleDataDirInfo(InnerBundleInfo &info, const InnerBundleUserInfo &userInfo) const
+{
     std::string dataBaseDir = Constants::BUNDLE_APP_DATA_BASE_DIR + Constants::BUNDLE_EL[1] +
         Constants::DATABASE + info.GetBundleName();
     info.SetAppDataBaseDir(dataBaseDir);
-    info.AddInnerBundleUserInfo(newInnerBundleUserInfo);
-    return ERR_OK;
+    info.AddInnerBundleUserInfo(userInfo);
 }
 
 ErrCode BaseBundleInstaller::ExtractModule(InnerBundleInfo &info, const std::string &modulePath)
+{
+    auto result = ExtractModuleCode(info, modulePath);
+    if (result != ERR_OK) {
+        return result;
+    }
+    AddModuleDirs(info);
+    return ERR_OK;
+}
+
+ErrCode BaseBundleInstaller::ExtractModuleCode(const InnerBundleInfo &info, const std::string &modulePath)
 {
     std::string targetSoPath;
     std::string nativeLibraryPath = info.GetBaseApplicationInfo().nativeLibraryPath;
@@ -1323,15 +1388,21 @@ ErrCode BaseBundleInstaller::ExtractModule(InnerBundleInfo &info, const std::str
     std::string cpuAbi = info.GetBaseApplicationInfo().cpuAbi;
     APP_LOGD("begin to extract module files, modulePath : %{private}s, targetSoPath : %{private}s, cpuAbi : %{public}s",
         modulePath.c_str(), targetSoPath.c_str(), cpuAbi.c_str());
+    int64_t startTime = GetTickCount();
     auto result = ExtractModuleFiles(info, modulePath, targetSoPath, cpuAbi);
+    PerfProfile::GetInstance().AddBundleModuleExtractTime(GetTickCount() - startTime);
     if (result != ERR_OK) {
         APP_LOGE("fail to extrace module dir, error is %{public}d", result);
         return result;
     }
+    return ERR_OK;
+}
+
+void BaseBundleInstaller::AddModuleDirs(InnerBundleInfo &info) const
+{
     auto moduleDir = info.GetAppCodePath() + Constants::PATH_SEPARATOR + info.GetCurrentModulePackage();
     info.AddModuleSrcDir(moduleDir);
     info.AddModuleResPath(moduleDir);
-    return ERR_OK;
 }
 
 ErrCode BaseBundleInstaller::RemoveBundleAndDataDir(const InnerBundleInfo &info, bool isKeepData) const
@@ -1427,24 +1498,17 @@ ErrCode BaseBundleInstaller::RemoveModuleDataDir(
     return result;
 }
 
-ErrCode BaseBundleInstaller::ParseBundleInfo(const std::string &bundleFilePath, InnerBundleInfo &info,
+ErrCode BaseBundleInstaller::ParseBundlePackInfo(const BundleExtractor &bundleExtractor, InnerBundleInfo &info,
     BundlePackInfo &packInfo) const
 {
     BundleParser bundleParser;
-    ErrCode result = bundleParser.Parse(bundleFilePath, info);
+    ErrCode result = bundleParser.ParsePackInfo(bundleExtractor, packInfo);
     if (result != ERR_OK) {
-        APP_LOGE("parse bundle info failed, error: %{public}d", result);
+        APP_LOGE("parse bundle pack info failed, error: %{public}d", result);
         return result;
     }
-    if (!packInfo.GetValid()) {
-        result = bundleParser.ParsePackInfo(bundleFilePath, packInfo);
-        if (result != ERR_OK) {
-            APP_LOGE("parse bundle pack info failed, error: %{public}d", result);
-            return result;
-        }
-        info.SetBundlePackInfo(packInfo);
-        packInfo.SetValid(true);
-    }
+    info.SetBundlePackInfo(packInfo);
+    packInfo.SetValid(true);
     return ERR_OK;
 }
 
@@ -1452,7 +1516,11 @@ ErrCode BaseBundleInstaller::ExtractModuleFiles(const InnerBundleInfo &info, con
     const std::string &targetSoPath, const std::string &cpuAbi)
 {
     APP_LOGD("extract module to %{private}s", modulePath.c_str());
-    auto result = InstalldClient::GetInstance()->ExtractModuleFiles(modulePath_, modulePath, targetSoPath, cpuAbi);
+    // a batch removes the partly extracted files and restores what was in the target path if the extraction fails
+    std::vector<InstalldOperation> operations = {
+        InstalldOperation::ExtractModuleFiles(modulePath_, modulePath, targetSoPath, cpuAbi),
+    };
+    auto result = InstalldClient::GetInstance()->ExecuteBatch(operations);
     if (result != ERR_OK) {
         APP_LOGE("extract module files failed, error is %{public}d", result);
         return result;
@@ -1460,11 +1528,23 @@ ErrCode BaseBundleInstaller::ExtractModuleFiles(const InnerBundleInfo &info, con
     return ERR_OK;
 }
 
-ErrCode BaseBundleInstaller::RenameModuleDir(const InnerBundleInfo &info) const
+ErrCode BaseBundleInstaller::RenameModuleDirs(const std::unordered_map<std::string, InnerBundleInfo> &newInfos) const
 {
-    auto moduleDir = info.GetAppCodePath() + Constants::PATH_SEPARATOR + info.GetCurrentModulePackage();
-    APP_LOGD("rename module to %{public}s", moduleDir.c_str());
-    auto result = InstalldClient::GetInstance()->RenameModuleDir(moduleDir + Constants::TMP_SUFFIX, moduleDir);
+    // a multi-hap install renames all modules in one installd transaction, so the old modules are kept on failure
+    std::vector<InstalldOperation> operations;
+    for (const auto &item : newInfos) {
+        const InnerBundleInfo &info = item.second;
+        if (info.IsOnlyCreateBundleUser()) {
+            continue;
+        }
+        auto moduleDir = info.GetAppCodePath() + Constants::PATH_SEPARATOR + info.GetCurrentModulePackage();
+        APP_LOGD("rename module to %{public}s", moduleDir.c_str());
+        operations.emplace_back(InstalldOperation::RenameModuleDir(moduleDir + Constants::TMP_SUFFIX, moduleDir));
+    }
+    if (operations.empty()) {
+        return ERR_OK;
+    }
+    auto result = InstalldClient::GetInstance()->ExecuteBatch(operations);
     if (result != ERR_OK) {
         APP_LOGE("rename module dir failed, error is %{public}d", result);
         return result;
@@ -1472,20 +1552,41 @@ ErrCode BaseBundleInstaller::RenameModuleDir(const InnerBundleInfo &info) const
     return ERR_OK;
 }
 
-ErrCode BaseBundleInstaller::CheckSysCap(const std::vector<std::string> &bundlePaths)
+ErrCode BaseBundleInstaller::OpenBundleExtractors(const std::vector<std::string> &bundlePaths,
+    std::vector<std::shared_ptr<BundleExtractor>> &bundleExtractors) const
+{
+    BYTRACE_NAME(BYTRACE_TAG_APP, __PRETTY_FUNCTION__);
+    int64_t startTime = GetTickCount();
+    for (const std::string &bundlePath : bundlePaths) {
+        auto bundleExtractor = std::make_shared<BundleExtractor>(bundlePath);
+        if (!bundleExtractor->Init()) {
+            APP_LOGE("bundle extractor init failed");
+            return ERR_APPEXECFWK_PARSE_UNEXPECTED;
+        }
+        bundleExtractors.emplace_back(bundleExtractor);
+    }
+    PerfProfile::GetInstance().AddBundleHapParseTime(GetTickCount() - startTime);
+    return ERR_OK;
+}
+
+ErrCode BaseBundleInstaller::CheckSysCap(const std::vector<std::shared_ptr<BundleExtractor>> &bundleExtractors)
 {
     BYTRACE_NAME(BYTRACE_TAG_APP, __PRETTY_FUNCTION__);
     APP_LOGD("check hap syscaps start.");
-    if (bundlePaths.empty()) {
+    if (bundleExtractors.empty()) {
         APP_LOGE("check hap syscaps failed due to empty bundlePaths!");
         return ERR_APPEXECFWK_INSTALL_PARAM_ERROR;
     }
 
+    int64_t startTime = GetTickCount();
+    ScopeGuard recordTimeGuard([startTime] {
+        PerfProfile::GetInstance().AddBundleSysCapCheckTime(GetTickCount() - startTime);
+    });
     ErrCode result = ERR_OK;
     BundleParser bundleParser;
-    for (auto bundlePath : bundlePaths) {
+    for (const auto &bundleExtractor : bundleExtractors) {
         std::vector<std::string> bundleSysCaps;
-        result = bundleParser.ParseSysCap(bundlePath, bundleSysCaps);
+        result = bundleParser.ParseSysCap(*bundleExtractor, bundleSysCaps);
         if (result != ERR_OK) {
             APP_LOGE("parse bundle syscap failed, error: %{public}d", result);
             return result;
@@ -1514,14 +1615,23 @@ ErrCode BaseBundleInstaller::CheckMultipleHapsSignInfo(const std::vector<std::st
         APP_LOGE("check hap sign info failed due to empty bundlePaths!");
         return ERR_APPEXECFWK_INSTALL_PARAM_ERROR;
     }
-    for (const std::string &bundlePath : bundlePaths) {
-        Security::Verify::HapVerifyResult hapVerifyResult;
-        auto verifyRes = BundleVerifyMgr::HapVerify(bundlePath, hapVerifyResult);
-        if (verifyRes != ERR_OK) {
+    int64_t startTime = GetTickCount();
+    ScopeGuard recordTimeGuard([startTime] {
+        PerfProfile::GetInstance().AddBundleSignatureVerifyTime(GetTickCount() - startTime);
+    });
+    // the haps are verified concurrently, and the results are checked in the order of bundlePaths
+    std::vector<Security::Verify::HapVerifyResult> verifyResults(bundlePaths.size());
+    std::vector<ErrCode> results(bundlePaths.size(), ERR_OK);
+    RunConcurrently(bundlePaths.size(), GetCpuBoundThreadNum(MAX_HAP_THREAD_NUM),
+        [&bundlePaths, &verifyResults, &results](size_t index) {
+            results[index] = BundleVerifyMgr::HapVerify(bundlePaths[index], verifyResults[index]);
+        });
+    for (size_t i = 0; i < bundlePaths.size(); ++i) {
+        if (results[i] != ERR_OK) {
             APP_LOGE("hap file verify failed");
-            return verifyRes;
+            return results[i];
         }
-        hapVerifyRes.emplace_back(hapVerifyResult);
+        hapVerifyRes.emplace_back(std::move(verifyResults[i]));
     }
     if (hapVerifyRes.empty()) {
         APP_LOGE("no sign info in the all haps!");
@@ -1554,24 +1664,44 @@ ErrCode BaseBundleInstaller::CheckMultipleHapsSignInfo(const std::vector<std::st
 ErrCode BaseBundleInstaller::ParseHapFiles(const std::vector<std::string> &bundlePaths,
     const InstallParam &installParam, const Constants::AppType appType,
     std::vector<Security::Verify::HapVerifyResult> &hapVerifyRes,
+    const std::vector<std::shared_ptr<BundleExtractor>> &bundleExtractors,
     std::unordered_map<std::string, InnerBundleInfo> &infos)
 {
     BYTRACE_NAME(BYTRACE_TAG_APP, __PRETTY_FUNCTION__);
     APP_LOGD("Parse hap file");
-    ErrCode result = ERR_OK;
-    BundlePackInfo packInfo;
-    for (uint32_t i = 0; i < bundlePaths.size(); ++i) {
-        InnerBundleInfo newInfo;
-        newInfo.SetAppType(appType);
+    int64_t startTime = GetTickCount();
+    ScopeGuard recordTimeGuard([startTime] {
+        PerfProfile::GetInstance().AddBundleHapParseTime(GetTickCount() - startTime);
+    });
+    std::vector<InnerBundleInfo> newInfos(bundlePaths.size());
+    for (size_t i = 0; i < bundlePaths.size(); ++i) {
+        newInfos[i].SetAppType(appType);
         Security::Verify::ProvisionInfo provisionInfo = hapVerifyRes[i].GetProvisionInfo();
         bool isSystemApp = (provisionInfo.bundleInfo.appFeature == Constants::HOS_SYSTEM_APP ||
             provisionInfo.bundleInfo.appFeature == Constants::OHOS_SYSTEM_APP);
         if (isSystemApp) {
-            newInfo.SetAppType(Constants::AppType::SYSTEM_APP);
+            newInfos[i].SetAppType(Constants::AppType::SYSTEM_APP);
+        }
+        newInfos[i].SetUserId(installParam.userId);
+        newInfos[i].SetIsPreInstallApp(installParam.isPreInstallApp);
+    }
+    // the haps are parsed concurrently, and the results are checked in the order of bundlePaths
+    std::vector<ErrCode> results(bundlePaths.size(), ERR_OK);
+    RunConcurrently(bundlePaths.size(), GetCpuBoundThreadNum(MAX_HAP_THREAD_NUM),
+        [&bundleExtractors, &newInfos, &results](size_t index) {
+            BundleParser bundleParser;
+            results[index] = bundleParser.Parse(*bundleExtractors[index], newInfos[index]);
+        });
+
+    ErrCode result = ERR_OK;
+    BundlePackInfo packInfo;
+    for (size_t i = 0; i < bundlePaths.size(); ++i) {
+        InnerBundleInfo &newInfo = newInfos[i];
+        Security::Verify::ProvisionInfo provisionInfo = hapVerifyRes[i].GetProvisionInfo();
+        result = results[i];
+        if (result == ERR_OK && !packInfo.GetValid()) {
+            result = ParseBundlePackInfo(*bundleExtractors[i], newInfo, packInfo);
         }
-        newInfo.SetUserId(installParam.userId);
-        newInfo.SetIsPreInstallApp(installParam.isPreInstallApp);
-        result = ParseBundleInfo(bundlePaths[i], newInfo, packInfo);
         if (result != ERR_OK) {
             APP_LOGE("bundle parse failed %{public}d", result);
             return result;
@@ -1595,7 +1725,7 @@ ErrCode BaseBundleInstaller::ParseHapFiles(const std::vector<std::string> &bundl
             return result;
         }
 
-        infos.emplace(bundlePaths[i], newInfo);
+        infos.emplace(bundlePaths[i], std::move(newInfo));
     }
     APP_LOGD("finish parse hap file");
     return result;
@@ -2004,6 +2134,8 @@ void BaseBundleInstaller::ResetInstallProperties()
     uninstallModuleVec_.clear();
     installedModules_.clear();
     state_ = InstallerState::INSTALL_START;
+    stateTime_ = 0;
+    installStagesTime_ = 0;
     singletonState_ = SingletonState::DEFAULT;
     sysEventInfo_.Reset();
 }
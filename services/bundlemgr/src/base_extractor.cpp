@@ -115,7 +115,7 @@ bool BaseExtractor::GetZipFileNames(std::vector<std::string> &fileNames)
     return true;
 }
 
-bool BaseExtractor::IsStageBasedModel(std::string abilityName)
+bool BaseExtractor::IsStageBasedModel(std::string abilityName) const
 {
     auto &entryMap = zipFile_.GetAllEntries();
     std::vector<std::string> splitStrs;
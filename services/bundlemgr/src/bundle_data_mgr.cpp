@@ -42,6 +42,12 @@
 
 namespace OHOS {
 namespace AppExecFwk {
+#ifdef GLOBAL_RESMGR_ENABLE
+namespace {
+const std::string DEFAULT_RESOURCE_LOCALE = "zh_Hans_CN";
+}
+#endif
+
 BundleDataMgr::BundleDataMgr()
 {
     InitStateTransferMap();
@@ -49,6 +55,10 @@ BundleDataMgr::BundleDataMgr()
     preInstallDataStorage_ = std::make_shared<PreInstallDataStorage>();
     distributedDataStorage_ = DistributedDataStorage::GetInstance();
     sandboxDataMgr_ = std::make_shared<BundleSandboxDataMgr>();
+    replyCache_ = std::make_shared<BundleMgrReplyCache>();
+#ifdef GLOBAL_RESMGR_ENABLE
+    resourceManagerCache_ = std::make_shared<ResourceManagerCache>();
+#endif
     APP_LOGI("BundleDataMgr instance is created");
 }
 
@@ -63,6 +73,7 @@ BundleDataMgr::~BundleDataMgr()
 bool BundleDataMgr::LoadDataFromPersistentStorage()
 {
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateAll();
     bool ret = dataStorage_->LoadAllData(bundleInfos_);
     if (ret) {
         if (bundleInfos_.empty()) {
@@ -90,6 +101,8 @@ bool BundleDataMgr::UpdateBundleInstallState(const std::string &bundleName, cons
 
     // always keep lock bundleInfoMutex_ before locking stateMutex_ to avoid deadlock
     std::lock_guard<std::mutex> lck(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
+    InvalidateResourceManager(bundleName);
     std::lock_guard<std::mutex> lock(stateMutex_);
     auto item = installStates_.find(bundleName);
     if (item == installStates_.end()) {
@@ -128,6 +141,8 @@ bool BundleDataMgr::AddInnerBundleInfo(const std::string &bundleName, InnerBundl
     }
 
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
+    InvalidateResourceManager(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem != bundleInfos_.end()) {
         APP_LOGE("bundle info already exist");
@@ -161,6 +176,8 @@ bool BundleDataMgr::SaveNewInfoToDB(const std::string &bundleName, InnerBundleIn
     }
 
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(Newbundlename);
+    InvalidateResourceManager(Newbundlename);
     auto infoItem = bundleInfos_.find(Newbundlename);
     if (infoItem != bundleInfos_.end()) {
         APP_LOGE("clone newinfo bundle info already exist");
@@ -184,6 +201,8 @@ bool BundleDataMgr::AddNewModuleInfo(
 {
     APP_LOGD("add new module info module name %{public}s ", newInfo.GetCurrentModulePackage().c_str());
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
+    InvalidateResourceManager(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem == bundleInfos_.end()) {
         APP_LOGE("bundle info not exist");
@@ -220,6 +239,8 @@ bool BundleDataMgr::RemoveModuleInfo(
 {
     APP_LOGD("remove module info:%{public}s/%{public}s", bundleName.c_str(), modulePackage.c_str());
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
+    InvalidateResourceManager(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem == bundleInfos_.end()) {
         APP_LOGE("bundle info not exist");
@@ -250,6 +271,7 @@ bool BundleDataMgr::AddInnerBundleUserInfo(
 {
     APP_LOGD("AddInnerBundleUserInfo:%{public}s", bundleName.c_str());
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem == bundleInfos_.end()) {
         APP_LOGE("bundle info not exist");
@@ -272,6 +294,7 @@ bool BundleDataMgr::RemoveInnerBundleUserInfo(
 {
     APP_LOGD("RemoveInnerBundleUserInfo:%{public}s", bundleName.c_str());
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem == bundleInfos_.end()) {
         APP_LOGE("bundle info not exist");
@@ -294,6 +317,8 @@ bool BundleDataMgr::UpdateInnerBundleInfo(
 {
     APP_LOGD("UpdateInnerBundleInfo:%{public}s", bundleName.c_str());
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
+    InvalidateResourceManager(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem == bundleInfos_.end()) {
         APP_LOGE("bundle info not exist");
@@ -686,6 +711,11 @@ bool BundleDataMgr::QueryLauncherAbilityInfos(
             APP_LOGE("no bundleName %{public}s found", bundleName.c_str());
             return false;
         }
+        // a disabled bundle is left out as the query of all launcher abilities does
+        if (item->second.IsDisabled()) {
+            APP_LOGI("app %{public}s is disabled", bundleName.c_str());
+            return true;
+        }
         GetMatchLauncherAbilityInfos(want, item->second, abilityInfos, requestUserId);
         FilterAbilityInfosByModuleName(element.GetModuleName(), abilityInfos);
         return true;
@@ -1454,6 +1484,7 @@ bool BundleDataMgr::GetInnerBundleInfo(const std::string &bundleName, InnerBundl
     }
 
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem == bundleInfos_.end()) {
         APP_LOGE("can not find bundle %{public}s", bundleName.c_str());
@@ -1464,6 +1495,23 @@ bool BundleDataMgr::GetInnerBundleInfo(const std::string &bundleName, InnerBundl
     return true;
 }
 
+bool BundleDataMgr::FetchInnerBundleInfo(const std::string &bundleName, InnerBundleInfo &info) const
+{
+    if (bundleName.empty()) {
+        APP_LOGE("bundleName is empty");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    auto infoItem = bundleInfos_.find(bundleName);
+    if (infoItem == bundleInfos_.end()) {
+        APP_LOGD("can not find bundle %{public}s", bundleName.c_str());
+        return false;
+    }
+    info = infoItem->second;
+    return true;
+}
+
 bool BundleDataMgr::DisableBundle(const std::string &bundleName)
 {
     APP_LOGD("DisableBundle %{public}s", bundleName.c_str());
@@ -1473,6 +1521,7 @@ bool BundleDataMgr::DisableBundle(const std::string &bundleName)
     }
 
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem == bundleInfos_.end()) {
         APP_LOGE("can not find bundle %{public}s", bundleName.c_str());
@@ -1491,6 +1540,7 @@ bool BundleDataMgr::EnableBundle(const std::string &bundleName)
     }
 
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem == bundleInfos_.end()) {
         APP_LOGE("can not find bundle %{public}s", bundleName.c_str());
@@ -1526,6 +1576,7 @@ bool BundleDataMgr::SetApplicationEnabled(const std::string &bundleName, bool is
         return false;
     }
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem == bundleInfos_.end()) {
         APP_LOGE("can not find bundle %{public}s", bundleName.c_str());
@@ -1556,6 +1607,7 @@ bool BundleDataMgr::SetModuleRemovable(const std::string &bundleName, const std:
     APP_LOGD("bundleName:%{public}s, moduleName:%{public}s, userId:%{public}d",
         bundleName.c_str(), moduleName.c_str(), userId);
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem == bundleInfos_.end()) {
         APP_LOGE("can not find bundle %{public}s", bundleName.c_str());
@@ -1617,6 +1669,7 @@ bool BundleDataMgr::SetAbilityEnabled(const AbilityInfo &abilityInfo, bool isEna
 {
     APP_LOGD("SetAbilityEnabled %{public}s", abilityInfo.name.c_str());
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(abilityInfo.bundleName);
     if (bundleInfos_.empty()) {
         APP_LOGE("bundleInfos_ data is empty");
         return false;
@@ -1691,6 +1744,11 @@ std::shared_ptr<BundleSandboxDataMgr> BundleDataMgr::GetSandboxDataMgr() const
 {
     return sandboxDataMgr_;
 }
+
+std::shared_ptr<BundleMgrReplyCache> BundleDataMgr::GetReplyCache() const
+{
+    return replyCache_;
+}
 bool BundleDataMgr::RegisterBundleStatusCallback(const sptr<IBundleStatusCallback> &bundleStatusCallback)
 {
     APP_LOGD("RegisterBundleStatusCallback %{public}s", bundleStatusCallback->GetBundleName().c_str());
@@ -1790,6 +1848,7 @@ bool BundleDataMgr::SetModuleUpgradeFlag(const std::string &bundleName,
 {
     APP_LOGD("SetModuleUpgradeFlag %{public}d", upgradeFlag);
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem == bundleInfos_.end()) {
         return false;
@@ -1827,6 +1886,7 @@ void BundleDataMgr::StoreSandboxPersistentInfo(const std::string &bundleName, co
         return;
     }
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
     if (bundleInfos_.find(bundleName) == bundleInfos_.end()) {
         APP_LOGW("can not find bundle %{public}s", bundleName.c_str());
         return;
@@ -1842,6 +1902,7 @@ void BundleDataMgr::DeleteSandboxPersistentInfo(const std::string &bundleName, c
         return;
     }
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
     if (bundleInfos_.find(bundleName) == bundleInfos_.end()) {
         APP_LOGW("can not find bundle %{public}s", bundleName.c_str());
         return;
@@ -2329,6 +2390,8 @@ bool BundleDataMgr::NotifyPermissionsChanged(int32_t uid)
 bool BundleDataMgr::RemoveClonedBundleInfo(const std::string &bundleName)
 {
     std::lock_guard<std::mutex> lock(bundleInfoMutex_);
+    replyCache_->InvalidateBundle(bundleName);
+    InvalidateResourceManager(bundleName);
     auto infoItem = bundleInfos_.find(bundleName);
     if (infoItem != bundleInfos_.end()) {
         APP_LOGI("del bundle name:%{public}s", bundleName.c_str());
@@ -2515,6 +2578,7 @@ void BundleDataMgr::AddUserId(int32_t userId)
         return;
     }
 
+    replyCache_->InvalidateAll();
     multiUserIdsSet_.insert(userId);
 }
 
@@ -2526,6 +2590,7 @@ void BundleDataMgr::RemoveUserId(int32_t userId)
         return;
     }
 
+    replyCache_->InvalidateAll();
     multiUserIdsSet_.erase(item);
 }
 
@@ -2895,6 +2960,13 @@ void BundleDataMgr::GetAllUriPrefix(std::vector<std::string> &uriPrefixList, int
 #ifdef GLOBAL_RESMGR_ENABLE
 std::shared_ptr<Global::Resource::ResourceManager> BundleDataMgr::GetResourceManager(
     const AppExecFwk::BundleInfo &bundleInfo) const
+{
+    return resourceManagerCache_->GetResourceManager(bundleInfo, DEFAULT_RESOURCE_LOCALE,
+        [this, &bundleInfo] { return CreateResourceManager(bundleInfo); });
+}
+
+std::shared_ptr<Global::Resource::ResourceManager> BundleDataMgr::CreateResourceManager(
+    const AppExecFwk::BundleInfo &bundleInfo) const
 {
     std::shared_ptr<Global::Resource::ResourceManager> resourceManager(Global::Resource::CreateResourceManager());
     for (auto moduleResPath : bundleInfo.moduleResPaths) {
@@ -2913,6 +2985,13 @@ std::shared_ptr<Global::Resource::ResourceManager> BundleDataMgr::GetResourceMan
 }
 #endif
 
+void BundleDataMgr::InvalidateResourceManager(const std::string &bundleName) const
+{
+#ifdef GLOBAL_RESMGR_ENABLE
+    resourceManagerCache_->InvalidateBundle(bundleName);
+#endif
+}
+
 #ifdef BUNDLE_FRAMEWORK_FREE_INSTALL
 bool BundleDataMgr::GetRemovableBundleNameVec(std::map<std::string, int>& bundlenameAndUids)
 {
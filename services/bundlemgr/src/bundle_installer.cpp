@@ -16,10 +16,12 @@
 #include "bundle_installer.h"
 
 #include <cinttypes>
+#include <unistd.h>
 
 #include "app_log_wrapper.h"
 #include "bundle_installer_manager.h"
 #include "bundle_mgr_service.h"
+#include "bundle_util.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -95,6 +97,38 @@ void BundleInstaller::Install(const std::vector<std::string> &bundleFilePaths, c
     SendRemoveEvent();
 }
 
+void BundleInstaller::StreamInstall(int32_t streamFd, const InstallParam &installParam)
+{
+    std::string bundleFilePath = Constants::STREAM_INSTALL_PATH + Constants::PATH_SEPARATOR +
+        std::to_string(installerId_) + Constants::INSTALL_FILE_SUFFIX;
+    ErrCode resultCode = BundleUtil::ReceiveStream(streamFd, bundleFilePath);
+    close(streamFd);
+    if (resultCode != ERR_OK) {
+        APP_LOGE("receive hap from stream failed, error: %{public}d", resultCode);
+        statusReceiver_->OnFinished(resultCode, "");
+        SendRemoveEvent();
+        return;
+    }
+
+    if (installParam.userId == Constants::ALL_USERID) {
+        auto userInstallParam = installParam;
+        for (auto userId : GetExistsCommonUserIs()) {
+            userInstallParam.userId = userId;
+            userInstallParam.installFlag = InstallFlag::REPLACE_EXISTING;
+            resultCode = InstallBundle(
+                bundleFilePath, userInstallParam, Constants::AppType::THIRD_PARTY_APP);
+            ResetInstallProperties();
+        }
+    } else {
+        resultCode = InstallBundle(
+            bundleFilePath, installParam, Constants::AppType::THIRD_PARTY_APP);
+    }
+    unlink(bundleFilePath.c_str());
+
+    statusReceiver_->OnFinished(resultCode, "");
+    SendRemoveEvent();
+}
+
 void BundleInstaller::InstallByBundleName(const std::string &bundleName, const InstallParam &installParam)
 {
     ErrCode resultCode = InstallBundleByBundleName(bundleName, installParam);
@@ -167,10 +201,10 @@ void BundleInstaller::Uninstall(
     SendRemoveEvent();
 }
 
-void BundleInstaller::UpdateInstallerState(const InstallerState state)
+void BundleInstaller::UpdateInstallerState(const InstallerState state, const int64_t criticalPathTime)
 {
-    APP_LOGI("UpdateInstallerState in bundleInstaller state %{public}d", state);
-    SetInstallerState(state);
+    APP_LOGD("UpdateInstallerState in bundleInstaller state %{public}d", state);
+    SetInstallerState(state, criticalPathTime);
     if (statusReceiver_) {
         statusReceiver_->OnStatusNotify(static_cast<int>(state));
     }
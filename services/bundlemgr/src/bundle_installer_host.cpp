@@ -15,6 +15,8 @@
 
 #include "bundle_installer_host.h"
 
+#include <unistd.h>
+
 #include "ipc_types.h"
 #include "string_ex.h"
 
@@ -91,6 +93,9 @@ int BundleInstallerHost::OnRemoteRequest(
         case IBundleInstaller::Message::UNINSTALL_SANDBOX_APP:
             HandleUninstallSandboxApp(data, reply);
             break;
+        case IBundleInstaller::Message::STREAM_INSTALL:
+            HandleStreamInstallMessage(data);
+            break;
         default:
             return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
     }
@@ -169,6 +174,35 @@ void BundleInstallerHost::HandleInstallMultipleHapsMessage(Parcel &data)
     APP_LOGD("handle install multiple haps finished");
 }
 
+void BundleInstallerHost::HandleStreamInstallMessage(MessageParcel &data)
+{
+    APP_LOGD("handle stream install message");
+    // the fd is duplicated by ipc, the installer closes it when the stream is received
+    int32_t streamFd = data.ReadFileDescriptor();
+    if (streamFd < 0) {
+        APP_LOGE("ReadFileDescriptor failed");
+        return;
+    }
+    std::unique_ptr<InstallParam> installParam(data.ReadParcelable<InstallParam>());
+    if (!installParam) {
+        APP_LOGE("ReadParcelable<InstallParam> failed");
+        close(streamFd);
+        return;
+    }
+    sptr<IRemoteObject> object = data.ReadObject<IRemoteObject>();
+    if (object == nullptr) {
+        APP_LOGE("read failed");
+        close(streamFd);
+        return;
+    }
+    sptr<IStatusReceiver> statusReceiver = iface_cast<IStatusReceiver>(object);
+
+    if (!StreamInstall(streamFd, *installParam, statusReceiver)) {
+        close(streamFd);
+    }
+    APP_LOGD("handle stream install message finished");
+}
+
 void BundleInstallerHost::HandleUninstallMessage(Parcel &data)
 {
     APP_LOGD("handle uninstall message");
@@ -270,6 +304,22 @@ bool BundleInstallerHost::Install(const std::vector<std::string> &bundleFilePath
     return true;
 }
 
+bool BundleInstallerHost::StreamInstall(int32_t streamFd, const InstallParam &installParam,
+    const sptr<IStatusReceiver> &statusReceiver)
+{
+    if (!CheckBundleInstallerManager(statusReceiver)) {
+        APP_LOGE("statusReceiver invalid");
+        return false;
+    }
+    if (!BundlePermissionMgr::VerifyCallingPermission(Constants::PERMISSION_INSTALL_BUNDLE)) {
+        APP_LOGE("install permission denied");
+        statusReceiver->OnFinished(ERR_APPEXECFWK_INSTALL_PERMISSION_DENIED, "");
+        return false;
+    }
+
+    return manager_->CreateStreamInstallTask(streamFd, CheckInstallParam(installParam), statusReceiver);
+}
+
 bool BundleInstallerHost::Recover(
     const std::string &bundleName, const InstallParam &installParam, const sptr<IStatusReceiver> &statusReceiver)
 {
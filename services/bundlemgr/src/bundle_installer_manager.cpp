@@ -105,6 +105,23 @@ void BundleInstallerManager::CreateInstallTask(const std::vector<std::string> &b
     installersPool_.AddTask(task);
 }
 
+bool BundleInstallerManager::CreateStreamInstallTask(int32_t streamFd, const InstallParam &installParam,
+    const sptr<IStatusReceiver> &statusReceiver)
+{
+    auto installer = CreateInstaller(statusReceiver);
+    if (!installer) {
+        APP_LOGE("create installer failed");
+        return false;
+    }
+    auto task = [installer, streamFd, installParam] {
+        int timerId = XCollieHelper::SetTimer(INSTALL_TASK, TIME_OUT_SECONDS, nullptr, nullptr);
+        installer->StreamInstall(streamFd, installParam);
+        XCollieHelper::CancelTimer(timerId);
+    };
+    installersPool_.AddTask(task);
+    return true;
+}
+
 void BundleInstallerManager::CreateInstallByBundleNameTask(const std::string &bundleName,
     const InstallParam &installParam, const sptr<IStatusReceiver> &statusReceiver)
 {
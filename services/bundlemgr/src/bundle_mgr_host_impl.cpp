@@ -27,10 +27,101 @@
 #include "element_name.h"
 #include "installd_client.h"
 #include "ipc_skeleton.h"
+#include "ipc_types.h"
 #include "json_serializer.h"
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+bool IsReplyCacheableCode(uint32_t code)
+{
+    switch (code) {
+        case IBundleMgr::Message::GET_APPLICATION_INFO:
+        case IBundleMgr::Message::GET_APPLICATION_INFO_WITH_INT_FLAGS:
+        case IBundleMgr::Message::GET_BUNDLE_INFO:
+        case IBundleMgr::Message::GET_BUNDLE_INFO_WITH_INT_FLAGS:
+        case IBundleMgr::Message::QUERY_ABILITY_INFO:
+        case IBundleMgr::Message::QUERY_ABILITY_INFO_MUTI_PARAM:
+            return true;
+        default:
+            return false;
+    }
+}
+}  // namespace
+
+int BundleMgrHostImpl::OnRemoteRequest(
+    uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
+{
+    if (!IsReplyCacheableCode(code)) {
+        return BundleMgrHost::OnRemoteRequest(code, data, reply, option);
+    }
+    auto dataMgr = GetDataMgrFromService();
+    if (dataMgr == nullptr || dataMgr->GetReplyCache() == nullptr) {
+        return BundleMgrHost::OnRemoteRequest(code, data, reply, option);
+    }
+    auto replyCache = dataMgr->GetReplyCache();
+    std::string bundleName;
+    std::string key;
+    if (!PeekCacheableQuery(code, data, bundleName, key)) {
+        return BundleMgrHost::OnRemoteRequest(code, data, reply, option);
+    }
+
+    std::vector<uint8_t> cachedReply;
+    // the cached reply does not depend on the caller, but the permission to read it does
+    if (replyCache->Lookup(key, cachedReply) && VerifyQueryPermission(bundleName)) {
+        APP_LOGD("reply of code %{public}u for %{public}s is served from cache", code, bundleName.c_str());
+        return reply.WriteBuffer(cachedReply.data(), cachedReply.size()) ? NO_ERROR : UNKNOWN_ERROR;
+    }
+
+    uint64_t generation = replyCache->GetGeneration();
+    int ret = BundleMgrHost::OnRemoteRequest(code, data, reply, option);
+    // only successful replies made of plain data can be replayed
+    if (ret == NO_ERROR && reply.GetOffsetsSize() == 0 && reply.ReadBool()) {
+        replyCache->Store(key, bundleName, generation,
+            reinterpret_cast<const uint8_t *>(reply.GetData()), reply.GetDataSize());
+    }
+    reply.RewindRead(0);
+    return ret;
+}
+
+bool BundleMgrHostImpl::PeekCacheableQuery(
+    uint32_t code, MessageParcel &data, std::string &bundleName, std::string &key)
+{
+    if (data.GetOffsetsSize() != 0) {
+        return false;
+    }
+    size_t startPosition = data.GetReadPosition();
+    if (data.ReadInterfaceToken() != GetDescriptor()) {
+        data.RewindRead(startPosition);
+        return false;
+    }
+    size_t argsPosition = data.GetReadPosition();
+    if (code == IBundleMgr::Message::QUERY_ABILITY_INFO || code == IBundleMgr::Message::QUERY_ABILITY_INFO_MUTI_PARAM) {
+        std::unique_ptr<Want> want(data.ReadParcelable<Want>());
+        // only explicit queries depend on a single bundle
+        if (want != nullptr && !want->GetElement().GetAbilityName().empty()) {
+            bundleName = want->GetElement().GetBundleName();
+        }
+    } else {
+        bundleName = data.ReadString();
+        // the requested permission states are read from the access token kit, and a runtime grant or revoke does
+        // not invalidate the cache
+        bool isBundleInfoQuery = code == IBundleMgr::Message::GET_BUNDLE_INFO ||
+            code == IBundleMgr::Message::GET_BUNDLE_INFO_WITH_INT_FLAGS;
+        if (isBundleInfoQuery &&
+            (data.ReadInt32() & static_cast<int32_t>(BundleFlag::GET_BUNDLE_WITH_REQUESTED_PERMISSION)) != 0) {
+            bundleName.clear();
+        }
+    }
+    if (!bundleName.empty() && data.GetDataSize() > argsPosition) {
+        const uint8_t *args = reinterpret_cast<const uint8_t *>(data.GetData()) + argsPosition;
+        int32_t callingUserId = BundleUtil::GetUserIdByUid(IPCSkeleton::GetCallingUid());
+        key = BundleMgrReplyCache::MakeKey(code, callingUserId, args, data.GetDataSize() - argsPosition);
+    }
+    data.RewindRead(startPosition);
+    return !key.empty();
+}
+
 bool BundleMgrHostImpl::GetApplicationInfo(
     const std::string &appName, const ApplicationFlag flag, const int userId, ApplicationInfo &appInfo)
 {
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bundle_mgr_reply_cache.h"
+
+#include "app_log_wrapper.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+const size_t MAX_CACHE_ENTRIES = 256;
+const size_t MAX_CACHE_BYTES = 4 * 1024 * 1024;
+const size_t MAX_REPLY_BYTES = 256 * 1024;
+}
+
+std::string BundleMgrReplyCache::MakeKey(uint32_t code, int32_t userId, const uint8_t *args, size_t argsSize)
+{
+    std::string key;
+    key.reserve(sizeof(code) + sizeof(userId) + argsSize);
+    key.append(reinterpret_cast<const char *>(&code), sizeof(code));
+    key.append(reinterpret_cast<const char *>(&userId), sizeof(userId));
+    if (args != nullptr) {
+        key.append(reinterpret_cast<const char *>(args), argsSize);
+    }
+    return key;
+}
+
+bool BundleMgrReplyCache::Lookup(const std::string &key, std::vector<uint8_t> &reply)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto item = entries_.find(key);
+    if (item == entries_.end()) {
+        stats_.misses++;
+        return false;
+    }
+    stats_.hits++;
+    lruList_.splice(lruList_.begin(), lruList_, item->second.lruIter);
+    reply = item->second.reply;
+    return true;
+}
+
+uint64_t BundleMgrReplyCache::GetGeneration() const
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return generation_;
+}
+
+void BundleMgrReplyCache::Store(const std::string &key, const std::string &bundleName, uint64_t generation,
+    const uint8_t *reply, size_t replySize)
+{
+    if (reply == nullptr || replySize == 0 || replySize > MAX_REPLY_BYTES || bundleName.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (generation != generation_) {
+        APP_LOGD("bundle data changed during query, skip caching reply of %{public}s", bundleName.c_str());
+        return;
+    }
+    auto item = entries_.find(key);
+    if (item != entries_.end()) {
+        EraseEntry(item);
+    }
+    lruList_.push_front(key);
+    Entry entry;
+    entry.bundleName = bundleName;
+    entry.reply.assign(reply, reply + replySize);
+    entry.lruIter = lruList_.begin();
+    entries_.emplace(key, std::move(entry));
+    bundleKeys_[bundleName].insert(key);
+    bytes_ += key.size() + replySize;
+    stats_.stores++;
+    Evict();
+}
+
+void BundleMgrReplyCache::InvalidateBundle(const std::string &bundleName)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    generation_++;
+    auto keysItem = bundleKeys_.find(bundleName);
+    if (keysItem == bundleKeys_.end()) {
+        return;
+    }
+    std::set<std::string> keys = std::move(keysItem->second);
+    bundleKeys_.erase(keysItem);
+    for (const auto &key : keys) {
+        auto item = entries_.find(key);
+        if (item != entries_.end()) {
+            EraseEntry(item);
+            stats_.invalidations++;
+        }
+    }
+}
+
+void BundleMgrReplyCache::InvalidateAll()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    generation_++;
+    stats_.invalidations += entries_.size();
+    entries_.clear();
+    lruList_.clear();
+    bundleKeys_.clear();
+    bytes_ = 0;
+}
+
+BundleMgrReplyCache::Stats BundleMgrReplyCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    Stats stats = stats_;
+    stats.entries = entries_.size();
+    stats.bytes = bytes_;
+    return stats;
+}
+
+void BundleMgrReplyCache::EraseEntry(std::unordered_map<std::string, Entry>::iterator iter)
+{
+    bytes_ -= iter->first.size() + iter->second.reply.size();
+    auto keysItem = bundleKeys_.find(iter->second.bundleName);
+    if (keysItem != bundleKeys_.end()) {
+        keysItem->second.erase(iter->first);
+        if (keysItem->second.empty()) {
+            bundleKeys_.erase(keysItem);
+        }
+    }
+    lruList_.erase(iter->second.lruIter);
+    entries_.erase(iter);
+}
+
+void BundleMgrReplyCache::Evict()
+{
+    while (!lruList_.empty() && (entries_.size() > MAX_CACHE_ENTRIES || bytes_ > MAX_CACHE_BYTES)) {
+        auto item = entries_.find(lruList_.back());
+        if (item == entries_.end()) {
+            lruList_.pop_back();
+            continue;
+        }
+        EraseEntry(item);
+        stats_.evictions++;
+    }
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
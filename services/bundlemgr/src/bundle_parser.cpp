@@ -102,7 +102,11 @@ ErrCode BundleParser::Parse(const std::string &pathName, InnerBundleInfo &innerB
         APP_LOGE("bundle extractor init failed");
         return ERR_APPEXECFWK_PARSE_UNEXPECTED;
     }
+    return Parse(bundleExtractor, innerBundleInfo);
+}
 
+ErrCode BundleParser::Parse(const BundleExtractor &bundleExtractor, InnerBundleInfo &innerBundleInfo) const
+{
     // to extract config.json
     std::ostringstream outStream;
     if (!bundleExtractor.ExtractProfile(outStream)) {
@@ -144,7 +148,11 @@ ErrCode BundleParser::ParsePackInfo(const std::string &pathName, BundlePackInfo
         APP_LOGE("bundle extractor init failed");
         return ERR_APPEXECFWK_PARSE_UNEXPECTED;
     }
+    return ParsePackInfo(bundleExtractor, bundlePackInfo);
+}
 
+ErrCode BundleParser::ParsePackInfo(const BundleExtractor &bundleExtractor, BundlePackInfo &bundlePackInfo) const
+{
     // to extract pack.info
     if (!bundleExtractor.HasEntry(Constants::BUNDLE_PACKFILE_NAME)) {
         APP_LOGW("cannot find pack.info in the hap file");
@@ -172,7 +180,11 @@ ErrCode BundleParser::ParseSysCap(const std::string &pathName, std::vector<std::
         APP_LOGE("Bundle extractor init failed");
         return ERR_APPEXECFWK_PARSE_UNEXPECTED;
     }
+    return ParseSysCap(bundleExtractor, sysCaps);
+}
 
+ErrCode BundleParser::ParseSysCap(const BundleExtractor &bundleExtractor, std::vector<std::string> &sysCaps) const
+{
     if (!bundleExtractor.HasEntry(Constants::SYSCAP_NAME)) {
         APP_LOGD("Rpcid.sc is not exist, and do not need verification sysCaps.");
         return ERR_OK;
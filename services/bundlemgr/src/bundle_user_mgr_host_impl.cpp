@@ -20,6 +20,7 @@
 #include "bundle_promise.h"
 #include "bundle_util.h"
 #include "bytrace.h"
+#include "installd_client.h"
 #include "status_receiver_host.h"
 
 namespace OHOS {
@@ -85,12 +86,14 @@ void BundleUserMgrHostImpl::CreateNewUser(int32_t userId)
     g_installedHapNum = 0;
     std::shared_ptr<BundlePromise> bundlePromise = std::make_shared<BundlePromise>();
     int32_t totalHapNum = static_cast<int32_t>(preInstallBundleInfos.size());
+    std::set<std::string> createdBundles = CreateBundleDataDirs(userId, dataMgr, preInstallBundleInfos);
     // Read apps installed by other users that are visible to all users
     for (const auto &info : preInstallBundleInfos) {
         InstallParam installParam;
         installParam.userId = userId;
         installParam.isPreInstallApp = true;
         installParam.installFlag = InstallFlag::NORMAL;
+        installParam.isDataDirCreated = createdBundles.count(info.GetBundleName()) > 0;
         sptr<UserReceiverImpl> userReceiverImpl(new (std::nothrow) UserReceiverImpl());
         userReceiverImpl->SetBundlePromise(bundlePromise);
         userReceiverImpl->SetTotalHapNum(totalHapNum);
@@ -106,6 +109,51 @@ void BundleUserMgrHostImpl::CreateNewUser(int32_t userId)
     APP_LOGD("CreateNewUser end userId: (%{public}d)", userId);
 }
 
+std::set<std::string> BundleUserMgrHostImpl::CreateBundleDataDirs(int32_t userId,
+    const std::shared_ptr<BundleDataMgr> &dataMgr, const std::vector<PreInstallBundleInfo> &preInstallBundleInfos)
+{
+    // the data dirs of the installed bundles are created by installd concurrently in advance,
+    // instead of one installd call per bundle when each bundle is installed for the new user.
+    std::vector<std::string> bundleNames;
+    std::vector<InstalldOperation> operations;
+    for (const auto &preInstallBundleInfo : preInstallBundleInfos) {
+        InnerBundleInfo info;
+        if (!dataMgr->FetchInnerBundleInfo(preInstallBundleInfo.GetBundleName(), info) ||
+            info.HasInnerBundleUserInfo(userId) || info.IsSingleton() != (userId == Constants::DEFAULT_USERID)) {
+            continue;
+        }
+        InnerBundleUserInfo userInfo;
+        userInfo.bundleName = info.GetBundleName();
+        userInfo.bundleUserInfo.userId = userId;
+        if (!dataMgr->GenerateUidAndGid(userInfo)) {
+            continue;
+        }
+        bundleNames.emplace_back(info.GetBundleName());
+        operations.emplace_back(InstalldOperation::CreateBundleDataDir(
+            info.GetBundleName(), userId, userInfo.uid, userInfo.uid, info.GetAppPrivilegeLevel()));
+    }
+
+    std::set<std::string> createdBundles;
+    if (operations.empty()) {
+        return createdBundles;
+    }
+    std::vector<ErrCode> results;
+    ErrCode result = InstalldClient::GetInstance()->CreateBundleDataDirs(operations, results);
+    if (result != ERR_OK) {
+        APP_LOGW("create data dirs of user %{public}d failed, error is %{public}d", userId, result);
+        return createdBundles;
+    }
+    for (size_t i = 0; i < results.size(); i++) {
+        if (results[i] == ERR_OK) {
+            createdBundles.emplace(bundleNames[i]);
+        } else {
+            APP_LOGW("create data dir of %{public}s failed, error is %{public}d", bundleNames[i].c_str(), results[i]);
+        }
+    }
+    APP_LOGD("data dirs of %{public}zu bundles created for user %{public}d", createdBundles.size(), userId);
+    return createdBundles;
+}
+
 void BundleUserMgrHostImpl::RemoveUser(int32_t userId)
 {
     BYTRACE(BYTRACE_TAG_APP);
@@ -19,10 +19,12 @@
 #include <cinttypes>
 #include <dirent.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <thread>
 #include <unistd.h>
+#include <vector>
 
 #include "app_log_wrapper.h"
 #include "bundle_constants.h"
@@ -35,6 +37,8 @@ namespace OHOS {
 namespace AppExecFwk {
 namespace {
 const std::string::size_type EXPECT_SPLIT_SIZE = 2;
+// the max size of data received from a stream at a time
+const size_t STREAM_CHUNK_SIZE = 256 * 1024;
 static std::string g_deviceUdid;
 static std::mutex g_mutex;
 }
@@ -167,6 +171,81 @@ bool BundleUtil::CheckSystemSize(const std::string &bundlePath, const std::strin
     return CheckFileSize(bundlePath, freeSize);
 }
 
+ErrCode BundleUtil::ReceiveStream(int32_t streamFd, const std::string &targetPath, int32_t idleTimeoutMs)
+{
+    BYTRACE_NAME(BYTRACE_TAG_APP, __PRETTY_FUNCTION__);
+    if (streamFd < 0) {
+        APP_LOGE("invalid stream fd");
+        return ERR_APPEXECFWK_INSTALL_INVALID_BUNDLE_FILE;
+    }
+    int32_t targetFd = open(targetPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP);
+    if (targetFd < 0) {
+        APP_LOGE("create stream file failed, errno:%{public}d", errno);
+        return ERR_APPEXECFWK_INSTALL_INTERNAL_ERROR;
+    }
+    ErrCode result = ERR_OK;
+    int64_t totalSize = 0;
+    bool isPipe = true;
+    std::vector<char> buffer;
+    while (true) {
+        // the sender may stall without closing the stream, so wait for the next data for a limited time
+        struct pollfd pollFd = { streamFd, POLLIN, 0 };
+        int32_t ready = TEMP_FAILURE_RETRY(poll(&pollFd, 1, idleTimeoutMs));
+        if (ready == 0) {
+            APP_LOGE("no data from stream in %{public}d ms", idleTimeoutMs);
+            result = ERR_APPEXECFWK_OPERATION_TIME_OUT;
+            break;
+        }
+        if (ready < 0) {
+            APP_LOGE("poll stream failed, errno:%{public}d", errno);
+            result = ERR_APPEXECFWK_INSTALL_INVALID_BUNDLE_FILE;
+            break;
+        }
+        ssize_t size = 0;
+        if (isPipe) {
+            size = TEMP_FAILURE_RETRY(splice(streamFd, nullptr, targetFd, nullptr, STREAM_CHUNK_SIZE,
+                SPLICE_F_MOVE | SPLICE_F_MORE));
+            if (size < 0 && errno == EINVAL && totalSize == 0) {
+                // not a pipe, read it into user space instead
+                isPipe = false;
+                buffer.resize(STREAM_CHUNK_SIZE);
+                continue;
+            }
+        } else {
+            size = TEMP_FAILURE_RETRY(read(streamFd, buffer.data(), buffer.size()));
+            for (ssize_t written = 0; size > 0 && written < size;) {
+                ssize_t ret = TEMP_FAILURE_RETRY(write(targetFd, buffer.data() + written, size - written));
+                if (ret < 0) {
+                    size = ret;
+                    break;
+                }
+                written += ret;
+            }
+        }
+        if (size == 0) {
+            break;
+        }
+        if (size < 0) {
+            APP_LOGE("receive stream failed, errno:%{public}d", errno);
+            result = ERR_APPEXECFWK_INSTALL_INVALID_BUNDLE_FILE;
+            break;
+        }
+        totalSize += size;
+        if (totalSize > Constants::MAX_HAP_SIZE) {
+            APP_LOGE("stream is larger than max hap size Max size is: %{public}" PRId64, Constants::MAX_HAP_SIZE);
+            result = ERR_APPEXECFWK_INSTALL_INVALID_HAP_SIZE;
+            break;
+        }
+    }
+    close(targetFd);
+    if (result != ERR_OK) {
+        unlink(targetPath.c_str());
+        return result;
+    }
+    APP_LOGD("received %{public}" PRId64 " bytes from stream", totalSize);
+    return ERR_OK;
+}
+
 bool BundleUtil::GetHapFilesFromBundlePath(const std::string& currentBundlePath, std::vector<std::string>& hapFileList)
 {
     APP_LOGD("GetHapFilesFromBundlePath with path is %{private}s", currentBundlePath.c_str());
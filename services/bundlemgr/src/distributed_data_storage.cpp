@@ -92,17 +92,22 @@ bool DistributedDataStorage::SaveStorageDistributeInfo(const std::string &bundle
         APP_LOGW("GetBundleInfo:%{public}s  userid:%{public}d failed", bundleName.c_str(), currentUserId);
         return false;
     }
-    ret = InnerSaveStorageDistributeInfo(ConvertToDistributedBundleInfo(bundleInfo));
+    bool isChanged = false;
+    ret = InnerSaveStorageDistributeInfo(ConvertToDistributedBundleInfo(bundleInfo), isChanged);
     if (!ret) {
         APP_LOGW("InnerSaveStorageDistributeInfo:%{public}s  failed", bundleName.c_str());
         return false;
     }
-    CheckToSyncDistributedData();
+    if (isChanged) {
+        CheckToSyncDistributedData();
+    }
     return true;
 }
 
-bool DistributedDataStorage::InnerSaveStorageDistributeInfo(const DistributedBundleInfo distributedBundleInfo)
+bool DistributedDataStorage::InnerSaveStorageDistributeInfo(
+    const DistributedBundleInfo distributedBundleInfo, bool &isChanged)
 {
+    isChanged = false;
     std::string udid;
     bool ret = GetLocalUdid(udid);
     if (!ret) {
@@ -116,6 +121,13 @@ bool DistributedDataStorage::InnerSaveStorageDistributeInfo(const DistributedBun
     Status status;
     {
         std::lock_guard<std::mutex> lock(kvStorePtrMutex_);
+        // an update that does not touch the exported fields, e.g. of a resource only hap, is not written
+        // and so is not synced to the other devices again
+        Value storedValue;
+        if (kvStorePtr_->Get(key, storedValue) == Status::SUCCESS && storedValue.ToString() == value.ToString()) {
+            APP_LOGD("DistributedBundleInfo of %{public}s is unchanged", distributedBundleInfo.bundleName.c_str());
+            return true;
+        }
         status = kvStorePtr_->Put(key, value);
         if (status == Status::IPC_ERROR) {
             status = kvStorePtr_->Put(key, value);
@@ -127,6 +139,7 @@ bool DistributedDataStorage::InnerSaveStorageDistributeInfo(const DistributedBun
         return false;
     }
     APP_LOGI("put value to kvStore success");
+    isChanged = true;
     return true;
 }
 
@@ -209,7 +222,7 @@ bool DistributedDataStorage::QueryStroageDistributeInfo(const std::string &bundl
             return true;
         }
         APP_LOGI("get value status: %{public}d", status);
-        else if (status == Status::IPC_ERROR) {
+        if (status == Status::IPC_ERROR) {
             status = kvStorePtr_->Get(key, value);
             APP_LOGW("distribute database ipc error and try to call again, result = %{public}d", status);
             if (status == Status::SUCCESS) {
@@ -302,7 +315,7 @@ int32_t DistributedDataStorage::GetUdidByNetworkId(const std::string &networkId,
 #endif
 }
 
-DistributedBundleInfo DistributedDataStorage::ConvertToDistributedBundleInfo(const BundleInfo &bundleInfo)
+DistributedBundleInfo DistributedDataStorage::ConvertToDistributedBundleInfo(const BundleInfo &bundleInfo) const
 {
     DistributedBundleInfo distributedBundleInfo;
     distributedBundleInfo.bundleName = bundleInfo.name;
@@ -382,34 +395,96 @@ void DistributedDataStorage::UpdateDistributedData(const std::vector<BundleInfo>
         APP_LOGE("GetLocalUdid failed");
         return;
     }
-    Key allEntryKeyPrefix("");
+    std::string keyPrefix;
+    DeviceAndNameToKey(udid, "", keyPrefix);
+    Key allEntryKeyPrefix(keyPrefix);
     std::vector<Entry> allEntries;
-    Status status = kvStorePtr_->GetEntries(allEntryKeyPrefix, allEntries);
+    Status status;
+    {
+        std::lock_guard<std::mutex> lock(kvStorePtrMutex_);
+        status = kvStorePtr_->GetEntries(allEntryKeyPrefix, allEntries);
+    }
     if (status != Status::SUCCESS) {
         APP_LOGE("dataManager_ GetEntries error: %{public}d", status);
         return;
     }
-    for (auto entry : allEntries) {
-        std::string key = entry.key.ToString();
-        if (key.find(udid) == std::string::npos) {
+    std::vector<Entry> changedEntries;
+    std::vector<Key> removedKeys;
+    CollectChangedData(udid, bundleInfos, allEntries, changedEntries, removedKeys);
+    APP_LOGI("UpdateDistributedData changed:%{public}zu removed:%{public}zu",
+        changedEntries.size(), removedKeys.size());
+    if (changedEntries.empty() && removedKeys.empty()) {
+        return;
+    }
+    if (!BatchUpdate(changedEntries, removedKeys)) {
+        APP_LOGW("UpdateDistributedData write kvStore failed");
+    }
+    CheckToSyncDistributedData();
+}
+
+void DistributedDataStorage::CollectChangedData(const std::string &udid, const std::vector<BundleInfo> &bundleInfos,
+    const std::vector<Entry> &storedEntries, std::vector<Entry> &changedEntries, std::vector<Key> &removedKeys) const
+{
+    // key:udid_bundleName, value:the stored DistributedBundleInfo
+    std::map<std::string, std::string> storedValues;
+    for (const auto &entry : storedEntries) {
+        storedValues.emplace(entry.key.ToString(), entry.value.ToString());
+    }
+
+    // only the records whose content changed are written, the bundles of a user switch or an OTA are
+    // mostly the same as the stored ones
+    for (const auto &bundleInfo : bundleInfos) {
+        if (bundleInfo.singleton) {
             continue;
         }
-        status = kvStorePtr_->Delete(entry.key);
-        if (status != Status::SUCCESS) {
-            APP_LOGE("Delete key:%{public}s failed", key.c_str());
+        std::string keyOfData;
+        DeviceAndNameToKey(udid, bundleInfo.name, keyOfData);
+        std::string value = ConvertToDistributedBundleInfo(bundleInfo).ToString();
+        auto item = storedValues.find(keyOfData);
+        if (item != storedValues.end()) {
+            bool isChanged = item->second != value;
+            storedValues.erase(item);
+            if (!isChanged) {
+                continue;
+            }
         }
+        Entry entry;
+        entry.key = Key(keyOfData);
+        entry.value = Value(value);
+        changedEntries.emplace_back(entry);
+    }
+    // the stored bundles left are not installed for the current user
+    for (const auto &item : storedValues) {
+        removedKeys.emplace_back(Key(item.first));
     }
+}
 
-    for (auto bundleInfo : bundleInfos) {
-        if (bundleInfo.singleton) {
-            continue;
+bool DistributedDataStorage::BatchUpdate(const std::vector<Entry> &entries, const std::vector<Key> &removedKeys)
+{
+    std::lock_guard<std::mutex> lock(kvStorePtrMutex_);
+    if (!removedKeys.empty()) {
+        Status status = kvStorePtr_->DeleteBatch(removedKeys);
+        if (status == Status::IPC_ERROR) {
+            status = kvStorePtr_->DeleteBatch(removedKeys);
+            APP_LOGW("distribute database ipc error and try to call again, result = %{public}d", status);
         }
-        bool ret = InnerSaveStorageDistributeInfo(ConvertToDistributedBundleInfo(bundleInfo));
-        if (!ret) {
-            APP_LOGW("UpdateDistributedData SaveStorageDistributeInfo:%{public}s failed", bundleInfo.name.c_str());
+        if (status != Status::SUCCESS) {
+            APP_LOGE("delete batch from kvStore error: %{public}d", status);
+            return false;
         }
     }
-    CheckToSyncDistributedData();
+    if (!entries.empty()) {
+        Status status = kvStorePtr_->PutBatch(entries);
+        if (status == Status::IPC_ERROR) {
+            status = kvStorePtr_->PutBatch(entries);
+            APP_LOGW("distribute database ipc error and try to call again, result = %{public}d", status);
+        }
+        if (status != Status::SUCCESS) {
+            APP_LOGE("put batch to kvStore error: %{public}d", status);
+            return false;
+        }
+    }
+    return true;
 }
 
 void DistributedDataStorage::RemoveDeviceData(const std::string &networkId)
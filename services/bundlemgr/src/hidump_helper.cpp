@@ -25,12 +25,14 @@ const int32_t MIN_ARGS_SIZE = 1;
 const int32_t MAX_ARGS_SIZE = 2;
 const int32_t FIRST_PARAM = 0;
 const int32_t SECOND_PARAM = 1;
+const uint64_t PERCENT = 100;
 const std::string ARGS_HELP = "-h";
 const std::string ARGS_ABILITY = "-ability";
 const std::string ARGS_ABILITY_LIST = "-ability-list";
 const std::string ARGS_BUNDLE = "-bundle";
 const std::string ARGS_BUNDLE_LIST = "-bundle-list";
 const std::string ARGS_DEVICEID = "-device";
+const std::string ARGS_REPLY_CACHE = "-cache";
 const std::string ILLEGAL_INFOMATION = "The arguments are illegal and you can enter '-h' for help.\n";
 const std::string NO_INFOMATION = "no such infomation\n";
 
@@ -41,6 +43,7 @@ const std::unordered_map<std::string, HidumpFlag> ARGS_MAP = {
     { ARGS_BUNDLE, HidumpFlag::GET_BUNDLE },
     { ARGS_BUNDLE_LIST, HidumpFlag::GET_BUNDLE_LIST },
     { ARGS_DEVICEID, HidumpFlag::GET_DEVICEID },
+    { ARGS_REPLY_CACHE, HidumpFlag::GET_REPLY_CACHE },
 };
 }
 
@@ -171,6 +174,10 @@ ErrCode HidumpHelper::ProcessDump(const HidumpParam& hidumpParam, std::string &r
             errCode = GetAllDeviced(result);
             break;
         }
+        case HidumpFlag::GET_REPLY_CACHE: {
+            errCode = GetReplyCacheStats(result);
+            break;
+        }
         default: {
             errCode = ERR_APPEXECFWK_HIDUMP_INVALID_ARGS;
             break;
@@ -361,6 +368,33 @@ ErrCode HidumpHelper::GetAllDeviced(std::string &result)
     return ERR_OK;
 }
 
+ErrCode HidumpHelper::GetReplyCacheStats(std::string &result)
+{
+    auto shareDataMgr = dataMgr_.lock();
+    if (!shareDataMgr) {
+        return ERR_APPEXECFWK_HIDUMP_SERVICE_ERROR;
+    }
+
+    auto replyCache = shareDataMgr->GetReplyCache();
+    if (replyCache == nullptr) {
+        APP_LOGE("reply cache is nullptr");
+        return ERR_APPEXECFWK_HIDUMP_ERROR;
+    }
+
+    BundleMgrReplyCache::Stats stats = replyCache->GetStats();
+    uint64_t lookups = stats.hits + stats.misses;
+    uint64_t hitRate = (lookups == 0) ? 0 : (stats.hits * PERCENT / lookups);
+    result.append("hits:").append(std::to_string(stats.hits)).append("\n")
+          .append("misses:").append(std::to_string(stats.misses)).append("\n")
+          .append("hitRate:").append(std::to_string(hitRate)).append("%\n")
+          .append("stores:").append(std::to_string(stats.stores)).append("\n")
+          .append("evictions:").append(std::to_string(stats.evictions)).append("\n")
+          .append("invalidations:").append(std::to_string(stats.invalidations)).append("\n")
+          .append("entries:").append(std::to_string(stats.entries)).append("\n")
+          .append("bytes:").append(std::to_string(stats.bytes)).append("\n");
+    return ERR_OK;
+}
+
 void HidumpHelper::ShowHelp(std::string &result)
 {
     result.append("Usage:dump  <command> [options]\n")
@@ -378,7 +412,9 @@ void HidumpHelper::ShowHelp(std::string &result)
           .append("-bundle-list      ")
           .append("dump list of all bundle names in the system\n")
           .append("-device           ")
-          .append("dump the list of devices involved in the ability infomation in the system\n");
+          .append("dump the list of devices involved in the ability infomation in the system\n")
+          .append("-cache            ")
+          .append("dump hit rate and memory usage of the query reply cache\n");
 }
 
 void HidumpHelper::ShowIllealInfomation(std::string &result)
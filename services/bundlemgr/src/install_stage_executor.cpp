@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "install_stage_executor.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <thread>
+
+#include "app_log_wrapper.h"
+#include "datetime_ex.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+const size_t MAX_STAGE_THREAD_NUM = 4;
+}
+
+size_t InstallStageExecutor::AddStage(const std::string &name, const Stage &stage,
+    const std::vector<size_t> &dependencies)
+{
+    size_t index = stages_.size();
+    StageNode node;
+    node.name = name;
+    node.stage = stage;
+    for (size_t dependency : dependencies) {
+        // a stage can only depend on the stages added before it, so the graph has no cycle
+        if (dependency >= index) {
+            APP_LOGE("stage %{public}s depends on an unknown stage %{public}zu", name.c_str(), dependency);
+            continue;
+        }
+        node.dependencies.emplace_back(dependency);
+        stages_[dependency].dependents.emplace_back(index);
+    }
+    stages_.emplace_back(std::move(node));
+    return index;
+}
+
+ErrCode InstallStageExecutor::Run()
+{
+    if (stages_.empty()) {
+        return ERR_OK;
+    }
+    size_t rootCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        readyStages_.clear();
+        runningCount_ = 0;
+        isFailed_ = false;
+        for (size_t i = 0; i < stages_.size(); ++i) {
+            StageNode &node = stages_[i];
+            node.pendingCount = node.dependencies.size();
+            node.finished = false;
+            node.result = ERR_OK;
+            node.startTime = 0;
+            node.endTime = 0;
+            if (node.pendingCount == 0) {
+                readyStages_.emplace_back(i);
+            }
+        }
+        rootCount = readyStages_.size();
+    }
+
+    // the stages mostly wait for installd or other services, so the thread count is not limited by the cpu cores,
+    // and the calling thread executes stages too, so one thread less is started
+    size_t threadNum = std::min(MAX_STAGE_THREAD_NUM, stages_.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadNum; ++i) {
+        threads.emplace_back([this] { ExecuteStages(); });
+    }
+    ExecuteStages();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    CalculateCriticalPath();
+    for (const auto &node : stages_) {
+        if (node.result != ERR_OK) {
+            APP_LOGE("install stage %{public}s failed, error: %{public}d", node.name.c_str(), node.result);
+            return node.result;
+        }
+    }
+    APP_LOGD("%{public}zu install stages from %{public}zu roots finished, critical path %{public}s takes "
+        "%{public}" PRId64 "ms", stages_.size(), rootCount, GetCriticalPath().c_str(), criticalPathTime_);
+    return ERR_OK;
+}
+
+void InstallStageExecutor::ExecuteStages()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        condition_.wait(lock, [this] { return !readyStages_.empty() || runningCount_ == 0; });
+        if (readyStages_.empty()) {
+            // nothing is running and nothing can be started any more
+            break;
+        }
+        size_t index = readyStages_.front();
+        readyStages_.pop_front();
+        ++runningCount_;
+        StageNode &node = stages_[index];
+        lock.unlock();
+
+        node.startTime = GetTickCount();
+        ErrCode result = node.stage ? node.stage() : ERR_OK;
+        node.endTime = GetTickCount();
+
+        lock.lock();
+        --runningCount_;
+        node.result = result;
+        node.finished = true;
+        if (result != ERR_OK) {
+            isFailed_ = true;
+            readyStages_.clear();
+        } else if (!isFailed_) {
+            for (size_t dependent : node.dependents) {
+                if (--stages_[dependent].pendingCount == 0) {
+                    readyStages_.emplace_back(dependent);
+                }
+            }
+        }
+        condition_.notify_all();
+    }
+}
+
+void InstallStageExecutor::CalculateCriticalPath()
+{
+    // the dependencies of a stage are always added before it, so the stages are in topological order
+    std::vector<int64_t> pathTimes(stages_.size(), 0);
+    std::vector<size_t> previous(stages_.size(), stages_.size());
+    size_t last = stages_.size();
+    criticalPathTime_ = 0;
+    for (size_t i = 0; i < stages_.size(); ++i) {
+        const StageNode &node = stages_[i];
+        if (!node.finished) {
+            continue;
+        }
+        int64_t dependencyTime = 0;
+        for (size_t dependency : node.dependencies) {
+            if (pathTimes[dependency] >= dependencyTime) {
+                dependencyTime = pathTimes[dependency];
+                previous[i] = dependency;
+            }
+        }
+        pathTimes[i] = dependencyTime + std::max<int64_t>(node.endTime - node.startTime, 0);
+        // on a tie the later stage wins, so the path ends with the stages depending on the others
+        if (pathTimes[i] >= criticalPathTime_) {
+            criticalPathTime_ = pathTimes[i];
+            last = i;
+        }
+    }
+    criticalPath_.clear();
+    for (size_t i = last; i < stages_.size(); i = previous[i]) {
+        criticalPath_.emplace_back(i);
+    }
+    std::reverse(criticalPath_.begin(), criticalPath_.end());
+}
+
+int64_t InstallStageExecutor::GetCriticalPathTime() const
+{
+    return criticalPathTime_;
+}
+
+std::string InstallStageExecutor::GetCriticalPath() const
+{
+    std::string path;
+    for (size_t index : criticalPath_) {
+        if (!path.empty()) {
+            path.append("->");
+        }
+        path.append(stages_[index].name);
+    }
+    return path;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
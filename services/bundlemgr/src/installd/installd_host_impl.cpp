@@ -15,7 +15,12 @@
 
 #include "installd/installd_host_impl.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
 #include <cstdio>
+#include <cstring>
+#include <dirent.h>
 #include <fstream>
 #include <map>
 #include <memory>
@@ -28,15 +33,23 @@
 #include "app_log_wrapper.h"
 #include "bundle_constants.h"
 #include "common_profile.h"
+#include "concurrent_util.h"
 #include "directory_ex.h"
 #ifdef WITH_SELINUX
 #include "hap_restorecon.h"
 #endif // WITH_SELINUX
 #include "installd/installd_operator.h"
+#include "installd/installd_trash.h"
 #include "parameters.h"
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+const std::string BATCH_BACKUP_SUFFIX = ".batch_bak";
+// the max count of threads creating data dirs in CreateBundleDataDirs, including the calling thread
+const size_t MAX_CREATE_DATA_DIR_THREAD_NUM = 4;
+}
+
 InstalldHostImpl::InstalldHostImpl()
 {
     APP_LOGI("installd service instance is created");
@@ -101,6 +114,12 @@ ErrCode InstalldHostImpl::RenameModuleDir(const std::string &oldPath, const std:
 
 ErrCode InstalldHostImpl::CreateBundleDataDir(const std::string &bundleName,
     const int userid, const int uid, const int gid, const std::string &apl)
+{
+    return CreateBundleDataDir(bundleName, userid, uid, gid, apl, nullptr);
+}
+
+ErrCode InstalldHostImpl::CreateBundleDataDir(const std::string &bundleName,
+    const int userid, const int uid, const int gid, const std::string &apl, AplDirs *aplDirs)
 {
     if (bundleName.empty() || userid < 0 || uid < 0 || gid < 0) {
         APP_LOGE("Calling the function CreateBundleDataDir with invalid param");
@@ -120,7 +139,12 @@ ErrCode InstalldHostImpl::CreateBundleDataDir(const std::string &bundleName,
                 }
             }
         }
-        ErrCode ret = SetDirApl(bundleDataDir, bundleName, apl);
+        ErrCode ret = ERR_OK;
+        if (aplDirs != nullptr) {
+            (*aplDirs)[bundleDataDir] = { bundleName, apl };
+        } else {
+            ret = SetDirApl(bundleDataDir, bundleName, apl);
+        }
         if (ret != ERR_OK) {
             APP_LOGE("CreateBundleDataDir SetDirApl failed");
             return ret;
@@ -131,7 +155,11 @@ ErrCode InstalldHostImpl::CreateBundleDataDir(const std::string &bundleName,
             APP_LOGE("CreateBundle databaseDir MkOwnerDir failed");
             return ERR_APPEXECFWK_INSTALLD_CREATE_DIR_FAILED;
         }
-        ret = SetDirApl(databaseDir, bundleName, apl);
+        if (aplDirs != nullptr) {
+            (*aplDirs)[databaseDir] = { bundleName, apl };
+        } else {
+            ret = SetDirApl(databaseDir, bundleName, apl);
+        }
         if (ret != ERR_OK) {
             APP_LOGE("CreateBundleDataDir SetDirApl failed");
             return ret;
@@ -165,12 +193,12 @@ ErrCode InstalldHostImpl::RemoveBundleDataDir(const std::string &bundleName, con
     }
     for (const auto &el : Constants::BUNDLE_EL) {
         std::string bundleDataDir = GetBundleDataDir(el, userid) + Constants::BASE + bundleName;
-        if (!InstalldOperator::DeleteDir(bundleDataDir)) {
+        if (!InstalldTrash::GetInstance().RemoveDir(bundleDataDir)) {
             APP_LOGE("remove dir %{public}s failed", bundleDataDir.c_str());
             return ERR_APPEXECFWK_INSTALLD_REMOVE_DIR_FAILED;
         }
         std::string databaseDir = GetBundleDataDir(el, userid) + Constants::DATABASE + bundleName;
-        if (!InstalldOperator::DeleteDir(databaseDir)) {
+        if (!InstalldTrash::GetInstance().RemoveDir(databaseDir)) {
             APP_LOGE("remove dir %{public}s failed", databaseDir.c_str());
             return ERR_APPEXECFWK_INSTALLD_REMOVE_DIR_FAILED;
         }
@@ -188,7 +216,7 @@ ErrCode InstalldHostImpl::RemoveModuleDataDir(const std::string &ModuleDir, cons
 
     for (const auto &el : Constants::BUNDLE_EL) {
         std::string moduleDataDir = GetBundleDataDir(el, userid) + Constants::BASE + ModuleDir;
-        if (!InstalldOperator::DeleteDir(moduleDataDir)) {
+        if (!InstalldTrash::GetInstance().RemoveDir(moduleDataDir)) {
             APP_LOGE("remove dir %{public}s failed", moduleDataDir.c_str());
         }
     }
@@ -201,7 +229,7 @@ ErrCode InstalldHostImpl::RemoveDir(const std::string &dir)
         APP_LOGE("Calling the function RemoveDir with invalid param");
         return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
     }
-    if (!InstalldOperator::DeleteDir(dir)) {
+    if (!InstalldTrash::GetInstance().RemoveDir(dir)) {
         APP_LOGE("remove dir %{public}s failed", dir.c_str());
         return ERR_APPEXECFWK_INSTALLD_REMOVE_DIR_FAILED;
     }
@@ -216,7 +244,7 @@ ErrCode InstalldHostImpl::CleanBundleDataDir(const std::string &dataDir)
         return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
     }
 
-    if (!InstalldOperator::DeleteFiles(dataDir)) {
+    if (!InstalldTrash::GetInstance().RemoveDirContents(dataDir)) {
         APP_LOGE("CleanBundleDataDir delete files failed");
         return ERR_APPEXECFWK_INSTALLD_CLEAN_DIR_FAILED;
     }
@@ -245,19 +273,19 @@ ErrCode InstalldHostImpl::GetBundleStats(
     int64_t fileSize = InstalldOperator::GetDiskUsage(path);
     bundleStats.push_back(fileSize);
 
-    // index 1 : local bundle data size
-    std::vector<std::string> bundlePath;
+    // index 1 : local bundle data size, index 3 : database size, index 4 : cache size
+    // the base and database directories of every el are walked in one pass, cache directories are counted on the way
+    int64_t bundleLocalSize = 0;
+    int64_t databaseFileSize = 0;
+    int64_t cacheSize = 0;
     for (auto &el : Constants::BUNDLE_EL) {
-        std::string filePath = Constants::BUNDLE_APP_DATA_BASE_DIR + el + Constants::FILE_SEPARATOR_CHAR +
-            std::to_string(userId) + Constants::BASE + bundleName;
-        bundlePath.push_back(filePath);
-    }
-    std::vector<std::string> cachePath;
-    for (auto &st : bundlePath) {
-        InstalldOperator::TraverseCacheDirectory(st, cachePath);
+        std::string elPath = Constants::BUNDLE_APP_DATA_BASE_DIR + el + Constants::FILE_SEPARATOR_CHAR +
+            std::to_string(userId);
+        int64_t elCacheSize = 0;
+        bundleLocalSize += InstalldOperator::GetDiskUsageWithCache(elPath + Constants::BASE + bundleName, elCacheSize);
+        cacheSize += elCacheSize;
+        databaseFileSize += InstalldOperator::GetDiskUsage(elPath + Constants::DATABASE + bundleName);
     }
-    int64_t bundleLocalSize = InstalldOperator::GetDiskUsageFromPath(bundlePath);
-    int64_t cacheSize = InstalldOperator::GetDiskUsageFromPath(cachePath);
     bundleLocalSize -= cacheSize;
     bundleStats.push_back(bundleLocalSize);
 
@@ -269,13 +297,6 @@ ErrCode InstalldHostImpl::GetBundleStats(
     bundleStats.push_back(distributedFileSize);
 
     // index 3 : database size
-    std::vector<std::string> dataBasePath;
-    for (auto &el : Constants::BUNDLE_EL) {
-        std::string filePath = Constants::BUNDLE_APP_DATA_BASE_DIR + el + Constants::FILE_SEPARATOR_CHAR +
-            std::to_string(userId) + Constants::DATABASE + bundleName;
-        dataBasePath.push_back(filePath);
-    }
-    int64_t databaseFileSize = InstalldOperator::GetDiskUsageFromPath(dataBasePath);
     bundleStats.push_back(databaseFileSize);
 
     // index 4 : cache size
@@ -316,5 +337,250 @@ ErrCode InstalldHostImpl::GetBundleCachePath(const std::string &dir, std::vector
     InstalldOperator::TraverseCacheDirectory(dir, cachePath);
     return ERR_OK;
 }
+
+ErrCode InstalldHostImpl::ExecuteBatch(const std::vector<InstalldOperation> &operations)
+{
+    if (operations.empty() || operations.size() > InstalldOperation::MAX_BATCH_SIZE) {
+        APP_LOGE("Calling the function ExecuteBatch with invalid param");
+        return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
+    }
+    BatchContext context;
+    ErrCode result = ERR_OK;
+    for (const auto &operation : operations) {
+        result = ExecuteOperation(operation, context);
+        if (result != ERR_OK) {
+            APP_LOGE("batch operation %{public}d failed, error is %{public}d",
+                static_cast<int32_t>(operation.type), result);
+            break;
+        }
+    }
+    if (result == ERR_OK) {
+        result = ApplyBatchApl(context.aplDirs);
+    }
+    if (result != ERR_OK) {
+        for (auto iter = context.rollbackLog.rbegin(); iter != context.rollbackLog.rend(); ++iter) {
+            (*iter)();
+        }
+        return result;
+    }
+    for (const auto &commit : context.commitLog) {
+        commit();
+    }
+    APP_LOGD("batch of %{public}zu operations executed", operations.size());
+    return ERR_OK;
+}
+
+ErrCode InstalldHostImpl::ExecuteOperation(const InstalldOperation &operation, BatchContext &context)
+{
+    const auto &strParams = operation.strParams;
+    const auto &intParams = operation.intParams;
+    switch (operation.type) {
+        case InstalldOperation::Type::CREATE_BUNDLE_DIR: {
+            if (strParams.size() != 1 || !intParams.empty() || !MoveAside(strParams[0], context)) {
+                break;
+            }
+            std::string bundleDir = strParams[0];
+            context.rollbackLog.emplace_back([bundleDir] { InstalldOperator::DeleteDir(bundleDir); });
+            return CreateBundleDir(bundleDir);
+        }
+        case InstalldOperation::Type::EXTRACT_MODULE_FILES: {
+            if (strParams.size() != 4 || !intParams.empty() || !MoveAside(strParams[1], context)) {
+                break;
+            }
+            std::string targetPath = strParams[1];
+            context.rollbackLog.emplace_back([targetPath] { InstalldOperator::DeleteDir(targetPath); });
+            return ExtractModuleFiles(strParams[0], targetPath, strParams[2], strParams[3]);
+        }
+        case InstalldOperation::Type::RENAME_MODULE_DIR: {
+            if (strParams.size() != 2 || !intParams.empty()) {
+                break;
+            }
+            std::string oldPath = strParams[0];
+            std::string newPath = strParams[1];
+            if (!InstalldOperator::IsExistDir(oldPath) && InstalldOperator::IsExistDir(newPath)) {
+                // already renamed
+                return ERR_OK;
+            }
+            if (!MoveAside(newPath, context)) {
+                break;
+            }
+            ErrCode result = RenameModuleDir(oldPath, newPath);
+            if (result == ERR_OK) {
+                context.rollbackLog.emplace_back([oldPath, newPath] { rename(newPath.c_str(), oldPath.c_str()); });
+            }
+            return result;
+        }
+        case InstalldOperation::Type::CREATE_BUNDLE_DATA_DIR: {
+            if (strParams.size() != 2 || intParams.size() != 3) {
+                break;
+            }
+            std::string bundleName = strParams[0];
+            int userid = intParams[0];
+            if (!bundleName.empty() && !InstalldOperator::IsExistDir(
+                GetBundleDataDir(Constants::BUNDLE_EL[0], userid) + Constants::BASE + bundleName)) {
+                context.rollbackLog.emplace_back([this, bundleName, userid] {
+                    RemoveBundleDataDir(bundleName, userid);
+                });
+            }
+            return CreateBundleDataDir(bundleName, userid, intParams[1], intParams[2], strParams[1], &context.aplDirs);
+        }
+        case InstalldOperation::Type::REMOVE_DIR: {
+            if (strParams.size() != 1 || !intParams.empty() || strParams[0].empty() ||
+                !MoveAside(strParams[0], context)) {
+                break;
+            }
+            return ERR_OK;
+        }
+        case InstalldOperation::Type::SET_DIR_APL: {
+            if (strParams.size() != 3 || !intParams.empty() || strParams[0].empty() || strParams[1].empty()) {
+                break;
+            }
+            context.aplDirs[strParams[0]] = { strParams[1], strParams[2] };
+            return ERR_OK;
+        }
+        default:
+            break;
+    }
+    return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
+}
+
+bool InstalldHostImpl::MoveAside(const std::string &path, BatchContext &context)
+{
+    // the replaced or removed path is kept until the batch is committed, so that it can be restored
+    if (path.empty()) {
+        return false;
+    }
+    struct stat fileInfo = {};
+    if (lstat(path.c_str(), &fileInfo) != 0) {
+        return errno == ENOENT;
+    }
+    std::string backupPath = path + BATCH_BACKUP_SUFFIX + std::to_string(context.rollbackLog.size());
+    InstalldOperator::DeleteDir(backupPath);
+    if (rename(path.c_str(), backupPath.c_str()) != 0) {
+        APP_LOGE("move %{private}s aside failed, errno:%{public}d", path.c_str(), errno);
+        return false;
+    }
+    context.rollbackLog.emplace_back([path, backupPath] {
+        InstalldOperator::DeleteDir(path);
+        rename(backupPath.c_str(), path.c_str());
+    });
+    context.commitLog.emplace_back([backupPath] { InstalldTrash::GetInstance().RemoveDir(backupPath); });
+    return true;
+}
+
+void InstalldHostImpl::RecoverBatchBackups()
+{
+    // a backup whose path is missing is restored, the batch did not get to its rollback; otherwise it is removed
+    std::vector<std::string> backups;
+    FindBatchBackups(Constants::BUNDLE_CODE_DIR, true, backups);
+    for (const auto &backupPath : backups) {
+        std::string path = backupPath.substr(0, backupPath.rfind(BATCH_BACKUP_SUFFIX));
+        struct stat fileInfo = {};
+        if (lstat(path.c_str(), &fileInfo) != 0 && errno == ENOENT) {
+            APP_LOGI("restore %{private}s moved aside by an interrupted batch", path.c_str());
+            if (rename(backupPath.c_str(), path.c_str()) != 0) {
+                APP_LOGE("restore %{private}s failed, errno:%{public}d", path.c_str(), errno);
+            }
+            continue;
+        }
+        APP_LOGI("remove %{private}s left by an interrupted batch", backupPath.c_str());
+        InstalldTrash::GetInstance().RemoveDir(backupPath);
+    }
+}
+
+void InstalldHostImpl::FindBatchBackups(
+    const std::string &dir, bool isRecursive, std::vector<std::string> &backups) const
+{
+    // the batches move aside the bundle code dirs and the module dirs in them
+    DIR *dirPtr = opendir(dir.c_str());
+    if (dirPtr == nullptr) {
+        return;
+    }
+    std::vector<std::string> subDirs;
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dirPtr)) != nullptr) {
+        if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0)) {
+            continue;
+        }
+        std::string name = entry->d_name;
+        std::string path = dir + Constants::PATH_SEPARATOR + name;
+        size_t pos = name.rfind(BATCH_BACKUP_SUFFIX);
+        if (pos != std::string::npos && pos > 0 && pos + BATCH_BACKUP_SUFFIX.size() < name.size() &&
+            std::all_of(name.begin() + pos + BATCH_BACKUP_SUFFIX.size(), name.end(),
+            [](unsigned char c) { return std::isdigit(c) != 0; })) {
+            backups.emplace_back(path);
+        } else if (isRecursive && entry->d_type == DT_DIR) {
+            subDirs.emplace_back(path);
+        }
+    }
+    closedir(dirPtr);
+    for (const auto &subDir : subDirs) {
+        FindBatchBackups(subDir, false, backups);
+    }
+}
+
+ErrCode InstalldHostImpl::ApplyBatchApl(const AplDirs &aplDirs)
+{
+    // the labels are applied recursively, so a dir is skipped if an ancestor is labelled with the same apl
+    const std::pair<std::string, std::string> *lastApl = nullptr;
+    std::string lastDir;
+    for (const auto &item : aplDirs) {
+        const std::string &dir = item.first;
+        if (lastApl != nullptr && *lastApl == item.second && dir.size() > lastDir.size() &&
+            dir.compare(0, lastDir.size(), lastDir) == 0 && dir[lastDir.size()] == Constants::FILE_SEPARATOR_CHAR) {
+            continue;
+        }
+        ErrCode result = SetDirApl(dir, item.second.first, item.second.second);
+        if (result != ERR_OK) {
+            APP_LOGE("batch SetDirApl failed, error is %{public}d", result);
+            return result;
+        }
+        lastApl = &item.second;
+        lastDir = dir;
+    }
+    return ERR_OK;
+}
+
+ErrCode InstalldHostImpl::CreateBundleDataDirs(
+    const std::vector<InstalldOperation> &operations, std::vector<ErrCode> &results)
+{
+    if (operations.empty() || operations.size() > InstalldOperation::MAX_BATCH_SIZE) {
+        APP_LOGE("Calling the function CreateBundleDataDirs with invalid param");
+        return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
+    }
+    results.assign(operations.size(), ERR_OK);
+    std::mutex aplMutex;
+    size_t threadNum = RunConcurrently(operations.size(), GetCpuBoundThreadNum(MAX_CREATE_DATA_DIR_THREAD_NUM),
+        [this, &operations, &results, &aplMutex](size_t index) {
+            results[index] = CreateBundleDataDirOfBatch(operations[index], aplMutex);
+        });
+    size_t failedCount = static_cast<size_t>(std::count_if(results.begin(), results.end(),
+        [](ErrCode result) { return result != ERR_OK; }));
+    APP_LOGI("data dirs of %{public}zu bundles created by %{public}zu threads, %{public}zu failed",
+        operations.size(), threadNum, failedCount);
+    return ERR_OK;
+}
+
+ErrCode InstalldHostImpl::CreateBundleDataDirOfBatch(const InstalldOperation &operation, std::mutex &aplMutex)
+{
+    const auto &strParams = operation.strParams;
+    const auto &intParams = operation.intParams;
+    if (operation.type != InstalldOperation::Type::CREATE_BUNDLE_DATA_DIR ||
+        strParams.size() != 2 || intParams.size() != 3) {
+        APP_LOGE("invalid operation %{public}d of CreateBundleDataDirs", static_cast<int32_t>(operation.type));
+        return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
+    }
+    AplDirs aplDirs;
+    ErrCode result = CreateBundleDataDir(strParams[0], intParams[0], intParams[1], intParams[2], strParams[1],
+        &aplDirs);
+    if (result != ERR_OK) {
+        APP_LOGE("create data dir of %{public}s failed, error is %{public}d", strParams[0].c_str(), result);
+        return result;
+    }
+    // the dirs are created concurrently, but labelled one bundle at a time since the restorecon
+    // library does not promise to be thread safe
+    std::lock_guard<std::mutex> lock(aplMutex);
+    return ApplyBatchApl(aplDirs);
+}
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -15,8 +15,10 @@
 
 #include "installd/installd_operator.h"
 
+#include <cerrno>
 #include <cstdio>
 #include <dirent.h>
+#include <fcntl.h>
 #include <fstream>
 #include <map>
 #include <sstream>
@@ -31,6 +33,46 @@
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+const int64_t STAT_BLOCK_SIZE = 512;
+
+// Walk the directory tree once by fd, count allocated blocks and the blocks under cache directories.
+void GetDiskUsageAt(int32_t dirFd, bool isCache, int64_t &size, int64_t &cacheSize)
+{
+    DIR *dirPtr = fdopendir(dirFd);
+    if (dirPtr == nullptr) {
+        close(dirFd);
+        return;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dirPtr)) != nullptr) {
+        if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0)) {
+            continue;
+        }
+        struct stat fileInfo = {};
+        if (fstatat(dirFd, entry->d_name, &fileInfo, AT_SYMLINK_NOFOLLOW) != 0) {
+            APP_LOGE("call fstatat error %{private}s", entry->d_name);
+            continue;
+        }
+        int64_t entrySize = static_cast<int64_t>(fileInfo.st_blocks) * STAT_BLOCK_SIZE;
+        size += entrySize;
+        if (isCache) {
+            cacheSize += entrySize;
+        }
+        if (!S_ISDIR(fileInfo.st_mode)) {
+            continue;
+        }
+        int32_t subDirFd = openat(dirFd, entry->d_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (subDirFd < 0) {
+            APP_LOGE("open dir %{private}s failed, errno:%{public}d", entry->d_name, errno);
+            continue;
+        }
+        GetDiskUsageAt(subDirFd, isCache || (Constants::CACHE_DIR == entry->d_name), size, cacheSize);
+    }
+    closedir(dirPtr);
+}
+}  // namespace
+
 bool InstalldOperator::IsExistFile(const std::string &path)
 {
     if (path.empty()) {
@@ -304,46 +346,24 @@ bool InstalldOperator::MkOwnerDir(const std::string &path, int mode, const int u
 
 int64_t InstalldOperator::GetDiskUsage(const std::string &dir)
 {
+    int64_t cacheSize = 0;
+    return GetDiskUsageWithCache(dir, cacheSize);
+}
+
+int64_t InstalldOperator::GetDiskUsageWithCache(const std::string &dir, int64_t &cacheSize)
+{
+    cacheSize = 0;
     if (dir.empty() || (dir.size() > Constants::PATH_MAX_SIZE)) {
         APP_LOGE("GetDiskUsage dir path invaild");
         return 0;
     }
-    std::string filePath = "";
-    if (!PathToRealPath(dir, filePath)) {
-        APP_LOGE("file is not real path, file path: %{private}s", dir.c_str());
-        return 0;
-    }
-    DIR *dirPtr = opendir(filePath.c_str());
-    if (dirPtr == nullptr) {
-        APP_LOGE("GetDiskUsage open file dir:%{private}s is failure", filePath.c_str());
+    int32_t dirFd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+        APP_LOGE("GetDiskUsage open file dir:%{private}s is failure, errno:%{public}d", dir.c_str(), errno);
         return 0;
     }
-    if (filePath.back() != Constants::FILE_SEPARATOR_CHAR) {
-        filePath.push_back(Constants::FILE_SEPARATOR_CHAR);
-    }
-    struct dirent *entry = nullptr;
     int64_t size = 0;
-    while ((entry = readdir(dirPtr)) != nullptr) {
-        if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0)) {
-            continue;
-        }
-        std::string path = filePath + entry->d_name;
-        std::string realPath = "";
-        if (!PathToRealPath(path, realPath)) {
-            APP_LOGE("file is not real path %{private}s", path.c_str());
-            continue;
-        }
-        struct stat fileInfo = {0};
-        if (stat(realPath.c_str(), &fileInfo) != 0) {
-            APP_LOGE("call stat error %{private}s", realPath.c_str());
-            fileInfo.st_size = 0;
-        }
-        size += fileInfo.st_size;
-        if (entry->d_type == DT_DIR) {
-            size += GetDiskUsage(realPath);
-        }
-    }
-    closedir(dirPtr);
+    GetDiskUsageAt(dirFd, false, size, cacheSize);
     return size;
 }
 
@@ -382,14 +402,5 @@ void InstalldOperator::TraverseCacheDirectory(const std::string &currentPath, st
     }
     closedir(dir);
 }
-
-int64_t InstalldOperator::GetDiskUsageFromPath(const std::vector<std::string> &path)
-{
-    int64_t fileSize = 0;
-    for (auto &st : path) {
-        fileSize += GetDiskUsage(st);
-    }
-    return fileSize;
-}
 }  // namespace AppExecFwk
 }  // namespace OHOS
\ No newline at end of file
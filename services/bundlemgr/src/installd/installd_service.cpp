@@ -23,6 +23,8 @@
 
 #include "app_log_wrapper.h"
 #include "bundle_constants.h"
+#include "installd/installd_operator.h"
+#include "installd/installd_trash.h"
 #include "system_ability_definition.h"
 #include "system_ability_helper.h"
 
@@ -65,6 +67,16 @@ bool InstalldService::Init()
     if (!InitDir(Constants::HAP_COPY_PATH)) {
         APP_LOGI("HAP_COPY_PATH is already exists");
     }
+    if (!InitDir(Constants::STREAM_INSTALL_PATH)) {
+        APP_LOGI("STREAM_INSTALL_PATH is already exists");
+        // the haps received from streams are never used again once the last run is over
+        if (!InstalldOperator::DeleteFiles(Constants::STREAM_INSTALL_PATH)) {
+            APP_LOGW("clear STREAM_INSTALL_PATH failed");
+        }
+    }
+    hostImpl_->RecoverBatchBackups();
+    // reap the directories left in trash by the last run
+    InstalldTrash::GetInstance().Start();
     return true;
 }
 
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "installd/installd_trash.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+#include "app_log_wrapper.h"
+#include "bundle_constants.h"
+#include "installd/installd_operator.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+const std::string TRASH_DIR_NAME = ".installd_trash";
+// the reaper unlinks at most MAX_UNLINK_PER_SECOND entries, checked every REAP_BATCH_COUNT unlinks
+const uint32_t MAX_UNLINK_PER_SECOND = 2048;
+const uint32_t REAP_BATCH_COUNT = 64;
+const int32_t REAPER_NICE = 19;
+const int32_t REAPER_IOPRIO_WHO_PROCESS = 1;
+const int32_t REAPER_IOPRIO_CLASS_IDLE = 3;
+const int32_t REAPER_IOPRIO_CLASS_SHIFT = 13;
+
+int64_t GetNowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool IsUserDirName(const std::string &name)
+{
+    if (name.empty()) {
+        return false;
+    }
+    for (const char c : name) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> SplitPath(const std::string &path)
+{
+    std::vector<std::string> components;
+    size_t begin = 0;
+    while (begin < path.size()) {
+        size_t end = path.find(Constants::PATH_SEPARATOR, begin);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+        if (end > begin) {
+            components.emplace_back(path.substr(begin, end - begin));
+        }
+        begin = end + 1;
+    }
+    return components;
+}
+
+std::vector<std::string> ListDir(const std::string &path)
+{
+    std::vector<std::string> names;
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        return names;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0)) {
+            continue;
+        }
+        names.emplace_back(entry->d_name);
+    }
+    closedir(dir);
+    return names;
+}
+
+void SetLowPriority()
+{
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), REAPER_NICE) != 0) {
+        APP_LOGW("set priority of trash reaper failed, errno:%{public}d", errno);
+    }
+    if (syscall(SYS_ioprio_set, REAPER_IOPRIO_WHO_PROCESS, 0,
+        REAPER_IOPRIO_CLASS_IDLE << REAPER_IOPRIO_CLASS_SHIFT) != 0) {
+        APP_LOGW("set io priority of trash reaper failed, errno:%{public}d", errno);
+    }
+}
+}  // namespace
+
+InstalldTrash &InstalldTrash::GetInstance()
+{
+    static InstalldTrash instance;
+    return instance;
+}
+
+InstalldTrash::~InstalldTrash()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (reaper_.joinable()) {
+        reaper_.join();
+    }
+}
+
+void InstalldTrash::Start()
+{
+    for (const auto &el : Constants::BUNDLE_EL) {
+        std::string elDir = Constants::BUNDLE_APP_DATA_BASE_DIR + el;
+        ScanTrashDir(elDir + Constants::PATH_SEPARATOR + TRASH_DIR_NAME);
+        for (const auto &name : ListDir(elDir)) {
+            if (IsUserDirName(name)) {
+                ScanTrashDir(elDir + Constants::PATH_SEPARATOR + name + Constants::PATH_SEPARATOR + TRASH_DIR_NAME);
+            }
+        }
+    }
+}
+
+bool InstalldTrash::RemoveDir(const std::string &path)
+{
+    struct stat fileInfo = {};
+    if ((lstat(path.c_str(), &fileInfo) != 0) && (errno == ENOENT)) {
+        return true;
+    }
+    if (MoveToTrash(path)) {
+        return true;
+    }
+    return InstalldOperator::DeleteDir(path);
+}
+
+bool InstalldTrash::RemoveDirContents(const std::string &dir)
+{
+    DIR *dirPtr = opendir(dir.c_str());
+    if (dirPtr == nullptr) {
+        return false;
+    }
+    closedir(dirPtr);
+    bool ret = true;
+    for (const auto &name : ListDir(dir)) {
+        std::string path = dir + Constants::PATH_SEPARATOR + name;
+        if (MoveToTrash(path)) {
+            continue;
+        }
+        if (!InstalldOperator::DeleteDir(path)) {
+            APP_LOGE("remove %{private}s failed", path.c_str());
+            ret = false;
+        }
+    }
+    return ret;
+}
+
+bool InstalldTrash::MoveToTrash(const std::string &path)
+{
+    std::string trashDir = GetTrashDir(path);
+    if (trashDir.empty()) {
+        return false;
+    }
+    if ((mkdir(trashDir.c_str(), S_IRWXU) != 0) && (errno != EEXIST)) {
+        APP_LOGW("create trash dir %{public}s failed, errno:%{public}d", trashDir.c_str(), errno);
+        return false;
+    }
+    struct stat trashInfo = {};
+    if ((lstat(trashDir.c_str(), &trashInfo) != 0) || !S_ISDIR(trashInfo.st_mode)) {
+        APP_LOGW("trash dir %{public}s is not a directory", trashDir.c_str());
+        return false;
+    }
+    std::string name;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        name = std::to_string(GetNowMs()) + "_" + std::to_string(trashSeq_++);
+    }
+    std::string trashPath = trashDir + Constants::PATH_SEPARATOR + name;
+    if (rename(path.c_str(), trashPath.c_str()) != 0) {
+        APP_LOGW("move %{private}s to trash failed, errno:%{public}d", path.c_str(), errno);
+        return false;
+    }
+    Enqueue(trashDir, name);
+    return true;
+}
+
+std::string InstalldTrash::GetTrashDir(const std::string &path) const
+{
+    // the trash of a path under /data/app/<el>/<userid>/ is in the user dir, otherwise it is in /data/app/<el>/,
+    // so that the rename never crosses a volume or an encryption policy boundary.
+    const std::string &baseDir = Constants::BUNDLE_APP_DATA_BASE_DIR;
+    if (path.compare(0, baseDir.size(), baseDir) != 0) {
+        return "";
+    }
+    std::vector<std::string> components = SplitPath(path.substr(baseDir.size()));
+    for (const auto &component : components) {
+        if (component == "." || component == ".." || component == TRASH_DIR_NAME) {
+            return "";
+        }
+    }
+    if (components.size() < 2 ||
+        std::find(Constants::BUNDLE_EL.begin(), Constants::BUNDLE_EL.end(), components[0]) ==
+        Constants::BUNDLE_EL.end()) {
+        return "";
+    }
+    std::string rootDir = baseDir + components[0];
+    if (components.size() > 2 && IsUserDirName(components[1])) {
+        rootDir += Constants::PATH_SEPARATOR + components[1];
+    }
+    return rootDir + Constants::PATH_SEPARATOR + TRASH_DIR_NAME;
+}
+
+void InstalldTrash::ScanTrashDir(const std::string &trashDir)
+{
+    std::vector<std::string> names = ListDir(trashDir);
+    if (names.empty()) {
+        return;
+    }
+    APP_LOGI("resume reaping %{public}zu entries in %{public}s", names.size(), trashDir.c_str());
+    for (const auto &name : names) {
+        Enqueue(trashDir, name);
+    }
+}
+
+void InstalldTrash::Enqueue(const std::string &trashDir, const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_) {
+        return;
+    }
+    if (!reaper_.joinable()) {
+        reaper_ = std::thread(&InstalldTrash::ReapLoop, this);
+    }
+    pending_.emplace_back(trashDir, name);
+    cv_.notify_one();
+}
+
+void InstalldTrash::ReapLoop()
+{
+    SetLowPriority();
+    windowStart_ = GetNowMs();
+    while (true) {
+        std::pair<std::string, std::string> victim;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+            if (stop_) {
+                return;
+            }
+            victim = std::move(pending_.front());
+            pending_.pop_front();
+        }
+        int32_t trashFd = open(victim.first.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (trashFd < 0) {
+            APP_LOGE("open trash dir %{public}s failed, errno:%{public}d", victim.first.c_str(), errno);
+            continue;
+        }
+        if (!RemoveTree(trashFd, victim.second)) {
+            APP_LOGW("reap %{public}s in %{public}s not finished", victim.second.c_str(), victim.first.c_str());
+        }
+        close(trashFd);
+    }
+}
+
+bool InstalldTrash::RemoveTree(int32_t parentFd, const std::string &name)
+{
+    struct stat fileInfo = {};
+    if (fstatat(parentFd, name.c_str(), &fileInfo, AT_SYMLINK_NOFOLLOW) != 0) {
+        return errno == ENOENT;
+    }
+    int32_t flags = 0;
+    if (S_ISDIR(fileInfo.st_mode)) {
+        int32_t dirFd = openat(parentFd, name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (dirFd < 0) {
+            return false;
+        }
+        DIR *dirPtr = fdopendir(dirFd);
+        if (dirPtr == nullptr) {
+            close(dirFd);
+            return false;
+        }
+        std::vector<std::string> children;
+        struct dirent *entry = nullptr;
+        while ((entry = readdir(dirPtr)) != nullptr) {
+            if ((strcmp(entry->d_name, ".") != 0) && (strcmp(entry->d_name, "..") != 0)) {
+                children.emplace_back(entry->d_name);
+            }
+        }
+        bool ret = true;
+        for (const auto &child : children) {
+            if (!RemoveTree(dirFd, child)) {
+                ret = false;
+                break;
+            }
+        }
+        closedir(dirPtr);
+        if (!ret) {
+            return false;
+        }
+        flags = AT_REMOVEDIR;
+    }
+    if (unlinkat(parentFd, name.c_str(), flags) != 0 && errno != ENOENT) {
+        APP_LOGE("unlink %{public}s failed, errno:%{public}d", name.c_str(), errno);
+        return false;
+    }
+    return Throttle();
+}
+
+bool InstalldTrash::Throttle()
+{
+    if (++unlinkCount_ < REAP_BATCH_COUNT) {
+        return true;
+    }
+    unlinkCount_ = 0;
+    int64_t budget = static_cast<int64_t>(REAP_BATCH_COUNT) * std::milli::den / MAX_UNLINK_PER_SECOND;
+    int64_t elapsed = GetNowMs() - windowStart_;
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (elapsed < budget) {
+        cv_.wait_for(lock, std::chrono::milliseconds(budget - elapsed), [this] { return stop_; });
+    }
+    windowStart_ = GetNowMs();
+    return !stop_;
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
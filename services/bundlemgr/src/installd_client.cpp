@@ -15,6 +15,8 @@
 
 #include "installd_client.h"
 
+#include <algorithm>
+
 #include "app_log_wrapper.h"
 #include "bundle_constants.h"
 #include "installd_death_recipient.h"
@@ -136,6 +138,38 @@ ErrCode InstalldClient::GetBundleCachePath(const std::string &dir, std::vector<s
     return CallService(&IInstalld::GetBundleCachePath, dir, cachePath);
 }
 
+ErrCode InstalldClient::ExecuteBatch(const std::vector<InstalldOperation> &operations)
+{
+    if (operations.empty() || operations.size() > InstalldOperation::MAX_BATCH_SIZE) {
+        APP_LOGE("params are invalid");
+        return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
+    }
+    return CallService(&IInstalld::ExecuteBatch, operations);
+}
+
+ErrCode InstalldClient::CreateBundleDataDirs(
+    const std::vector<InstalldOperation> &operations, std::vector<ErrCode> &results)
+{
+    results.clear();
+    if (operations.empty()) {
+        APP_LOGE("params are invalid");
+        return ERR_APPEXECFWK_INSTALLD_PARAM_ERROR;
+    }
+    for (size_t begin = 0; begin < operations.size(); begin += InstalldOperation::MAX_BATCH_SIZE) {
+        size_t end = std::min(begin + InstalldOperation::MAX_BATCH_SIZE, operations.size());
+        std::vector<InstalldOperation> chunk(operations.begin() + begin, operations.begin() + end);
+        std::vector<ErrCode> chunkResults;
+        ErrCode result = CallService(&IInstalld::CreateBundleDataDirs, chunk, chunkResults);
+        if (result != ERR_OK || chunkResults.size() != chunk.size()) {
+            APP_LOGE("fail to create bundle data dirs, error is %{public}d", result);
+            results.clear();
+            return result != ERR_OK ? result : ERR_APPEXECFWK_PARCEL_ERROR;
+        }
+        results.insert(results.end(), chunkResults.begin(), chunkResults.end());
+    }
+    return ERR_OK;
+}
+
 void InstalldClient::ResetInstalldProxy()
 {
     if ((installdProxy_ != nullptr) && (installdProxy_->AsObject() != nullptr)) {
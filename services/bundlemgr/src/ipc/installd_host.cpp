@@ -23,6 +23,28 @@
 
 namespace OHOS {
 namespace AppExecFwk {
+namespace {
+const int32_t MAX_OPERATION_PARAM_SIZE = 8;
+
+bool ReadOperation(MessageParcel &data, InstalldOperation &operation)
+{
+    operation.type = static_cast<InstalldOperation::Type>(data.ReadInt32());
+    int32_t strSize = data.ReadInt32();
+    if (strSize < 0 || strSize > MAX_OPERATION_PARAM_SIZE) {
+        APP_LOGE("invalid param size %{public}d of operation", strSize);
+        return false;
+    }
+    for (int32_t i = 0; i < strSize; i++) {
+        operation.strParams.emplace_back(Str16ToStr8(data.ReadString16()));
+    }
+    if (!data.ReadInt32Vector(&operation.intParams)) {
+        APP_LOGE("fail to read operation from data");
+        return false;
+    }
+    return true;
+}
+}
+
 InstalldHost::InstalldHost()
 {
     init();
@@ -47,6 +69,8 @@ void InstalldHost::init()
     funcMap_.emplace(IInstalld::Message::REMOVE_DIR, &InstalldHost::HandleRemoveDir);
     funcMap_.emplace(IInstalld::Message::GET_BUNDLE_STATS, &InstalldHost::HandleGetBundleStats);
     funcMap_.emplace(IInstalld::Message::GET_BUNDLE_CACHE_PATH, &InstalldHost::HandleGetBundleCachePath);
+    funcMap_.emplace(IInstalld::Message::EXECUTE_BATCH, &InstalldHost::HandleExecuteBatch);
+    funcMap_.emplace(IInstalld::Message::CREATE_BUNDLE_DATA_DIRS, &InstalldHost::HandleCreateBundleDataDirs);
 }
 
 int InstalldHost::OnRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
@@ -184,5 +208,48 @@ bool InstalldHost::HandleGetBundleCachePath(MessageParcel &data, MessageParcel &
     }
     return true;
 }
+
+bool InstalldHost::HandleExecuteBatch(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t size = data.ReadInt32();
+    if (size <= 0 || static_cast<size_t>(size) > InstalldOperation::MAX_BATCH_SIZE) {
+        APP_LOGE("invalid batch size %{public}d", size);
+        WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(Int32, reply, ERR_APPEXECFWK_INSTALLD_PARAM_ERROR);
+        return true;
+    }
+    std::vector<InstalldOperation> operations(size);
+    for (auto &operation : operations) {
+        if (!ReadOperation(data, operation)) {
+            return false;
+        }
+    }
+    ErrCode result = ExecuteBatch(operations);
+    WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(Int32, reply, result);
+    return true;
+}
+
+bool InstalldHost::HandleCreateBundleDataDirs(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t size = data.ReadInt32();
+    if (size <= 0 || static_cast<size_t>(size) > InstalldOperation::MAX_BATCH_SIZE) {
+        APP_LOGE("invalid size %{public}d of CreateBundleDataDirs", size);
+        WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(Int32, reply, ERR_APPEXECFWK_INSTALLD_PARAM_ERROR);
+        return true;
+    }
+    std::vector<InstalldOperation> operations(size);
+    for (auto &operation : operations) {
+        if (!ReadOperation(data, operation)) {
+            return false;
+        }
+    }
+    std::vector<ErrCode> results;
+    ErrCode result = CreateBundleDataDirs(operations, results);
+    WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(Int32, reply, result);
+    if (result == ERR_OK) {
+        std::vector<int32_t> replyResults(results.begin(), results.end());
+        WRITE_PARCEL_AND_RETURN_FALSE_IF_FAIL(Int32Vector, reply, replyResults);
+    }
+    return true;
+}
 }  // namespace AppExecFwk
 }  // namespace OHOS
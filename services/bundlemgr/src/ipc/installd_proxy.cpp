@@ -189,6 +189,59 @@ ErrCode InstalldProxy::GetBundleCachePath(const std::string &dir, std::vector<st
     return ret;
 }
 
+ErrCode InstalldProxy::ExecuteBatch(const std::vector<InstalldOperation> &operations)
+{
+    MessageParcel data;
+    INSTALLD_PARCEL_WRITE_INTERFACE_TOKEN(data, (GetDescriptor()));
+    ErrCode ret = WriteOperations(data, operations);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_SYNC);
+    return TransactInstalldCmd(IInstalld::Message::EXECUTE_BATCH, data, reply, option);
+}
+
+ErrCode InstalldProxy::CreateBundleDataDirs(
+    const std::vector<InstalldOperation> &operations, std::vector<ErrCode> &results)
+{
+    MessageParcel data;
+    INSTALLD_PARCEL_WRITE_INTERFACE_TOKEN(data, (GetDescriptor()));
+    ErrCode ret = WriteOperations(data, operations);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_SYNC);
+    ret = TransactInstalldCmd(IInstalld::Message::CREATE_BUNDLE_DATA_DIRS, data, reply, option);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+    std::vector<int32_t> replyResults;
+    if (!reply.ReadInt32Vector(&replyResults) || replyResults.size() != operations.size()) {
+        APP_LOGE("fail to read results of CreateBundleDataDirs from reply");
+        return ERR_APPEXECFWK_PARCEL_ERROR;
+    }
+    results.assign(replyResults.begin(), replyResults.end());
+    return ERR_OK;
+}
+
+ErrCode InstalldProxy::WriteOperations(MessageParcel &data, const std::vector<InstalldOperation> &operations)
+{
+    INSTALLD_PARCEL_WRITE(data, Int32, static_cast<int32_t>(operations.size()));
+    for (const auto &operation : operations) {
+        INSTALLD_PARCEL_WRITE(data, Int32, static_cast<int32_t>(operation.type));
+        INSTALLD_PARCEL_WRITE(data, Int32, static_cast<int32_t>(operation.strParams.size()));
+        for (const auto &param : operation.strParams) {
+            INSTALLD_PARCEL_WRITE(data, String16, Str8ToStr16(param));
+        }
+        INSTALLD_PARCEL_WRITE(data, Int32Vector, operation.intParams);
+    }
+    return ERR_OK;
+}
+
 ErrCode InstalldProxy::TransactInstalldCmd(uint32_t code, MessageParcel &data, MessageParcel &reply,
     MessageOption &option)
 {
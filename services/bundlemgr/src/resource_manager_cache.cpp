@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef GLOBAL_RESMGR_ENABLE
+#include "resource_manager_cache.h"
+
+#include "app_log_wrapper.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace {
+// a ResourceManager holds the parsed resource index of all the modules of an app, keep a few of them only
+const size_t MAX_CACHE_ENTRIES = 16;
+const char KEY_SEPARATOR = '\0';
+
+std::string MakeKey(const BundleInfo &bundleInfo, const std::string &locale)
+{
+    std::string key = bundleInfo.name;
+    for (const auto &moduleResPath : bundleInfo.moduleResPaths) {
+        key.push_back(KEY_SEPARATOR);
+        key.append(moduleResPath);
+    }
+    key.push_back(KEY_SEPARATOR);
+    key.append(locale);
+    return key;
+}
+}
+
+std::shared_ptr<Global::Resource::ResourceManager> ResourceManagerCache::GetResourceManager(
+    const BundleInfo &bundleInfo, const std::string &locale, const Creator &creator)
+{
+    std::string key = MakeKey(bundleInfo, locale);
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto item = entries_.find(key);
+        if (item != entries_.end()) {
+            lruList_.splice(lruList_.begin(), lruList_, item->second.lruIter);
+            return item->second.resourceManager;
+        }
+        generation = generation_;
+    }
+
+    // creating a ResourceManager parses the resource index of every module, so other lookups are not blocked by it
+    std::shared_ptr<Global::Resource::ResourceManager> resourceManager = creator();
+    if (resourceManager == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto item = entries_.find(key);
+    if (item != entries_.end()) {
+        // another thread has cached it meanwhile
+        lruList_.splice(lruList_.begin(), lruList_, item->second.lruIter);
+        return item->second.resourceManager;
+    }
+    if (generation != generation_) {
+        // the bundle may be updated while the ResourceManager was created, do not cache the old resources
+        return resourceManager;
+    }
+    APP_LOGD("cache ResourceManager of %{public}s", bundleInfo.name.c_str());
+    lruList_.push_front(key);
+    Entry entry;
+    entry.bundleName = bundleInfo.name;
+    entry.resourceManager = resourceManager;
+    entry.lruIter = lruList_.begin();
+    entries_.emplace(key, std::move(entry));
+    while (entries_.size() > MAX_CACHE_ENTRIES) {
+        entries_.erase(lruList_.back());
+        lruList_.pop_back();
+    }
+    return resourceManager;
+}
+
+void ResourceManagerCache::InvalidateBundle(const std::string &bundleName)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    generation_++;
+    for (auto item = entries_.begin(); item != entries_.end();) {
+        if (item->second.bundleName == bundleName) {
+            lruList_.erase(item->second.lruIter);
+            item = entries_.erase(item);
+        } else {
+            ++item;
+        }
+    }
+}
+
+void ResourceManagerCache::InvalidateAll()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    generation_++;
+    entries_.clear();
+    lruList_.clear();
+}
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // GLOBAL_RESMGR_ENABLE
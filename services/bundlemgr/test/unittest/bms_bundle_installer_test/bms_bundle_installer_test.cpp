@@ -15,25 +15,35 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <dirent.h>
 #include <fcntl.h>
 #include <fstream>
+#include <future>
+#include <sstream>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <thread>
 #include <unistd.h>
 
 #include "bundle_info.h"
 #include "bundle_data_storage_database.h"
 #include "bundle_installer_host.h"
+#include "bundle_installer_proxy.h"
 #include "bundle_mgr_service.h"
+#include "bundle_util.h"
 #include "directory_ex.h"
 #include "install_param.h"
+#include "install_stage_executor.h"
 #include "installd/installd_service.h"
 #include "installd_client.h"
 #include "mock_status_receiver.h"
 #include "ohos/aafwk/content/want.h"
+#include "status_receiver_host.h"
 #include "system_bundle_installer.h"
 
 using namespace testing::ext;
@@ -66,8 +76,39 @@ const std::string BUNDLE_BACKUP_NAME = "com.example.backuptest";
 const std::string MODULE_NAME = "entry";
 const std::string EXTENSION_ABILITY_NAME = "extensionAbility_A";
 const size_t NUMBER_ONE = 1;
+const std::string STREAM_RECEIVED_FILE = "/data/test/resource/bms/install_bundle/stream_received.hap";
+const std::string STREAM_TRUNCATED_FILE = "/data/test/resource/bms/install_bundle/stream_truncated.hap";
+const int32_t STREAM_IDLE_TIMEOUT_MS = 100;
+const size_t STALLED_STREAM_SIZE = 1024;
+// the pipe is written by pieces smaller than the pipe buffer, so the receiver splices while it is written
+const size_t STREAM_WRITE_SIZE = 4096;
 }  // namespace
 
+// receives the install result over ipc, unlike MockStatusReceiver it can be written into a parcel by a proxy
+class StreamStatusReceiver : public StatusReceiverHost {
+public:
+    StreamStatusReceiver() = default;
+    virtual ~StreamStatusReceiver() override = default;
+
+    virtual void OnStatusNotify(const int32_t progress) override
+    {}
+
+    virtual void OnFinished(const int32_t resultCode, [[maybe_unused]] const std::string &resultMsg) override
+    {
+        signal_.set_value(resultCode);
+    }
+
+    int32_t GetResultCode()
+    {
+        auto future = signal_.get_future();
+        future.wait();
+        return future.get();
+    }
+
+private:
+    std::promise<int32_t> signal_;
+};
+
 class BmsBundleInstallerTest : public testing::Test {
 public:
     BmsBundleInstallerTest();
@@ -88,6 +129,10 @@ public:
     void StopBundleService();
     void CreateInstallerManager();
     void ClearBundleInfo();
+    std::string ReadFileContent(const std::string &filePath) const;
+    std::thread WriteStream(int32_t streamFd, const std::string &content) const;
+    ErrCode StreamInstallThirdPartyBundle(const sptr<IBundleInstaller> &installer, int32_t streamFd) const;
+    bool IsStreamInstallPathEmpty() const;
 
 private:
     std::shared_ptr<BundleInstallerManager> manager_ = nullptr;
@@ -286,6 +331,66 @@ void BmsBundleInstallerTest::ClearBundleInfo()
     EXPECT_TRUE(result) << "the bundle info in db clear fail: " << BUNDLE_NAME;
 }
 
+std::string BmsBundleInstallerTest::ReadFileContent(const std::string &filePath) const
+{
+    std::ifstream file(filePath, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+std::thread BmsBundleInstallerTest::WriteStream(int32_t streamFd, const std::string &content) const
+{
+    return std::thread([streamFd, content] {
+        for (size_t offset = 0; offset < content.size();) {
+            size_t length = std::min(STREAM_WRITE_SIZE, content.size() - offset);
+            ssize_t size = write(streamFd, content.data() + offset, length);
+            if (size <= 0) {
+                break;
+            }
+            offset += static_cast<size_t>(size);
+        }
+        close(streamFd);
+    });
+}
+
+ErrCode BmsBundleInstallerTest::StreamInstallThirdPartyBundle(
+    const sptr<IBundleInstaller> &installer, int32_t streamFd) const
+{
+    sptr<StreamStatusReceiver> receiver = new (std::nothrow) StreamStatusReceiver();
+    if (!receiver) {
+        EXPECT_FALSE(true) << "the receiver is nullptr";
+        return ERR_APPEXECFWK_INSTALL_INTERNAL_ERROR;
+    }
+    InstallParam installParam;
+    installParam.userId = USERID;
+    installParam.installFlag = InstallFlag::NORMAL;
+    bool result = installer->StreamInstall(streamFd, installParam, receiver);
+    EXPECT_TRUE(result);
+    if (!result) {
+        return ERR_APPEXECFWK_INSTALL_INTERNAL_ERROR;
+    }
+    return receiver->GetResultCode();
+}
+
+bool BmsBundleInstallerTest::IsStreamInstallPathEmpty() const
+{
+    DIR *dir = opendir(Constants::STREAM_INSTALL_PATH.c_str());
+    if (dir == nullptr) {
+        return true;
+    }
+    bool isEmpty = true;
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+            isEmpty = false;
+            break;
+        }
+    }
+    closedir(dir);
+    return isEmpty;
+}
+
 /**
  * @tc.number: SystemInstall_0100
  * @tc.name: test the right system bundle file can be installed
@@ -765,4 +870,230 @@ HWTEST_F(BmsBundleInstallerTest, QueryExtensionAbilityInfos_0400, Function | Sma
     }
     UnInstallBundle(BUNDLE_BACKUP_NAME);
 }
+
+/**
+ * @tc.number: InstallStageExecutor_0100
+ * @tc.name: test the dependent stages
+ * @tc.desc: 1.add two independent stages and a stage depending on them
+ *           2.the dependent stage runs after the others and ends the critical path
+ */
+HWTEST_F(BmsBundleInstallerTest, InstallStageExecutor_0100, Function | SmallTest | Level0)
+{
+    std::atomic<int32_t> finishedCount {0};
+    int32_t finishedCountBeforeLast = 0;
+    InstallStageExecutor executor;
+    size_t first = executor.AddStage("first", [&finishedCount] {
+        std::this_thread::sleep_for(10ms);
+        finishedCount++;
+        return ERR_OK;
+    });
+    size_t second = executor.AddStage("second", [&finishedCount] {
+        finishedCount++;
+        return ERR_OK;
+    });
+    executor.AddStage("last", [&finishedCount, &finishedCountBeforeLast] {
+        finishedCountBeforeLast = finishedCount;
+        return ERR_OK;
+    }, { first, second });
+    EXPECT_EQ(executor.Run(), ERR_OK);
+    EXPECT_EQ(finishedCountBeforeLast, 2);
+    EXPECT_EQ(executor.GetCriticalPath(), "first->last");
+    EXPECT_GE(executor.GetCriticalPathTime(), 10);
+}
+
+/**
+ * @tc.number: InstallStageExecutor_0200
+ * @tc.name: test the failed stage
+ * @tc.desc: 1.add a failed stage and a stage depending on it
+ *           2.the error is returned and the dependent stage does not run
+ */
+HWTEST_F(BmsBundleInstallerTest, InstallStageExecutor_0200, Function | SmallTest | Level0)
+{
+    bool isDependentRun = false;
+    InstallStageExecutor executor;
+    size_t failed = executor.AddStage("failed", [] { return ERR_APPEXECFWK_INSTALL_INTERNAL_ERROR; });
+    executor.AddStage("other", [] { return ERR_OK; });
+    executor.AddStage("dependent", [&isDependentRun] {
+        isDependentRun = true;
+        return ERR_OK;
+    }, { failed });
+    EXPECT_EQ(executor.Run(), ERR_APPEXECFWK_INSTALL_INTERNAL_ERROR);
+    EXPECT_FALSE(isDependentRun);
+}
+
+/**
+ * @tc.number: ReceiveStream_0100
+ * @tc.name: test receiving a hap from a pipe
+ * @tc.desc: 1.write the hap into a pipe while it is received
+ *           2.the received file is the same as the hap
+ */
+HWTEST_F(BmsBundleInstallerTest, ReceiveStream_0100, Function | SmallTest | Level0)
+{
+    std::string content = ReadFileContent(RESOURCE_ROOT_PATH + RIGHT_BUNDLE);
+    ASSERT_FALSE(content.empty());
+    int32_t pipeFds[2] = { -1, -1 };
+    ASSERT_EQ(pipe(pipeFds), 0);
+    std::thread writer = WriteStream(pipeFds[1], content);
+    ErrCode result = BundleUtil::ReceiveStream(pipeFds[0], STREAM_RECEIVED_FILE);
+    writer.join();
+    close(pipeFds[0]);
+    EXPECT_EQ(result, ERR_OK);
+    EXPECT_EQ(ReadFileContent(STREAM_RECEIVED_FILE), content);
+    unlink(STREAM_RECEIVED_FILE.c_str());
+}
+
+/**
+ * @tc.number: ReceiveStream_0200
+ * @tc.name: test receiving a hap from a regular file
+ * @tc.desc: 1.splice fails on two regular files, the hap is read and written instead
+ *           2.the received file is the same as the hap
+ */
+HWTEST_F(BmsBundleInstallerTest, ReceiveStream_0200, Function | SmallTest | Level0)
+{
+    std::string bundleFile = RESOURCE_ROOT_PATH + RIGHT_BUNDLE;
+    int32_t streamFd = open(bundleFile.c_str(), O_RDONLY);
+    ASSERT_GE(streamFd, 0);
+    ErrCode result = BundleUtil::ReceiveStream(streamFd, STREAM_RECEIVED_FILE);
+    close(streamFd);
+    EXPECT_EQ(result, ERR_OK);
+    EXPECT_EQ(ReadFileContent(STREAM_RECEIVED_FILE), ReadFileContent(bundleFile));
+    unlink(STREAM_RECEIVED_FILE.c_str());
+}
+
+/**
+ * @tc.number: ReceiveStream_0300
+ * @tc.name: test receiving a truncated stream
+ * @tc.desc: 1.the pipe is closed in the middle of the hap, and a regular file holds the first half of the hap
+ *           2.both are received up to where they end, the hap is rejected later by the install
+ */
+HWTEST_F(BmsBundleInstallerTest, ReceiveStream_0300, Function | SmallTest | Level0)
+{
+    std::string content = ReadFileContent(RESOURCE_ROOT_PATH + RIGHT_BUNDLE);
+    ASSERT_FALSE(content.empty());
+    std::string truncatedContent = content.substr(0, content.size() / 2);
+    int32_t pipeFds[2] = { -1, -1 };
+    ASSERT_EQ(pipe(pipeFds), 0);
+    std::thread writer = WriteStream(pipeFds[1], truncatedContent);
+    ErrCode result = BundleUtil::ReceiveStream(pipeFds[0], STREAM_RECEIVED_FILE);
+    writer.join();
+    close(pipeFds[0]);
+    EXPECT_EQ(result, ERR_OK);
+    EXPECT_EQ(ReadFileContent(STREAM_RECEIVED_FILE), truncatedContent);
+    unlink(STREAM_RECEIVED_FILE.c_str());
+
+    std::ofstream truncatedFile(STREAM_TRUNCATED_FILE, std::ios::binary);
+    truncatedFile << truncatedContent;
+    truncatedFile.close();
+    int32_t streamFd = open(STREAM_TRUNCATED_FILE.c_str(), O_RDONLY);
+    ASSERT_GE(streamFd, 0);
+    result = BundleUtil::ReceiveStream(streamFd, STREAM_RECEIVED_FILE);
+    close(streamFd);
+    EXPECT_EQ(result, ERR_OK);
+    EXPECT_EQ(ReadFileContent(STREAM_RECEIVED_FILE), truncatedContent);
+    unlink(STREAM_RECEIVED_FILE.c_str());
+    unlink(STREAM_TRUNCATED_FILE.c_str());
+}
+
+/**
+ * @tc.number: ReceiveStream_0400
+ * @tc.name: test receiving from an invalid fd
+ * @tc.desc: 1.the stream fd is invalid
+ *           2.the error is returned and the target file is removed
+ */
+HWTEST_F(BmsBundleInstallerTest, ReceiveStream_0400, Function | SmallTest | Level0)
+{
+    ErrCode result = BundleUtil::ReceiveStream(-1, STREAM_RECEIVED_FILE);
+    EXPECT_EQ(result, ERR_APPEXECFWK_INSTALL_INVALID_BUNDLE_FILE);
+    EXPECT_NE(access(STREAM_RECEIVED_FILE.c_str(), F_OK), 0);
+}
+
+/**
+ * @tc.number: ReceiveStream_0500
+ * @tc.name: test receiving from a stalled stream
+ * @tc.desc: 1.the sender writes a part of the hap and keeps the pipe open without writing more
+ *           2.the receiving times out, the error is returned and the target file is removed
+ */
+HWTEST_F(BmsBundleInstallerTest, ReceiveStream_0500, Function | SmallTest | Level0)
+{
+    std::string content = ReadFileContent(RESOURCE_ROOT_PATH + RIGHT_BUNDLE);
+    ASSERT_GT(content.size(), STALLED_STREAM_SIZE);
+    int32_t pipeFds[2] = { -1, -1 };
+    ASSERT_EQ(pipe(pipeFds), 0);
+    ASSERT_EQ(write(pipeFds[1], content.data(), STALLED_STREAM_SIZE), static_cast<ssize_t>(STALLED_STREAM_SIZE));
+    ErrCode result = BundleUtil::ReceiveStream(pipeFds[0], STREAM_RECEIVED_FILE, STREAM_IDLE_TIMEOUT_MS);
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+    EXPECT_EQ(result, ERR_APPEXECFWK_OPERATION_TIME_OUT);
+    EXPECT_NE(access(STREAM_RECEIVED_FILE.c_str(), F_OK), 0);
+}
+
+/**
+ * @tc.number: StreamInstall_0100
+ * @tc.name: test the hap written into a pipe can be installed by the installer host
+ * @tc.desc: 1.write the hap into a pipe while it is installed
+ *           2.the bundle is installed and the received file is removed
+ */
+HWTEST_F(BmsBundleInstallerTest, StreamInstall_0100, Function | SmallTest | Level0)
+{
+    std::string content = ReadFileContent(RESOURCE_ROOT_PATH + RIGHT_BUNDLE);
+    ASSERT_FALSE(content.empty());
+    auto installer = DelayedSingleton<BundleMgrService>::GetInstance()->GetBundleInstaller();
+    ASSERT_NE(installer, nullptr);
+    int32_t pipeFds[2] = { -1, -1 };
+    ASSERT_EQ(pipe(pipeFds), 0);
+    std::thread writer = WriteStream(pipeFds[1], content);
+    // the installer takes the read end and closes it
+    ErrCode result = StreamInstallThirdPartyBundle(installer, pipeFds[0]);
+    writer.join();
+    EXPECT_EQ(result, ERR_OK);
+    CheckFileExist();
+    EXPECT_TRUE(IsStreamInstallPathEmpty());
+    EXPECT_EQ(UnInstallBundle(BUNDLE_NAME), ERR_OK);
+}
+
+/**
+ * @tc.number: StreamInstall_0200
+ * @tc.name: test the hap in a regular file can be installed by the installer proxy
+ * @tc.desc: 1.the fd of the hap is passed by the proxy, the host receives it by read and write
+ *           2.the bundle is installed and the received file is removed
+ */
+HWTEST_F(BmsBundleInstallerTest, StreamInstall_0200, Function | SmallTest | Level0)
+{
+    auto installer = DelayedSingleton<BundleMgrService>::GetInstance()->GetBundleInstaller();
+    ASSERT_NE(installer, nullptr);
+    sptr<IBundleInstaller> proxy = new (std::nothrow) BundleInstallerProxy(installer->AsObject());
+    ASSERT_NE(proxy, nullptr);
+    std::string bundleFile = RESOURCE_ROOT_PATH + RIGHT_BUNDLE;
+    int32_t streamFd = open(bundleFile.c_str(), O_RDONLY);
+    ASSERT_GE(streamFd, 0);
+    // the fd is duplicated into the parcel, the caller still owns it
+    ErrCode result = StreamInstallThirdPartyBundle(proxy, streamFd);
+    close(streamFd);
+    EXPECT_EQ(result, ERR_OK);
+    CheckFileExist();
+    EXPECT_TRUE(IsStreamInstallPathEmpty());
+    EXPECT_EQ(UnInstallBundle(BUNDLE_NAME), ERR_OK);
+}
+
+/**
+ * @tc.number: StreamInstall_0300
+ * @tc.name: test a truncated stream can not be installed
+ * @tc.desc: 1.the pipe is closed in the middle of the hap
+ *           2.the install fails, nothing is installed and the received file is removed
+ */
+HWTEST_F(BmsBundleInstallerTest, StreamInstall_0300, Function | SmallTest | Level0)
+{
+    std::string content = ReadFileContent(RESOURCE_ROOT_PATH + RIGHT_BUNDLE);
+    ASSERT_FALSE(content.empty());
+    auto installer = DelayedSingleton<BundleMgrService>::GetInstance()->GetBundleInstaller();
+    ASSERT_NE(installer, nullptr);
+    int32_t pipeFds[2] = { -1, -1 };
+    ASSERT_EQ(pipe(pipeFds), 0);
+    std::thread writer = WriteStream(pipeFds[1], content.substr(0, content.size() / 2));
+    ErrCode result = StreamInstallThirdPartyBundle(installer, pipeFds[0]);
+    writer.join();
+    EXPECT_NE(result, ERR_OK);
+    CheckFileNonExist();
+    EXPECT_TRUE(IsStreamInstallPathEmpty());
+}
 } // OHOS
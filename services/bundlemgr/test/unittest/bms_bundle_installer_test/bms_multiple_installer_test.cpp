@@ -23,7 +23,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#define private public
+#include "base_bundle_installer.h"
+#undef private
 #include "bundle_data_storage_database.h"
+#include "bundle_extractor.h"
 #include "bundle_info.h"
 #include "bundle_installer_host.h"
 #include "bundle_mgr_service.h"
@@ -96,6 +100,7 @@ const int32_t ROOT_UID = 0;
 const int32_t USERID = 100;
 const std::string INSTALL_THREAD = "TestInstall";
 const int32_t WAIT_TIME = 5; // init mocked bms
+const size_t NUMBER_ONE = 1;
 const std::vector<std::string> BUNDLE_DATA_DIR_PAGENAME = {
     "cache",
     "files",
@@ -127,6 +132,10 @@ public:
     void CheckModuleFileExist(const std::string &packageName) const;
     void CheckModuleFileNonExist(const std::string &packageName) const;
     void IsContainModuleInfo(const BundleInfo &info, const std::string &packageName1) const;
+    ErrCode CheckMultipleHapsSignInfo(const std::vector<std::string> &filePaths,
+        std::vector<Security::Verify::HapVerifyResult> &hapVerifyRes) const;
+    ErrCode ParseHapFiles(const std::vector<std::string> &filePaths,
+        std::unordered_map<std::string, InnerBundleInfo> &infos) const;
 
 private:
     std::shared_ptr<InstalldService> installdService_ = std::make_shared<InstalldService>();
@@ -284,6 +293,31 @@ void BmsMultipleInstallerTest::IsContainModuleInfo(const BundleInfo &info, const
     EXPECT_TRUE(ret);
 }
 
+ErrCode BmsMultipleInstallerTest::CheckMultipleHapsSignInfo(const std::vector<std::string> &filePaths,
+    std::vector<Security::Verify::HapVerifyResult> &hapVerifyRes) const
+{
+    BaseBundleInstaller installer;
+    InstallParam installParam;
+    installParam.userId = USERID;
+    return installer.CheckMultipleHapsSignInfo(filePaths, installParam, hapVerifyRes);
+}
+
+ErrCode BmsMultipleInstallerTest::ParseHapFiles(const std::vector<std::string> &filePaths,
+    std::unordered_map<std::string, InnerBundleInfo> &infos) const
+{
+    BaseBundleInstaller installer;
+    std::vector<std::shared_ptr<BundleExtractor>> bundleExtractors;
+    ErrCode result = installer.OpenBundleExtractors(filePaths, bundleExtractors);
+    if (result != ERR_OK) {
+        return result;
+    }
+    InstallParam installParam;
+    installParam.userId = USERID;
+    std::vector<Security::Verify::HapVerifyResult> hapVerifyRes(filePaths.size());
+    return installer.ParseHapFiles(filePaths, installParam, Constants::AppType::THIRD_PARTY_APP, hapVerifyRes,
+        bundleExtractors, infos);
+}
+
 const std::shared_ptr<BundleDataMgr> BmsMultipleInstallerTest::GetBundleDataMgr() const
 {
     return bundleMgrService_->GetDataMgr();
@@ -2529,4 +2563,108 @@ HWTEST_F(BmsMultipleInstallerTest, MultipleHapsUpdateData_2700, Function | Small
     EXPECT_FALSE(result);
 
     dataMgr->UpdateBundleInstallState(BUNDLE_NAME, InstallState::INSTALL_FAIL);
-}
\ No newline at end of file
+}
+
+/**
+ * @tc.number: MultipleHapsVerify_0100
+ * @tc.name: test the signature info of haps verified concurrently is in the order of the input file paths
+ * @tc.desc: 1.three haps of a bundle are verified concurrently
+ *           2.the verification is successful and there is a signature info for each hap
+ */
+HWTEST_F(BmsMultipleInstallerTest, MultipleHapsVerify_0100, Function | SmallTest | Level1)
+{
+    std::vector<std::string> filePaths;
+    filePaths.emplace_back(RESOURCE_ROOT_PATH + RIGHT_BUNDLE_FIRST);
+    filePaths.emplace_back(RESOURCE_ROOT_PATH + RIGHT_BUNDLE_SECOND);
+    filePaths.emplace_back(RESOURCE_ROOT_PATH + RIGHT_BUNDLE_TWELFTH);
+    std::vector<Security::Verify::HapVerifyResult> hapVerifyRes;
+    ErrCode result = CheckMultipleHapsSignInfo(filePaths, hapVerifyRes);
+    EXPECT_EQ(result, ERR_OK);
+    ASSERT_EQ(hapVerifyRes.size(), filePaths.size());
+
+    for (size_t i = 0; i < filePaths.size(); ++i) {
+        std::vector<Security::Verify::HapVerifyResult> singleVerifyRes;
+        result = CheckMultipleHapsSignInfo({ filePaths[i] }, singleVerifyRes);
+        EXPECT_EQ(result, ERR_OK);
+        ASSERT_EQ(singleVerifyRes.size(), NUMBER_ONE);
+        EXPECT_EQ(hapVerifyRes[i].GetProvisionInfo().appId, singleVerifyRes[0].GetProvisionInfo().appId);
+        EXPECT_EQ(hapVerifyRes[i].GetProvisionInfo().bundleInfo.bundleName,
+            singleVerifyRes[0].GetProvisionInfo().bundleInfo.bundleName);
+    }
+}
+
+/**
+ * @tc.number: MultipleHapsVerify_0200
+ * @tc.name: test the first failed hap in the input file paths decides the error of the verification
+ * @tc.desc: 1.a hap without sign info and a hap which does not exist are verified concurrently
+ *           2.the error is the one of the hap which comes first in the input file paths
+ */
+HWTEST_F(BmsMultipleInstallerTest, MultipleHapsVerify_0200, Function | SmallTest | Level1)
+{
+    std::string rightFile = RESOURCE_ROOT_PATH + RIGHT_BUNDLE_FIRST;
+    std::string noSignFile = RESOURCE_ROOT_PATH + RIGHT_BUNDLE_SIXTH;
+    std::string nonExistFile = RESOURCE_ROOT_PATH + INVALID_BUNDLE;
+    std::vector<Security::Verify::HapVerifyResult> hapVerifyRes;
+    ErrCode nonExistResult = CheckMultipleHapsSignInfo({ nonExistFile }, hapVerifyRes);
+    EXPECT_NE(nonExistResult, ERR_OK);
+    EXPECT_NE(nonExistResult, ERR_APPEXECFWK_INSTALL_FAILED_NO_BUNDLE_SIGNATURE);
+
+    hapVerifyRes.clear();
+    ErrCode result = CheckMultipleHapsSignInfo({ rightFile, noSignFile, nonExistFile }, hapVerifyRes);
+    EXPECT_EQ(result, ERR_APPEXECFWK_INSTALL_FAILED_NO_BUNDLE_SIGNATURE);
+
+    hapVerifyRes.clear();
+    result = CheckMultipleHapsSignInfo({ rightFile, nonExistFile, noSignFile }, hapVerifyRes);
+    EXPECT_EQ(result, nonExistResult);
+}
+
+/**
+ * @tc.number: MultipleHapsParse_0100
+ * @tc.name: test each hap parsed concurrently keeps its own bundle info
+ * @tc.desc: 1.four haps of a bundle are parsed concurrently
+ *           2.the parsing is successful and the info of each file path is the module of that hap
+ */
+HWTEST_F(BmsMultipleInstallerTest, MultipleHapsParse_0100, Function | SmallTest | Level1)
+{
+    const std::vector<std::pair<std::string, std::string>> expectedModules = {
+        { RESOURCE_ROOT_PATH + RIGHT_BUNDLE_SECOND, PACKAGE_NAME_SECOND },
+        { RESOURCE_ROOT_PATH + RIGHT_BUNDLE_TWELFTH, PACKAGE_NAME_THIRD },
+        { RESOURCE_ROOT_PATH + RIGHT_BUNDLE_FIRST, PACKAGE_NAME_FIRST },
+        { RESOURCE_ROOT_PATH + RIGHT_BUNDLE_SECOND_BACKUP, PACKAGE_NAME_SECOND },
+    };
+    std::vector<std::string> filePaths;
+    for (const auto &expectedModule : expectedModules) {
+        filePaths.emplace_back(expectedModule.first);
+    }
+    std::unordered_map<std::string, InnerBundleInfo> infos;
+    ErrCode result = ParseHapFiles(filePaths, infos);
+    EXPECT_EQ(result, ERR_OK);
+    ASSERT_EQ(infos.size(), expectedModules.size());
+
+    for (const auto &expectedModule : expectedModules) {
+        auto iter = infos.find(expectedModule.first);
+        ASSERT_NE(iter, infos.end()) << expectedModule.first;
+        EXPECT_EQ(iter->second.GetBundleName(), BUNDLE_NAME);
+        EXPECT_EQ(iter->second.GetCurrentModulePackage(), expectedModule.second) << expectedModule.first;
+    }
+}
+
+/**
+ * @tc.number: MultipleHapsParse_0200
+ * @tc.name: test the first failed hap in the input file paths decides the error of the parsing
+ * @tc.desc: 1.a hap without profile and a second entry hap are parsed concurrently
+ *           2.the error is the one of the hap which comes first in the input file paths
+ */
+HWTEST_F(BmsMultipleInstallerTest, MultipleHapsParse_0200, Function | SmallTest | Level1)
+{
+    std::string entryFile = RESOURCE_ROOT_PATH + RIGHT_BUNDLE_FIRST;
+    std::string noProfileFile = RESOURCE_ROOT_PATH + FORMAT_ERROR_BUNDLE;
+    std::string secondEntryFile = RESOURCE_ROOT_PATH + RIGHT_BUNDLE_FIFTH;
+    std::unordered_map<std::string, InnerBundleInfo> infos;
+    ErrCode result = ParseHapFiles({ entryFile, noProfileFile, secondEntryFile }, infos);
+    EXPECT_EQ(result, ERR_APPEXECFWK_PARSE_NO_PROFILE);
+
+    infos.clear();
+    result = ParseHapFiles({ entryFile, secondEntryFile, noProfileFile }, infos);
+    EXPECT_EQ(result, ERR_APPEXECFWK_INSTALL_INVALID_NUMBER_OF_ENTRY_HAP);
+}
@@ -25,12 +25,16 @@
 #include "bundle_permission_mgr.h"
 #include "bundle_mgr_service.h"
 #include "bundle_mgr_host.h"
+#include "bundle_mgr_reply_cache.h"
 #include "directory_ex.h"
 #include "install_param.h"
 #include "installd/installd_service.h"
 #include "installd_client.h"
 #include "inner_bundle_info.h"
+#define private public
 #include "launcher_service.h"
+#undef private
+#include "message_parcel.h"
 #include "mock_clean_cache.h"
 #include "mock_bundle_status.h"
 #include "ohos/aafwk/content/want.h"
@@ -181,6 +185,16 @@ const std::string URI_PATH_REGEX_001 = SCHEME_001 + SCHEME_SEPARATOR + HOST_001
     PORT_SEPARATOR + PORT_001 + PATH_SEPARATOR + PATH_REGEX_001;
 const int32_t DEFAULT_USERID = 100;
 const int32_t WAIT_TIME = 5; // init mocked bms
+const int32_t SANDBOX_APP_INDEX = 1;
+const size_t REPLY_CACHE_ENTRIES_ZERO = 0;
+const size_t REPLY_CACHE_ENTRIES_ONE = 1;
+const uint64_t REPLY_CACHE_HITS_ONE = 1;
+const int32_t LAUNCHER_LABEL_ID = 1;
+const int32_t LAUNCHER_CHANGED_LABEL_ID = 2;
+const uint64_t LAUNCHER_VERSION_ONE = 1;
+const uint64_t LAUNCHER_VERSION_TWO = 2;
+const uint64_t LAUNCHER_VERSION_THREE = 3;
+const size_t MAX_LAUNCHER_CHANGES = 1000;
 }  // namespace
 
 class BmsBundleKitServiceTest : public testing::Test {
@@ -246,6 +260,8 @@ public:
         const std::string &abilityName, InnerBundleInfo &innerBundleInfo) const;
     void SaveToDatabase(const std::string &bundleName, InnerBundleInfo &innerBundleInfo,
         bool userDataClearable, bool isSystemApp) const;
+    int RequestApplicationInfo(const sptr<BundleMgrHostImpl> &host, MessageParcel &reply) const;
+    LauncherAbilityInfo MockLauncherAbilityInfo(const std::string &bundleName, int32_t labelId) const;
 
 public:
     std::shared_ptr<BundleMgrService> bundleMgrService_ = DelayedSingleton<BundleMgrService>::GetInstance();
@@ -288,6 +304,32 @@ std::shared_ptr<LauncherService> BmsBundleKitServiceTest::GetLauncherService() c
     return launcherService_;
 }
 
+int BmsBundleKitServiceTest::RequestApplicationInfo(const sptr<BundleMgrHostImpl> &host, MessageParcel &reply) const
+{
+    MessageParcel data;
+    data.WriteInterfaceToken(BundleMgrHost::GetDescriptor());
+    data.WriteString(BUNDLE_NAME_TEST);
+    data.WriteInt32(static_cast<int32_t>(ApplicationFlag::GET_BASIC_APPLICATION_INFO));
+    data.WriteInt32(DEFAULT_USERID);
+    MessageOption option;
+    return host->OnRemoteRequest(IBundleMgr::Message::GET_APPLICATION_INFO, data, reply, option);
+}
+
+LauncherAbilityInfo BmsBundleKitServiceTest::MockLauncherAbilityInfo(
+    const std::string &bundleName, int32_t labelId) const
+{
+    LauncherAbilityInfo info;
+    info.applicationInfo.bundleName = bundleName;
+    info.elementName.SetBundleName(bundleName);
+    info.elementName.SetModuleName(MODULE_NAME_TEST);
+    info.elementName.SetAbilityName(ABILITY_NAME_TEST);
+    info.labelId = labelId;
+    info.iconId = 0;
+    info.userId = DEFAULT_USERID;
+    info.installTime = 0;
+    return info;
+}
+
 void BmsBundleKitServiceTest::AddBundleInfo(const std::string &bundleName, BundleInfo &bundleInfo) const
 {
     bundleInfo.name = bundleName;
@@ -4433,4 +4475,249 @@ HWTEST_F(BmsBundleKitServiceTest, GetAlldependentModuleNames_004, Function | Sma
         EXPECT_EQ(res[MODULE_NAMES_SIZE_TWO], MODULE_NAME_TEST_3);
     }
 }
+
+/**
+ * @tc.number: ReplyCache_0100
+ * @tc.name: test the reply of GetApplicationInfo is cached by OnRemoteRequest
+ * @tc.desc: 1.system run normally
+ *           2.the second same request is served from the reply cache
+ *           3.storing or deleting a sandbox persistent info drops the cached reply
+ */
+HWTEST_F(BmsBundleKitServiceTest, ReplyCache_0100, Function | SmallTest | Level1)
+{
+    MockInstallBundle(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    auto dataMgr = GetBundleDataMgr();
+    ASSERT_NE(dataMgr, nullptr);
+    auto replyCache = dataMgr->GetReplyCache();
+    ASSERT_NE(replyCache, nullptr);
+    replyCache->InvalidateAll();
+    sptr<BundleMgrHostImpl> host = new (std::nothrow) BundleMgrHostImpl();
+    ASSERT_NE(host, nullptr);
+
+    MessageParcel firstReply;
+    EXPECT_EQ(RequestApplicationInfo(host, firstReply), NO_ERROR);
+    BundleMgrReplyCache::Stats stats = replyCache->GetStats();
+    EXPECT_EQ(stats.entries, REPLY_CACHE_ENTRIES_ONE);
+
+    MessageParcel secondReply;
+    EXPECT_EQ(RequestApplicationInfo(host, secondReply), NO_ERROR);
+    EXPECT_EQ(replyCache->GetStats().hits, stats.hits + REPLY_CACHE_HITS_ONE);
+    ASSERT_EQ(secondReply.GetDataSize(), firstReply.GetDataSize());
+    EXPECT_EQ(memcmp(reinterpret_cast<const void *>(secondReply.GetData()),
+        reinterpret_cast<const void *>(firstReply.GetData()), firstReply.GetDataSize()), 0);
+
+    SandboxAppPersistentInfo info;
+    info.appIndex = SANDBOX_APP_INDEX;
+    info.userId = DEFAULT_USERID;
+    dataMgr->StoreSandboxPersistentInfo(BUNDLE_NAME_TEST, info);
+    EXPECT_EQ(replyCache->GetStats().entries, REPLY_CACHE_ENTRIES_ZERO);
+
+    MessageParcel thirdReply;
+    EXPECT_EQ(RequestApplicationInfo(host, thirdReply), NO_ERROR);
+    EXPECT_EQ(replyCache->GetStats().entries, REPLY_CACHE_ENTRIES_ONE);
+    dataMgr->DeleteSandboxPersistentInfo(BUNDLE_NAME_TEST, info);
+    EXPECT_EQ(replyCache->GetStats().entries, REPLY_CACHE_ENTRIES_ZERO);
+
+    MockUninstallBundle(BUNDLE_NAME_TEST);
+}
+
+/**
+ * @tc.number: LauncherSnapshot_0100
+ * @tc.name: test the launcher abilities of a bundle are applied to a snapshot
+ * @tc.desc: 1.an added, an unchanged, a changed and a removed bundle are applied in turn
+ *           2.only real changes are recorded, each with the version it leads to
+ */
+HWTEST_F(BmsBundleKitServiceTest, LauncherSnapshot_0100, Function | SmallTest | Level1)
+{
+    auto launcherService = GetLauncherService();
+    ASSERT_NE(launcherService, nullptr);
+    LauncherService::LauncherSnapshot snapshot;
+
+    std::vector<LauncherAbilityInfo> infos = { MockLauncherAbilityInfo(BUNDLE_NAME_TEST, LAUNCHER_LABEL_ID) };
+    EXPECT_TRUE(launcherService->ApplyBundleAbilities(BUNDLE_NAME_TEST, infos, snapshot));
+    snapshot.version++;
+    ASSERT_EQ(snapshot.changes.size(), ABILITY_SIZE_ONE);
+    EXPECT_EQ(snapshot.changes.back().version, LAUNCHER_VERSION_ONE);
+    EXPECT_EQ(snapshot.changes.back().type, LauncherService::LauncherChangeType::ADDED);
+
+    infos = { MockLauncherAbilityInfo(BUNDLE_NAME_TEST, LAUNCHER_LABEL_ID) };
+    EXPECT_FALSE(launcherService->ApplyBundleAbilities(BUNDLE_NAME_TEST, infos, snapshot));
+    EXPECT_EQ(snapshot.changes.size(), ABILITY_SIZE_ONE);
+
+    infos = { MockLauncherAbilityInfo(BUNDLE_NAME_TEST, LAUNCHER_CHANGED_LABEL_ID) };
+    EXPECT_TRUE(launcherService->ApplyBundleAbilities(BUNDLE_NAME_TEST, infos, snapshot));
+    snapshot.version++;
+    EXPECT_EQ(snapshot.changes.back().version, LAUNCHER_VERSION_TWO);
+    EXPECT_EQ(snapshot.changes.back().type, LauncherService::LauncherChangeType::CHANGED);
+    ASSERT_EQ(snapshot.bundleAbilities[BUNDLE_NAME_TEST].size(), ABILITY_SIZE_ONE);
+    EXPECT_EQ(snapshot.bundleAbilities[BUNDLE_NAME_TEST][0].labelId, LAUNCHER_CHANGED_LABEL_ID);
+
+    infos.clear();
+    EXPECT_TRUE(launcherService->ApplyBundleAbilities(BUNDLE_NAME_TEST, infos, snapshot));
+    snapshot.version++;
+    EXPECT_EQ(snapshot.changes.back().version, LAUNCHER_VERSION_THREE);
+    EXPECT_EQ(snapshot.changes.back().type, LauncherService::LauncherChangeType::REMOVED);
+    EXPECT_TRUE(snapshot.bundleAbilities.empty());
+}
+
+/**
+ * @tc.number: LauncherDelta_0100
+ * @tc.name: test the delta since a version folds the changes of each ability
+ * @tc.desc: 1.an ability is added, changed and then removed
+ *           2.the delta since each version holds the one change to apply
+ *           3.a version which is too old or too new gets a full snapshot
+ */
+HWTEST_F(BmsBundleKitServiceTest, LauncherDelta_0100, Function | SmallTest | Level1)
+{
+    auto launcherService = GetLauncherService();
+    ASSERT_NE(launcherService, nullptr);
+    LauncherService::LauncherSnapshot snapshot;
+    std::vector<LauncherAbilityInfo> infos = { MockLauncherAbilityInfo(BUNDLE_NAME_TEST, LAUNCHER_LABEL_ID) };
+    launcherService->ApplyBundleAbilities(BUNDLE_NAME_TEST, infos, snapshot);
+    snapshot.version++;
+    infos = { MockLauncherAbilityInfo(BUNDLE_NAME_TEST, LAUNCHER_CHANGED_LABEL_ID) };
+    launcherService->ApplyBundleAbilities(BUNDLE_NAME_TEST, infos, snapshot);
+    snapshot.version++;
+
+    LauncherAbilityDelta delta;
+    launcherService->CollectDelta(snapshot, 0, delta);
+    EXPECT_FALSE(delta.isFullSnapshot);
+    EXPECT_EQ(delta.version, LAUNCHER_VERSION_TWO);
+    ASSERT_EQ(delta.added.size(), ABILITY_SIZE_ONE);
+    EXPECT_EQ(delta.added[0].labelId, LAUNCHER_CHANGED_LABEL_ID);
+    EXPECT_TRUE(delta.changed.empty());
+
+    launcherService->CollectDelta(snapshot, LAUNCHER_VERSION_ONE, delta);
+    EXPECT_TRUE(delta.added.empty());
+    EXPECT_EQ(delta.changed.size(), ABILITY_SIZE_ONE);
+
+    launcherService->CollectDelta(snapshot, LAUNCHER_VERSION_TWO, delta);
+    EXPECT_TRUE(delta.added.empty());
+    EXPECT_TRUE(delta.changed.empty());
+    EXPECT_TRUE(delta.removed.empty());
+
+    infos.clear();
+    launcherService->ApplyBundleAbilities(BUNDLE_NAME_TEST, infos, snapshot);
+    snapshot.version++;
+    launcherService->CollectDelta(snapshot, 0, delta);
+    EXPECT_TRUE(delta.added.empty());
+    EXPECT_TRUE(delta.removed.empty());
+    launcherService->CollectDelta(snapshot, LAUNCHER_VERSION_ONE, delta);
+    EXPECT_EQ(delta.removed.size(), ABILITY_SIZE_ONE);
+
+    launcherService->CollectDelta(snapshot, LAUNCHER_VERSION_THREE + 1, delta);
+    EXPECT_TRUE(delta.isFullSnapshot);
+    snapshot.oldestDeltaVersion = LAUNCHER_VERSION_TWO;
+    launcherService->CollectDelta(snapshot, LAUNCHER_VERSION_ONE, delta);
+    EXPECT_TRUE(delta.isFullSnapshot);
+    EXPECT_EQ(delta.version, LAUNCHER_VERSION_THREE);
+}
+
+/**
+ * @tc.number: LauncherDelta_0200
+ * @tc.name: test the oldest changes are dropped
+ * @tc.desc: 1.an ability changes more often than the changes kept
+ *           2.the delta since the first version becomes a full snapshot
+ */
+HWTEST_F(BmsBundleKitServiceTest, LauncherDelta_0200, Function | SmallTest | Level1)
+{
+    auto launcherService = GetLauncherService();
+    ASSERT_NE(launcherService, nullptr);
+    LauncherService::LauncherSnapshot snapshot;
+    for (size_t i = 0; i <= MAX_LAUNCHER_CHANGES; ++i) {
+        std::vector<LauncherAbilityInfo> infos = { MockLauncherAbilityInfo(BUNDLE_NAME_TEST, static_cast<int32_t>(i)) };
+        EXPECT_TRUE(launcherService->ApplyBundleAbilities(BUNDLE_NAME_TEST, infos, snapshot));
+        snapshot.version++;
+    }
+    EXPECT_EQ(snapshot.changes.size(), MAX_LAUNCHER_CHANGES);
+    EXPECT_EQ(snapshot.oldestDeltaVersion, LAUNCHER_VERSION_ONE);
+
+    LauncherAbilityDelta delta;
+    launcherService->CollectDelta(snapshot, 0, delta);
+    EXPECT_TRUE(delta.isFullSnapshot);
+    EXPECT_EQ(delta.added.size(), ABILITY_SIZE_ONE);
+    launcherService->CollectDelta(snapshot, LAUNCHER_VERSION_ONE, delta);
+    EXPECT_FALSE(delta.isFullSnapshot);
+    EXPECT_EQ(delta.changed.size(), ABILITY_SIZE_ONE);
+}
+
+/**
+ * @tc.number: LauncherSnapshot_0200
+ * @tc.name: test the snapshot version follows the installed bundles
+ * @tc.desc: 1.the version is kept while nothing changes
+ *           2.installing and uninstalling a bundle each lead to a new version and a delta
+ */
+HWTEST_F(BmsBundleKitServiceTest, LauncherSnapshot_0200, Function | SmallTest | Level1)
+{
+    auto launcherService = GetLauncherService();
+    ASSERT_NE(launcherService, nullptr);
+    uint64_t version = 0;
+    std::vector<LauncherAbilityInfo> launcherAbilityInfos;
+    ASSERT_TRUE(launcherService->GetLauncherAbilitySnapshot(DEFAULT_USERID, version, launcherAbilityInfos));
+    uint64_t sameVersion = 0;
+    launcherAbilityInfos.clear();
+    ASSERT_TRUE(launcherService->GetLauncherAbilitySnapshot(DEFAULT_USERID, sameVersion, launcherAbilityInfos));
+    EXPECT_EQ(sameVersion, version);
+
+    MockInstallBundle(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    {
+        // the mocked install publishes no common event
+        std::lock_guard<std::mutex> lock(launcherService->changedBundles_->mutex);
+        launcherService->changedBundles_->bundleNames[DEFAULT_USERID].insert(BUNDLE_NAME_TEST);
+    }
+    LauncherAbilityDelta delta;
+    ASSERT_TRUE(launcherService->GetLauncherAbilityDelta(DEFAULT_USERID, version, delta));
+    EXPECT_FALSE(delta.isFullSnapshot);
+    EXPECT_EQ(delta.version, version + LAUNCHER_VERSION_ONE);
+    ASSERT_EQ(delta.added.size(), ABILITY_SIZE_ONE);
+    EXPECT_EQ(delta.added[0].elementName.GetBundleName(), BUNDLE_NAME_TEST);
+
+    MockUninstallBundle(BUNDLE_NAME_TEST);
+    {
+        std::lock_guard<std::mutex> lock(launcherService->changedBundles_->mutex);
+        launcherService->changedBundles_->bundleNames[DEFAULT_USERID].insert(BUNDLE_NAME_TEST);
+    }
+    uint64_t addedVersion = delta.version;
+    ASSERT_TRUE(launcherService->GetLauncherAbilityDelta(DEFAULT_USERID, addedVersion, delta));
+    EXPECT_EQ(delta.version, addedVersion + LAUNCHER_VERSION_ONE);
+    ASSERT_EQ(delta.removed.size(), ABILITY_SIZE_ONE);
+    EXPECT_EQ(delta.removed[0].elementName.GetBundleName(), BUNDLE_NAME_TEST);
+}
+
+/**
+ * @tc.number: QueryLauncherAbilityInfos_0100
+ * @tc.name: test the launcher abilities of a disabled bundle are not queried
+ * @tc.desc: 1.query the launcher abilities of one bundle and of all the bundles
+ *           2.a disabled bundle is left out of both queries
+ */
+HWTEST_F(BmsBundleKitServiceTest, QueryLauncherAbilityInfos_0100, Function | SmallTest | Level1)
+{
+    MockInstallBundle(BUNDLE_NAME_TEST, MODULE_NAME_TEST, ABILITY_NAME_TEST);
+    auto dataMgr = GetBundleDataMgr();
+    ASSERT_NE(dataMgr, nullptr);
+    Want want;
+    want.SetAction(ACTION);
+    want.AddEntity(ENTITY);
+    Want bundleWant = want;
+    ElementName elementName;
+    elementName.SetBundleName(BUNDLE_NAME_TEST);
+    bundleWant.SetElement(elementName);
+
+    std::vector<AbilityInfo> abilityInfos;
+    EXPECT_TRUE(dataMgr->QueryLauncherAbilityInfos(bundleWant, DEFAULT_USERID, abilityInfos));
+    EXPECT_EQ(abilityInfos.size(), ABILITY_SIZE_ONE);
+
+    EXPECT_TRUE(dataMgr->DisableBundle(BUNDLE_NAME_TEST));
+    abilityInfos.clear();
+    EXPECT_TRUE(dataMgr->QueryLauncherAbilityInfos(bundleWant, DEFAULT_USERID, abilityInfos));
+    EXPECT_TRUE(abilityInfos.empty());
+    abilityInfos.clear();
+    dataMgr->QueryLauncherAbilityInfos(want, DEFAULT_USERID, abilityInfos);
+    for (const auto &abilityInfo : abilityInfos) {
+        EXPECT_NE(abilityInfo.bundleName, BUNDLE_NAME_TEST);
+    }
+
+    EXPECT_TRUE(dataMgr->EnableBundle(BUNDLE_NAME_TEST));
+    MockUninstallBundle(BUNDLE_NAME_TEST);
+}
 }
\ No newline at end of file
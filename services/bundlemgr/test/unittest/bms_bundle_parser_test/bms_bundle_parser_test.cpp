@@ -13,8 +13,10 @@
  * limitations under the License.
  */
 
+#include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "app_log_wrapper.h"
@@ -34,6 +36,7 @@ using namespace OHOS::AppExecFwk::ProfileReader;
 namespace {
 const std::string RESOURCE_ROOT_PATH = "/data/test/resource/bms/parse_bundle/";
 const std::string NEW_APP = "new";
+const std::string NEW_APP_BUNDLE_NAME = "com.example.hiworld.himusic";
 const std::string BREAK_ZIP = "break_zip";
 const std::string NO_PROFILE = "no_profile";
 const std::string EMPTY_CONFIG = "empty_config";
@@ -929,6 +932,73 @@ HWTEST_F(BmsBundleParserTest, TestParse_2700, Function | SmallTest | Level1)
     )"_json;
     CheckProfileShortcut(errorShortcutJson);
 }
+
+/**
+ * @tc.number: TestParse_2800
+ * @tc.name: parse bundle package by an opened extractor
+ * @tc.desc: 1. system running normally
+ *           2. test parsing by an extractor which failed to open the package
+ */
+HWTEST_F(BmsBundleParserTest, TestParse_2800, Function | SmallTest | Level1)
+{
+    pathStream_ << RESOURCE_ROOT_PATH << UNKOWN_PATH << INSTALL_FILE_SUFFIX;
+    BundleExtractor bundleExtractor(pathStream_.str());
+    EXPECT_FALSE(bundleExtractor.Init());
+
+    BundleParser bundleParser;
+    InnerBundleInfo innerBundleInfo;
+    ErrCode result = bundleParser.Parse(bundleExtractor, innerBundleInfo);
+    EXPECT_EQ(result, ERR_APPEXECFWK_PARSE_NO_PROFILE);
+
+    BundlePackInfo bundlePackInfo;
+    result = bundleParser.ParsePackInfo(bundleExtractor, bundlePackInfo);
+    EXPECT_EQ(result, ERR_OK);
+
+    std::vector<std::string> sysCaps;
+    result = bundleParser.ParseSysCap(bundleExtractor, sysCaps);
+    EXPECT_EQ(result, ERR_OK);
+    EXPECT_TRUE(sysCaps.empty());
+}
+
+/**
+ * @tc.number: TestParse_2900
+ * @tc.name: parse bundle package by a shared extractor
+ * @tc.desc: 1. system running normally
+ *           2. test the syscap check, the parsing and the pack.info parsing share one opened real package,
+ *              the package is opened as BaseBundleInstaller::OpenBundleExtractors does
+ */
+HWTEST_F(BmsBundleParserTest, TestParse_2900, Function | SmallTest | Level1)
+{
+    pathStream_ << RESOURCE_ROOT_PATH << NEW_APP << INSTALL_FILE_SUFFIX;
+    std::vector<std::shared_ptr<BundleExtractor>> bundleExtractors;
+    auto bundleExtractor = std::make_shared<BundleExtractor>(pathStream_.str());
+    ASSERT_TRUE(bundleExtractor->Init());
+    bundleExtractors.emplace_back(bundleExtractor);
+    bundleExtractor.reset();
+
+    BundleParser bundleParser;
+    const auto &sharedExtractor = bundleExtractors.front();
+    std::vector<std::string> sysCaps;
+    ErrCode result = bundleParser.ParseSysCap(*sharedExtractor, sysCaps);
+    EXPECT_EQ(result, ERR_OK);
+    EXPECT_TRUE(sysCaps.empty());
+
+    InnerBundleInfo innerBundleInfo;
+    result = bundleParser.Parse(*sharedExtractor, innerBundleInfo);
+    EXPECT_EQ(result, ERR_OK);
+    EXPECT_EQ(innerBundleInfo.GetBundleName(), NEW_APP_BUNDLE_NAME);
+
+    BundlePackInfo bundlePackInfo;
+    result = bundleParser.ParsePackInfo(*sharedExtractor, bundlePackInfo);
+    EXPECT_EQ(result, ERR_OK);
+
+    InnerBundleInfo reparsedInfo;
+    result = bundleParser.Parse(*sharedExtractor, reparsedInfo);
+    EXPECT_EQ(result, ERR_OK);
+    EXPECT_EQ(reparsedInfo.GetBundleName(), NEW_APP_BUNDLE_NAME);
+    EXPECT_EQ(sharedExtractor.use_count(), 1);
+}
+
 /**
  * @tc.number: TestExtractByName_0100
  * @tc.name: extract file stream by file name from package
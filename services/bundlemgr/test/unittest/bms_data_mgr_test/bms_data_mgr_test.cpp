@@ -23,6 +23,9 @@
 #include "json_constants.h"
 #include "json_serializer.h"
 #include "parcel.h"
+#ifdef GLOBAL_RESMGR_ENABLE
+#include "resource_manager_cache.h"
+#endif
 
 using namespace testing::ext;
 using namespace OHOS::AppExecFwk;
@@ -47,6 +50,13 @@ const std::string RESOURCE_PATH = "/data/app/el1/bundle/public/com.example.l3jsd
 const std::string LIB_PATH = "/data/app/el1/bundle/public/com.example.l3jsdemo";
 const bool VISIBLE = true;
 const int32_t USERID = 100;
+const size_t CACHE_ENTRIES_ZERO = 0;
+const size_t CACHE_BYTES_ZERO = 0;
+#ifdef GLOBAL_RESMGR_ENABLE
+const std::string LOCALE = "zh-Hans-CN";
+const std::string MODULE_RES_PATH = "/data/app/el1/bundle/public/com.example.l3jsdemo/entry/resources.index";
+const size_t MAX_RESOURCE_MANAGER_CACHE_ENTRIES = 16;
+#endif
 }  // namespace
 
 class BmsDataMgrTest : public testing::Test {
@@ -59,6 +69,11 @@ public:
     void TearDown();
     const std::shared_ptr<BundleDataMgr> GetDataMgr() const;
     AbilityInfo GetDefaultAbilityInfo() const;
+#ifdef GLOBAL_RESMGR_ENABLE
+    BundleInfo GetResourceBundleInfo(const std::string &bundleName) const;
+    std::shared_ptr<OHOS::Global::Resource::ResourceManager> GetCachedResourceManager(ResourceManagerCache &cache,
+        const std::string &bundleName, int32_t &createCount) const;
+#endif
 
 private:
     std::shared_ptr<BundleDataMgr> dataMgr_ = std::make_shared<BundleDataMgr>();
@@ -111,6 +126,26 @@ const std::shared_ptr<BundleDataMgr> BmsDataMgrTest::GetDataMgr() const
     return dataMgr_;
 }
 
+#ifdef GLOBAL_RESMGR_ENABLE
+BundleInfo BmsDataMgrTest::GetResourceBundleInfo(const std::string &bundleName) const
+{
+    BundleInfo bundleInfo;
+    bundleInfo.name = bundleName;
+    bundleInfo.moduleResPaths.emplace_back(MODULE_RES_PATH);
+    return bundleInfo;
+}
+
+std::shared_ptr<OHOS::Global::Resource::ResourceManager> BmsDataMgrTest::GetCachedResourceManager(
+    ResourceManagerCache &cache, const std::string &bundleName, int32_t &createCount) const
+{
+    return cache.GetResourceManager(GetResourceBundleInfo(bundleName), LOCALE, [&createCount] {
+        createCount++;
+        return std::shared_ptr<OHOS::Global::Resource::ResourceManager>(
+            OHOS::Global::Resource::CreateResourceManager());
+    });
+}
+#endif
+
 /**
  * @tc.number: UpdateInstallState_0100
  * @tc.name: UpdateInstallState
@@ -987,4 +1022,190 @@ HWTEST_F(BmsDataMgrTest, GetApplicationInfo_0200, Function | SmallTest | Level0)
     EXPECT_NE(appInfo.name, appInfo3.name);
     EXPECT_NE(appInfo.bundleName, appInfo3.bundleName);
     EXPECT_NE(appInfo.deviceId, appInfo3.deviceId);
-}
\ No newline at end of file
+}
+
+/**
+ * @tc.number: ReplyCache_0100
+ * @tc.name: ReplyCache
+ * @tc.desc: 1. store a reply into the reply cache
+ *           2. lookup the reply then verify
+ */
+HWTEST_F(BmsDataMgrTest, ReplyCache_0100, Function | SmallTest | Level0)
+{
+    auto dataMgr = GetDataMgr();
+    EXPECT_NE(dataMgr, nullptr);
+    auto replyCache = dataMgr->GetReplyCache();
+    EXPECT_NE(replyCache, nullptr);
+
+    const std::vector<uint8_t> args = { 1, 2, 3, 4 };
+    const std::vector<uint8_t> reply = { 5, 6, 7, 8 };
+    std::string key = BundleMgrReplyCache::MakeKey(1, USERID, args.data(), args.size());
+    replyCache->Store(key, BUNDLE_NAME, replyCache->GetGeneration(), reply.data(), reply.size());
+
+    std::vector<uint8_t> cachedReply;
+    EXPECT_TRUE(replyCache->Lookup(key, cachedReply));
+    EXPECT_EQ(cachedReply, reply);
+    EXPECT_FALSE(replyCache->Lookup(BundleMgrReplyCache::MakeKey(1, 0, args.data(), args.size()), cachedReply));
+    replyCache->InvalidateAll();
+}
+
+/**
+ * @tc.number: ReplyCache_0200
+ * @tc.name: ReplyCache
+ * @tc.desc: 1. store a reply into the reply cache
+ *           2. change the bundle in the data manager
+ *           3. verify the reply is dropped
+ */
+HWTEST_F(BmsDataMgrTest, ReplyCache_0200, Function | SmallTest | Level0)
+{
+    auto dataMgr = GetDataMgr();
+    EXPECT_NE(dataMgr, nullptr);
+    auto replyCache = dataMgr->GetReplyCache();
+    EXPECT_NE(replyCache, nullptr);
+
+    const std::vector<uint8_t> args = { 1, 2, 3, 4 };
+    const std::vector<uint8_t> reply = { 5, 6, 7, 8 };
+    std::string key = BundleMgrReplyCache::MakeKey(1, USERID, args.data(), args.size());
+    replyCache->Store(key, BUNDLE_NAME, replyCache->GetGeneration(), reply.data(), reply.size());
+
+    dataMgr->UpdateBundleInstallState(BUNDLE_NAME, InstallState::INSTALL_START);
+    std::vector<uint8_t> cachedReply;
+    EXPECT_FALSE(replyCache->Lookup(key, cachedReply));
+    dataMgr->UpdateBundleInstallState(BUNDLE_NAME, InstallState::INSTALL_FAIL);
+}
+
+/**
+ * @tc.number: ReplyCache_0300
+ * @tc.name: ReplyCache
+ * @tc.desc: 1. take the generation before computing a reply
+ *           2. change the bundle before the reply is stored
+ *           3. verify the stale reply is not cached
+ */
+HWTEST_F(BmsDataMgrTest, ReplyCache_0300, Function | SmallTest | Level0)
+{
+    auto dataMgr = GetDataMgr();
+    EXPECT_NE(dataMgr, nullptr);
+    auto replyCache = dataMgr->GetReplyCache();
+    EXPECT_NE(replyCache, nullptr);
+
+    const std::vector<uint8_t> args = { 1, 2, 3, 4 };
+    const std::vector<uint8_t> reply = { 5, 6, 7, 8 };
+    std::string key = BundleMgrReplyCache::MakeKey(1, USERID, args.data(), args.size());
+    uint64_t generation = replyCache->GetGeneration();
+    replyCache->InvalidateBundle(BUNDLE_NAME);
+    replyCache->Store(key, BUNDLE_NAME, generation, reply.data(), reply.size());
+
+    std::vector<uint8_t> cachedReply;
+    EXPECT_FALSE(replyCache->Lookup(key, cachedReply));
+    BundleMgrReplyCache::Stats stats = replyCache->GetStats();
+    EXPECT_EQ(stats.entries, CACHE_ENTRIES_ZERO);
+    EXPECT_EQ(stats.bytes, CACHE_BYTES_ZERO);
+}
+
+#ifdef GLOBAL_RESMGR_ENABLE
+/**
+ * @tc.number: ResourceManagerCache_0100
+ * @tc.name: ResourceManagerCache
+ * @tc.desc: 1. get the ResourceManager of a bundle twice
+ *           2. verify it is created once and the cached one is returned
+ */
+HWTEST_F(BmsDataMgrTest, ResourceManagerCache_0100, Function | SmallTest | Level0)
+{
+    ResourceManagerCache cache;
+    int32_t createCount = 0;
+    auto resourceManager = GetCachedResourceManager(cache, BUNDLE_NAME, createCount);
+    EXPECT_NE(resourceManager, nullptr);
+    EXPECT_EQ(GetCachedResourceManager(cache, BUNDLE_NAME, createCount), resourceManager);
+    EXPECT_EQ(createCount, 1);
+}
+
+/**
+ * @tc.number: ResourceManagerCache_0200
+ * @tc.name: ResourceManagerCache
+ * @tc.desc: 1. fill the cache, then use the oldest entry again
+ *           2. add one more bundle
+ *           3. verify the least recently used entry is evicted and the reused one is kept
+ */
+HWTEST_F(BmsDataMgrTest, ResourceManagerCache_0200, Function | SmallTest | Level0)
+{
+    ResourceManagerCache cache;
+    int32_t createCount = 0;
+    for (size_t i = 0; i < MAX_RESOURCE_MANAGER_CACHE_ENTRIES; ++i) {
+        GetCachedResourceManager(cache, BUNDLE_NAME + std::to_string(i), createCount);
+    }
+    EXPECT_EQ(createCount, static_cast<int32_t>(MAX_RESOURCE_MANAGER_CACHE_ENTRIES));
+    GetCachedResourceManager(cache, BUNDLE_NAME + std::to_string(0), createCount);
+    GetCachedResourceManager(cache, BUNDLE_NAME, createCount);
+    EXPECT_EQ(createCount, static_cast<int32_t>(MAX_RESOURCE_MANAGER_CACHE_ENTRIES) + 1);
+
+    createCount = 0;
+    GetCachedResourceManager(cache, BUNDLE_NAME + std::to_string(0), createCount);
+    GetCachedResourceManager(cache, BUNDLE_NAME, createCount);
+    EXPECT_EQ(createCount, 0);
+    GetCachedResourceManager(cache, BUNDLE_NAME + std::to_string(1), createCount);
+    EXPECT_EQ(createCount, 1);
+}
+
+/**
+ * @tc.number: ResourceManagerCache_0300
+ * @tc.name: ResourceManagerCache
+ * @tc.desc: 1. cache the ResourceManagers of two bundles
+ *           2. invalidate one bundle
+ *           3. verify only the invalidated bundle is created again
+ */
+HWTEST_F(BmsDataMgrTest, ResourceManagerCache_0300, Function | SmallTest | Level0)
+{
+    ResourceManagerCache cache;
+    int32_t createCount = 0;
+    auto resourceManager = GetCachedResourceManager(cache, BUNDLE_NAME, createCount);
+    auto otherResourceManager = GetCachedResourceManager(cache, BUNDLE_NAME + std::to_string(0), createCount);
+    EXPECT_EQ(createCount, 2);
+
+    cache.InvalidateBundle(BUNDLE_NAME);
+    createCount = 0;
+    EXPECT_EQ(GetCachedResourceManager(cache, BUNDLE_NAME + std::to_string(0), createCount), otherResourceManager);
+    EXPECT_EQ(createCount, 0);
+    EXPECT_NE(GetCachedResourceManager(cache, BUNDLE_NAME, createCount), resourceManager);
+    EXPECT_EQ(createCount, 1);
+}
+
+/**
+ * @tc.number: ResourceManagerCache_0400
+ * @tc.name: ResourceManagerCache
+ * @tc.desc: 1. invalidate the bundle while its ResourceManager is being created
+ *           2. verify the created one is returned but not cached
+ */
+HWTEST_F(BmsDataMgrTest, ResourceManagerCache_0400, Function | SmallTest | Level0)
+{
+    ResourceManagerCache cache;
+    auto resourceManager = cache.GetResourceManager(GetResourceBundleInfo(BUNDLE_NAME), LOCALE, [&cache] {
+        cache.InvalidateBundle(BUNDLE_NAME);
+        return std::shared_ptr<OHOS::Global::Resource::ResourceManager>(
+            OHOS::Global::Resource::CreateResourceManager());
+    });
+    EXPECT_NE(resourceManager, nullptr);
+
+    int32_t createCount = 0;
+    EXPECT_NE(GetCachedResourceManager(cache, BUNDLE_NAME, createCount), resourceManager);
+    EXPECT_EQ(createCount, 1);
+}
+
+/**
+ * @tc.number: ResourceManagerCache_0500
+ * @tc.name: ResourceManagerCache
+ * @tc.desc: 1. the creator fails
+ *           2. verify nullptr is returned and nothing is cached
+ */
+HWTEST_F(BmsDataMgrTest, ResourceManagerCache_0500, Function | SmallTest | Level0)
+{
+    ResourceManagerCache cache;
+    auto resourceManager = cache.GetResourceManager(GetResourceBundleInfo(BUNDLE_NAME), LOCALE, [] {
+        return std::shared_ptr<OHOS::Global::Resource::ResourceManager>();
+    });
+    EXPECT_EQ(resourceManager, nullptr);
+
+    int32_t createCount = 0;
+    EXPECT_NE(GetCachedResourceManager(cache, BUNDLE_NAME, createCount), nullptr);
+    EXPECT_EQ(createCount, 1);
+}
+#endif
@@ -14,8 +14,12 @@
  */
 
 #include <gtest/gtest.h>
+#include <map>
 
 #include "bundle_info.h"
+#define private public
+#include "distributed_data_storage.h"
+#undef private
 #include "bundle_installer_host.h"
 #include "bundle_mgr_service.h"
 #include "install_param.h"
@@ -42,6 +46,57 @@ constexpr int32_t USER_ID {100};
 constexpr int32_t USER_ID_INVALID {1000};
 std::string APP_ID {"com.ohos.distributedmusicplayer_1234567890123"};
 std::string NETWORK_ID_INVALID {"ffea7058b8cfcb4b74628faeaa7063ac3f1a337294176202b54311540072db42"};
+const std::string BUNDULE_NAME_THIRD {"bunduleName3"};
+const std::string LOCAL_UDID {"ffea7058b8cfcb4b74628faeaa7063ac3f1a337294176202b54311540072db43"};
+constexpr uint32_t VERSION_CODE_UPDATED {11};
+constexpr size_t RECORD_COUNT_ONE {1};
+constexpr size_t RECORD_COUNT_TWO {2};
+
+// stands in for the kvStore of the distributed bundle infos, it keeps the records in memory and counts the
+// batch writes the same way BatchUpdate issues them
+class CountingKvStore {
+public:
+    void WriteBatch(const std::vector<Entry> &changedEntries, const std::vector<Key> &removedKeys)
+    {
+        if (!removedKeys.empty()) {
+            deleteBatchCount++;
+            for (const auto &key : removedKeys) {
+                records.erase(key.ToString());
+            }
+        }
+        if (!changedEntries.empty()) {
+            putBatchCount++;
+            for (const auto &entry : changedEntries) {
+                records[entry.key.ToString()] = entry.value.ToString();
+                putCount++;
+            }
+        }
+    }
+
+    std::vector<Entry> GetEntries() const
+    {
+        std::vector<Entry> entries;
+        for (const auto &record : records) {
+            Entry entry;
+            entry.key = Key(record.first);
+            entry.value = Value(record.second);
+            entries.emplace_back(entry);
+        }
+        return entries;
+    }
+
+    void ResetCount()
+    {
+        putBatchCount = 0;
+        deleteBatchCount = 0;
+        putCount = 0;
+    }
+
+    std::map<std::string, std::string> records;
+    int32_t putBatchCount = 0;
+    int32_t deleteBatchCount = 0;
+    int32_t putCount = 0;
+};
 }
 
 class BmsDistributedDataStorageTest : public testing::Test {
@@ -54,6 +109,7 @@ public:
     void TearDown();
     const std::shared_ptr<DistributedDataStorage> GetDistributedDataStorage() const;
     BundleInfo MockBundleInfo(const std::string &bundleName) const;
+    void UpdateDistributedData(CountingKvStore &kvStore, const std::vector<BundleInfo> &bundleInfos) const;
 
 private:
     std::shared_ptr<DistributedDataStorage> distributedDataStorage_ = DistributedDataStorage::GetInstance();
@@ -101,6 +157,16 @@ BundleInfo BmsDistributedDataStorageTest::MockBundleInfo(const std::string &bund
     return bundleInfo;
 }
 
+void BmsDistributedDataStorageTest::UpdateDistributedData(
+    CountingKvStore &kvStore, const std::vector<BundleInfo> &bundleInfos) const
+{
+    std::vector<Entry> changedEntries;
+    std::vector<Key> removedKeys;
+    GetDistributedDataStorage()->CollectChangedData(
+        LOCAL_UDID, bundleInfos, kvStore.GetEntries(), changedEntries, removedKeys);
+    kvStore.WriteBatch(changedEntries, removedKeys);
+}
+
 /**
  * @tc.number: SaveStorageDistributeInfo_0100
  * @tc.name: test bundle DistributedBundleInfo can be save success
@@ -233,4 +299,95 @@ HWTEST_F(BmsDistributedDataStorageTest, QueryStroageDistributeInfo_0500, Functio
 
     result = dataStorage->DeleteStorageDistributeInfo(BUNDULE_NAME_FIRST);
     EXPECT_TRUE(result);
-}
\ No newline at end of file
+}
+
+/**
+ * @tc.number: UpdateDistributedData_0100
+ * @tc.name: test the unchanged DistributedBundleInfos are not written again
+ * @tc.desc: 1.update the distributed data of two bundles
+ *           2.update the distributed data with the same bundles
+ *           3.verify nothing is written by the second update
+ */
+HWTEST_F(BmsDistributedDataStorageTest, UpdateDistributedData_0100, Function | SmallTest | Level0)
+{
+    std::vector<BundleInfo> bundleInfos = { MockBundleInfo(BUNDULE_NAME_FIRST), MockBundleInfo(BUNDULE_NAME_SECOND) };
+    CountingKvStore kvStore;
+    UpdateDistributedData(kvStore, bundleInfos);
+    EXPECT_EQ(kvStore.putBatchCount, 1);
+    EXPECT_EQ(kvStore.putCount, 2);
+    EXPECT_EQ(kvStore.records.size(), RECORD_COUNT_TWO);
+
+    kvStore.ResetCount();
+    UpdateDistributedData(kvStore, bundleInfos);
+    EXPECT_EQ(kvStore.putBatchCount, 0);
+    EXPECT_EQ(kvStore.deleteBatchCount, 0);
+    EXPECT_EQ(kvStore.records.size(), RECORD_COUNT_TWO);
+}
+
+/**
+ * @tc.number: UpdateDistributedData_0200
+ * @tc.name: test the changed DistributedBundleInfos are written in one batch
+ * @tc.desc: 1.update the distributed data of three bundles
+ *           2.update two of the bundles and add the distributed data again
+ *           3.verify only the two changed bundles are written, by one batch
+ */
+HWTEST_F(BmsDistributedDataStorageTest, UpdateDistributedData_0200, Function | SmallTest | Level0)
+{
+    std::vector<BundleInfo> bundleInfos = { MockBundleInfo(BUNDULE_NAME_FIRST), MockBundleInfo(BUNDULE_NAME_SECOND),
+        MockBundleInfo(BUNDULE_NAME_THIRD) };
+    CountingKvStore kvStore;
+    UpdateDistributedData(kvStore, bundleInfos);
+
+    kvStore.ResetCount();
+    bundleInfos[0].versionCode = VERSION_CODE_UPDATED;
+    bundleInfos[2].versionCode = VERSION_CODE_UPDATED;
+    UpdateDistributedData(kvStore, bundleInfos);
+    EXPECT_EQ(kvStore.putBatchCount, 1);
+    EXPECT_EQ(kvStore.putCount, 2);
+    EXPECT_EQ(kvStore.deleteBatchCount, 0);
+
+    std::string key;
+    GetDistributedDataStorage()->DeviceAndNameToKey(LOCAL_UDID, BUNDULE_NAME_THIRD, key);
+    DistributedBundleInfo distributedBundleInfo;
+    EXPECT_TRUE(distributedBundleInfo.FromJsonString(kvStore.records[key]));
+    EXPECT_EQ(distributedBundleInfo.versionCode, VERSION_CODE_UPDATED);
+}
+
+/**
+ * @tc.number: UpdateDistributedData_0300
+ * @tc.name: test the DistributedBundleInfos of the removed bundles are deleted in one batch
+ * @tc.desc: 1.update the distributed data of three bundles
+ *           2.update the distributed data with one bundle only
+ *           3.verify the other two are deleted by one batch and nothing is put
+ */
+HWTEST_F(BmsDistributedDataStorageTest, UpdateDistributedData_0300, Function | SmallTest | Level0)
+{
+    std::vector<BundleInfo> bundleInfos = { MockBundleInfo(BUNDULE_NAME_FIRST), MockBundleInfo(BUNDULE_NAME_SECOND),
+        MockBundleInfo(BUNDULE_NAME_THIRD) };
+    CountingKvStore kvStore;
+    UpdateDistributedData(kvStore, bundleInfos);
+
+    kvStore.ResetCount();
+    bundleInfos.resize(1);
+    UpdateDistributedData(kvStore, bundleInfos);
+    EXPECT_EQ(kvStore.putBatchCount, 0);
+    EXPECT_EQ(kvStore.deleteBatchCount, 1);
+    EXPECT_EQ(kvStore.records.size(), RECORD_COUNT_ONE);
+}
+
+/**
+ * @tc.number: UpdateDistributedData_0400
+ * @tc.name: test the singleton bundles are not written
+ * @tc.desc: 1.update the distributed data of a singleton bundle and a normal one
+ *           2.verify only the normal bundle is written
+ */
+HWTEST_F(BmsDistributedDataStorageTest, UpdateDistributedData_0400, Function | SmallTest | Level0)
+{
+    std::vector<BundleInfo> bundleInfos = { MockBundleInfo(BUNDULE_NAME_FIRST), MockBundleInfo(BUNDULE_NAME_SECOND) };
+    bundleInfos[0].singleton = true;
+    CountingKvStore kvStore;
+    UpdateDistributedData(kvStore, bundleInfos);
+    EXPECT_EQ(kvStore.putBatchCount, 1);
+    EXPECT_EQ(kvStore.putCount, 1);
+    EXPECT_EQ(kvStore.records.size(), RECORD_COUNT_ONE);
+}
@@ -14,11 +14,14 @@
  */
 
 #include <cstdio>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include "bundle_constants.h"
 #include "directory_ex.h"
+#include "installd/installd_operator.h"
 #include "installd/installd_service.h"
 #include "installd_client.h"
 
@@ -41,12 +44,34 @@ const std::string BUNDLE_EL2_BASE_DIR = "/data/app/el2/101/base/com.example.l4js
 const std::string BUNDLE_EL3_BASE_DIR = "/data/app/el3/101/base/com.example.l4jsdemo/temp";
 const std::string BUNDLE_EL4_BASE_DIR = "/data/app/el4/101/base/com.example.l4jsdemo/temp";
 const std::string BUNDLE_NAME = "com.example.l4jsdemo";
+const std::string BUNDLE_DATA_DIR_2 = "/data/app/el2/100/base/com.example.l4jsdemo";
 const int32_t ROOT_UID = 0;
 const int32_t USERID = 100;
 const int32_t UID = 1000;
 const int32_t GID = 1000;
 const std::string APL = "normal";
 const int32_t USERID_2 = 101;
+const std::string BUNDLE_CODE_TRASH_DIR = "/data/app/el1/.installd_trash";
+const int32_t TRASH_FILE_COUNT = 100;
+const int32_t REAP_WAIT_TIMES = 50;
+const int32_t REAP_WAIT_INTERVAL_US = 100 * 1000;
+const std::string DISK_USAGE_DIR = "/data/test/installd_disk_usage";
+const std::string DISK_USAGE_FILE = "/data/test/installd_disk_usage/file";
+const std::string DISK_USAGE_SUB_DIR = "/data/test/installd_disk_usage/sub";
+const std::string DISK_USAGE_SUB_FILE = "/data/test/installd_disk_usage/sub/file";
+const std::string DISK_USAGE_CACHE_DIR = "/data/test/installd_disk_usage/cache";
+const std::string DISK_USAGE_CACHE_FILE = "/data/test/installd_disk_usage/cache/file";
+const std::string DISK_USAGE_NESTED_CACHE_DIR = "/data/test/installd_disk_usage/sub/cache";
+const std::string DISK_USAGE_NESTED_CACHE_FILE = "/data/test/installd_disk_usage/sub/cache/file";
+const size_t DISK_USAGE_FILE_SIZE = 8192;
+const int64_t STAT_BLOCK_SIZE = 512;
+const std::string MODULE_MARK_FILE = "/data/app/el1/bundle/public/com.example.l3jsdemo/com.example.l3jsdemo/mark";
+const std::string MODULE_BACKUP_DIR =
+    "/data/app/el1/bundle/public/com.example.l3jsdemo/com.example.l3jsdemo.batch_bak0";
+const std::string ORPHAN_MODULE_BACKUP_DIR =
+    "/data/app/el1/bundle/public/com.example.l3jsdemo/com.example.l3jsdemo.batch_bak3";
+const std::string ORPHAN_TEMP_BACKUP_DIR = "/data/app/el1/bundle/public/com.example.l3jsdemo/temp.batch_bak1";
+const std::string ORPHAN_STREAM_FILE = "/data/sadata/install_tmp/stream_install/0.hap";
 }  // namespace
 
 class BmsInstallDaemonTest : public testing::Test {
@@ -70,6 +95,10 @@ public:
     bool CheckBundleDirExist() const;
     bool CheckBundleDataDirExist() const;
     bool GetBundleStats(const std::string &bundleName, const int32_t userId, std::vector<int64_t> &bundleStats) const;
+    int ExecuteBatch(const std::vector<InstalldOperation> &operations) const;
+    int CreateBundleDataDirs(const std::vector<InstalldOperation> &operations, std::vector<ErrCode> &results) const;
+    void CreateDiskUsageFile(const std::string &filePath) const;
+    int64_t GetAllocatedSize(const std::string &path) const;
 
 private:
     std::shared_ptr<InstalldService> service_ = std::make_shared<InstalldService>();
@@ -171,6 +200,23 @@ int BmsInstallDaemonTest::RenameModuleDir(const std::string &oldPath, const std:
     return InstalldClient::GetInstance()->RenameModuleDir(oldPath, newPath);
 }
 
+int BmsInstallDaemonTest::ExecuteBatch(const std::vector<InstalldOperation> &operations) const
+{
+    if (!service_->IsServiceReady()) {
+        service_->Start();
+    }
+    return InstalldClient::GetInstance()->ExecuteBatch(operations);
+}
+
+int BmsInstallDaemonTest::CreateBundleDataDirs(
+    const std::vector<InstalldOperation> &operations, std::vector<ErrCode> &results) const
+{
+    if (!service_->IsServiceReady()) {
+        service_->Start();
+    }
+    return InstalldClient::GetInstance()->CreateBundleDataDirs(operations, results);
+}
+
 bool BmsInstallDaemonTest::CheckBundleDirExist() const
 {
     int bundleCodeExist = access(BUNDLE_CODE_DIR.c_str(), F_OK);
@@ -201,6 +247,22 @@ bool BmsInstallDaemonTest::GetBundleStats(const std::string &bundleName, const i
     return false;
 }
 
+void BmsInstallDaemonTest::CreateDiskUsageFile(const std::string &filePath) const
+{
+    std::ofstream file(filePath, std::ios::binary);
+    std::string content(DISK_USAGE_FILE_SIZE, 'a');
+    file.write(content.data(), content.size());
+}
+
+int64_t BmsInstallDaemonTest::GetAllocatedSize(const std::string &path) const
+{
+    struct stat fileInfo = {};
+    if (lstat(path.c_str(), &fileInfo) != 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(fileInfo.st_blocks) * STAT_BLOCK_SIZE;
+}
+
 /**
  * @tc.number: Startup_0100
  * @tc.name: test the start function of the installd service when service is not ready
@@ -652,4 +714,223 @@ HWTEST_F(BmsInstallDaemonTest, GetBundleStats_0400, Function | SmallTest | Level
     OHOS::ForceRemoveDirectory(BUNDLE_EL3_BASE_DIR);
     OHOS::ForceRemoveDirectory(BUNDLE_EL4_BASE_DIR);
 }
+
+/**
+ * @tc.number: RemoveDir_0100
+ * @tc.name: test the RemoveDir function of installd service
+ * @tc.desc: 1. the code dir is moved to the trash and disappears at once
+ *           2. the trash is reaped in the background
+ * @tc.require: AR000GJ4KK
+*/
+HWTEST_F(BmsInstallDaemonTest, RemoveDir_0100, Function | SmallTest | Level0)
+{
+    int result = CreateBundleDir(BUNDLE_CODE_DIR);
+    EXPECT_EQ(result, 0);
+    for (int32_t i = 0; i < TRASH_FILE_COUNT; i++) {
+        std::ofstream file(BUNDLE_CODE_DIR + "/file" + std::to_string(i));
+        file << i;
+    }
+    result = RemoveBundleDir(BUNDLE_CODE_DIR);
+    EXPECT_EQ(result, 0);
+    EXPECT_FALSE(CheckBundleDirExist());
+    bool isReaped = false;
+    for (int32_t i = 0; i < REAP_WAIT_TIMES && !isReaped; i++) {
+        isReaped = OHOS::IsEmptyFolder(BUNDLE_CODE_TRASH_DIR);
+        if (!isReaped) {
+            usleep(REAP_WAIT_INTERVAL_US);
+        }
+    }
+    EXPECT_TRUE(isReaped);
+}
+
+/**
+ * @tc.number: ExecuteBatch_0100
+ * @tc.name: test the ExecuteBatch function of installd service
+ * @tc.desc: 1. the code dir and the data dir are created in one batch
+ * @tc.require: AR000GJ4KK
+*/
+HWTEST_F(BmsInstallDaemonTest, ExecuteBatch_0100, Function | SmallTest | Level0)
+{
+    std::vector<InstalldOperation> operations = {
+        InstalldOperation::CreateBundleDir(BUNDLE_CODE_DIR),
+        InstalldOperation::CreateBundleDataDir(BUNDLE_NAME13, USERID, UID, GID, APL),
+    };
+    int result = ExecuteBatch(operations);
+    EXPECT_EQ(result, 0);
+    EXPECT_TRUE(CheckBundleDirExist());
+    EXPECT_TRUE(CheckBundleDataDirExist());
+}
+
+/**
+ * @tc.number: ExecuteBatch_0200
+ * @tc.name: test the ExecuteBatch function of installd service
+ * @tc.desc: 1. the batch fails at the last operation
+ *           2. the dirs created by the former operations are rolled back
+ * @tc.require: AR000GJ4KK
+*/
+HWTEST_F(BmsInstallDaemonTest, ExecuteBatch_0200, Function | SmallTest | Level0)
+{
+    std::vector<InstalldOperation> operations = {
+        InstalldOperation::CreateBundleDir(BUNDLE_CODE_DIR),
+        InstalldOperation::CreateBundleDataDir(BUNDLE_NAME13, USERID, UID, GID, APL),
+        InstalldOperation::RenameModuleDir("", MODULE_DIR),
+    };
+    int result = ExecuteBatch(operations);
+    EXPECT_NE(result, 0);
+    EXPECT_FALSE(CheckBundleDirExist());
+    EXPECT_FALSE(CheckBundleDataDirExist());
+}
+
+/**
+ * @tc.number: ExecuteBatch_0300
+ * @tc.name: test the ExecuteBatch function of installd service
+ * @tc.desc: 1. the batch is empty
+ * @tc.require: AR000GJ4KK
+*/
+HWTEST_F(BmsInstallDaemonTest, ExecuteBatch_0300, Function | SmallTest | Level0)
+{
+    std::vector<InstalldOperation> operations;
+    int result = ExecuteBatch(operations);
+    EXPECT_EQ(result, ERR_APPEXECFWK_INSTALLD_PARAM_ERROR);
+}
+
+/**
+ * @tc.number: ExecuteBatch_0400
+ * @tc.name: test the ExecuteBatch function of installd service
+ * @tc.desc: 1. the module dir is replaced by the renamed one and the next operation fails
+ *           2. the previous module dir and the renamed one are restored, no backup is left
+ * @tc.require: AR000GJ4KK
+*/
+HWTEST_F(BmsInstallDaemonTest, ExecuteBatch_0400, Function | SmallTest | Level0)
+{
+    OHOS::ForceCreateDirectory(TEMP_DIR);
+    OHOS::ForceCreateDirectory(MODULE_DIR);
+    std::ofstream(MODULE_MARK_FILE).close();
+    std::vector<InstalldOperation> operations = {
+        InstalldOperation::RenameModuleDir(TEMP_DIR, MODULE_DIR),
+        InstalldOperation::RemoveDir(""),
+    };
+    int result = ExecuteBatch(operations);
+    EXPECT_NE(result, 0);
+    EXPECT_EQ(access(MODULE_MARK_FILE.c_str(), F_OK), 0);
+    EXPECT_EQ(access(TEMP_DIR.c_str(), F_OK), 0);
+    EXPECT_NE(access(MODULE_BACKUP_DIR.c_str(), F_OK), 0);
+    OHOS::ForceRemoveDirectory(BUNDLE_CODE_DIR);
+}
+
+/**
+ * @tc.number: RecoverBatchBackups_0100
+ * @tc.name: test the backups left by an interrupted batch when installd starts
+ * @tc.desc: 1. the backup of a missing module dir is restored
+ *           2. the backup of an existing dir is removed
+ * @tc.require: AR000GJ4KK
+*/
+HWTEST_F(BmsInstallDaemonTest, RecoverBatchBackups_0100, Function | SmallTest | Level0)
+{
+    OHOS::ForceRemoveDirectory(MODULE_DIR);
+    OHOS::ForceCreateDirectory(ORPHAN_MODULE_BACKUP_DIR);
+    OHOS::ForceCreateDirectory(TEMP_DIR);
+    OHOS::ForceCreateDirectory(ORPHAN_TEMP_BACKUP_DIR);
+    std::shared_ptr<InstalldService> installdService = std::make_shared<InstalldService>();
+    installdService->Start();
+    EXPECT_TRUE(installdService->IsServiceReady());
+    EXPECT_EQ(access(MODULE_DIR.c_str(), F_OK), 0);
+    EXPECT_NE(access(ORPHAN_MODULE_BACKUP_DIR.c_str(), F_OK), 0);
+    EXPECT_EQ(access(TEMP_DIR.c_str(), F_OK), 0);
+    EXPECT_NE(access(ORPHAN_TEMP_BACKUP_DIR.c_str(), F_OK), 0);
+    installdService->Stop();
+    OHOS::ForceRemoveDirectory(BUNDLE_CODE_DIR);
+}
+
+/**
+ * @tc.number: ClearStreamInstallPath_0100
+ * @tc.name: test the haps left by the stream installs of the last run when installd starts
+ * @tc.desc: 1. a hap is left in the stream install path
+ *           2. the hap is removed and the stream install path is kept
+ * @tc.require: AR000GJ4KK
+*/
+HWTEST_F(BmsInstallDaemonTest, ClearStreamInstallPath_0100, Function | SmallTest | Level0)
+{
+    OHOS::ForceCreateDirectory(Constants::STREAM_INSTALL_PATH);
+    std::ofstream orphanFile(ORPHAN_STREAM_FILE);
+    orphanFile << BUNDLE_NAME13;
+    orphanFile.close();
+    ASSERT_EQ(access(ORPHAN_STREAM_FILE.c_str(), F_OK), 0);
+    std::shared_ptr<InstalldService> installdService = std::make_shared<InstalldService>();
+    installdService->Start();
+    EXPECT_TRUE(installdService->IsServiceReady());
+    EXPECT_NE(access(ORPHAN_STREAM_FILE.c_str(), F_OK), 0);
+    EXPECT_EQ(access(Constants::STREAM_INSTALL_PATH.c_str(), F_OK), 0);
+    installdService->Stop();
+}
+
+/**
+ * @tc.number: CreateBundleDataDirs_0100
+ * @tc.name: test the CreateBundleDataDirs function of installd service
+ * @tc.desc: 1. the data dirs of two bundles are created, the operation with invalid param fails
+ *           2. the failed operation does not stop the others
+ * @tc.require: AR000GJ4KK
+*/
+HWTEST_F(BmsInstallDaemonTest, CreateBundleDataDirs_0100, Function | SmallTest | Level0)
+{
+    std::vector<InstalldOperation> operations = {
+        InstalldOperation::CreateBundleDataDir(BUNDLE_NAME13, USERID, UID, GID, APL),
+        InstalldOperation::CreateBundleDataDir("", USERID, UID, GID, APL),
+        InstalldOperation::CreateBundleDataDir(BUNDLE_NAME, USERID, UID, GID, APL),
+    };
+    std::vector<ErrCode> results;
+    int result = CreateBundleDataDirs(operations, results);
+    EXPECT_EQ(result, 0);
+    ASSERT_EQ(results.size(), operations.size());
+    EXPECT_EQ(results[0], ERR_OK);
+    EXPECT_EQ(results[1], ERR_APPEXECFWK_INSTALLD_PARAM_ERROR);
+    EXPECT_EQ(results[2], ERR_OK);
+    EXPECT_TRUE(CheckBundleDataDirExist());
+    EXPECT_EQ(access(BUNDLE_DATA_DIR_2.c_str(), F_OK), 0);
+    OHOS::ForceRemoveDirectory(BUNDLE_DATA_DIR_2);
+}
+
+/**
+ * @tc.number: GetDiskUsageWithCache_0100
+ * @tc.name: test the GetDiskUsageWithCache function of InstalldOperator
+ * @tc.desc: 1. a small tree with a cache dir at the top and a nested one
+ *           2. the total is the allocated size of every entry, the cache size is that of the files in cache dirs
+ * @tc.require: AR000GK0AH
+*/
+HWTEST_F(BmsInstallDaemonTest, GetDiskUsageWithCache_0100, Function | SmallTest | Level0)
+{
+    OHOS::ForceCreateDirectory(DISK_USAGE_CACHE_DIR);
+    OHOS::ForceCreateDirectory(DISK_USAGE_NESTED_CACHE_DIR);
+    CreateDiskUsageFile(DISK_USAGE_FILE);
+    CreateDiskUsageFile(DISK_USAGE_SUB_FILE);
+    CreateDiskUsageFile(DISK_USAGE_CACHE_FILE);
+    CreateDiskUsageFile(DISK_USAGE_NESTED_CACHE_FILE);
+
+    int64_t cacheSize = GetAllocatedSize(DISK_USAGE_CACHE_FILE) + GetAllocatedSize(DISK_USAGE_NESTED_CACHE_FILE);
+    int64_t totalSize = cacheSize + GetAllocatedSize(DISK_USAGE_FILE) + GetAllocatedSize(DISK_USAGE_SUB_FILE) +
+        GetAllocatedSize(DISK_USAGE_SUB_DIR) + GetAllocatedSize(DISK_USAGE_CACHE_DIR) +
+        GetAllocatedSize(DISK_USAGE_NESTED_CACHE_DIR);
+    EXPECT_GE(cacheSize, static_cast<int64_t>(DISK_USAGE_FILE_SIZE * 2));
+
+    int64_t usageCacheSize = -1;
+    EXPECT_EQ(InstalldOperator::GetDiskUsageWithCache(DISK_USAGE_DIR, usageCacheSize), totalSize);
+    EXPECT_EQ(usageCacheSize, cacheSize);
+    EXPECT_EQ(InstalldOperator::GetDiskUsage(DISK_USAGE_DIR), totalSize);
+    OHOS::ForceRemoveDirectory(DISK_USAGE_DIR);
+}
+
+/**
+ * @tc.number: GetDiskUsageWithCache_0200
+ * @tc.name: test the GetDiskUsageWithCache function of InstalldOperator
+ * @tc.desc: 1. the dir does not exist
+ *           2. both the total and the cache size are 0
+ * @tc.require: AR000GK0AH
+*/
+HWTEST_F(BmsInstallDaemonTest, GetDiskUsageWithCache_0200, Function | SmallTest | Level0)
+{
+    OHOS::ForceRemoveDirectory(DISK_USAGE_DIR);
+    int64_t cacheSize = -1;
+    EXPECT_EQ(InstalldOperator::GetDiskUsageWithCache(DISK_USAGE_DIR, cacheSize), 0);
+    EXPECT_EQ(cacheSize, 0);
+}
 } // OHOS
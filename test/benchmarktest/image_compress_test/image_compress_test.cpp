@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "image_compress.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+
+using namespace std;
+using namespace OHOS;
+using namespace OHOS::AppExecFwk;
+
+namespace {
+    const uint32_t ICON_SIZE = 512;
+    const int32_t RGBA_COMPONENTS = 4;
+    const int32_t RGB_COMPONENTS = 3;
+    const double QUARTER_RATIO = 0.25;
+    const uint32_t PIXEL_STEP = 7;
+
+    std::shared_ptr<ImageBuffer> CreateIcon(int32_t components)
+    {
+        std::shared_ptr<ImageBuffer> imageBuffer = std::make_shared<ImageBuffer>();
+        imageBuffer->SetWidth(ICON_SIZE);
+        imageBuffer->SetHeight(ICON_SIZE);
+        imageBuffer->SetComponents(components);
+        imageBuffer->MallocImageMap(components);
+        ImageRow data = imageBuffer->GetImageDataPointer().get();
+        size_t size = static_cast<size_t>(ICON_SIZE) * ICON_SIZE * components;
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<ImageData>(i * PIXEL_STEP);
+        }
+        return imageBuffer;
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForResizeRGBAIcon
+     * @tc.desc: Testcase for testing 'ResizeImage' function with a 512x512 RGBA icon.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForResizeRGBAIcon(benchmark::State &state)
+    {
+        ImageCompress imageCompress;
+        std::shared_ptr<ImageBuffer> imageBufferIn = CreateIcon(RGBA_COMPONENTS);
+        for (auto _ : state) {
+            /* @tc.steps: step1.call ResizeImage in loop */
+            std::shared_ptr<ImageBuffer> imageBufferOut = std::make_shared<ImageBuffer>();
+            imageCompress.ResizeImage(imageBufferIn, imageBufferOut, QUARTER_RATIO);
+        }
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForResizeRGBIcon
+     * @tc.desc: Testcase for testing 'ResizeImage' function with a 512x512 RGB icon.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForResizeRGBIcon(benchmark::State &state)
+    {
+        ImageCompress imageCompress;
+        std::shared_ptr<ImageBuffer> imageBufferIn = CreateIcon(RGB_COMPONENTS);
+        for (auto _ : state) {
+            /* @tc.steps: step1.call ResizeImage in loop */
+            std::shared_ptr<ImageBuffer> imageBufferOut = std::make_shared<ImageBuffer>();
+            imageCompress.ResizeImage(imageBufferIn, imageBufferOut, QUARTER_RATIO);
+        }
+    }
+
+    BENCHMARK(BenchmarkTestForResizeRGBAIcon)->Iterations(1000);
+    BENCHMARK(BenchmarkTestForResizeRGBIcon)->Iterations(1000);
+}
+
+BENCHMARK_MAIN();
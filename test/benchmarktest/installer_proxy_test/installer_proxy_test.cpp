@@ -14,7 +14,15 @@
  */
 
 #include <benchmark/benchmark.h>
-
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "appexecfwk_errors.h"
 #include "bundle_constants.h"
 #include "bundle_installer_interface.h"
 #include "bundle_mgr_interface.h"
@@ -27,6 +35,13 @@ using namespace OHOS;
 using namespace OHOS::AppExecFwk;
 namespace {
 const std::string THIRD_BUNDLE_PATH = "/data/test/benchmark/";
+const std::string MULTIPLE_BUNDLE_PATH = "/data/test/benchmark/multiple/";
+const std::string MULTIPLE_BUNDLE_NAME = "com.example.l3jsdemo";
+const std::string ENTRY_BUNDLE_FILE = "entry.hap";
+const std::vector<std::string> FEATURE_BUNDLE_FILES = { "feature1.hap", "feature2.hap" };
+const std::string FEATURE_BUNDLE_PREFIX = "feature";
+const std::string INSTALL_FILE_SUFFIX = ".hap";
+const int32_t INSTALL_TIMEOUT_SECONDS = 60;
 
 class InstallerProxyTest : public StatusReceiverHost {
 public:
@@ -34,6 +49,13 @@ public:
     virtual ~InstallerProxyTest() override;
     virtual void OnStatusNotify(const int progress) override;
     virtual void OnFinished(const int32_t resultCode, const std::string &resultMsg) override;
+    int32_t WaitForFinished();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable finishedCondition_;
+    bool isFinished_ = false;
+    int32_t resultCode_ = ERR_OK;
 };
 
 InstallerProxyTest::InstallerProxyTest()
@@ -46,7 +68,23 @@ void InstallerProxyTest::OnStatusNotify(const int progress)
 {}
 
 void InstallerProxyTest::OnFinished(const int32_t resultCode, const std::string &resultMsg)
-{}
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isFinished_ = true;
+    resultCode_ = resultCode;
+    finishedCondition_.notify_all();
+}
+
+int32_t InstallerProxyTest::WaitForFinished()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!finishedCondition_.wait_for(lock, std::chrono::seconds(INSTALL_TIMEOUT_SECONDS),
+        [this] { return isFinished_; })) {
+        return ERR_APPEXECFWK_OPERATION_TIME_OUT;
+    }
+    isFinished_ = false;
+    return resultCode_;
+}
 
 sptr<IBundleMgr> GetBundleMgrProxy()
 {
@@ -79,6 +117,50 @@ sptr<IBundleInstaller> GetInstallerProxy()
     return installerProxy;
 }
 
+void RemoveMultipleHaps(const std::vector<std::string> &bundleFilePaths)
+{
+    for (const auto &bundleFilePath : bundleFilePaths) {
+        if (bundleFilePath.compare(0, MULTIPLE_BUNDLE_PATH.size(), MULTIPLE_BUNDLE_PATH) == 0) {
+            remove(bundleFilePath.c_str());
+        }
+    }
+    rmdir(MULTIPLE_BUNDLE_PATH.c_str());
+}
+
+/**
+ * @brief Prepare the haps of one installation, the entry hap and hapCount - 1 feature haps.
+ *        The feature haps are copied under different names, so every hap of the installation is a separate file.
+ */
+bool PrepareMultipleHaps(size_t hapCount, std::vector<std::string> &bundleFilePaths)
+{
+    bundleFilePaths.emplace_back(THIRD_BUNDLE_PATH + ENTRY_BUNDLE_FILE);
+    if (hapCount <= 1) {
+        return true;
+    }
+    if (mkdir(MULTIPLE_BUNDLE_PATH.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) != 0 && errno != EEXIST) {
+        return false;
+    }
+    for (size_t i = 1; i < hapCount; ++i) {
+        std::string sourcePath = THIRD_BUNDLE_PATH + FEATURE_BUNDLE_FILES[(i - 1) % FEATURE_BUNDLE_FILES.size()];
+        std::string targetPath = MULTIPLE_BUNDLE_PATH + FEATURE_BUNDLE_PREFIX + std::to_string(i) + INSTALL_FILE_SUFFIX;
+        std::ifstream source(sourcePath, std::ios::binary);
+        std::ofstream target(targetPath, std::ios::binary | std::ios::trunc);
+        bundleFilePaths.emplace_back(targetPath);
+        if (!source.is_open() || !target.is_open() || !(target << source.rdbuf())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void UninstallMultipleBundle(const sptr<IBundleInstaller> &installerProxy, const InstallParam &installParam,
+    const sptr<InstallerProxyTest> &statusReceiver)
+{
+    if (installerProxy->Uninstall(MULTIPLE_BUNDLE_NAME, installParam, statusReceiver)) {
+        statusReceiver->WaitForFinished();
+    }
+}
+
 /**
  * @tc.name: BenchmarkTestInstallerProxyInfo
  * @tc.desc: Testcase for testing Installs an application through the proxy object.
@@ -100,8 +182,9 @@ static void BenchmarkTestInstallerProxyInfo(benchmark::State &state)
 }
 
 /**
- * @tc.name: BenchmarkTestInstallerProxyInfo
- * @tc.desc: Testcase for testing Installs multiple haps.
+ * @tc.name: BenchmarkTestMultipleInstallerProxyInfo
+ * @tc.desc: Testcase for testing Installs an entry hap and state.range(0) - 1 feature haps of a bundle at once,
+ *           every iteration waits for the installation to finish.
  * @tc.type: FUNC
  * @tc.require: Issue Number
  */
@@ -109,16 +192,32 @@ static void BenchmarkTestInstallerProxyInfo(benchmark::State &state)
 static void BenchmarkTestMultipleInstallerProxyInfo(benchmark::State &state)
 {
     sptr<IBundleInstaller> installerProxy = GetInstallerProxy();
+    sptr<InstallerProxyTest> statusReceiver(new (std::nothrow) InstallerProxyTest());
+    if (!installerProxy || !statusReceiver) {
+        state.SkipWithError("failed to get the installer proxy");
+        return;
+    }
     std::vector<std::string> bundleFilePaths;
-    std::string bundleFilePath = THIRD_BUNDLE_PATH + "test.hap";
-    bundleFilePaths.push_back(bundleFilePath);
+    if (!PrepareMultipleHaps(static_cast<size_t>(state.range(0)), bundleFilePaths)) {
+        RemoveMultipleHaps(bundleFilePaths);
+        state.SkipWithError("failed to prepare the haps");
+        return;
+    }
     InstallParam installParam;
     installParam.installFlag = InstallFlag::REPLACE_EXISTING;
-    sptr<InstallerProxyTest> statusReceiver(new (std::nothrow) InstallerProxyTest());
+    installParam.userId = Constants::DEFAULT_USERID;
+    // test.hap installed by the other benchmarks has the same bundle name but another signature
+    UninstallMultipleBundle(installerProxy, installParam, statusReceiver);
     for (auto _ : state) {
-        /* @tc.steps: step1.call ReadFromParcel in loop */
-        installerProxy->Install(bundleFilePaths, installParam, statusReceiver);
+        /* @tc.steps: step1.call Install in loop and wait for the result */
+        if (!installerProxy->Install(bundleFilePaths, installParam, statusReceiver) ||
+            statusReceiver->WaitForFinished() != ERR_OK) {
+            state.SkipWithError("failed to install the haps");
+            break;
+        }
     }
+    UninstallMultipleBundle(installerProxy, installParam, statusReceiver);
+    RemoveMultipleHaps(bundleFilePaths);
 }
 
 /**
@@ -145,7 +244,7 @@ static void BenchmarkTestUninstallerApplication(benchmark::State &state)
 }
 
 BENCHMARK(BenchmarkTestInstallerProxyInfo)->Iterations(1000);
-BENCHMARK(BenchmarkTestMultipleInstallerProxyInfo)->Iterations(1000);
+BENCHMARK(BenchmarkTestMultipleInstallerProxyInfo)->Arg(1)->Arg(4)->Arg(10)->Iterations(100);
 BENCHMARK(BenchmarkTestUninstallerApplication)->Iterations(1000);
 }  // namespace
 
@@ -214,6 +214,45 @@ namespace {
         }
     }
 
+    /**
+     * @tc.name: BenchmarkTestForGetLauncherAbilitySnapshot
+     * @tc.desc: Testcase for testing 'GetLauncherAbilitySnapshot' function.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForGetLauncherAbilitySnapshot(benchmark::State &state)
+    {
+        LauncherService launcherservice;
+        int32_t userId = 100;
+        uint64_t version = 0;
+        std::vector<LauncherAbilityInfo> launcherAbilityInfos;
+        for (auto _ : state) {
+            /* @tc.steps: step1.call GetLauncherAbilitySnapshot in loop */
+            launcherAbilityInfos.clear();
+            launcherservice.GetLauncherAbilitySnapshot(userId, version, launcherAbilityInfos);
+        }
+    }
+
+    /**
+     * @tc.name: BenchmarkTestForGetLauncherAbilityDelta
+     * @tc.desc: Testcase for testing 'GetLauncherAbilityDelta' function.
+     * @tc.type: FUNC
+     * @tc.require: Issue Number
+     */
+    static void BenchmarkTestForGetLauncherAbilityDelta(benchmark::State &state)
+    {
+        LauncherService launcherservice;
+        int32_t userId = 100;
+        uint64_t version = 0;
+        std::vector<LauncherAbilityInfo> launcherAbilityInfos;
+        launcherservice.GetLauncherAbilitySnapshot(userId, version, launcherAbilityInfos);
+        LauncherAbilityDelta delta;
+        for (auto _ : state) {
+            /* @tc.steps: step1.call GetLauncherAbilityDelta in loop */
+            launcherservice.GetLauncherAbilityDelta(userId, version, delta);
+        }
+    }
+
     BENCHMARK(BenchmarkTestForRegisterCallback)->Iterations(1000);
     BENCHMARK(BenchmarkTestForUnRegisterCallback)->Iterations(1000);
     BENCHMARK(BenchmarkTestForGetAbilityList)->Iterations(1000);
@@ -223,6 +262,8 @@ namespace {
     BENCHMARK(BenchmarkTestForIsAbilityEnabled)->Iterations(1000);
     BENCHMARK(BenchmarkTestForGetShortcutInfos)->Iterations(1000);
     BENCHMARK(BenchmarkTestForGetAllLauncherAbilityInfos)->Iterations(1000);
+    BENCHMARK(BenchmarkTestForGetLauncherAbilitySnapshot)->Iterations(1000);
+    BENCHMARK(BenchmarkTestForGetLauncherAbilityDelta)->Iterations(1000);
 }
 
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -28,8 +28,13 @@ namespace LIBZIP {
 namespace {
 const int kZipMaxPath = 256;
 const int kZipBufSize = 8192;
+const int kZipMaxBufSize = 1024 * 1024;
 }  // namespace
 
+// Returns the size of the buffer used to read and write the data of an entry, which follows the chunk size of
+// |options|, but is not smaller than kZipBufSize or larger than kZipMaxBufSize.
+size_t GetZipBufferSize(const OPTIONS &options);
+
 // Callback function for zlib that opens a file stream from a file descriptor.
 // Since we do not own the file descriptor, dup it so that we can fdopen/fclose
 // a file stream.
@@ -55,6 +60,11 @@ unzFile OpenFdForUnzipping(int zipFD);
 // read data from the specified string.
 unzFile PrepareMemoryForUnzipping(const std::string &data);
 
+// Creates a custom unzFile object which reads data from the |length| bytes at
+// |data|, e.g. a mapped zip file. The data is not copied, so it must be kept
+// until the unzFile object is closed.
+unzFile PrepareMemoryForUnzipping(const char *data, size_t length);
+
 // Opens the given file name in UTF-8 for zipping, with some setup for
 // Windows. |append_flag| will be passed to zipOpen2().
 zipFile OpenForZipping(const std::string &fileNameUtf8, int appendFlag);
@@ -63,8 +73,10 @@ zipFile OpenForZipping(const std::string &fileNameUtf8, int appendFlag);
 // passed to zipOpen2().
 zipFile OpenFdForZipping(PlatformFile zipFd, int appendFlag);
 
-bool ZipOpenNewFileInZip(
-    zipFile zipFile, const std::string &strPath, const OPTIONS &options, const struct tm *lastModifiedTime);
+// Opens a new entry in the ZIP file. If |raw| is true, the data written to the entry is deflated already, and the
+// entry is closed with zipCloseFileInZipRaw().
+bool ZipOpenNewFileInZip(zipFile zipFile, const std::string &strPath, const OPTIONS &options,
+    const struct tm *lastModifiedTime, bool raw = false);
 
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
@@ -45,7 +45,7 @@ public:
     // extraction.
     virtual bool WriteBytes(const char *data, int numBytes) = 0;
 
-    // Sets the last-modified time of the data.
+    // Sets the last-modified time of the data, and closes the file.
     virtual void SetTimeModified(const struct tm *modifiedTime) = 0;
 };
 
@@ -82,6 +82,13 @@ public:
             return originalSize_;
         }
 
+        // Returns the size of the entry stored in the zip file (i.e. before uncompressed).
+        // Returns 0 if the entry is a directory.
+        int64_t GetCompressedSize() const
+        {
+            return compressedSize_;
+        }
+
         // Returns the last modified time. If the time stored in the zip file was
         // not valid, the unix epoch will be returned.
         struct tm GetLastModified() const
@@ -111,6 +118,7 @@ public:
     private:
         FilePath filePath_;
         int64_t originalSize_ = 0;
+        int64_t compressedSize_ = 0;
         struct tm lastModified_ {
             .tm_year = 0,
             .tm_mon = 0,
@@ -141,6 +149,11 @@ public:
     // string until it finishes extracting files.
     bool OpenFromString(const std::string &data);
 
+    // Opens the zip data of |length| bytes at |data|, e.g. a mapped zip file.
+    // Like OpenFromString(), the data is not copied, so the caller should keep
+    // it until it finishes extracting files.
+    bool OpenFromMemory(const char *data, size_t length);
+
     // Closes the currently opened zip file. This function is called in the
     // destructor of the class, so you usually don't need to call this.
     void Close();
@@ -152,6 +165,15 @@ public:
     // Advances the next entry. Returns true on success.
     bool AdvanceToNextEntry();
 
+    // Gets the position of the current entry in the central directory, which
+    // can be passed to GoToEntry() of any reader of the same zip data later.
+    // Returns true on success.
+    bool GetCurrentEntryPosition(unz_file_pos &position) const;
+
+    // Goes to the entry at |position|, got by GetCurrentEntryPosition(),
+    // without scanning the entries before it. Returns true on success.
+    bool GoToEntry(const unz_file_pos &position);
+
     // Opens the current entry in the zip file. On success, returns true and
     // updates the the current entry state (i.e. CurrentEntryInfo() is
     // updated). This function should be called before operations over the
@@ -166,6 +188,9 @@ public:
     // the entire file was extracted.
     bool ExtractCurrentEntry(WriterDelegate *delegate, uint64_t numBytesToExtract) const;
 
+    // Same as above, but the data is read in chunks of |bufferSize| bytes.
+    bool ExtractCurrentEntry(WriterDelegate *delegate, uint64_t numBytesToExtract, size_t bufferSize) const;
+
     // Returns the current entry info. Returns NULL if the current entry is
     // not yet opened. OpenCurrentEntryInZip() must be called beforehand.
     EntryInfo *CurrentEntryInfo() const
@@ -199,6 +224,9 @@ private:
 class FilePathWriterDelegate : public WriterDelegate {
 public:
     explicit FilePathWriterDelegate(const FilePath &outputFilePath);
+    // |reservedSize| is the space reserved for the output file before writing
+    // when it is not 0, the part of which not written is released on closing.
+    FilePathWriterDelegate(const FilePath &outputFilePath, int64_t reservedSize);
     ~FilePathWriterDelegate() override;
 
     // WriterDelegate methods:
@@ -210,11 +238,13 @@ public:
     // bytes could be written.
     bool WriteBytes(const char *data, int numBytes) override;
 
-    // Sets the last-modified time of the data.
+    // Sets the last-modified time of the data, and closes the file.
     void SetTimeModified(const struct tm *time) override;
 
 private:
     FilePath outputFilePath_ = FilePath(std::string());
+    int64_t reservedSize_ = 0;
+    int64_t writtenSize_ = 0;
     FILE *file_ = nullptr;
 
     DISALLOW_COPY_AND_ASSIGN(FilePathWriterDelegate);
@@ -127,8 +127,10 @@ struct Options {
 using OPTIONS = struct Options;
 
 constexpr PlatformFile kInvalidPlatformFile = -1;
+// Numbers of threads deflating or inflating the entries of a zip file at the same time, the calling one included.
+constexpr size_t MAX_ZIP_THREAD_NUM = 4;
 
-struct tm *GetCurrentSystemTime(void);
+bool GetCurrentSystemTime(struct tm &time);
 bool StartsWith(const std::string &str, const std::string &searchFor);
 bool EndsWith(const std::string &str, const std::string &searchFor);
 void PostTask(const OHOS::AppExecFwk::InnerEvent::Callback &callback);
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_APPEXECFWK_STANDARD_TOOLS_ZLIB_STREAM_H
+#define FOUNDATION_APPEXECFWK_STANDARD_TOOLS_ZLIB_STREAM_H
+
+#include <stddef.h>
+#include <vector>
+
+#include "zip_utils.h"
+#include "zlib.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace LIBZIP {
+
+// Compresses or decompresses data in the zlib format chunk by chunk, e.g. a
+// network payload which is not received at once. The level, memLevel and
+// strategy of the options are used to compress, and the output grows by the
+// chunk size of the options.
+class ZlibStream {
+public:
+    enum class Mode {
+        DEFLATE,
+        INFLATE
+    };
+
+    ZlibStream(Mode mode, const OPTIONS &options);
+    ~ZlibStream();
+
+    // Initializes the zlib stream. Returns ERROR_CODE_OK on success, or the
+    // zlib error code otherwise.
+    int Init();
+
+    // Feeds |length| bytes of |data| with the zlib |flush| type, and appends
+    // the data produced to |output|. Use FLUSH_TYPE_FINISH to get the end of
+    // the compressed data. Returns ERROR_CODE_OK on success, or the zlib
+    // error code otherwise.
+    int Write(const char *data, size_t length, int flush, std::vector<char> &output);
+
+    // Returns true if the end of the compressed data is written or read.
+    bool IsFinished() const
+    {
+        return finished_;
+    }
+
+private:
+    Mode mode_;
+    OPTIONS options_;
+    z_stream stream_ = {};
+    bool initialized_ = false;
+    bool finished_ = false;
+
+    DISALLOW_COPY_AND_ASSIGN(ZlibStream);
+};
+
+// Compresses the |length| bytes of |data| in the zlib format to |output| at
+// once. Returns ERROR_CODE_OK on success, or the zlib error code otherwise.
+int Deflate(const char *data, size_t length, const OPTIONS &options, std::vector<char> &output);
+
+// Decompresses the |length| bytes of zlib format |data| to |output| at once.
+// Returns ERROR_CODE_OK on success, ERROR_CODE_BUF_ERROR if the data is
+// truncated, or the zlib error code otherwise.
+int Inflate(const char *data, size_t length, const OPTIONS &options, std::vector<char> &output);
+
+}  // namespace LIBZIP
+}  // namespace AppExecFwk
+}  // namespace OHOS
+#endif  // FOUNDATION_APPEXECFWK_STANDARD_TOOLS_ZLIB_STREAM_H
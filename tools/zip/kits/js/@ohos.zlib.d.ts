@@ -86,6 +86,33 @@ declare namespace zlib {
     level?: CompressLevel;
     memLevel?: MemLevel;
     strategy?: CompressStrategy;
+    chunkSize?: number;
+  }
+
+/**
+ * @name ZlibStream
+ * @since 9
+ * @SysCap SystemCapability.Appexecfwk
+ * @import NA
+ * @permission NA
+ * @devices phone, tablet, tv, wearable, car
+ */
+  interface ZlibStream {
+    /**
+     * Compress or decompress a chunk of the data.
+     *
+     * @param data Indicates the chunk, which is read without copying it.
+     * @return Returns the data produced by the chunk.
+     */
+    write(data: ArrayBuffer | Uint8Array): ArrayBuffer;
+
+    /**
+     * Compress or decompress the last chunk of the data and finish the stream.
+     *
+     * @param data Indicates the last chunk, which is optional.
+     * @return Returns the rest of the data produced.
+     */
+    end(data?: ArrayBuffer | Uint8Array): ArrayBuffer;
   }
 
   /**
@@ -111,4 +138,56 @@ declare namespace zlib {
    * @return Returns error code.
    */
   function unzipFile(inFile:string, outFile:string, options: Options): Promise<void>;
+
+  /**
+   * Compress the data in the zlib format in memory.
+   *
+   * @devices phone, tablet, tv, wearable, car
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   * @param data Indicates the data to be compressed, which is not copied, so it should not be modified until the
+   *             result is returned.
+   * @param options Indicates the level, memLevel, strategy and chunkSize used to compress.
+   * @return Returns the compressed data.
+   */
+  function deflate(data: ArrayBuffer | Uint8Array, options?: Options): Promise<ArrayBuffer>;
+  function deflate(data: ArrayBuffer | Uint8Array, callback: AsyncCallback<ArrayBuffer>): void;
+  function deflate(data: ArrayBuffer | Uint8Array, options: Options, callback: AsyncCallback<ArrayBuffer>): void;
+
+  /**
+   * Decompress the data in the zlib or gzip format in memory.
+   *
+   * @devices phone, tablet, tv, wearable, car
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   * @param data Indicates the data to be decompressed, which is not copied, so it should not be modified until the
+   *             result is returned.
+   * @param options Indicates the chunkSize by which the output grows.
+   * @return Returns the decompressed data.
+   */
+  function inflate(data: ArrayBuffer | Uint8Array, options?: Options): Promise<ArrayBuffer>;
+  function inflate(data: ArrayBuffer | Uint8Array, callback: AsyncCallback<ArrayBuffer>): void;
+  function inflate(data: ArrayBuffer | Uint8Array, options: Options, callback: AsyncCallback<ArrayBuffer>): void;
+
+  /**
+   * Create a stream compressing the data in the zlib format chunk by chunk.
+   *
+   * @devices phone, tablet, tv, wearable, car
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   * @param options Indicates the level, memLevel, strategy and chunkSize used to compress.
+   * @return Returns the stream.
+   */
+  function createDeflate(options?: Options): ZlibStream;
+
+  /**
+   * Create a stream decompressing the data in the zlib or gzip format chunk by chunk.
+   *
+   * @devices phone, tablet, tv, wearable, car
+   * @since 9
+   * @SysCap SystemCapability.Appexecfwk
+   * @param options Indicates the chunkSize by which the output grows.
+   * @return Returns the stream.
+   */
+  function createInflate(options?: Options): ZlibStream;
 }
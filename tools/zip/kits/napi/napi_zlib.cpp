@@ -25,6 +25,7 @@
 #include "napi_zlib_common.h"
 #include "zip.h"
 #include "zip_utils.h"
+#include "zlib_stream.h"
 
 using namespace OHOS::AppExecFwk;
 
@@ -38,6 +39,11 @@ constexpr size_t ARGS_MAX_COUNT = 10;
 constexpr int32_t PARAM0 = 0;
 constexpr int32_t PARAM1 = 1;
 constexpr int32_t PARAM3 = 3;
+
+struct ZlibStreamInfo {
+    std::unique_ptr<ZlibStream> stream;
+    int flush = FLUSH_TYPE_NO_FLUSH;
+};
 }
 
 #define COMPRESS_LEVE_CHECK(level, ret)                                                            \
@@ -78,6 +84,9 @@ void ZipAndUnzipFileAsyncCallBack(std::shared_ptr<ZlibCallbackInfo> &zipAceCallb
 napi_value ZipFilePromise(napi_env env, AsyncZipCallbackInfo *asyncZipCallbackInfo);
 napi_value UnzipFilePromise(napi_env env, AsyncZipCallbackInfo *asyncZipCallbackInfo);
 void ZipAndUnzipFileAsyncCallBackInnerJsThread(uv_work_t *work, int status);
+napi_value ZlibBufferAsync(napi_env env, napi_callback_info info, bool isDeflate);
+napi_value CreateZlibStream(napi_env env, napi_callback_info info, ZlibStream::Mode mode);
+napi_value ZlibStreamWrite(napi_env env, napi_callback_info info, bool isEnd);
 
 /**
  * @brief FlushType data initialization.
@@ -262,6 +271,10 @@ napi_value ZlibInit(napi_env env, napi_value exports)
     napi_property_descriptor properties[] = {
         DECLARE_NAPI_FUNCTION("zipFile", NAPI_ZipFile),
         DECLARE_NAPI_FUNCTION("unzipFile", NAPI_UnzipFile),
+        DECLARE_NAPI_FUNCTION("deflate", NAPI_Deflate),
+        DECLARE_NAPI_FUNCTION("inflate", NAPI_Inflate),
+        DECLARE_NAPI_FUNCTION("createDeflate", NAPI_CreateDeflate),
+        DECLARE_NAPI_FUNCTION("createInflate", NAPI_CreateInflate),
     };
 
     NAPI_CALL(env, napi_define_properties(env, exports, sizeof(properties) / sizeof(properties[0]), properties));
@@ -898,6 +911,246 @@ void ZipAndUnzipFileAsyncCallBack(std::shared_ptr<ZlibCallbackInfo> &zipAceCallb
     }
 }
 
+void ReleaseAsyncBufferCallbackInfo(napi_env env, AsyncBufferCallbackInfo *asyncCallbackInfo)
+{
+    if (asyncCallbackInfo == nullptr) {
+        return;
+    }
+    if (asyncCallbackInfo->inputRef != nullptr) {
+        napi_delete_reference(env, asyncCallbackInfo->inputRef);
+    }
+    if (asyncCallbackInfo->callback != nullptr) {
+        napi_delete_reference(env, asyncCallbackInfo->callback);
+    }
+    if (asyncCallbackInfo->asyncWork != nullptr) {
+        napi_delete_async_work(env, asyncCallbackInfo->asyncWork);
+    }
+    delete asyncCallbackInfo;
+}
+
+void ZlibBufferAsyncComplete(napi_env env, napi_status status, void *data)
+{
+    APP_LOGI("NAPI_ZlibBuffer, main event thread complete.");
+    AsyncBufferCallbackInfo *asyncCallbackInfo = static_cast<AsyncBufferCallbackInfo *>(data);
+    if (asyncCallbackInfo == nullptr) {
+        return;
+    }
+    napi_value result[ARGS_TWO] = {nullptr};
+    if (asyncCallbackInfo->result == ERROR_CODE_OK) {
+        result[PARAM1] = CreateArrayBuffer(env, std::move(asyncCallbackInfo->output));
+        if (result[PARAM1] == nullptr) {
+            asyncCallbackInfo->result = ERROR_CODE_MEM_ERROR;
+        }
+    }
+    if (asyncCallbackInfo->result != ERROR_CODE_OK) {
+        napi_get_undefined(env, &result[PARAM1]);
+    }
+    result[PARAM0] = GetCallbackErrorValue(env, asyncCallbackInfo->result);
+    if (asyncCallbackInfo->callback != nullptr) {
+        // callback(err, data)
+        napi_value callback = nullptr;
+        napi_value undefined = nullptr;
+        napi_value jsResult = nullptr;
+        napi_get_reference_value(env, asyncCallbackInfo->callback, &callback);
+        napi_get_undefined(env, &undefined);
+        napi_call_function(env, undefined, callback, ARGS_TWO, result, &jsResult);
+    } else if (asyncCallbackInfo->result == ERROR_CODE_OK) {
+        napi_resolve_deferred(env, asyncCallbackInfo->deferred, result[PARAM1]);
+    } else {
+        napi_reject_deferred(env, asyncCallbackInfo->deferred, result[PARAM0]);
+    }
+    ReleaseAsyncBufferCallbackInfo(env, asyncCallbackInfo);
+}
+
+napi_value ZlibBufferAsync(napi_env env, napi_callback_info info, bool isDeflate)
+{
+    APP_LOGI("%{public}s called, isDeflate: %{public}d", __func__, isDeflate);
+    napi_value args[ARGS_MAX_COUNT] = {nullptr};
+    size_t argc = ARGS_MAX_COUNT;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+    // (data[, options][, callback])
+    bool hasCallback = (argc > PARAM1) && IsTypeForNapiValue(env, args[argc - 1], napi_function);
+    size_t optionsCount = hasCallback ? (argc - ARGS_TWO) : (argc - PARAM1);
+    if (argc < PARAM1 || optionsCount > PARAM1) {
+        APP_LOGE("%{public}s, Wrong argument count.", __func__);
+        return nullptr;
+    }
+    auto asyncCallbackInfo = std::make_unique<AsyncBufferCallbackInfo>();
+    asyncCallbackInfo->env = env;
+    asyncCallbackInfo->isDeflate = isDeflate;
+    if (!UnwrapBufferFromJS(env, args[PARAM0], asyncCallbackInfo->input, asyncCallbackInfo->inputLength)) {
+        APP_LOGE("%{public}s, args[0] error. It should be an ArrayBuffer or a Uint8Array.", __func__);
+        return nullptr;
+    }
+    if (optionsCount > 0 && !UnwrapOptionsParams(asyncCallbackInfo->options, env, args[PARAM1])) {
+        APP_LOGE("%{public}s, args[1] error.", __func__);
+        return nullptr;
+    }
+
+    napi_value result = nullptr;
+    if (hasCallback) {
+        NAPI_CALL(env, napi_create_reference(env, args[argc - 1], 1, &asyncCallbackInfo->callback));
+        napi_get_null(env, &result);
+    } else {
+        NAPI_CALL(env, napi_create_promise(env, &asyncCallbackInfo->deferred, &result));
+    }
+    napi_value resourceName = nullptr;
+    napi_create_string_latin1(env, __func__, NAPI_AUTO_LENGTH, &resourceName);
+    if (napi_create_reference(env, args[PARAM0], 1, &asyncCallbackInfo->inputRef) != napi_ok ||
+        napi_create_async_work(env, nullptr, resourceName,
+            [](napi_env env, void *data) {
+                APP_LOGI("NAPI_ZlibBuffer, worker pool thread execute.");
+                AsyncBufferCallbackInfo *asyncCallbackInfo = static_cast<AsyncBufferCallbackInfo *>(data);
+                asyncCallbackInfo->output = std::make_unique<std::vector<char>>();
+                asyncCallbackInfo->result = asyncCallbackInfo->isDeflate ?
+                    Deflate(asyncCallbackInfo->input, asyncCallbackInfo->inputLength, asyncCallbackInfo->options,
+                        *asyncCallbackInfo->output) :
+                    Inflate(asyncCallbackInfo->input, asyncCallbackInfo->inputLength, asyncCallbackInfo->options,
+                        *asyncCallbackInfo->output);
+            },
+            ZlibBufferAsyncComplete, asyncCallbackInfo.get(), &asyncCallbackInfo->asyncWork) != napi_ok ||
+        napi_queue_async_work(env, asyncCallbackInfo->asyncWork) != napi_ok) {
+        APP_LOGE("%{public}s, failed to queue the async work.", __func__);
+        ReleaseAsyncBufferCallbackInfo(env, asyncCallbackInfo.release());
+        return nullptr;
+    }
+    asyncCallbackInfo.release();
+    return result;
+}
+
+/**
+ * @brief Zlib NAPI method : deflate.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ */
+napi_value NAPI_Deflate(napi_env env, napi_callback_info info)
+{
+    return ZlibBufferAsync(env, info, true);
+}
+
+/**
+ * @brief Zlib NAPI method : inflate.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ */
+napi_value NAPI_Inflate(napi_env env, napi_callback_info info)
+{
+    return ZlibBufferAsync(env, info, false);
+}
+
+void ThrowZlibError(napi_env env, int errCode)
+{
+    napi_throw_error(env, std::to_string(errCode).c_str(), "zlib stream failed");
+}
+
+napi_value ZlibStreamWrite(napi_env env, napi_callback_info info, bool isEnd)
+{
+    napi_value args[ARGS_MAX_COUNT] = {nullptr};
+    size_t argc = ARGS_MAX_COUNT;
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisVar, nullptr));
+    ZlibStreamInfo *streamInfo = nullptr;
+    NAPI_CALL(env, napi_unwrap(env, thisVar, reinterpret_cast<void **>(&streamInfo)));
+    if (streamInfo == nullptr || streamInfo->stream == nullptr) {
+        APP_LOGE("%{public}s, the stream is released.", __func__);
+        return nullptr;
+    }
+    // the data is optional for end() only
+    const char *data = nullptr;
+    size_t length = 0;
+    bool hasData = (argc > PARAM0) && !IsTypeForNapiValue(env, args[PARAM0], napi_undefined);
+    if ((hasData || !isEnd) && !UnwrapBufferFromJS(env, args[PARAM0], data, length)) {
+        APP_LOGE("%{public}s, args[0] error. It should be an ArrayBuffer or a Uint8Array.", __func__);
+        return nullptr;
+    }
+    auto output = std::make_unique<std::vector<char>>();
+    int ret = streamInfo->stream->Write(data, length, isEnd ? FLUSH_TYPE_FINISH : streamInfo->flush, *output);
+    if (ret == ERROR_CODE_OK && isEnd && !streamInfo->stream->IsFinished()) {
+        // the compressed data is truncated
+        ret = ERROR_CODE_BUF_ERROR;
+    }
+    if (ret != ERROR_CODE_OK) {
+        ThrowZlibError(env, ret);
+        return nullptr;
+    }
+    return CreateArrayBuffer(env, std::move(output));
+}
+
+napi_value NAPI_ZlibStreamWrite(napi_env env, napi_callback_info info)
+{
+    return ZlibStreamWrite(env, info, false);
+}
+
+napi_value NAPI_ZlibStreamEnd(napi_env env, napi_callback_info info)
+{
+    return ZlibStreamWrite(env, info, true);
+}
+
+napi_value CreateZlibStream(napi_env env, napi_callback_info info, ZlibStream::Mode mode)
+{
+    APP_LOGI("%{public}s called.", __func__);
+    napi_value args[ARGS_MAX_COUNT] = {nullptr};
+    size_t argc = ARGS_MAX_COUNT;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+    OPTIONS options;
+    if (argc > PARAM0 && !UnwrapOptionsParams(options, env, args[PARAM0])) {
+        APP_LOGE("%{public}s, args[0] error.", __func__);
+        return nullptr;
+    }
+    auto streamInfo = std::make_unique<ZlibStreamInfo>();
+    streamInfo->stream = std::make_unique<ZlibStream>(mode, options);
+    streamInfo->flush = options.flush;
+    int ret = streamInfo->stream->Init();
+    if (ret != ERROR_CODE_OK) {
+        ThrowZlibError(env, ret);
+        return nullptr;
+    }
+
+    napi_value stream = nullptr;
+    NAPI_CALL(env, napi_create_object(env, &stream));
+    napi_property_descriptor properties[] = {
+        DECLARE_NAPI_FUNCTION("write", NAPI_ZlibStreamWrite),
+        DECLARE_NAPI_FUNCTION("end", NAPI_ZlibStreamEnd),
+    };
+    NAPI_CALL(env, napi_define_properties(env, stream, sizeof(properties) / sizeof(properties[0]), properties));
+    NAPI_CALL(env, napi_wrap(env, stream, streamInfo.get(),
+        [](napi_env env, void *data, void *hint) { delete static_cast<ZlibStreamInfo *>(data); }, nullptr, nullptr));
+    streamInfo.release();
+    return stream;
+}
+
+/**
+ * @brief Zlib NAPI method : createDeflate.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ */
+napi_value NAPI_CreateDeflate(napi_env env, napi_callback_info info)
+{
+    return CreateZlibStream(env, info, ZlibStream::Mode::DEFLATE);
+}
+
+/**
+ * @brief Zlib NAPI method : createInflate.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ */
+napi_value NAPI_CreateInflate(napi_env env, napi_callback_info info)
+{
+    return CreateZlibStream(env, info, ZlibStream::Mode::INFLATE);
+}
+
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -155,6 +155,78 @@ napi_value NAPI_ZipFile(napi_env env, napi_callback_info info);
  */
 napi_value NAPI_UnzipFile(napi_env env, napi_callback_info info);
 
+/**
+ * @brief Zlib NAPI method : deflate.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ *
+ * NAPI_Deflate compresses an ArrayBuffer or Uint8Array in the zlib format to an ArrayBuffer, it supports promise
+ * and callback calls. The options are optional, the input is not copied, so it should not be modified until the
+ * result is returned.
+ *
+ * example
+ * var data = new Uint8Array([1, 2, 3, 4]);
+ * var option = {
+ *           level:9,
+ *           memLevel:8,
+ *           strategy:0,
+ *           chunkSize:16384
+ *       };
+ * zlib.deflate(data, option).then((result) => { ... });
+ */
+napi_value NAPI_Deflate(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Zlib NAPI method : inflate.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ *
+ * NAPI_Inflate decompresses an ArrayBuffer or Uint8Array in the zlib or gzip format to an ArrayBuffer, it supports
+ * promise and callback calls like NAPI_Deflate.
+ *
+ * example
+ * zlib.inflate(compressed, {chunkSize:65536}, (err, result) => { ... });
+ */
+napi_value NAPI_Inflate(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Zlib NAPI method : createDeflate.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ *
+ * NAPI_CreateDeflate creates a stream compressing the data chunk by chunk. Its write(data) compresses a chunk with
+ * the flush type of the options, its end(data) compresses the last chunk, which is optional, and finishes the
+ * stream, and both of them return the data produced in an ArrayBuffer.
+ *
+ * example
+ * var stream = zlib.createDeflate({level:1});
+ * var part1 = stream.write(chunk1);
+ * var part2 = stream.end(chunk2);
+ */
+napi_value NAPI_CreateDeflate(napi_env env, napi_callback_info info);
+
+/**
+ * @brief Zlib NAPI method : createInflate.
+ *
+ * @param env The environment that the Node-API call is invoked under.
+ * @param info The callback info passed into the callback function.
+ *
+ * @return The return value from NAPI C++ to JS for the module.
+ *
+ * NAPI_CreateInflate creates a stream decompressing the data chunk by chunk, it works like NAPI_CreateDeflate, and
+ * its end() throws if the compressed data is truncated.
+ */
+napi_value NAPI_CreateInflate(napi_env env, napi_callback_info info);
+
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
 }  // namespace OHOS
@@ -96,6 +96,58 @@ void SetNamedProperty(napi_env env, napi_value obj, const char *propName, const
     napi_create_int32(env, propValue, &prop);
     napi_set_named_property(env, obj, propName, prop);
 }
+
+bool UnwrapBufferFromJS(napi_env env, napi_value param, const char *&data, size_t &length)
+{
+    // the memory of the ArrayBuffer or Uint8Array is read directly, without copying it
+    bool isArrayBuffer = false;
+    NAPI_CALL_BASE(env, napi_is_arraybuffer(env, param, &isArrayBuffer), false);
+    if (isArrayBuffer) {
+        void *buffer = nullptr;
+        NAPI_CALL_BASE(env, napi_get_arraybuffer_info(env, param, &buffer, &length), false);
+        data = static_cast<const char *>(buffer);
+        return true;
+    }
+    bool isTypedArray = false;
+    NAPI_CALL_BASE(env, napi_is_typedarray(env, param, &isTypedArray), false);
+    if (!isTypedArray) {
+        return false;
+    }
+    napi_typedarray_type type = napi_int8_array;
+    void *buffer = nullptr;
+    napi_value arrayBuffer = nullptr;
+    size_t byteOffset = 0;
+    NAPI_CALL_BASE(env,
+        napi_get_typedarray_info(env, param, &type, &length, &buffer, &arrayBuffer, &byteOffset), false);
+    if (type != napi_uint8_array) {
+        return false;
+    }
+    data = static_cast<const char *>(buffer);
+    return true;
+}
+
+napi_value CreateArrayBuffer(napi_env env, std::unique_ptr<std::vector<char>> data)
+{
+    napi_value result = nullptr;
+    if (data == nullptr || data->empty()) {
+        void *buffer = nullptr;
+        NAPI_CALL(env, napi_create_arraybuffer(env, 0, &buffer, &result));
+        return result;
+    }
+    // the output is reserved for the worst case, do not let the ArrayBuffer keep much more memory than its size
+    if (data->capacity() / 2 > data->size()) {
+        data->shrink_to_fit();
+    }
+    // the ArrayBuffer takes the memory of the vector instead of copying it, and releases it when collected
+    std::vector<char> *output = data.release();
+    napi_status status = napi_create_external_arraybuffer(env, output->data(), output->size(),
+        [](napi_env env, void *data, void *hint) { delete static_cast<std::vector<char> *>(hint); }, output, &result);
+    if (status != napi_ok) {
+        delete output;
+        return nullptr;
+    }
+    return result;
+}
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
 }  // namespace OHOS
\ No newline at end of file
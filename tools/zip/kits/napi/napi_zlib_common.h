@@ -16,6 +16,7 @@
 #define OHOS_APPEXECFWK_LIBZIP_COMMON_H
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "napi/native_api.h"
 #include "napi/native_common.h"
@@ -51,11 +52,28 @@ struct AsyncZipCallbackInfo {
     napi_async_work asyncWork;
     std::shared_ptr<ZlibCallbackInfo> aceCallback;
 };
+
+struct AsyncBufferCallbackInfo {
+    napi_env env = nullptr;
+    napi_async_work asyncWork = nullptr;
+    napi_deferred deferred = nullptr;
+    napi_ref callback = nullptr;
+    // keeps the input alive while it is read by the worker thread, it is not copied
+    napi_ref inputRef = nullptr;
+    const char *input = nullptr;
+    size_t inputLength = 0;
+    OPTIONS options;
+    bool isDeflate = true;
+    int result = ERROR_CODE_ERRNO;
+    std::unique_ptr<std::vector<char>> output;
+};
 bool UnwrapIntValue(napi_env env, napi_value jsValue, int &result);
 bool IsTypeForNapiValue(napi_env env, napi_value param, napi_valuetype expectType);
 std::string UnwrapStringFromJS(napi_env env, napi_value param, const std::string &defaultValue);
 napi_value GetCallbackErrorValue(napi_env env, int errCode);
 void SetNamedProperty(napi_env env, napi_value obj, const char *propName, const int propValue);
+bool UnwrapBufferFromJS(napi_env env, napi_value param, const char *&data, size_t &length);
+napi_value CreateArrayBuffer(napi_env env, std::unique_ptr<std::vector<char>> data);
 
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
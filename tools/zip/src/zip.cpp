@@ -14,14 +14,20 @@
  */
 #include "zip.h"
 
+#include <algorithm>
+#include <atomic>
 #include <fcntl.h>
 #include <list>
 #include <stdio.h>
 #include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
+#include <unordered_map>
 #include <vector>
 
 #include "app_log_wrapper.h"
+#include "concurrent_util.h"
 #include "directory_ex.h"
 #include "event_handler.h"
 #include "file_path.h"
@@ -37,12 +43,15 @@ namespace LIBZIP {
 namespace {
 using FilterCallback = std::function<bool(const FilePath &)>;
 using DirectoryCreator = std::function<bool(FilePath &, FilePath &)>;
-using WriterFactory = std::function<std::unique_ptr<WriterDelegate>(FilePath &, FilePath &)>;
+using WriterFactory = std::function<std::unique_ptr<WriterDelegate>(FilePath &, FilePath &, int64_t)>;
 
 const std::string SEPARATOR = "/";
 const char HIDDEN_SEPARATOR = '.';
 const std::string ZIP = ".zip";
 const std::int32_t ZIP_SIZE = 4;
+// the space reserved for an extracted file is at most this multiple of its compressed size, since the original
+// size stored in the zip file is not trusted
+const int64_t MAX_RESERVED_SIZE_RATIO = 16;
 
 #define CALLING_CALL_BACK(callback, result) \
     if (callback != nullptr) {              \
@@ -111,15 +120,24 @@ bool CreateDirectory(FilePath &extractDir, FilePath &entryPath)
     }
 }
 
-// Creates a WriterDelegate that can write a file at |extractDir|/|entryPath|.
-std::unique_ptr<WriterDelegate> CreateFilePathWriterDelegate(FilePath &extractDir, FilePath entryPath)
+// Creates a WriterDelegate that can write a file of |size| bytes at |extractDir|/|entryPath|.
+std::unique_ptr<WriterDelegate> CreateFilePathWriterDelegate(FilePath &extractDir, FilePath entryPath, int64_t size)
 {
     if (EndsWith(extractDir.Value(), SEPARATOR)) {
-        return std::make_unique<FilePathWriterDelegate>(FilePath(extractDir.Value() + entryPath.Value()));
+        return std::make_unique<FilePathWriterDelegate>(FilePath(extractDir.Value() + entryPath.Value()), size);
     } else {
-        return std::make_unique<FilePathWriterDelegate>(FilePath(extractDir.Value() + "/" + entryPath.Value()));
+        return std::make_unique<FilePathWriterDelegate>(
+            FilePath(extractDir.Value() + "/" + entryPath.Value()), size);
     }
 }
+
+int64_t GetReservedSize(const ZipReader::EntryInfo &entryInfo)
+{
+    if (entryInfo.GetCompressedSize() <= 0) {
+        return 0;
+    }
+    return std::min(entryInfo.GetOriginalSize(), entryInfo.GetCompressedSize() * MAX_RESERVED_SIZE_RATIO);
+}
 }  // namespace
 
 ZipParams::ZipParams(const FilePath &srcDir, const FilePath &destFile) : srcDir_(srcDir), destFile_(destFile)
@@ -221,7 +239,8 @@ bool UnzipWithFilterAndWriters(const PlatformFile &srcFile, FilePath &destDir, W
                 }
 
             } else {
-                std::unique_ptr<WriterDelegate> writer = writerFactory(destDir, entryPath);
+                std::unique_ptr<WriterDelegate> writer =
+                    writerFactory(destDir, entryPath, GetReservedSize(*reader.CurrentEntryInfo()));
                 if (!reader.ExtractCurrentEntry(writer.get(), std::numeric_limits<uint64_t>::max())) {
                     CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
                     APP_LOGI("%{public}s called, Failed to extract.", __func__);
@@ -241,6 +260,101 @@ bool UnzipWithFilterAndWriters(const PlatformFile &srcFile, FilePath &destDir, W
     CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_OK)
     return true;
 }
+
+// Same as UnzipWithFilterAndWriters, but reads the zip file mapped at |data|: the entries are listed from the
+// central directory once, the directories are created in order, and then the files are extracted concurrently,
+// each of them by a reader of its own which goes to the entry directly.
+bool UnzipMappedFileWithFilterAndWriters(const char *data, size_t length, FilePath &destDir,
+    WriterFactory writerFactory, DirectoryCreator directoryCreator, const OPTIONS &options, UnzipParam &unzipParam)
+{
+    APP_LOGI("%{public}s called, destDir=%{public}s", __func__, destDir.Value().c_str());
+    ZipReader reader;
+    if (!reader.OpenFromMemory(data, length)) {
+        CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
+        APP_LOGI("%{public}s called, Failed to open srcFile.", __func__);
+        return false;
+    }
+    struct FileEntry {
+        unz_file_pos position;
+        FilePath entryPath;
+        int64_t reservedSize;
+    };
+    std::vector<FileEntry> fileEntries;
+    // an entry stored more than once is extracted from the last one, which overwrites the others when extracting
+    // them in order
+    std::unordered_map<std::string, size_t> fileEntryIndexes;
+    while (reader.HasMore()) {
+        if (!reader.OpenCurrentEntryInZip()) {
+            CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
+            APP_LOGI("%{public}s called, Failed to open the current file in zip.", __func__);
+            return false;
+        }
+        FilePath entryPath = reader.CurrentEntryInfo()->GetFilePath();
+        if (reader.CurrentEntryInfo()->IsUnsafe()) {
+            CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
+            APP_LOGI("%{public}s called, Found an unsafe file in zip.", __func__);
+            return false;
+        }
+        if (unzipParam.filterCB(entryPath)) {
+            if (reader.CurrentEntryInfo()->IsDirectory()) {
+                if (!directoryCreator(destDir, entryPath)) {
+                    APP_LOGI("!!!directory_creator(%{private}s) Failed!!!.", entryPath.Value().c_str());
+                    CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
+                    return false;
+                }
+            } else {
+                FileEntry fileEntry = { {}, entryPath, GetReservedSize(*reader.CurrentEntryInfo()) };
+                if (!reader.GetCurrentEntryPosition(fileEntry.position)) {
+                    CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
+                    APP_LOGI("%{public}s called, Failed to get the position of the current file.", __func__);
+                    return false;
+                }
+                auto result = fileEntryIndexes.emplace(entryPath.Value(), fileEntries.size());
+                if (result.second) {
+                    fileEntries.emplace_back(fileEntry);
+                } else {
+                    fileEntries[result.first->second] = fileEntry;
+                }
+            }
+        } else if (unzipParam.logSkippedFiles) {
+            APP_LOGI("%{public}s called, Skipped file.", __func__);
+        }
+
+        if (!reader.AdvanceToNextEntry()) {
+            CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
+            APP_LOGI("%{public}s called, Failed to advance to the next file.", __func__);
+            return false;
+        }
+    }
+
+    size_t bufferSize = GetZipBufferSize(options);
+    std::atomic<bool> isFailed {false};
+    RunConcurrently(fileEntries.size(), GetCpuBoundThreadNum(MAX_ZIP_THREAD_NUM), [&](size_t index) {
+        if (isFailed) {
+            return;
+        }
+        FileEntry &fileEntry = fileEntries[index];
+        // opening the mapped data only reads the end of the central directory, so a reader is not shared by threads
+        ZipReader entryReader;
+        if (!entryReader.OpenFromMemory(data, length) || !entryReader.GoToEntry(fileEntry.position)) {
+            APP_LOGI("%{public}s called, Failed to go to the file in zip.", __func__);
+            isFailed = true;
+            return;
+        }
+        std::unique_ptr<WriterDelegate> writer = writerFactory(destDir, fileEntry.entryPath, fileEntry.reservedSize);
+        if (!entryReader.ExtractCurrentEntry(writer.get(), std::numeric_limits<uint64_t>::max(), bufferSize)) {
+            APP_LOGI("%{public}s called, Failed to extract.", __func__);
+            isFailed = true;
+        }
+    });
+    if (isFailed) {
+        CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
+        return false;
+    }
+    CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_OK)
+    return true;
+}
+
 bool UnzipWithFilterCallback(
     const FilePath &srcFile, const FilePath &destDir, const OPTIONS &options, UnzipParam &unzipParam)
 {
@@ -270,11 +384,23 @@ bool UnzipWithFilterCallback(
         CALLING_CALL_BACK(unzipParam.callback, ERROR_CODE_ERRNO)
         return false;
     }
-    bool ret = UnzipWithFilterAndWriters(zipFd,
-        dest,
-        std::bind(&CreateFilePathWriterDelegate, std::placeholders::_1, std::placeholders::_2),
-        std::bind(&CreateDirectory, std::placeholders::_1, std::placeholders::_2),
-        unzipParam);
+    WriterFactory writerFactory = std::bind(
+        &CreateFilePathWriterDelegate, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+    DirectoryCreator directoryCreator = std::bind(&CreateDirectory, std::placeholders::_1, std::placeholders::_2);
+    // map the zip file to extract its entries concurrently, and read it sequentially if it can not be mapped
+    struct stat zipStat = {};
+    void *zipData = MAP_FAILED;
+    if (fstat(zipFd, &zipStat) == 0 && zipStat.st_size > 0) {
+        zipData = mmap(nullptr, static_cast<size_t>(zipStat.st_size), PROT_READ, MAP_PRIVATE, zipFd, 0);
+    }
+    bool ret = false;
+    if (zipData != MAP_FAILED) {
+        ret = UnzipMappedFileWithFilterAndWriters(static_cast<const char *>(zipData),
+            static_cast<size_t>(zipStat.st_size), dest, writerFactory, directoryCreator, options, unzipParam);
+        munmap(zipData, static_cast<size_t>(zipStat.st_size));
+    } else {
+        ret = UnzipWithFilterAndWriters(zipFd, dest, writerFactory, directoryCreator, unzipParam);
+    }
 
     close(zipFd);
 
@@ -380,8 +506,7 @@ bool Zip(const FilePath &srcDir, const FilePath &destFile, const OPTIONS &option
         return false;
     }
     
-    auto innerTask = [srcDir, destFile, includeHiddenFiles, callback]() {
-        OPTIONS options;
+    auto innerTask = [srcDir, destFile, options, includeHiddenFiles, callback]() {
         if (includeHiddenFiles) {
             ZipWithFilterCallback(srcDir, destFile, options, callback, ExcludeNoFilesFilter);
         } else {
@@ -247,10 +247,20 @@ unzFile OpenFdForUnzipping(int zipFD)
     return unzOpen2("fd", &zipFuncs);
 }
 
+size_t GetZipBufferSize(const OPTIONS &options)
+{
+    return static_cast<size_t>(std::min(std::max(options.chunkSize, kZipBufSize), kZipMaxBufSize));
+}
+
 // static
 unzFile PrepareMemoryForUnzipping(const std::string &data)
 {
-    if (data.empty()) {
+    return PrepareMemoryForUnzipping(data.data(), data.length());
+}
+
+unzFile PrepareMemoryForUnzipping(const char *data, size_t length)
+{
+    if (data == nullptr || length == 0) {
         return NULL;
     }
     ZipBuffer *buffer = static_cast<ZipBuffer *>(malloc(sizeof(ZipBuffer)));
@@ -258,8 +268,8 @@ unzFile PrepareMemoryForUnzipping(const std::string &data)
         free(buffer);
         return NULL;
     }
-    buffer->data = data.data();
-    buffer->length = data.length();
+    buffer->data = data;
+    buffer->length = length;
     buffer->offset = 0;
 
     zlib_filefunc_def zipFunctions;
@@ -291,8 +301,8 @@ zipFile OpenFdForZipping(PlatformFile zipFd, int appendFlag)
     return zipOpen2("fd", appendFlag, NULL, &zipFuncs);
 }
 
-bool ZipOpenNewFileInZip(
-    zipFile zipFile, const std::string &strPath, const OPTIONS &options, const struct tm *lastModifiedTime)
+bool ZipOpenNewFileInZip(zipFile zipFile, const std::string &strPath, const OPTIONS &options,
+    const struct tm *lastModifiedTime, bool raw)
 {
     const uLong LANGUAGE_ENCODING_FLAG = 0x1 << 11;
 
@@ -308,7 +318,7 @@ bool ZipOpenNewFileInZip(
         NULL,    // comment
         Z_DEFLATED,    // method
         (int)options.level,    // level:default Z_DEFAULT_COMPRESSION
-        0,    // raw
+        raw ? 1 : 0,    // raw
         -MAX_WBITS,    // windowBits
         (int)options.memLevel,    // memLevel: default DEF_MEM_LEVEL
         (int)options.strategy,    // strategy:default Z_DEFAULT_STRATEGY
@@ -15,6 +15,8 @@
 
 #include "zip_reader.h"
 
+#include <cerrno>
+#include <fcntl.h>
 #include <stdio.h>
 #include <time.h>
 #include <unistd.h>
@@ -40,6 +42,7 @@ ZipReader::EntryInfo::EntryInfo(const std::string &fileNameInZip, const unz_file
     : filePath_(FilePath::FromUTF8Unsafe(fileNameInZip)), isDirectory_(false), isUnsafe_(false), isEncrypted_(false)
 {
     originalSize_ = rawFileInfo.uncompressed_size;
+    compressedSize_ = rawFileInfo.compressed_size;
 
     // Directory entries in zip files end with "/".
     isDirectory_ = EndsWith(fileNameInZip, "/");
@@ -58,8 +61,9 @@ ZipReader::EntryInfo::EntryInfo(const std::string &fileNameInZip, const unz_file
 
     // Construct the last modified time. The timezone info is not present in
     // zip files, so we construct the time as local time.
-    if (GetCurrentSystemTime() != nullptr) {
-        lastModified_ = *GetCurrentSystemTime();
+    struct tm modifiedTime = {};
+    if (GetCurrentSystemTime(modifiedTime)) {
+        lastModified_ = modifiedTime;
     }
 }
 
@@ -113,6 +117,19 @@ bool ZipReader::OpenFromString(const std::string &data)
     return OpenInternal();
 }
 
+bool ZipReader::OpenFromMemory(const char *data, size_t length)
+{
+    if (zipFile_ != nullptr) {
+        return false;
+    }
+    zipFile_ = PrepareMemoryForUnzipping(data, length);
+    if (!zipFile_) {
+        return false;
+    }
+
+    return OpenInternal();
+}
+
 void ZipReader::Close()
 {
     if (zipFile_) {
@@ -154,6 +171,27 @@ bool ZipReader::AdvanceToNextEntry()
     return true;
 }
 
+bool ZipReader::GetCurrentEntryPosition(unz_file_pos &position) const
+{
+    if (zipFile_ == nullptr || reachedEnd_) {
+        return false;
+    }
+    return unzGetFilePos(zipFile_, &position) == UNZ_OK;
+}
+
+bool ZipReader::GoToEntry(const unz_file_pos &position)
+{
+    if (zipFile_ == nullptr) {
+        return false;
+    }
+    if (unzGoToFilePos(zipFile_, const_cast<unz_file_pos *>(&position)) != UNZ_OK) {
+        return false;
+    }
+    reachedEnd_ = false;
+    currentEntryInfo_.reset();
+    return true;
+}
+
 bool ZipReader::OpenCurrentEntryInZip()
 {
     if (zipFile_ == nullptr) {
@@ -184,7 +222,12 @@ bool ZipReader::OpenCurrentEntryInZip()
 
 bool ZipReader::ExtractCurrentEntry(WriterDelegate *delegate, uint64_t numBytesToExtract) const
 {
-    if ((zipFile_ == nullptr) || (delegate == nullptr)) {
+    return ExtractCurrentEntry(delegate, numBytesToExtract, kZipBufSize);
+}
+
+bool ZipReader::ExtractCurrentEntry(WriterDelegate *delegate, uint64_t numBytesToExtract, size_t bufferSize) const
+{
+    if ((zipFile_ == nullptr) || (delegate == nullptr) || (bufferSize == 0)) {
         return false;
     }
     const int openResult = unzOpenCurrentFile(zipFile_);
@@ -194,12 +237,12 @@ bool ZipReader::ExtractCurrentEntry(WriterDelegate *delegate, uint64_t numBytesT
     if (!delegate->PrepareOutput()) {
         return false;
     }
-    auto buf = std::make_unique<char[]>(kZipBufSize);
+    auto buf = std::make_unique<char[]>(bufferSize);
     uint64_t remainingCapacity = numBytesToExtract;
     bool entirefileextracted = false;
 
     while (remainingCapacity > 0) {
-        const int numBytesRead = unzReadCurrentFile(zipFile_, buf.get(), kZipBufSize);
+        const int numBytesRead = unzReadCurrentFile(zipFile_, buf.get(), static_cast<unsigned int>(bufferSize));
         if (numBytesRead == 0) {
             entirefileextracted = true;
             break;
@@ -223,7 +266,8 @@ bool ZipReader::ExtractCurrentEntry(WriterDelegate *delegate, uint64_t numBytesT
 
     unzCloseCurrentFile(zipFile_);
     // closeFile
-    delegate->SetTimeModified(GetCurrentSystemTime());
+    struct tm modifiedTime = {};
+    delegate->SetTimeModified(GetCurrentSystemTime(modifiedTime) ? &modifiedTime : nullptr);
 
     return entirefileextracted;
 }
@@ -260,6 +304,10 @@ void ZipReader::Reset()
 FilePathWriterDelegate::FilePathWriterDelegate(const FilePath &outputFilePath) : outputFilePath_(outputFilePath)
 {}
 
+FilePathWriterDelegate::FilePathWriterDelegate(const FilePath &outputFilePath, int64_t reservedSize)
+    : outputFilePath_(outputFilePath), reservedSize_(reservedSize)
+{}
+
 FilePathWriterDelegate::~FilePathWriterDelegate()
 {}
 
@@ -276,6 +324,13 @@ bool FilePathWriterDelegate::PrepareOutput()
     }
 
     file_ = fopen(outputFilePath_.Value().c_str(), "wb");
+    if (file_ != nullptr && reservedSize_ > 0) {
+        // reserve the blocks at once instead of growing the file chunk by chunk, the file size is kept and a
+        // failure is ignored, the blocks past the bytes written are released by SetTimeModified
+        if (fallocate(fileno(file_), FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(reservedSize_)) != 0) {
+            reservedSize_ = 0;
+        }
+    }
     return FilePath::PathIsValid(outputFilePath_);
 }
 
@@ -285,11 +340,20 @@ bool FilePathWriterDelegate::WriteBytes(const char *data, int numBytes)
         return false;
     }
     int writebytes = fwrite(data, 1, numBytes, file_);
+    writtenSize_ += writebytes;
     return numBytes == writebytes;
 }
 
 void FilePathWriterDelegate::SetTimeModified(const struct tm *time)
 {
+    if (file_ == nullptr) {
+        return;
+    }
+    // truncating to the size written releases the blocks reserved beyond it, even if the size is not changed
+    if (reservedSize_ > writtenSize_ && fflush(file_) == 0 &&
+        ftruncate(fileno(file_), static_cast<off_t>(writtenSize_)) != 0) {
+        APP_LOGW("%{public}s called, failed to release the reserved space, errno: %{public}d.", __func__, errno);
+    }
     fclose(file_);
     file_ = nullptr;
 }
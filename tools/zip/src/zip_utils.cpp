@@ -14,7 +14,11 @@
  */
 #include "zip_utils.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <regex>
+#include <vector>
 
 #include "event_handler.h"
 
@@ -24,33 +28,65 @@ namespace LIBZIP {
 namespace {
 const std::string SEPARATOR = "/";
 const std::regex FILE_PATH_REGEX("([0-9A-Za-z/+_=\\-,.])+");
+// Numbers of runners the zip and unzip tasks are posted to, so a long task does not block the others.
+constexpr size_t MAX_RUNNER_NUM = 4;
+
+struct TaskRunner {
+    std::shared_ptr<EventHandler> handler;
+    std::shared_ptr<std::atomic<uint32_t>> pendingTaskCount;
+};
 }  // namespace
 using namespace OHOS::AppExecFwk;
 
-std::shared_ptr<EventHandler> g_handler = nullptr;
+std::mutex g_runnersMutex;
+std::vector<TaskRunner> g_runners;
 void PostTask(const InnerEvent::Callback &callback)
 {
-    if (g_handler == nullptr) {
-        auto runner = EventRunner::Create(true);
-        g_handler = std::make_shared<EventHandler>(runner);
+    TaskRunner taskRunner;
+    {
+        std::lock_guard<std::mutex> lock(g_runnersMutex);
+        // post the task to an idle runner, or create a new runner, or post it to the least busy one
+        auto iter = std::min_element(g_runners.begin(), g_runners.end(),
+            [](const TaskRunner &left, const TaskRunner &right) {
+                return *left.pendingTaskCount < *right.pendingTaskCount;
+            });
+        if (iter != g_runners.end() && (*iter->pendingTaskCount == 0 || g_runners.size() >= MAX_RUNNER_NUM)) {
+            taskRunner = *iter;
+        } else {
+            auto runner = EventRunner::Create(true);
+            if (runner == nullptr) {
+                return;
+            }
+            taskRunner.handler = std::make_shared<EventHandler>(runner);
+            taskRunner.pendingTaskCount = std::make_shared<std::atomic<uint32_t>>(0);
+            g_runners.emplace_back(taskRunner);
+        }
+        (*taskRunner.pendingTaskCount)++;
     }
 
-    if (g_handler != nullptr) {
-        g_handler->PostTask(callback);
+    auto pendingTaskCount = taskRunner.pendingTaskCount;
+    auto task = [callback, pendingTaskCount]() {
+        if (callback) {
+            callback();
+        }
+        (*pendingTaskCount)--;
+    };
+    if (!taskRunner.handler->PostTask(task)) {
+        (*pendingTaskCount)--;
     }
 }
 
-struct tm *GetCurrentSystemTime(void)
+bool GetCurrentSystemTime(struct tm &time)
 {
+    // the zip tasks run concurrently, so the time is converted into the buffer of the caller
     auto tt = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-    struct tm *time = localtime(&tt);
-    if (time == nullptr) {
-        return nullptr;
+    if (localtime_r(&tt, &time) == nullptr) {
+        return false;
     }
     int baseYear = 1900;
-    time->tm_mday = time->tm_mday + baseYear;
-    time->tm_mday = time->tm_mon + 1;
-    return time;
+    time.tm_mday = time.tm_mday + baseYear;
+    time.tm_mday = time.tm_mon + 1;
+    return true;
 }
 
 bool StartsWith(const std::string &str, const std::string &searchFor)
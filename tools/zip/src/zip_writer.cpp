@@ -15,12 +15,16 @@
  */
 #include "zip_writer.h"
 
+#include <algorithm>
 #include <stdio.h>
+#include <sys/stat.h>
 
 #include "app_log_wrapper.h"
+#include "concurrent_util.h"
 #include "contrib/minizip/zip.h"
 #include "directory_ex.h"
 #include "zip_internal.h"
+#include "zlib.h"
 
 using namespace OHOS::AppExecFwk;
 
@@ -31,17 +35,96 @@ namespace {
 // Numbers of pending entries that trigger writting them to the ZIP file.
 constexpr size_t g_MaxPendingEntriesCount = 50;
 const std::string SEPARATOR = "/";
+// Files up to this size are deflated into memory concurrently and then written in order, larger files are
+// deflated by the writing thread while they are written.
+constexpr int64_t MAX_DEFLATE_IN_MEMORY_FILE_SIZE = 8 * 1024 * 1024;
+// Total size of the files deflated into memory at a time.
+constexpr int64_t MAX_DEFLATE_IN_MEMORY_SIZE = 32 * 1024 * 1024;
 
 #define CALLING_CALL_BACK(callback, result) \
     if (callback != nullptr) {              \
         callback(result);                   \
     }
 
-bool AddFileContentToZip(zipFile zip_file, FilePath &file_path)
+struct ZipEntry {
+    FilePath relativePath;
+    FilePath absolutePath;
+    bool isFile = false;
+    int64_t fileSize = 0;
+    bool needDeflateInMemory = false;
+    // Set when the file is deflated into memory successfully.
+    bool isDeflated = false;
+    std::vector<char> deflatedData;
+    uLong crc = 0;
+    uLong uncompressedSize = 0;
+};
+
+// Deflates the file into an independent raw deflate stream in memory, which is written to the ZIP file as is.
+bool DeflateFileToMemory(ZipEntry &entry, const OPTIONS &options)
+{
+    if (!FilePathCheckValid(entry.absolutePath.Value())) {
+        return false;
+    }
+    FILE *fp = fopen(entry.absolutePath.Value().c_str(), "rb");
+    if (fp == nullptr) {
+        return false;
+    }
+    z_stream stream = {};
+    if (deflateInit2(&stream, static_cast<int>(options.level), Z_DEFLATED, -MAX_WBITS,
+        static_cast<int>(options.memLevel), static_cast<int>(options.strategy)) != Z_OK) {
+        fclose(fp);
+        return false;
+    }
+    size_t bufferSize = GetZipBufferSize(options);
+    std::vector<char> buf(bufferSize);
+    std::vector<char> &data = entry.deflatedData;
+    data.resize(deflateBound(&stream, static_cast<uLong>(entry.fileSize)) + bufferSize);
+    uLong crc = crc32(0L, Z_NULL, 0);
+    int ret = Z_OK;
+    int flush = Z_NO_FLUSH;
+    while (flush != Z_FINISH) {
+        size_t numBytes = fread(buf.data(), 1, bufferSize, fp);
+        if (ferror(fp)) {
+            ret = Z_ERRNO;
+            break;
+        }
+        flush = feof(fp) ? Z_FINISH : Z_NO_FLUSH;
+        crc = crc32(crc, reinterpret_cast<Bytef *>(buf.data()), static_cast<uInt>(numBytes));
+        stream.next_in = reinterpret_cast<Bytef *>(buf.data());
+        stream.avail_in = static_cast<uInt>(numBytes);
+        do {
+            // the file may have grown since its size was got
+            if (stream.total_out == data.size()) {
+                data.resize(data.size() + bufferSize);
+            }
+            stream.next_out = reinterpret_cast<Bytef *>(data.data() + stream.total_out);
+            stream.avail_out = static_cast<uInt>(data.size() - stream.total_out);
+            ret = deflate(&stream, flush);
+        } while (ret != Z_STREAM_ERROR && stream.avail_out == 0);
+        if (ret == Z_STREAM_ERROR) {
+            break;
+        }
+    }
+    fclose(fp);
+    fp = nullptr;
+    data.resize(stream.total_out);
+    entry.crc = crc;
+    entry.uncompressedSize = stream.total_in;
+    deflateEnd(&stream);
+    if (ret != Z_STREAM_END) {
+        APP_LOGI("%{public}s called, deflate failed: %{public}d", __func__, ret);
+        std::vector<char>().swap(data);
+        return false;
+    }
+    return true;
+}
+
+bool AddFileContentToZip(zipFile zip_file, FilePath &file_path, const OPTIONS &options)
 {
     APP_LOGI("%{public}s called", __func__);
     uint32_t num_bytes;
-    char buf[kZipBufSize];
+    size_t bufferSize = GetZipBufferSize(options);
+    std::vector<char> buf(bufferSize);
     if (!FilePathCheckValid(file_path.Value())) {
         APP_LOGI(
             "%{public}s called, filePath is invalid!!! file_path=%{public}s", __func__, file_path.Value().c_str());
@@ -61,9 +144,9 @@ bool AddFileContentToZip(zipFile zip_file, FilePath &file_path)
     }
 
     while (!feof(fp)) {
-        num_bytes = fread(buf, 1, kZipBufSize, fp);
+        num_bytes = fread(buf.data(), 1, bufferSize, fp);
         if (num_bytes > 0) {
-            if (zipWriteInFileInZip(zip_file, buf, num_bytes) != ZIP_OK) {
+            if (zipWriteInFileInZip(zip_file, buf.data(), num_bytes) != ZIP_OK) {
                 APP_LOGI("%{public}s called, Could not write data to zip for path:%{private}s ",
                     __func__, file_path.Value().c_str());
                 fclose(fp);
@@ -102,14 +185,14 @@ bool AddFileEntryToZip(zipFile zip_file, FilePath &relativePath, FilePath &absol
 {
     APP_LOGI("%{public}s called", __func__);
 
-    struct tm *lastModified = GetCurrentSystemTime();
-    if (lastModified == nullptr) {
+    struct tm lastModified = {};
+    if (!GetCurrentSystemTime(lastModified)) {
         return false;
     }
-    if (!OpenNewFileEntry(zip_file, relativePath, false, lastModified, options)) {
+    if (!OpenNewFileEntry(zip_file, relativePath, false, &lastModified, options)) {
         return false;
     }
-    bool success = AddFileContentToZip(zip_file, absolutePath);
+    bool success = AddFileContentToZip(zip_file, absolutePath, options);
     if (!CloseNewFileEntry(zip_file)) {
         APP_LOGI("!!! CloseNewFileEntry returnValule is false !!!");
         return false;
@@ -117,12 +200,102 @@ bool AddFileEntryToZip(zipFile zip_file, FilePath &relativePath, FilePath &absol
     return success;
 }
 
+bool AddDeflatedFileEntryToZip(zipFile zip_file, ZipEntry &entry, const OPTIONS &options)
+{
+    APP_LOGI("%{public}s called", __func__);
+
+    struct tm lastModified = {};
+    if (!GetCurrentSystemTime(lastModified)) {
+        return false;
+    }
+    // the data is deflated already, so it is written raw, and the entry is closed with the crc and size of the file
+    if (!ZipOpenNewFileInZip(zip_file, entry.relativePath.Value(), options, &lastModified, true)) {
+        return false;
+    }
+    unsigned int size = static_cast<unsigned int>(entry.deflatedData.size());
+    bool success = (size == 0) || (zipWriteInFileInZip(zip_file, entry.deflatedData.data(), size) == ZIP_OK);
+    if (zipCloseFileInZipRaw(zip_file, entry.uncompressedSize, entry.crc) != ZIP_OK) {
+        APP_LOGI("!!! zipCloseFileInZipRaw returnValule is false !!!");
+        return false;
+    }
+    return success;
+}
+
 bool AddDirectoryEntryToZip(zipFile zip_file, FilePath &path, struct tm *lastModified, const OPTIONS &options)
 {
     APP_LOGI("%{public}s called", __func__);
     return OpenNewFileEntry(zip_file, path, true, lastModified, options) && CloseNewFileEntry(zip_file);
 }
 
+bool AddEntryToZip(zipFile zip_file, ZipEntry &entry, const OPTIONS &options)
+{
+    if (entry.isDeflated) {
+        if (!AddDeflatedFileEntryToZip(zip_file, entry, options)) {
+            APP_LOGI("%{public}s called, Failed to write deflated file", __func__);
+            return false;
+        }
+    } else if (entry.isFile) {
+        if (!AddFileEntryToZip(zip_file, entry.relativePath, entry.absolutePath, options)) {
+            APP_LOGI("%{public}s called, Failed to write file", __func__);
+            return false;
+        }
+    } else {
+        // Missing file or directory case.
+        struct tm lastModified = {};
+        struct tm *lastModifiedPtr = GetCurrentSystemTime(lastModified) ? &lastModified : nullptr;
+        if (!AddDirectoryEntryToZip(zip_file, entry.relativePath, lastModifiedPtr, options)) {
+            APP_LOGI("%{public}s called, Failed to write directory", __func__);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Writes the entries in order. The small files of a window of entries are deflated concurrently into independent
+// deflate streams first, so the entries and the central directory records are the same as they are deflated one
+// by one, and the memory used is limited by MAX_DEFLATE_IN_MEMORY_SIZE.
+bool AddEntriesToZip(zipFile zip_file, std::vector<ZipEntry> &entries, const OPTIONS &options)
+{
+    for (auto &entry : entries) {
+        entry.isFile = FilePath::PathIsValid(entry.absolutePath) && !FilePath::IsDir(entry.absolutePath);
+        struct stat fileStat = {};
+        if (entry.isFile && stat(entry.absolutePath.Value().c_str(), &fileStat) == 0 && S_ISREG(fileStat.st_mode) &&
+            fileStat.st_size <= MAX_DEFLATE_IN_MEMORY_FILE_SIZE) {
+            entry.fileSize = fileStat.st_size;
+            entry.needDeflateInMemory = true;
+        }
+    }
+    size_t begin = 0;
+    while (begin < entries.size()) {
+        size_t end = begin;
+        int64_t windowSize = 0;
+        std::vector<size_t> deflateIndexes;
+        for (; end < entries.size(); ++end) {
+            if (!entries[end].needDeflateInMemory) {
+                continue;
+            }
+            if (!deflateIndexes.empty() && windowSize + entries[end].fileSize > MAX_DEFLATE_IN_MEMORY_SIZE) {
+                break;
+            }
+            windowSize += entries[end].fileSize;
+            deflateIndexes.emplace_back(end);
+        }
+        RunConcurrently(deflateIndexes.size(), GetCpuBoundThreadNum(MAX_ZIP_THREAD_NUM),
+            [&entries, &deflateIndexes, &options](size_t index) {
+                ZipEntry &entry = entries[deflateIndexes[index]];
+                entry.isDeflated = DeflateFileToMemory(entry, options);
+            });
+        for (size_t i = begin; i < end; ++i) {
+            // the file failed to be deflated into memory is written as before, which reports the error
+            if (!AddEntryToZip(zip_file, entries[i], options)) {
+                return false;
+            }
+            std::vector<char>().swap(entries[i].deflatedData);
+        }
+        begin = end;
+    }
+    return true;
+}
 }  // namespace
 
 std::unique_ptr<ZipWriter> ZipWriter::CreateWithFd(PlatformFile zipFilefd, const FilePath &rootDir)
@@ -200,39 +373,22 @@ bool ZipWriter::FlushEntriesIfNeeded(bool force, const OPTIONS &options, CALLBAC
     while (pendingEntries_.size() >= g_MaxPendingEntriesCount || (force && !pendingEntries_.empty())) {
 
         size_t entry_count = std::min(pendingEntries_.size(), g_MaxPendingEntriesCount);
-        std::vector<FilePath> relativePaths;
-        std::vector<FilePath> absolutePaths;
-
-        relativePaths.insert(relativePaths.begin(), pendingEntries_.begin(), pendingEntries_.begin() + entry_count);
-        for (auto iter = pendingEntries_.begin(); iter != pendingEntries_.begin() + entry_count; ++iter) {
+        std::vector<ZipEntry> entries(entry_count);
+        bool isRootDir = FilePath::IsDir(rootDir_);
+        for (size_t i = 0; i < entry_count; i++) {
+            entries[i].relativePath = pendingEntries_[i];
             // The FileAccessor requires absolute paths.
-            if (FilePath::IsDir(rootDir_)) {
-                absolutePaths.push_back(FilePath(rootDir_.Value() + iter->Value()));
+            if (isRootDir) {
+                entries[i].absolutePath = FilePath(rootDir_.Value() + pendingEntries_[i].Value());
             } else {
-                absolutePaths.push_back(FilePath(rootDir_.Value()));
+                entries[i].absolutePath = FilePath(rootDir_.Value());
             }
         }
         pendingEntries_.erase(pendingEntries_.begin(), pendingEntries_.begin() + entry_count);
-        for (size_t i = 0; i < absolutePaths.size(); i++) {
-            FilePath &relativePath = relativePaths[i];
-            FilePath &absolutePath = absolutePaths[i];
-            bool isValid = FilePath::PathIsValid(absolutePath);
-            bool isDir = FilePath::IsDir(absolutePath);
-            if (isValid && !isDir) {
-                if (!AddFileEntryToZip(zipFile_, relativePath, absolutePath, options)) {
-                    CALLING_CALL_BACK(callback, ERROR_CODE_ERRNO)
-                    APP_LOGI("%{public}s called, Failed to write file", __func__);
-                    return false;
-                }
-            } else {
-                // Missing file or directory case.
-                struct tm *last_modified = GetCurrentSystemTime();
-                if (!AddDirectoryEntryToZip(zipFile_, relativePath, last_modified, options)) {
-                    CALLING_CALL_BACK(callback, ERROR_CODE_ERRNO)
-                    APP_LOGI("%{public}s called, Failed to write directory", __func__);
-                    return false;
-                }
-            }
+        if (!AddEntriesToZip(zipFile_, entries, options)) {
+            CALLING_CALL_BACK(callback, ERROR_CODE_ERRNO)
+            APP_LOGI("%{public}s called, Failed to write entries", __func__);
+            return false;
         }
     }
     CALLING_CALL_BACK(callback, ERROR_CODE_OK)
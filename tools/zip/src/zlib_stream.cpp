@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "zlib_stream.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "app_log_wrapper.h"
+#include "zip_internal.h"
+
+namespace OHOS {
+namespace AppExecFwk {
+namespace LIBZIP {
+namespace {
+// Inflating detects the zlib and the gzip headers both.
+constexpr int INFLATE_WINDOW_BITS = MAX_WBITS + 32;
+}
+
+ZlibStream::ZlibStream(Mode mode, const OPTIONS &options) : mode_(mode), options_(options)
+{}
+
+ZlibStream::~ZlibStream()
+{
+    if (!initialized_) {
+        return;
+    }
+    if (mode_ == Mode::DEFLATE) {
+        deflateEnd(&stream_);
+    } else {
+        inflateEnd(&stream_);
+    }
+}
+
+int ZlibStream::Init()
+{
+    if (initialized_) {
+        return ERROR_CODE_OK;
+    }
+    int ret = Z_OK;
+    if (mode_ == Mode::DEFLATE) {
+        ret = deflateInit2(&stream_, options_.level, Z_DEFLATED, MAX_WBITS, options_.memLevel, options_.strategy);
+    } else {
+        ret = inflateInit2(&stream_, INFLATE_WINDOW_BITS);
+    }
+    if (ret != Z_OK) {
+        APP_LOGE("%{public}s called, init failed, error: %{public}d", __func__, ret);
+        return ret;
+    }
+    initialized_ = true;
+    return ERROR_CODE_OK;
+}
+
+int ZlibStream::Write(const char *data, size_t length, int flush, std::vector<char> &output)
+{
+    if (!initialized_ || (data == nullptr && length > 0)) {
+        return ERROR_CODE_STREAM_ERROR;
+    }
+    if (finished_) {
+        // nothing follows the end of the compressed data
+        return (length == 0) ? ERROR_CODE_OK : ERROR_CODE_STREAM_ERROR;
+    }
+    size_t chunkSize = GetZipBufferSize(options_);
+    size_t offset = 0;
+    do {
+        // the input size of zlib is 32 bits, so a larger input is fed piece by piece, and only the last piece is
+        // flushed
+        size_t inputSize = std::min<size_t>(length - offset, std::numeric_limits<uInt>::max());
+        stream_.next_in = (inputSize == 0) ? Z_NULL : reinterpret_cast<Bytef *>(const_cast<char *>(data + offset));
+        stream_.avail_in = static_cast<uInt>(inputSize);
+        offset += inputSize;
+        int pieceFlush = (offset == length) ? flush : Z_NO_FLUSH;
+        int ret = Z_OK;
+        do {
+            size_t outputSize = output.size();
+            output.resize(outputSize + chunkSize);
+            stream_.next_out = reinterpret_cast<Bytef *>(output.data() + outputSize);
+            stream_.avail_out = static_cast<uInt>(chunkSize);
+            ret = (mode_ == Mode::DEFLATE) ? deflate(&stream_, pieceFlush) : inflate(&stream_, pieceFlush);
+            output.resize(outputSize + chunkSize - stream_.avail_out);
+            if (ret == Z_STREAM_END) {
+                finished_ = true;
+                return ERROR_CODE_OK;
+            }
+            // Z_BUF_ERROR only means no progress was possible with the buffers given
+            if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                APP_LOGE("%{public}s called, error: %{public}d", __func__, ret);
+                return ret;
+            }
+        } while (stream_.avail_out == 0 || (ret == Z_OK && stream_.avail_in > 0));
+    } while (offset < length);
+    return ERROR_CODE_OK;
+}
+
+int Deflate(const char *data, size_t length, const OPTIONS &options, std::vector<char> &output)
+{
+    ZlibStream stream(ZlibStream::Mode::DEFLATE, options);
+    int ret = stream.Init();
+    if (ret != ERROR_CODE_OK) {
+        return ret;
+    }
+    output.reserve(output.size() + compressBound(static_cast<uLong>(length)));
+    return stream.Write(data, length, FLUSH_TYPE_FINISH, output);
+}
+
+int Inflate(const char *data, size_t length, const OPTIONS &options, std::vector<char> &output)
+{
+    ZlibStream stream(ZlibStream::Mode::INFLATE, options);
+    int ret = stream.Init();
+    if (ret != ERROR_CODE_OK) {
+        return ret;
+    }
+    ret = stream.Write(data, length, FLUSH_TYPE_FINISH, output);
+    if (ret != ERROR_CODE_OK) {
+        return ret;
+    }
+    return stream.IsFinished() ? ERROR_CODE_OK : ERROR_CODE_BUF_ERROR;
+}
+
+}  // namespace LIBZIP
+}  // namespace AppExecFwk
+}  // namespace OHOS
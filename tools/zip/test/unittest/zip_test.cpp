@@ -13,10 +13,15 @@
  * limitations under the License.
  */
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <fstream>
+#include <future>
 #include <memory>
+#include <sstream>
 #include <thread>
 
 #include "zip.h"
+#include "zlib_stream.h"
 
 namespace OHOS {
 namespace AppExecFwk {
@@ -106,6 +111,47 @@ HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_zip_0100_zip1file, Function | MediumTest | L
     std::this_thread::sleep_for(std::chrono::milliseconds(5000));
 }
 
+/**
+ * @tc.number: APPEXECFWK_LIBZIP_zip_0300_multiple_files
+ * @tc.name: zip_0300_multiple_files
+ * @tc.desc: the files deflated concurrently are unzipped to the same contents in order
+ */
+HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_zip_0300_multiple_files, Function | MediumTest | Level1)
+{
+    const int fileCount = 10;
+    std::string src = BASE_PATH + APP_PATH + "multiple";
+    std::string dest = BASE_PATH + APP_PATH + "result/multiple.zip";
+    std::string unzipDir = BASE_PATH + APP_PATH + "unzip/multiple";
+    EXPECT_TRUE(FilePath::CreateDirectory(FilePath(src)));
+    EXPECT_TRUE(FilePath::CreateDirectory(FilePath(unzipDir)));
+    std::vector<std::string> contents;
+    for (int i = 0; i < fileCount; i++) {
+        std::string content(i * i * 1024, static_cast<char>('a' + i));
+        std::ofstream(src + "/file" + std::to_string(i) + ".txt") << content;
+        contents.emplace_back(content);
+    }
+
+    OPTIONS options;
+    options.chunkSize = 64 * 1024;
+    std::promise<int> zipResult;
+    EXPECT_TRUE(Zip(FilePath(src), FilePath(dest), options, [&zipResult](int result) {
+        zipResult.set_value(result);
+    }, false));
+    EXPECT_EQ(zipResult.get_future().get(), ERROR_CODE_OK);
+
+    std::promise<int> unzipResult;
+    EXPECT_TRUE(Unzip(FilePath(dest), FilePath(unzipDir), options, [&unzipResult](int result) {
+        unzipResult.set_value(result);
+    }));
+    EXPECT_EQ(unzipResult.get_future().get(), ERROR_CODE_OK);
+    for (int i = 0; i < fileCount; i++) {
+        std::ifstream file(unzipDir + "/file" + std::to_string(i) + ".txt");
+        std::stringstream content;
+        content << file.rdbuf();
+        EXPECT_EQ(content.str(), contents[i]);
+    }
+}
+
 /**
  * @tc.number: APPEXECFWK_LIBZIP_unzip_0100_8file
  * @tc.name: unzip_0100_8file
@@ -149,6 +195,50 @@ HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_unzip_0100_zip1file, Function | MediumTest |
     std::this_thread::sleep_for(std::chrono::milliseconds(5000));
 }
 
+/**
+ * @tc.number: APPEXECFWK_LIBZIP_unzip_0300_directories
+ * @tc.name: unzip_0300_directories
+ * @tc.desc: the files in nested directories are extracted concurrently to the same contents
+ */
+HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_unzip_0300_directories, Function | MediumTest | Level1)
+{
+    const int dirCount = 4;
+    const int fileCount = 8;
+    std::string src = BASE_PATH + APP_PATH + "directories";
+    std::string dest = BASE_PATH + APP_PATH + "result/directories.zip";
+    std::string unzipDir = BASE_PATH + APP_PATH + "unzip/directories";
+    EXPECT_TRUE(FilePath::CreateDirectory(FilePath(unzipDir)));
+    for (int i = 0; i < dirCount; i++) {
+        std::string dir = src + "/dir" + std::to_string(i) + "/sub";
+        EXPECT_TRUE(FilePath::CreateDirectory(FilePath(dir)));
+        for (int j = 0; j < fileCount; j++) {
+            std::ofstream(dir + "/file" + std::to_string(j) + ".txt") << std::string((i + 1) * (j + 1) * 4096, 'a' + j);
+        }
+    }
+
+    OPTIONS options;
+    std::promise<int> zipResult;
+    EXPECT_TRUE(Zip(FilePath(src), FilePath(dest), options, [&zipResult](int result) {
+        zipResult.set_value(result);
+    }, false));
+    EXPECT_EQ(zipResult.get_future().get(), ERROR_CODE_OK);
+
+    std::promise<int> unzipResult;
+    EXPECT_TRUE(Unzip(FilePath(dest), FilePath(unzipDir), options, [&unzipResult](int result) {
+        unzipResult.set_value(result);
+    }));
+    EXPECT_EQ(unzipResult.get_future().get(), ERROR_CODE_OK);
+    for (int i = 0; i < dirCount; i++) {
+        std::string dir = unzipDir + "/dir" + std::to_string(i) + "/sub";
+        for (int j = 0; j < fileCount; j++) {
+            std::ifstream file(dir + "/file" + std::to_string(j) + ".txt");
+            std::stringstream content;
+            content << file.rdbuf();
+            EXPECT_EQ(content.str(), std::string((i + 1) * (j + 1) * 4096, 'a' + j));
+        }
+    }
+}
+
 /**
  * @tc.number: APPEXECFWK_LIBZIP_Checkzip_0100
  * @tc.name: Checkzip_0100
@@ -299,6 +389,66 @@ HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_Checkzip_0800, Function | MediumTest | Level
     Unzip(srcFile, destFile, options, UnzipCallBack);
     std::this_thread::sleep_for(std::chrono::milliseconds(5000));
 }
+
+/**
+ * @tc.number: APPEXECFWK_LIBZIP_zlib_0100_buffer
+ * @tc.name: zlib_0100_buffer
+ * @tc.desc: a buffer deflated at once is inflated to the same data, and a truncated one fails
+ */
+HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_zlib_0100_buffer, Function | MediumTest | Level1)
+{
+    std::string data;
+    for (int i = 0; i < 100000; i++) {
+        data += std::to_string(i);
+    }
+    OPTIONS options;
+    options.level = COMPRESS_LEVEL_BEST_COMPRESSION;
+    std::vector<char> compressed;
+    EXPECT_EQ(Deflate(data.data(), data.size(), options, compressed), ERROR_CODE_OK);
+    EXPECT_LT(compressed.size(), data.size());
+
+    std::vector<char> decompressed;
+    EXPECT_EQ(Inflate(compressed.data(), compressed.size(), options, decompressed), ERROR_CODE_OK);
+    EXPECT_EQ(std::string(decompressed.begin(), decompressed.end()), data);
+
+    decompressed.clear();
+    EXPECT_EQ(Inflate(compressed.data(), compressed.size() / 2, options, decompressed), ERROR_CODE_BUF_ERROR);
+}
+
+/**
+ * @tc.number: APPEXECFWK_LIBZIP_zlib_0200_stream
+ * @tc.name: zlib_0200_stream
+ * @tc.desc: the data deflated and inflated chunk by chunk is the same as the original one
+ */
+HWTEST_F(ZipTest, APPEXECFWK_LIBZIP_zlib_0200_stream, Function | MediumTest | Level1)
+{
+    const size_t chunkSize = 1000;
+    std::string data;
+    for (int i = 0; i < 100000; i++) {
+        data += std::to_string(i * i);
+    }
+    OPTIONS options;
+    ZlibStream deflateStream(ZlibStream::Mode::DEFLATE, options);
+    EXPECT_EQ(deflateStream.Init(), ERROR_CODE_OK);
+    std::vector<char> compressed;
+    for (size_t offset = 0; offset < data.size(); offset += chunkSize) {
+        size_t length = std::min(chunkSize, data.size() - offset);
+        EXPECT_EQ(deflateStream.Write(data.data() + offset, length, FLUSH_TYPE_NO_FLUSH, compressed), ERROR_CODE_OK);
+    }
+    EXPECT_EQ(deflateStream.Write(nullptr, 0, FLUSH_TYPE_FINISH, compressed), ERROR_CODE_OK);
+    EXPECT_TRUE(deflateStream.IsFinished());
+
+    ZlibStream inflateStream(ZlibStream::Mode::INFLATE, options);
+    EXPECT_EQ(inflateStream.Init(), ERROR_CODE_OK);
+    std::vector<char> decompressed;
+    for (size_t offset = 0; offset < compressed.size(); offset += chunkSize) {
+        size_t length = std::min(chunkSize, compressed.size() - offset);
+        EXPECT_EQ(inflateStream.Write(compressed.data() + offset, length, FLUSH_TYPE_SYNC_FLUSH, decompressed),
+            ERROR_CODE_OK);
+    }
+    EXPECT_TRUE(inflateStream.IsFinished());
+    EXPECT_EQ(std::string(decompressed.begin(), decompressed.end()), data);
+}
 }  // namespace LIBZIP
 }  // namespace AppExecFwk
 }  // namespace OHOS
\ No newline at end of file